@@ -31,10 +31,9 @@ option(MKLDNN_VERBOSE
     environment variable set to 1" ON) # enabled by default
 
 option(MKLDNN_ENABLE_CONCURRENT_EXEC
-    "disables sharing a common scratchpad between primitives.
-    This option must be turned on if there is a possibility of concurrent
-    execution of primitives that were created in the same thread.
-    CAUTION: enabling this option increases memory consumption"
+    "deprecated, has no effect. Primitives borrow their scratchpads from
+    the executing stream, so primitives executed by different streams may
+    always run concurrently"
     OFF) # disabled by default
 
 # =============================
@@ -55,7 +54,8 @@ set(MKLDNN_INSTALL_MODE "DEFAULT" CACHE STRING
     The BUNDLE option requires MKLDNN_USE_MKL be set to FULL:STATIC.")
 
 set(MKLDNN_THREADING "OMP" CACHE STRING
-    "specifies threading type; supports OMP (default), OMP:COMP, OMP:INTEL, or TBB.
+    "specifies threading type; supports OMP (default), OMP:COMP, OMP:INTEL, TBB,
+    or THREADPOOL.
 
     When OpenMP is used a user can choose what runtime to use:
     - native OpenMP runtime that comes with the compiler (OMP:COMP), or
@@ -69,7 +69,10 @@ set(MKLDNN_THREADING "OMP" CACHE STRING
 
     To use Intel(R) Threading Building Blocks (Intel(R) TBB) one should also
     set TBBROOT (either environment variable or CMake option) to the library
-    location")
+    location.
+
+    THREADPOOL uses the native thread pool of the library, which needs no
+    runtime besides the system threads library")
 
 set(MKLDNN_USE_MKL "NONE" CACHE STRING
     "specifies what Intel MKL library to use.
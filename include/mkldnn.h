@@ -453,6 +453,83 @@ mkldnn_status_t MKLDNN_API mkldnn_post_ops_get_params_eltwise(
         const_mkldnn_post_ops_t post_ops, int index, float *scale,
         mkldnn_alg_kind_t *alg, float *alpha, float *beta);
 
+/** Appends binary post operation to the @p post_ops with given algorithm
+ * @p alg_kind (@sa mkldnn_binary_desc_init) and memory descriptor
+ * @p src1_desc of its second operand.
+ *
+ * The kind of this post operation is #mkldnn_binary.
+ *
+ * In the simplest case when the binary is the only post operation, the
+ * computations would be:
+ * dst[] <- binary_op ( op(...), src1[] ) // instead of dst[] <- op(...)
+ *
+ * The src1 tensor has the number of dimensions of the destination and is
+ * broadcast against it: either it has all the dimensions equal to one
+ * (per-tensor), or all but the channel one (per-channel), or it matches the
+ * destination including its format. The format of @p src1_desc cannot be
+ * #mkldnn_any.
+ *
+ * The src1 memories are passed to the primitive as extra inputs that follow
+ * the regular ones, in the order of the binary post operations.
+ */
+mkldnn_status_t MKLDNN_API mkldnn_post_ops_append_binary(
+        mkldnn_post_ops_t post_ops, mkldnn_alg_kind_t alg_kind,
+        const mkldnn_memory_desc_t *src1_desc);
+
+/** Gets the binary parameters of the post operation with index @p index in
+ * the sequence of @p post_ops. The returned @p src1_desc points to the
+ * internal storage of @p post_ops.
+ */
+mkldnn_status_t MKLDNN_API mkldnn_post_ops_get_params_binary(
+        const_mkldnn_post_ops_t post_ops, int index,
+        mkldnn_alg_kind_t *alg_kind, const mkldnn_memory_desc_t **src1_desc);
+
+/** Appends a depthwise convolution post operation with the 3x3 kernel, the
+ * stride of 1 and the padding of 1 to the @p post_ops. The data types of the
+ * weights, the bias (#mkldnn_data_type_undef for none) and the destination
+ * of the depthwise convolution are @p weights_data_type, @p bias_data_type
+ * and @p dst_data_type.
+ *
+ * The kind of this post operation is #mkldnn_convolution.
+ *
+ * The depthwise convolution runs over the output of the primitive with one
+ * group per output channel, so the destination of the primitive becomes the
+ * destination of the depthwise convolution. Its weights (G x 1 x 1 x 3 x 3)
+ * and its bias are passed to the primitive as extra inputs that follow the
+ * bias of the primitive; their formats are chosen by the implementation and
+ * can be queried with #mkldnn_query_input_pd.
+ */
+mkldnn_status_t MKLDNN_API mkldnn_post_ops_append_dw_k3s1p1(
+        mkldnn_post_ops_t post_ops, mkldnn_data_type_t weights_data_type,
+        mkldnn_data_type_t bias_data_type, mkldnn_data_type_t dst_data_type);
+
+/** Gets the data types of the depthwise convolution post operation with
+ * index @p index in the sequence of @p post_ops, which must have been
+ * appended with mkldnn_post_ops_append_dw_k3s1p1().
+ */
+mkldnn_status_t MKLDNN_API mkldnn_post_ops_get_params_dw_k3s1p1(
+        const_mkldnn_post_ops_t post_ops, int index,
+        mkldnn_data_type_t *weights_data_type,
+        mkldnn_data_type_t *bias_data_type, mkldnn_data_type_t *dst_data_type);
+
+/** Appends a depthwise convolution post operation with the 3x3 kernel, the
+ * stride of 2 and the padding of 1 to the @p post_ops.
+ *
+ * @sa mkldnn_post_ops_append_dw_k3s1p1
+ */
+mkldnn_status_t MKLDNN_API mkldnn_post_ops_append_dw_k3s2p1(
+        mkldnn_post_ops_t post_ops, mkldnn_data_type_t weights_data_type,
+        mkldnn_data_type_t bias_data_type, mkldnn_data_type_t dst_data_type);
+
+/** Gets the data types of the depthwise convolution post operation with
+ * index @p index in the sequence of @p post_ops, which must have been
+ * appended with mkldnn_post_ops_append_dw_k3s2p1().
+ */
+mkldnn_status_t MKLDNN_API mkldnn_post_ops_get_params_dw_k3s2p1(
+        const_mkldnn_post_ops_t post_ops, int index,
+        mkldnn_data_type_t *weights_data_type,
+        mkldnn_data_type_t *bias_data_type, mkldnn_data_type_t *dst_data_type);
+
 /** @} */
 
 /** @} */
@@ -1169,6 +1246,28 @@ mkldnn_status_t MKLDNN_API mkldnn_softmax_backward_desc_init(
         const mkldnn_memory_desc_t *diff_desc,
         const mkldnn_memory_desc_t *data_desc, int softmax_axis);
 
+/** Initializes a @p softmax_desc for forward propagation of logsoftmax
+ *
+ * \f[dst[ou][c][in] = src[ou][c][in] - \max\limits_{c}(src[ou][c][in])
+ *    - \log\sum\limits_{c}\exp(src[ou][c][in]
+ *    - \max\limits_{c}(src[ou][c][in])),\f]
+ *
+ * with the same arguments, inputs and outputs as
+ * mkldnn_softmax_forward_desc_init(). The algorithm of the descriptor is
+ * #mkldnn_softmax_log. */
+mkldnn_status_t MKLDNN_API mkldnn_logsoftmax_forward_desc_init(
+        mkldnn_softmax_desc_t *softmax_desc, mkldnn_prop_kind_t prop_kind,
+        const mkldnn_memory_desc_t *data_desc, int softmax_axis);
+
+/** Initializes a @p softmax_desc for backward propagation of logsoftmax
+ * with the same arguments, inputs and outputs as
+ * mkldnn_softmax_backward_desc_init(). The dst input is the result of the
+ * forward logsoftmax. */
+mkldnn_status_t MKLDNN_API mkldnn_logsoftmax_backward_desc_init(
+        mkldnn_softmax_desc_t *softmax_desc,
+        const mkldnn_memory_desc_t *diff_desc,
+        const mkldnn_memory_desc_t *data_desc, int softmax_axis);
+
 /** @} */
 
 /** @addtogroup c_api_pooling Pooling
@@ -1415,6 +1514,89 @@ mkldnn_status_t MKLDNN_API mkldnn_batch_normalization_backward_desc_init(
 
 /** @} */
 
+/** @addtogroup c_api_layer_normalization Layer Normalization
+ * A primitive to perform layer normalization, the normalization running along
+ * the last dimension (C) of the data.
+ *
+ * \f[dst[t][c] = \gamma[c] \frac{src[t][c] - \mu[t]}
+ *                  {\sqrt{\sigma[t] + eps}} + \beta[c],\f]
+ *
+ * where t runs over the outer dimensions, \f$\gamma[c], \beta[c]\f$ are
+ * weights and bias for a channel and,
+ *
+ * \f$\mu[t] = \frac{1}{C} \sum\limits_{c} src[t][c]\f$,
+ * \f$\sigma[t] = \frac{1}{C} \sum\limits_{c} (src[t][c] - \mu[t])^2\f$,
+ *
+ * and @c eps is a constant to improve numerical stability.
+ *
+ * Both forward and backward passes support in-place operation.
+ *
+ * @sa mkldnn_layer_normalization_desc_t
+ * @{ */
+
+/** Initializes a layer normalization descriptor @p lnrm_desc for forward
+ * propagation using @p prop_kind (possible values are
+ * #mkldnn_forward_training and #mkldnn_forward_inference), memory descriptor
+ * @p data_desc, statistics memory descriptor @p stat_desc, normalization
+ * parameter @p epsilon, and @p flags set using bit flags
+ * #mkldnn_use_global_stats and #mkldnn_use_scaleshift.
+ *
+ * @p stat_desc may be @c NULL, the statistics are then dense with the
+ * dimensions of @p data_desc but the last one.
+ *
+ * Order of inputs:
+ *  - src (#mkldnn_query_src_pd, 0)
+ *  - mean (#mkldnn_query_src_pd, 1),
+ *      if #mkldnn_use_global_stats bit-flags is set in @p flags
+ *  - variance (#mkldnn_query_src_pd, 2),
+ *      if #mkldnn_use_global_stats bit-flags is set in @p flags
+ *  - scale_and_shift (#mkldnn_query_weights_pd, 0),
+ *      if #mkldnn_use_scaleshift bit-flags is set in @p flags
+ *
+ * Order of outputs:
+ *  - dst (#mkldnn_query_dst_pd, 0)
+ *  - mean (#mkldnn_query_dst_pd, 1),
+ *      if #mkldnn_use_global_stats bit-flags is not set in @p flags
+ *      @p prop_kind = #mkldnn_forward_training
+ *  - variance (#mkldnn_query_dst_pd, 2),
+ *      if #mkldnn_use_global_stats bit-flags is not set in @p flags
+ *      and @p prop_kind = #mkldnn_forward_training
+ */
+mkldnn_status_t MKLDNN_API mkldnn_layer_normalization_forward_desc_init(
+        mkldnn_layer_normalization_desc_t *lnrm_desc,
+        mkldnn_prop_kind_t prop_kind, const mkldnn_memory_desc_t *data_desc,
+        const mkldnn_memory_desc_t *stat_desc, float epsilon, unsigned flags);
+
+/** Initializes a layer normalization descriptor @p lnrm_desc for backward
+ * propagation with respect to data and scale-shift parameters using memory
+ * descriptors @p diff_data_desc, @p data_desc and @p stat_desc (may be
+ * @c NULL, see mkldnn_layer_normalization_forward_desc_init()),
+ * normalization parameter @p epsilon, and @p flags set using bit flags
+ * #mkldnn_use_global_stats and #mkldnn_use_scaleshift.
+ *
+ * Order of inputs:
+ *  - src (#mkldnn_query_src_pd, 0)
+ *  - mean (#mkldnn_query_src_pd, 1)
+ *  - variance (#mkldnn_query_src_pd, 2)
+ *  - diff_dst (#mkldnn_query_diff_dst_pd, 0)
+ *  - scale_and_shift (#mkldnn_query_weights_pd, 0),
+ *      if #mkldnn_use_scaleshift bit-flags is set in @p flags
+ *
+ * Order of outputs:
+ *  - diff_src (#mkldnn_query_diff_src_pd, 0)
+ *  - diff_scale_and_shift (#mkldnn_query_diff_weights_pd, 0),
+ *      if #mkldnn_use_scaleshift bit-flags is set in @p flags
+ *      and @p prop_kind = #mkldnn_backward
+ */
+mkldnn_status_t MKLDNN_API mkldnn_layer_normalization_backward_desc_init(
+        mkldnn_layer_normalization_desc_t *lnrm_desc,
+        mkldnn_prop_kind_t prop_kind,
+        const mkldnn_memory_desc_t *diff_data_desc,
+        const mkldnn_memory_desc_t *data_desc,
+        const mkldnn_memory_desc_t *stat_desc, float epsilon, unsigned flags);
+
+/** @} */
+
 /** @addtogroup c_api_inner_product Inner product
  * A primitive to compute an inner product.
  *
@@ -1687,6 +1869,82 @@ mkldnn_status_t MKLDNN_API mkldnn_rnn_backward_desc_init(
 
 /** @} */
 
+/** @addtogroup c_api_matmul Matrix multiplication
+ * A primitive to multiply (batches of) matrices.
+ *
+ * \f[dst[b][m][n] = \sum\limits_{k} src[b][m][k] \cdot weights[b][k][n]
+ *                 + bias[b][m][n]\f]
+ *
+ * where b runs over the outer dimensions, along which src, weights and bias
+ * may be broadcast (see #mkldnn_matmul_desc_t). Output scales with a zero
+ * mask scale the whole right hand side, the sum and eltwise post-ops are
+ * applied afterwards.
+ * @{ */
+
+/** Initializes a matrix multiplication descriptor @p matmul_desc using
+ * memory descriptors of 2 to 5 dimensions. In order to create
+ * a matmul without bias, @p bias_desc should be either @c NULL or a pointer
+ * to a descriptor with memory format equal to #mkldnn_format_undef.
+ *
+ * @note
+ *     Memory descriptors are allowed to be initialized with #mkldnn_any value
+ *     of @p format_kind, which stands for the row major layout. Any plain
+ *     (non-blocked) layout is accepted, e.g. a transposed matrix is described
+ *     by its strides.
+ *
+ * Order of inputs:
+ *  - src (#mkldnn_query_src_pd, 0)
+ *  - weights (#mkldnn_query_weights_pd, 0)
+ *  - bias (#mkldnn_query_weights_pd, 1), if created with bias
+ *
+ * Order of outputs:
+ *  - dst (#mkldnn_query_dst_pd, 0)
+ */
+mkldnn_status_t MKLDNN_API mkldnn_matmul_desc_init(
+        mkldnn_matmul_desc_t *matmul_desc,
+        const mkldnn_memory_desc_t *src_desc,
+        const mkldnn_memory_desc_t *weights_desc,
+        const mkldnn_memory_desc_t *bias_desc,
+        const mkldnn_memory_desc_t *dst_desc);
+
+/** @} */
+
+/** @addtogroup c_api_binary Binary
+ * A primitive to perform an elementwise binary operation on two tensors.
+ *
+ * \f[dst[i] = alg(src0[i], src1[i'])\f]
+ *
+ * where alg is add, mul, max or min and i' is i with the coordinates of the
+ * dimensions along which src1 is broadcast (see #mkldnn_binary_desc_t) set
+ * to 0.
+ * @{ */
+
+/** Initializes a binary descriptor @p binary_desc using @p alg_kind
+ * (possible values are #mkldnn_binary_add, #mkldnn_binary_mul,
+ * #mkldnn_binary_max and #mkldnn_binary_min) and memory descriptors of 1 to
+ * 5 dimensions. @p dst_desc may be @c NULL, dst is then described by
+ * @p src0_desc.
+ *
+ * @note
+ *     The formats of @p src0_desc and @p src1_desc may be #mkldnn_any, which
+ *     stands for the layout of dst or, if it is #mkldnn_any as well, the
+ *     plain one.
+ *
+ * Inputs:
+ *  - src0 (#mkldnn_query_src_pd, 0)
+ *  - src1 (#mkldnn_query_src_pd, 1)
+ *
+ * Outputs:
+ *  - dst (#mkldnn_query_dst_pd, 0)
+ */
+mkldnn_status_t MKLDNN_API mkldnn_binary_desc_init(
+        mkldnn_binary_desc_t *binary_desc, mkldnn_alg_kind_t alg_kind,
+        const mkldnn_memory_desc_t *src0_desc,
+        const mkldnn_memory_desc_t *src1_desc,
+        const mkldnn_memory_desc_t *dst_desc);
+
+/** @} */
+
 /** @} */
 
 /** @addtogroup c_api_engine Engine operations
@@ -1733,6 +1991,24 @@ mkldnn_status_t MKLDNN_API mkldnn_stream_wait(mkldnn_stream_t stream,
 mkldnn_status_t MKLDNN_API mkldnn_stream_rerun(mkldnn_stream_t stream,
         mkldnn_primitive_t *error_primitive);
 
+/** Limits the number of threads the primitives of the @p stream run on to
+ * @p nthr; zero removes the limit. Several streams driven from different
+ * threads can this way share the cores. Returns #mkldnn_unimplemented unless
+ * the library is built with the native thread pool runtime
+ * (MKLDNN_THREADING=THREADPOOL). */
+mkldnn_status_t MKLDNN_API mkldnn_stream_set_max_threads(
+        mkldnn_stream_t stream, int nthr);
+
+/** Makes the primitives executed by the @p stream borrow their scratchpads
+ * from @p size bytes of user memory at @p ptr, which must be 64-byte aligned
+ * and stay valid while the stream executes. By default a stream owns memory
+ * sized to the largest scratchpad of the primitives submitted to it (see
+ * #mkldnn_query_memory_consumption_s64). The same memory may be given to
+ * several streams that do not execute at the same time. Passing @c NULL
+ * returns to memory owned by the stream. */
+mkldnn_status_t MKLDNN_API mkldnn_stream_set_scratchpad(
+        mkldnn_stream_t stream, void *ptr, size_t size);
+
 /** Destroys an execution @p stream. */
 mkldnn_status_t MKLDNN_API mkldnn_stream_destroy(mkldnn_stream_t stream);
 
@@ -1761,6 +2037,20 @@ mkldnn_status_t MKLDNN_API mkldnn_set_verbose(int level);
  *     This setting overrides the MKLDNN_JIT_DUMP environment variable. */
 mkldnn_status_t MKLDNN_API mkldnn_set_jit_dump(int dump);
 
+/** Sets the number of primitive descriptors and of generated kernels that
+ * the library keeps for reuse. Creating a primitive descriptor for an op
+ * descriptor and attributes seen before then skips the implementation
+ * search, and creating a primitive reuses the generated code of its
+ * kernels. Zero disables the caching; the default is 1024.
+ *
+ * @note
+ *     This setting overrides the MKLDNN_PRIMITIVE_CACHE_CAPACITY environment
+ *     variable. */
+mkldnn_status_t MKLDNN_API mkldnn_set_primitive_cache_capacity(int capacity);
+
+/** Returns the capacity of the primitive cache in @p capacity. */
+mkldnn_status_t MKLDNN_API mkldnn_get_primitive_cache_capacity(int *capacity);
+
 /** Gets library version information.
  * Version information includes:
  *  - major -- major version number
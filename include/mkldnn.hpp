@@ -128,6 +128,9 @@ public:
         batch_normalization = mkldnn_batch_normalization,
         inner_product = mkldnn_inner_product,
         rnn = mkldnn_rnn,
+        matmul = mkldnn_matmul,
+        layer_normalization = mkldnn_layer_normalization,
+        binary = mkldnn_binary,
     };
 
     /// A wrapper structure to specify a particular output of a primitive.
@@ -280,7 +283,13 @@ enum algorithm {
     vanilla_rnn = mkldnn_vanilla_rnn,
     vanilla_lstm = mkldnn_vanilla_lstm,
     vanilla_gru = mkldnn_vanilla_gru,
-    gru_linear_before_reset = mkldnn_gru_linear_before_reset
+    gru_linear_before_reset = mkldnn_gru_linear_before_reset,
+    softmax_accurate = mkldnn_softmax_accurate,
+    softmax_log = mkldnn_softmax_log,
+    binary_add = mkldnn_binary_add,
+    binary_mul = mkldnn_binary_mul,
+    binary_max = mkldnn_binary_max,
+    binary_min = mkldnn_binary_min
 };
 
 inline mkldnn_alg_kind_t convert_to_c(algorithm aalgorithm) {
@@ -336,6 +345,9 @@ enum query {
     batch_normalization_d = mkldnn_query_batch_normalization_d,
     inner_product_d = mkldnn_query_inner_product_d,
     rnn_d = mkldnn_query_rnn_d,
+    matmul_d = mkldnn_query_matmul_d,
+    layer_normalization_d = mkldnn_query_layer_normalization_d,
+    binary_d = mkldnn_query_binary_d,
 
     input_pd = mkldnn_query_input_pd,
     output_pd = mkldnn_query_output_pd,
@@ -409,6 +421,62 @@ struct post_ops: public handle<mkldnn_post_ops_t> {
                 "could not get eltwise params");
         alg = static_cast<algorithm>(c_alg);
     }
+
+    /// Appends a binary post operation, @p src1_desc is the descriptor of
+    /// the second operand (the data of a memory::desc).
+    void append_binary(algorithm alg, const mkldnn_memory_desc_t &src1_desc) {
+        error::wrap_c_api(mkldnn_post_ops_append_binary(get(),
+                    convert_to_c(alg), &src1_desc),
+                "could not append binary");
+    }
+
+    void get_params_binary(int index, algorithm &alg,
+            mkldnn_memory_desc_t &src1_desc) const {
+        mkldnn_alg_kind_t c_alg;
+        const mkldnn_memory_desc_t *c_src1_desc;
+        error::wrap_c_api(mkldnn_post_ops_get_params_binary(get(), index,
+                    &c_alg, &c_src1_desc),
+                "could not get binary params");
+        alg = static_cast<algorithm>(c_alg);
+        src1_desc = *c_src1_desc;
+    }
+
+    /// Appends a depthwise convolution post operation with the 3x3 kernel,
+    /// the stride of 1 and the padding of 1. Its weights and bias are the
+    /// inputs of the primitive that follow the bias.
+    void append_dw_k3s1p1(mkldnn_data_type_t weights_data_type,
+            mkldnn_data_type_t bias_data_type,
+            mkldnn_data_type_t dst_data_type) {
+        error::wrap_c_api(mkldnn_post_ops_append_dw_k3s1p1(get(),
+                    weights_data_type, bias_data_type, dst_data_type),
+                "could not append dw_k3s1p1");
+    }
+
+    void get_params_dw_k3s1p1(int index, mkldnn_data_type_t &weights_data_type,
+            mkldnn_data_type_t &bias_data_type,
+            mkldnn_data_type_t &dst_data_type) const {
+        error::wrap_c_api(mkldnn_post_ops_get_params_dw_k3s1p1(get(), index,
+                    &weights_data_type, &bias_data_type, &dst_data_type),
+                "could not get dw_k3s1p1 params");
+    }
+
+    /// Appends a depthwise convolution post operation with the 3x3 kernel,
+    /// the stride of 2 and the padding of 1.
+    void append_dw_k3s2p1(mkldnn_data_type_t weights_data_type,
+            mkldnn_data_type_t bias_data_type,
+            mkldnn_data_type_t dst_data_type) {
+        error::wrap_c_api(mkldnn_post_ops_append_dw_k3s2p1(get(),
+                    weights_data_type, bias_data_type, dst_data_type),
+                "could not append dw_k3s2p1");
+    }
+
+    void get_params_dw_k3s2p1(int index, mkldnn_data_type_t &weights_data_type,
+            mkldnn_data_type_t &bias_data_type,
+            mkldnn_data_type_t &dst_data_type) const {
+        error::wrap_c_api(mkldnn_post_ops_get_params_dw_k3s2p1(get(), index,
+                    &weights_data_type, &bias_data_type, &dst_data_type),
+                "could not get dw_k3s2p1 params");
+    }
 };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -1477,6 +1545,8 @@ struct convolution_forward: public primitive {
         mkldnn_primitive_at_t inputs[] = { src.data, weights.data,
                     bias.data };
         const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 3, 1,
+            "convolution forward");
         error::wrap_c_api(mkldnn_primitive_create(&result,
                     aprimitive_desc.get(), inputs, outputs),
                 "could not create a convolution forward bias primitive");
@@ -1496,6 +1566,23 @@ struct convolution_forward: public primitive {
                 "could not create a convolution forward primitive");
         reset(result);
     }
+
+    /// Creates the primitive from all its inputs: the regular ones followed
+    /// by the src1 memories of the binary post operations.
+    convolution_forward(const primitive_desc &aprimitive_desc,
+            const std::vector<primitive::at> &inputs, const memory &dst) {
+        mkldnn_primitive_t result;
+        std::vector<mkldnn_primitive_at_t> p_inputs;
+        for (size_t i = 0; i < inputs.size(); i++)
+            p_inputs.push_back(inputs[i].data);
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), (int)p_inputs.size(), 1,
+            "convolution forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                    aprimitive_desc.get(), &p_inputs[0], outputs),
+                "could not create a convolution forward primitive");
+        reset(result);
+    }
 };
 
 struct convolution_backward_data : public primitive {
@@ -2417,6 +2504,20 @@ struct softmax_forward : public primitive {
                     softmax_axis),
                 "could not create a softmax forward descriptor");
         }
+        desc(prop_kind aprop_kind, algorithm aalgorithm,
+                const memory::desc &data_desc, int softmax_axis) {
+            mkldnn_status_t status = mkldnn_invalid_arguments;
+            if (aalgorithm == algorithm::softmax_accurate)
+                status = mkldnn_softmax_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind), &data_desc.data,
+                        softmax_axis);
+            else if (aalgorithm == algorithm::softmax_log)
+                status = mkldnn_logsoftmax_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind), &data_desc.data,
+                        softmax_axis);
+            error::wrap_c_api(status,
+                "could not create a softmax forward descriptor");
+        }
     };
 
     struct primitive_desc : public mkldnn::primitive_desc {
@@ -2452,6 +2553,18 @@ struct softmax_backward : public primitive {
                         &diff_desc.data, &data_desc.data, softmax_axis),
                     "could not init a backward softmax descriptor");
         }
+        desc(algorithm aalgorithm, const memory::desc &diff_desc,
+                const memory::desc &data_desc, int softmax_axis) {
+            mkldnn_status_t status = mkldnn_invalid_arguments;
+            if (aalgorithm == algorithm::softmax_accurate)
+                status = mkldnn_softmax_backward_desc_init(&data,
+                        &diff_desc.data, &data_desc.data, softmax_axis);
+            else if (aalgorithm == algorithm::softmax_log)
+                status = mkldnn_logsoftmax_backward_desc_init(&data,
+                        &diff_desc.data, &data_desc.data, softmax_axis);
+            error::wrap_c_api(status,
+                    "could not init a backward softmax descriptor");
+        }
     };
 
     struct primitive_desc : public mkldnn::primitive_desc {
@@ -2799,6 +2912,252 @@ struct batch_normalization_backward : public primitive {
 
 /// @}
 
+/// @addtogroup cpp_api_layer_norm Layer normalization
+/// A primitive to perform layer normalization.
+///
+/// @sa @ref c_api_layer_normalization in @ref c_api
+/// @{
+
+struct layer_normalization_forward : public primitive {
+    struct desc {
+        mkldnn_layer_normalization_desc_t data;
+        template <typename T>
+        desc(prop_kind aprop_kind, const memory::desc &src_desc,
+                const memory::desc &stat_desc, T epsilon, unsigned flags) {
+            error::wrap_c_api(
+                    mkldnn_layer_normalization_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind), &src_desc.data,
+                        &stat_desc.data, static_cast<float>(epsilon), flags),
+                "could not create a layer normalization forward descriptor");
+        }
+        template <typename T>
+        desc(prop_kind aprop_kind, const memory::desc &src_desc, T epsilon,
+                unsigned flags) {
+            error::wrap_c_api(
+                    mkldnn_layer_normalization_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind), &src_desc.data,
+                        nullptr, static_cast<float>(epsilon), flags),
+                "could not create a layer normalization forward descriptor");
+        }
+    };
+
+    struct primitive_desc : public mkldnn::primitive_desc {
+        primitive_desc(const desc &desc, const engine &e)
+            : mkldnn::primitive_desc(&desc.data, nullptr, e, nullptr) {}
+
+        primitive_desc(const desc &desc, const primitive_attr &attr, const engine &e)
+            : mkldnn::primitive_desc(&desc.data, &attr, e, nullptr) {}
+
+        REG_QUERY_MPD(src, src, 0);
+        REG_QUERY_MPD(weights, weights, 0);
+        REG_QUERY_MPD(dst, dst, 0);
+
+        memory::primitive_desc mean_primitive_desc() const
+        { return stat_primitive_desc(mean); }
+        memory::primitive_desc variance_primitive_desc() const
+        { return stat_primitive_desc(var); }
+
+    private:
+        enum { mean = 1, var = 2, };
+        memory::primitive_desc stat_primitive_desc(int kind) const {
+            mkldnn_layer_normalization_desc_t *p;
+            error::wrap_c_api(mkldnn_primitive_desc_query(
+                    get(), mkldnn::convert_to_c(layer_normalization_d), 0, &p),
+                    "could not get a layer-normalization descriptor");
+            return query_mpd(p->flags & use_global_stats ? src_pd : dst_pd, kind);
+        }
+    };
+
+    layer_normalization_forward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at &mean,
+            const primitive::at &variance, const primitive::at &weights,
+            const memory &dst) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data,
+            mean.data, variance.data, weights.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 4, 1,
+            "layer normalization forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization forward primitive");
+        reset(result);
+    }
+
+    layer_normalization_forward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at &mean,
+            const primitive::at &variance, const memory &dst) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data,
+            mean.data, variance.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 3, 1,
+            "layer normalization forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization forward primitive");
+        reset(result);
+    }
+
+    layer_normalization_forward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at &weights,
+            const memory &dst, const memory &mean, const memory &variance) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data, weights.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get(),
+            mean.get(), variance.get() };
+        check_num_parameters(aprimitive_desc.get(), 2, 3,
+            "layer normalization forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization forward primitive");
+        reset(result);
+    }
+
+    layer_normalization_forward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const memory &dst, const memory &mean,
+            const memory &variance) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get(),
+            mean.get(), variance.get() };
+        check_num_parameters(aprimitive_desc.get(), 1, 3,
+            "layer normalization forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization forward primitive");
+        reset(result);
+    }
+
+    layer_normalization_forward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at &weights,
+            const memory &dst) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data, weights.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 2, 1,
+            "layer normalization forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization forward primitive");
+        reset(result);
+    }
+
+    layer_normalization_forward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const memory &dst) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 1, 1,
+            "layer normalization forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization forward primitive");
+        reset(result);
+    }
+};
+
+struct layer_normalization_backward : public primitive {
+    struct desc {
+        mkldnn_layer_normalization_desc_t data;
+        template <typename T>
+        desc(prop_kind aprop_kind, const memory::desc &diff_data_desc,
+                const memory::desc &data_desc, const memory::desc &stat_desc,
+                T epsilon, unsigned flags) {
+            error::wrap_c_api(
+                    mkldnn_layer_normalization_backward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind),
+                        &diff_data_desc.data, &data_desc.data,
+                        &stat_desc.data, static_cast<float>(epsilon), flags),
+                "could not create a layer normalization backward descriptor");
+        }
+        template <typename T>
+        desc(prop_kind aprop_kind, const memory::desc &diff_data_desc,
+                const memory::desc &data_desc, T epsilon, unsigned flags) {
+            error::wrap_c_api(
+                    mkldnn_layer_normalization_backward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind),
+                        &diff_data_desc.data, &data_desc.data, nullptr,
+                        static_cast<float>(epsilon), flags),
+                "could not create a layer normalization backward descriptor");
+        }
+    };
+
+    struct primitive_desc : public mkldnn::primitive_desc {
+        primitive_desc(const desc &desc, const engine &e,
+                const layer_normalization_forward::primitive_desc &hint_fwd_pd)
+            : mkldnn::primitive_desc(&desc.data, nullptr, e, hint_fwd_pd.get()) {}
+
+        primitive_desc(const desc &desc, const primitive_attr &attr, const engine &e,
+                const layer_normalization_forward::primitive_desc &hint_fwd_pd)
+            : mkldnn::primitive_desc(&desc.data, &attr, e, hint_fwd_pd.get()) {}
+
+        REG_QUERY_MPD(src, src, 0);
+        REG_QUERY_MPD(mean, src, 1);
+        REG_QUERY_MPD(variance, src, 2);
+        REG_QUERY_MPD(weights, weights, 0);
+        REG_QUERY_MPD(diff_dst, diff_dst, 0);
+
+        REG_QUERY_MPD(diff_src, diff_src, 0);
+        REG_QUERY_MPD(diff_weights, diff_weights, 0);
+    };
+
+    // Prop_kind == backward
+    layer_normalization_backward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at &mean,
+            const primitive::at &variance, const primitive::at &diff_dst,
+            const primitive::at &weights, const memory &diff_src,
+            const memory &diff_weights) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data,
+            mean.data, variance.data, diff_dst.data, weights.data };
+        const_mkldnn_primitive_t outputs[] = { diff_src.get(),
+                diff_weights.get() };
+        check_num_parameters(aprimitive_desc.get(), 5, 2,
+            "layer normalization backward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization backward primitive");
+        reset(result);
+    }
+
+    // Prop_kind == backward_data (+weights)
+    layer_normalization_backward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at &mean,
+            const primitive::at &variance, const primitive::at &diff_dst,
+            const primitive::at &weights, const memory &diff_src) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data, mean.data, variance.data,
+            diff_dst.data, weights.data };
+        const_mkldnn_primitive_t outputs[] = { diff_src.get() };
+        check_num_parameters(aprimitive_desc.get(), 5, 1,
+            "layer normalization backward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization backward primitive");
+        reset(result);
+    }
+
+    // Prop_kind == backward_data
+    layer_normalization_backward(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at &mean,
+            const primitive::at &variance, const primitive::at &diff_dst,
+            const memory &diff_src) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data,
+            mean.data, variance.data, diff_dst.data };
+        const_mkldnn_primitive_t outputs[] = { diff_src.get() };
+        check_num_parameters(aprimitive_desc.get(), 4, 1,
+            "layer normalization backward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a layer normalization backward primitive");
+        reset(result);
+    }
+};
+
+/// @}
+
 /// @addtogroup cpp_api_inner_product Inner Product
 /// A primitive to compute an inner product.
 ///
@@ -2871,6 +3230,23 @@ struct inner_product_forward: public primitive {
             "could not create a inner product forward primitive");
         reset(result);
     }
+
+    /// Creates the primitive from all its inputs: the regular ones followed
+    /// by the src1 memories of the binary post operations.
+    inner_product_forward(const primitive_desc &aprimitive_desc,
+            const std::vector<primitive::at> &inputs, const memory &dst) {
+        mkldnn_primitive_t result;
+        std::vector<mkldnn_primitive_at_t> p_inputs;
+        for (size_t i = 0; i < inputs.size(); i++)
+            p_inputs.push_back(inputs[i].data);
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), (int)p_inputs.size(), 1,
+            "inner product forward");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                    aprimitive_desc.get(), &p_inputs[0], outputs),
+                "could not create a inner product forward primitive");
+        reset(result);
+    }
 };
 
 struct inner_product_backward_data: public primitive {
@@ -3291,6 +3667,144 @@ struct shuffle_backward : public primitive {
 
 /// @}
 
+/// @addtogroup cpp_api_matmul Matrix multiplication
+/// A primitive to multiply (batches of) matrices.
+///
+/// @sa @ref c_api_matmul in @ref c_api
+/// @{
+
+struct matmul: public primitive {
+    struct desc {
+        mkldnn_matmul_desc_t data;
+        desc(const memory::desc &src_desc, const memory::desc &weights_desc,
+                const memory::desc &bias_desc, const memory::desc &dst_desc) {
+            error::wrap_c_api(mkldnn_matmul_desc_init(&data, &src_desc.data,
+                        &weights_desc.data, &bias_desc.data, &dst_desc.data),
+                    "could not create a matmul descriptor");
+        }
+
+        desc(const memory::desc &src_desc, const memory::desc &weights_desc,
+                const memory::desc &dst_desc) {
+            error::wrap_c_api(mkldnn_matmul_desc_init(&data, &src_desc.data,
+                        &weights_desc.data, nullptr, &dst_desc.data),
+                    "could not create a matmul descriptor");
+        }
+    };
+
+    struct primitive_desc : public mkldnn::primitive_desc {
+        primitive_desc(const desc &desc, const engine &e)
+            : mkldnn::primitive_desc(&desc.data, nullptr, e, nullptr) {}
+
+        primitive_desc(const desc &desc, const primitive_attr &attr, const engine &e)
+            : mkldnn::primitive_desc(&desc.data, &attr, e, nullptr) {}
+
+        REG_QUERY_MPD(src, src, 0);
+        REG_QUERY_MPD(weights, weights, 0);
+        REG_QUERY_MPD(bias, weights, 1);
+        REG_QUERY_MPD(dst, dst, 0);
+    };
+
+    matmul(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at weights,
+            const primitive::at &bias, const memory &dst) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data, weights.data,
+                bias.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 3, 1, "matmul");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a matmul primitive");
+        reset(result);
+    }
+
+    matmul(const primitive_desc &aprimitive_desc,
+            const primitive::at &src, const primitive::at weights,
+            const memory &dst) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src.data, weights.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 2, 1, "matmul");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a matmul primitive");
+        reset(result);
+    }
+
+    /// Creates the primitive from all its inputs: the regular ones followed
+    /// by the src1 memories of the binary post operations.
+    matmul(const primitive_desc &aprimitive_desc,
+            const std::vector<primitive::at> &inputs, const memory &dst) {
+        mkldnn_primitive_t result;
+        std::vector<mkldnn_primitive_at_t> p_inputs;
+        for (size_t i = 0; i < inputs.size(); i++)
+            p_inputs.push_back(inputs[i].data);
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), (int)p_inputs.size(), 1,
+            "matmul");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                    aprimitive_desc.get(), &p_inputs[0], outputs),
+                "could not create a matmul primitive");
+        reset(result);
+    }
+};
+
+/// @}
+
+/// @addtogroup cpp_api_binary Binary
+/// A primitive to perform an elementwise binary operation with broadcasting.
+///
+/// @sa @ref c_api_binary in @ref c_api
+/// @{
+
+struct binary: public primitive {
+    struct desc {
+        mkldnn_binary_desc_t data;
+        desc(algorithm aalgorithm, const memory::desc &src0_desc,
+                const memory::desc &src1_desc, const memory::desc &dst_desc) {
+            error::wrap_c_api(mkldnn_binary_desc_init(&data,
+                        mkldnn::convert_to_c(aalgorithm), &src0_desc.data,
+                        &src1_desc.data, &dst_desc.data),
+                    "could not create a binary descriptor");
+        }
+
+        desc(algorithm aalgorithm, const memory::desc &src0_desc,
+                const memory::desc &src1_desc) {
+            error::wrap_c_api(mkldnn_binary_desc_init(&data,
+                        mkldnn::convert_to_c(aalgorithm), &src0_desc.data,
+                        &src1_desc.data, nullptr),
+                    "could not create a binary descriptor");
+        }
+    };
+
+    struct primitive_desc : public mkldnn::primitive_desc {
+        primitive_desc(const desc &desc, const engine &e)
+            : mkldnn::primitive_desc(&desc.data, nullptr, e, nullptr) {}
+
+        primitive_desc(const desc &desc, const primitive_attr &attr, const engine &e)
+            : mkldnn::primitive_desc(&desc.data, &attr, e, nullptr) {}
+
+        REG_QUERY_MPD(src0, src, 0);
+        REG_QUERY_MPD(src1, src, 1);
+        REG_QUERY_MPD(dst, dst, 0);
+    };
+
+    binary(const primitive_desc &aprimitive_desc,
+            const primitive::at &src0, const primitive::at &src1,
+            const memory &dst) {
+        mkldnn_primitive_t result;
+        mkldnn_primitive_at_t inputs[] = { src0.data, src1.data };
+        const_mkldnn_primitive_t outputs[] = { dst.get() };
+        check_num_parameters(aprimitive_desc.get(), 2, 1, "binary");
+        error::wrap_c_api(mkldnn_primitive_create(&result,
+                aprimitive_desc.get(), inputs, outputs),
+            "could not create a binary primitive");
+        reset(result);
+    }
+};
+
+/// @}
+
 /// @} Primitives
 
 /// @addtogroup cpp_api_stream Stream
@@ -3373,6 +3887,31 @@ struct stream: public handle<mkldnn_stream_t> {
                 "could not rerun a stream", &c_api_error_primitive);
         return *this;
     }
+
+    /// Limits the number of threads the primitives of the stream run on.
+    ///
+    /// @param nthr The maximum number of threads, 0 removes the limit.
+    /// @returns The stream.
+    /// @note Requires the native thread pool runtime
+    ///       (MKLDNN_THREADING=THREADPOOL).
+    stream &set_max_threads(int nthr) {
+        error::wrap_c_api(mkldnn_stream_set_max_threads(get(), nthr),
+                "could not set the maximum number of threads of a stream");
+        return *this;
+    }
+
+    /// Makes the primitives of the stream borrow their scratchpads from user
+    /// memory.
+    ///
+    /// @param ptr 64-byte aligned memory, or nullptr to use memory owned by
+    ///            the stream.
+    /// @param size The size of the memory in bytes.
+    /// @returns The stream.
+    stream &set_scratchpad(void *ptr, size_t size) {
+        error::wrap_c_api(mkldnn_stream_set_scratchpad(get(), ptr, size),
+                "could not set the scratchpad of a stream");
+        return *this;
+    }
 };
 
 #undef REG_QUERY_MPD
@@ -517,6 +517,12 @@ typedef enum {
     mkldnn_inner_product,
     /** A rnn primitive. */
     mkldnn_rnn,
+    /** A matrix multiplication primitive. */
+    mkldnn_matmul,
+    /** A layer normalization primitive. */
+    mkldnn_layer_normalization,
+    /** A binary elementwise primitive. */
+    mkldnn_binary,
 } mkldnn_primitive_kind_t;
 
 /** Kinds of algorithms. */
@@ -582,9 +588,23 @@ typedef enum {
      * \f$[b_{u}, b_{r}, b_{c_x}, b_{c_h}]\f$
      * */
     mkldnn_gru_linear_before_reset = 0x4fff,
+    /** Softmax */
+    mkldnn_softmax_accurate = 0x30000,
+    /** Logsoftmax, the logarithm of the softmax computed in one primitive */
+    mkldnn_softmax_log = 0x30001,
+    /** Binary add */
+    mkldnn_binary_add = 0x1fff0,
+    /** Binary mul */
+    mkldnn_binary_mul = 0x1fff1,
+    /** Binary max */
+    mkldnn_binary_max = 0x1fff2,
+    /** Binary min */
+    mkldnn_binary_min = 0x1fff3,
 } mkldnn_alg_kind_t;
 
-/** Flags for batch-normalization primititve. */
+/** Flags for batch-normalization primititve. Layer normalization takes
+ * #mkldnn_use_global_stats and #mkldnn_use_scaleshift with the same meaning,
+ * the statistics being computed per row of the last dimension instead. */
 typedef enum {
     /** Use global statistics
      *
@@ -868,6 +888,9 @@ typedef struct {
     mkldnn_memory_desc_t diff_desc;
     /** The axis along which to perform the softmax. */
     int softmax_axis;
+    /** The kind of softmax algorithm. Possible values:
+     * #mkldnn_softmax_accurate and #mkldnn_softmax_log. */
+    mkldnn_alg_kind_t alg_kind;
 } mkldnn_softmax_desc_t;
 
 /** A descriptor of a pooling operation. */
@@ -962,6 +985,35 @@ typedef struct {
     unsigned flags;
 } mkldnn_batch_normalization_desc_t;
 
+/** A descriptor of a Layer Normalization operation. */
+typedef struct {
+    /** The kind of primitive. Used for self-identifying the primitive
+     * descriptor. Must be #mkldnn_layer_normalization. */
+    mkldnn_primitive_kind_t primitive_kind;
+    /** The kind of propagation. Possible values: #mkldnn_forward_training,
+     * #mkldnn_forward_inference, #mkldnn_backward, and #mkldnn_backward_data.
+     */
+    mkldnn_prop_kind_t prop_kind;
+    /** Source and destination memory descriptor. The normalization runs
+     * along the last dimension. */
+    mkldnn_memory_desc_t data_desc;
+    /** Source and destination gradient memory descriptor. */
+    mkldnn_memory_desc_t diff_data_desc;
+    /** Scale and shift data and gradient memory descriptors.
+     *
+     * Scaleshift memory descriptor uses 2D #mkldnn_nc format[2,C], C being
+     * the last dimension of the data. 1-st dimension contains gamma
+     * parameter, 2-nd dimension contains beta parameter. */
+    mkldnn_memory_desc_t data_scaleshift_desc;
+    mkldnn_memory_desc_t diff_data_scaleshift_desc;
+    /** Mean and variance memory descriptor. It has the dimensions of the
+     * data but the last one. */
+    mkldnn_memory_desc_t stat_desc;
+    /** Layer normalization epsilon parameter. */
+    float layer_norm_epsilon;
+    unsigned flags;
+} mkldnn_layer_normalization_desc_t;
+
 /** A descriptor of an inner product operation. */
 typedef struct {
     /** The kind of primitive. Used for self-identifying the primitive
@@ -1072,6 +1124,48 @@ typedef struct {
     mkldnn_memory_desc_t diff_dst_iter_desc;
 } mkldnn_rnn_desc_t;
 
+/** A descriptor of a matrix multiplication operation.
+ *
+ * The two innermost dimensions hold the matrices: src is ... x M x K,
+ * weights ... x K x N and dst ... x M x N. Every outer (batch) dimension of
+ * src and weights is either the one of dst or 1, in which case the matrix
+ * is broadcast along it. The optional bias has the dimensions of dst, any
+ * of which may be 1 as well. */
+typedef struct {
+    /** The kind of primitive. Used for self-identifying the primitive
+     * descriptor. Must be #mkldnn_matmul. */
+    mkldnn_primitive_kind_t primitive_kind;
+    /** Source memory descriptor. */
+    mkldnn_memory_desc_t src_desc;
+    /** Weights memory descriptor. */
+    mkldnn_memory_desc_t weights_desc;
+    /** Bias memory descriptor. */
+    mkldnn_memory_desc_t bias_desc;
+    /** Destination memory descriptor. */
+    mkldnn_memory_desc_t dst_desc;
+    /** The accumulator data type. Initialized automatically. */
+    mkldnn_data_type_t accum_data_type;
+} mkldnn_matmul_desc_t;
+
+/** A descriptor of a binary elementwise operation.
+ *
+ * dst = alg(src0, src1), where src0 and dst have the same dimensions and
+ * every dimension of src1 is either the one of dst or 1, in which case src1
+ * is broadcast along it (NumPy style). */
+typedef struct {
+    /** The kind of primitive. Used for self-identifying the primitive
+     * descriptor. Must be #mkldnn_binary. */
+    mkldnn_primitive_kind_t primitive_kind;
+    /** The kind of the binary algorithm. Possible values:
+     * #mkldnn_binary_add, #mkldnn_binary_mul, #mkldnn_binary_max and
+     * #mkldnn_binary_min. */
+    mkldnn_alg_kind_t alg_kind;
+    /** Source memory descriptors. */
+    mkldnn_memory_desc_t src_desc[2];
+    /** Destination memory descriptor. */
+    mkldnn_memory_desc_t dst_desc;
+} mkldnn_binary_desc_t;
+
 /** @} */
 
 /** @addtogroup c_api_engine_types Engine
@@ -1259,6 +1353,9 @@ typedef enum {
     mkldnn_query_batch_normalization_d, /**< batch normalization descriptor */
     mkldnn_query_inner_product_d, /**< inner product descriptor */
     mkldnn_query_rnn_d, /**< rnn descriptor */
+    mkldnn_query_matmul_d, /**< matmul descriptor */
+    mkldnn_query_layer_normalization_d, /**< layer normalization descriptor */
+    mkldnn_query_binary_d, /**< binary descriptor */
 
     /* (memory) primitive descriptor section */
     mkldnn_query_some_pd = 128, /**< stub */
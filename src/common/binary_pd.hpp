@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef BINARY_PD_HPP
+#define BINARY_PD_HPP
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "memory_pd.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+struct binary_pd_t: public primitive_desc_t {
+    typedef binary_pd_t base_class;
+    typedef binary_pd_t hint_class;
+    static constexpr auto base_pkind = primitive_kind::binary;
+
+    binary_pd_t(mkldnn::impl::engine_t *engine,
+            const binary_desc_t *adesc,
+            const primitive_attr_t *attr,
+            const binary_pd_t *hint_pd)
+        : primitive_desc_t(engine, attr, primitive_kind::binary)
+        , desc_(*adesc) { UNUSED(hint_pd); }
+    virtual ~binary_pd_t() {}
+
+    const binary_desc_t *desc() const { return &desc_; }
+    virtual const op_desc_t *op_desc() const override
+    { return reinterpret_cast<const op_desc_t *>(this->desc()); }
+    virtual void init_info() override { init_info_binary(this, this->info_); }
+
+    virtual const memory_pd_t *input_pd(int index = 0) const override
+    { return src_pd(index); }
+    virtual const memory_pd_t *output_pd(int index = 0) const override
+    { return dst_pd(index); }
+
+    virtual int n_inputs() const override { return 2; }
+    virtual int n_outputs() const override { return 1; }
+
+    virtual status_t query(query_t what, int idx, void *result) const override
+    {
+        switch (what) {
+        case query::binary_d:
+            *(const binary_desc_t**)result = desc(); break;
+        default: return primitive_desc_t::query(what, idx, result);
+        }
+        return status::success;
+    }
+
+    /* common binary aux functions */
+
+    inline int ndims() const { return desc_.dst_desc.ndims; }
+
+    /** true if src1 has the dimensions of dst */
+    inline bool is_src1_same_dims() const {
+        return utils::array_cmp(desc_.src_desc[1].dims, desc_.dst_desc.dims,
+                ndims());
+    }
+
+    bool has_zero_dim_memory() const
+    { return memory_desc_wrapper(desc_.dst_desc).has_zero_dim(); }
+
+protected:
+    binary_desc_t desc_;
+
+    virtual status_t init() = 0;
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
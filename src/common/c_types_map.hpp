@@ -87,6 +87,12 @@ namespace alg_kind {
     const alg_kind_t vanilla_lstm = mkldnn_vanilla_lstm;
     const alg_kind_t vanilla_gru = mkldnn_vanilla_gru;
     const alg_kind_t gru_linear_before_reset = mkldnn_gru_linear_before_reset;
+    const alg_kind_t softmax_accurate = mkldnn_softmax_accurate;
+    const alg_kind_t softmax_log = mkldnn_softmax_log;
+    const alg_kind_t binary_add = mkldnn_binary_add;
+    const alg_kind_t binary_mul = mkldnn_binary_mul;
+    const alg_kind_t binary_max = mkldnn_binary_max;
+    const alg_kind_t binary_min = mkldnn_binary_min;
 }
 
 using data_type_t = mkldnn_data_type_t;
@@ -301,6 +307,9 @@ namespace primitive_kind {
     const primitive_kind_t batch_normalization = mkldnn_batch_normalization;
     const primitive_kind_t inner_product = mkldnn_inner_product;
     const primitive_kind_t rnn = mkldnn_rnn;
+    const primitive_kind_t matmul = mkldnn_matmul;
+    const primitive_kind_t layer_normalization = mkldnn_layer_normalization;
+    const primitive_kind_t binary = mkldnn_binary;
 }
 
 using query_t = mkldnn_query_t;
@@ -331,6 +340,9 @@ namespace query {
     const query_t batch_normalization_d = mkldnn_query_batch_normalization_d;
     const query_t inner_product_d = mkldnn_query_inner_product_d;
     const query_t rnn_d = mkldnn_query_rnn_d;
+    const query_t matmul_d = mkldnn_query_matmul_d;
+    const query_t layer_normalization_d = mkldnn_query_layer_normalization_d;
+    const query_t binary_d = mkldnn_query_binary_d;
 
     const query_t some_pd = mkldnn_query_some_pd;
     const query_t input_pd = mkldnn_query_input_pd;
@@ -357,12 +369,16 @@ using eltwise_desc_t = mkldnn_eltwise_desc_t;
 using softmax_desc_t = mkldnn_softmax_desc_t;
 using lrn_desc_t = mkldnn_lrn_desc_t;
 using batch_normalization_desc_t = mkldnn_batch_normalization_desc_t;
+using layer_normalization_desc_t = mkldnn_layer_normalization_desc_t;
 using inner_product_desc_t = mkldnn_inner_product_desc_t;
 
 using rnn_direction_t = mkldnn_rnn_direction_t;
 using rnn_cell_desc_t = mkldnn_rnn_cell_desc_t;
 using rnn_desc_t = mkldnn_rnn_desc_t;
 
+using matmul_desc_t = mkldnn_matmul_desc_t;
+using binary_desc_t = mkldnn_binary_desc_t;
+
 /* C op_desc_t, which eventually are just (void*) */
 using c_op_desc_t = mkldnn_op_desc_t;
 using const_c_op_desc_t = const_mkldnn_op_desc_t;
@@ -381,6 +397,9 @@ struct op_desc_t {
         batch_normalization_desc_t batch_normalization;
         inner_product_desc_t inner_product;
         rnn_desc_t rnn;
+        matmul_desc_t matmul;
+        layer_normalization_desc_t layer_normalization;
+        binary_desc_t binary;
     };
 
     op_desc_t(const primitive_kind_t &_): kind(_) {}
@@ -402,6 +421,9 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(batch_normalization_desc_t, batch_normalization);
     DECL_CTOR_AND_CONVERTERS(inner_product_desc_t, inner_product);
     DECL_CTOR_AND_CONVERTERS(rnn_desc_t, rnn);
+    DECL_CTOR_AND_CONVERTERS(matmul_desc_t, matmul);
+    DECL_CTOR_AND_CONVERTERS(layer_normalization_desc_t, layer_normalization);
+    DECL_CTOR_AND_CONVERTERS(binary_desc_t, binary);
 
 #   undef DECL_CTOR_AND_CONVERTERS
 };
@@ -62,18 +62,34 @@ struct convolution_fwd_pd_t: public primitive_desc_t {
     virtual void init_info() override { init_info_conv(this, this->info_); }
 
     virtual const memory_pd_t *input_pd(int index = 0) const override {
-        switch (index) {
-        case 0: return src_pd();
-        case 1: case 2: return weights_pd(index - 1);
-        default: return nullptr;
-        }
+        if (index == 0) return src_pd();
+        if (index == 1 || (index == 2 && with_bias()))
+            return weights_pd(index - 1);
+        index -= 2 + with_bias();
+        if (index < dw_conv_po_n_inputs()) return dw_conv_po_pd(index);
+        return binary_po_pd(index - dw_conv_po_n_inputs());
     }
     virtual const memory_pd_t *output_pd(int index = 0) const override
     { return index == 0 ? dst_pd() : nullptr; }
 
-    virtual int n_inputs() const override { return 2 + with_bias(); }
+    virtual int n_inputs() const override {
+        return 2 + with_bias() + dw_conv_po_n_inputs()
+            + attr()->post_ops_.count(primitive_kind::binary);
+    }
     virtual int n_outputs() const override { return 1; }
 
+    /** the weights and the bias (if any) of the depthwise convolution
+     * post-op follow the bias */
+    virtual const memory_pd_t *dw_conv_po_pd(int index = 0) const
+    { UNUSED(index); return nullptr; }
+
+    int dw_conv_po_n_inputs() const {
+        const auto &po = attr()->post_ops_;
+        const int idx = po.find(primitive_kind::convolution);
+        if (idx == -1) return 0;
+        return 1 + (po.entry_[idx].depthwise_conv.bias_dt != data_type::undef);
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
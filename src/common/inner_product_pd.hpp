@@ -45,16 +45,18 @@ struct inner_product_fwd_pd_t: public primitive_desc_t {
     virtual void init_info() override { init_info_iprod(this, this->info_); }
 
     virtual const memory_pd_t *input_pd(int index = 0) const override {
-        switch (index) {
-        case 0: return src_pd();
-        case 1: case 2: return weights_pd(index - 1);
-        default: return nullptr;
-        }
+        if (index == 0) return src_pd();
+        if (index == 1 || (index == 2 && with_bias()))
+            return weights_pd(index - 1);
+        return binary_po_pd(index - 2 - with_bias());
     }
     virtual const memory_pd_t *output_pd(int index = 0) const override
     { return index == 0 ? dst_pd() : nullptr; }
 
-    virtual int n_inputs() const override { return 2 + with_bias(); }
+    virtual int n_inputs() const override {
+        return 2 + with_bias()
+            + attr()->post_ops_.count(primitive_kind::binary);
+    }
     virtual int n_outputs() const override { return 1; }
 
     virtual status_t query(query_t what, int idx, void *result) const override
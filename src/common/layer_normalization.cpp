@@ -0,0 +1,115 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::utils;
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::prop_kind;
+using namespace mkldnn::impl::types;
+
+namespace {
+status_t lnrm_desc_init(layer_normalization_desc_t *lnrm_desc,
+        prop_kind_t prop_kind, const memory_desc_t *data_desc,
+        const memory_desc_t *stat_desc, const memory_desc_t *diff_data_desc,
+        float epsilon, unsigned flags) {
+    bool args_ok = true
+        && !any_null(lnrm_desc, data_desc)
+        && one_of(prop_kind, forward_training, forward_inference,
+                backward_data, backward)
+        && IMPLICATION(prop_kind & backward, diff_data_desc != nullptr)
+        && one_of(data_desc->ndims, 2, 3, 4, 5);
+    if (!args_ok) return invalid_arguments;
+
+    auto ld = layer_normalization_desc_t();
+    ld.primitive_kind = primitive_kind::layer_normalization;
+    ld.prop_kind = prop_kind;
+
+    const int ndims = data_desc->ndims;
+    const int C = data_desc->dims[ndims - 1];
+
+    ld.data_desc = *data_desc;
+    ld.diff_data_desc = zero_md();
+    if (one_of(ld.prop_kind, backward_data, backward))
+        ld.diff_data_desc = *diff_data_desc;
+
+    dims_t scaleshift_dims = { 2, C };
+    mkldnn_memory_desc_init(&ld.data_scaleshift_desc, 2, scaleshift_dims,
+            data_type::f32, mkldnn_nc);
+    ld.diff_data_scaleshift_desc = zero_md();
+    if (ld.prop_kind == backward) {
+        mkldnn_memory_desc_init(&ld.diff_data_scaleshift_desc, 2,
+                scaleshift_dims, data_type::f32, mkldnn_nc);
+    }
+
+    /* the statistics are dense over the outer dims by default */
+    if (stat_desc) {
+        ld.stat_desc = *stat_desc;
+    } else {
+        const memory_format_t stat_fmt = pick(ndims - 2, mkldnn_x, mkldnn_nc,
+                mkldnn_ncw, mkldnn_nchw);
+        mkldnn_memory_desc_init(&ld.stat_desc, ndims - 1, data_desc->dims,
+                data_type::f32, stat_fmt);
+    }
+
+    ld.layer_norm_epsilon = epsilon;
+
+    unsigned lnorm_flags = mkldnn_use_global_stats | mkldnn_use_scaleshift;
+    if ((~lnorm_flags & flags) != 0) return invalid_arguments;
+
+    ld.flags = flags;
+
+    bool consistency = true
+        && ld.stat_desc.ndims == ndims - 1
+        && array_cmp(ld.stat_desc.dims, ld.data_desc.dims, ndims - 1);
+    if (one_of(ld.prop_kind, backward_data, backward))
+        consistency = consistency
+            && ld.diff_data_desc.ndims == ndims
+            && array_cmp(ld.diff_data_desc.dims, ld.data_desc.dims, ndims);
+    if (!consistency) return invalid_arguments;
+
+    *lnrm_desc = ld;
+    return success;
+}
+}
+
+status_t mkldnn_layer_normalization_forward_desc_init(
+        layer_normalization_desc_t *lnrm_desc, prop_kind_t prop_kind,
+        const memory_desc_t *data_desc, const memory_desc_t *stat_desc,
+        float epsilon, unsigned flags) {
+    if (!one_of(prop_kind, forward_training, forward_inference))
+        return invalid_arguments;
+    return lnrm_desc_init(lnrm_desc, prop_kind, data_desc, stat_desc,
+            nullptr, epsilon, flags);
+}
+
+status_t mkldnn_layer_normalization_backward_desc_init(
+        layer_normalization_desc_t *lnrm_desc, prop_kind_t prop_kind,
+        const memory_desc_t *diff_data_desc, const memory_desc_t *data_desc,
+        const memory_desc_t *stat_desc, float epsilon, unsigned flags) {
+    if (!one_of(prop_kind, backward, backward_data))
+        return invalid_arguments;
+    return lnrm_desc_init(lnrm_desc, prop_kind, data_desc, stat_desc,
+            diff_data_desc, epsilon, flags);
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
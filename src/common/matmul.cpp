@@ -0,0 +1,74 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::utils;
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::types;
+
+status_t mkldnn_matmul_desc_init(matmul_desc_t *matmul_desc,
+        const memory_desc_t *src_desc, const memory_desc_t *weights_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_desc) {
+    bool args_ok = !any_null(matmul_desc, src_desc, weights_desc, dst_desc);
+    if (!args_ok) return invalid_arguments;
+
+    auto md = matmul_desc_t();
+    md.primitive_kind = primitive_kind::matmul;
+
+    const bool with_bias
+        = bias_desc && bias_desc->format != memory_format::undef;
+
+    md.src_desc = *src_desc;
+    md.weights_desc = *weights_desc;
+    md.bias_desc = with_bias ? *bias_desc : zero_md();
+    md.dst_desc = *dst_desc;
+
+    md.accum_data_type = types::default_accum_data_type(src_desc->data_type,
+            weights_desc->data_type, dst_desc->data_type,
+            prop_kind::forward_inference);
+
+    const int ndims = dst_desc->ndims;
+    bool consistency = true
+        && one_of(ndims, 2, 3, 4, 5)
+        && src_desc->ndims == ndims
+        && weights_desc->ndims == ndims
+        && IMPLICATION(with_bias, bias_desc->ndims == ndims)
+        && src_desc->dims[ndims - 2] == dst_desc->dims[ndims - 2]
+        && src_desc->dims[ndims - 1] == weights_desc->dims[ndims - 2]
+        && weights_desc->dims[ndims - 1] == dst_desc->dims[ndims - 1];
+    for (int d = 0; d < ndims; ++d) {
+        const int D = dst_desc->dims[d];
+        if (d < ndims - 2)
+            consistency = consistency
+                && one_of(src_desc->dims[d], 1, D)
+                && one_of(weights_desc->dims[d], 1, D);
+        if (with_bias)
+            consistency = consistency && one_of(bias_desc->dims[d], 1, D);
+    }
+    if (!consistency) return invalid_arguments;
+
+    *matmul_desc = md;
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,103 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef MATMUL_PD_HPP
+#define MATMUL_PD_HPP
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "primitive_desc.hpp"
+#include "memory_pd.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+struct matmul_pd_t: public primitive_desc_t {
+    typedef matmul_pd_t base_class;
+    typedef matmul_pd_t hint_class;
+    static constexpr auto base_pkind = primitive_kind::matmul;
+
+    matmul_pd_t(mkldnn::impl::engine_t *engine,
+            const matmul_desc_t *adesc,
+            const primitive_attr_t *attr,
+            const matmul_pd_t *hint_pd)
+        : primitive_desc_t(engine, attr, primitive_kind::matmul)
+        , desc_(*adesc) { UNUSED(hint_pd); }
+    virtual ~matmul_pd_t() {}
+
+    const matmul_desc_t *desc() const { return &desc_; }
+    virtual const op_desc_t *op_desc() const override
+    { return reinterpret_cast<const op_desc_t *>(this->desc()); }
+    virtual void init_info() override { init_info_matmul(this, this->info_); }
+
+    virtual const memory_pd_t *input_pd(int index = 0) const override {
+        if (index == 0) return src_pd();
+        if (index == 1 || (index == 2 && with_bias()))
+            return weights_pd(index - 1);
+        return binary_po_pd(index - 2 - with_bias());
+    }
+    virtual const memory_pd_t *output_pd(int index = 0) const override
+    { return index == 0 ? dst_pd() : nullptr; }
+
+    virtual int n_inputs() const override {
+        return 2 + with_bias()
+            + attr()->post_ops_.count(primitive_kind::binary);
+    }
+    virtual int n_outputs() const override { return 1; }
+
+    virtual status_t query(query_t what, int idx, void *result) const override
+    {
+        switch (what) {
+        case query::matmul_d:
+            *(const matmul_desc_t**)result = desc(); break;
+        default: return primitive_desc_t::query(what, idx, result);
+        }
+        return status::success;
+    }
+
+    /* common matmul aux functions */
+
+    inline int ndims() const { return desc_.dst_desc.ndims; }
+    inline int M() const { return desc_.dst_desc.dims[ndims() - 2]; }
+    inline int N() const { return desc_.dst_desc.dims[ndims() - 1]; }
+    inline int K() const { return desc_.src_desc.dims[ndims() - 1]; }
+    /** number of matrices in dst */
+    inline int batch() const
+    { return utils::array_product(desc_.dst_desc.dims, ndims() - 2); }
+
+    inline bool with_bias() const
+    { return !memory_desc_wrapper(desc_.bias_desc).is_zero(); }
+
+    bool has_zero_dim_memory() const {
+        return false
+            || memory_desc_wrapper(desc_.src_desc).has_zero_dim()
+            || memory_desc_wrapper(desc_.weights_desc).has_zero_dim()
+            || memory_desc_wrapper(desc_.dst_desc).has_zero_dim();
+    }
+
+protected:
+    matmul_desc_t desc_;
+
+    virtual status_t init() = 0;
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -158,9 +158,12 @@ enum {
     key_conv_bia_reduction,
     key_conv_gemm_col,
     key_conv_gemm_imtr,
+    key_conv_gemm_implicit_a,
     key_conv_int_dat_in_acc_dt,
     key_conv_padded_bias,
     key_conv_bias_bf16_convert_wsp,
+    key_conv_dw_band,
+    key_conv_dw_padded_bias,
     key_conv_rtus_space,
     key_conv_tr_diff_dst,
     key_conv_tr_diff_dst_bctx,
@@ -176,6 +179,7 @@ enum {
     key_iprod_dst_bf16_convert_wsp,
     key_iprod_bias_bf16_convert_wsp,
     key_iprod_int_dat_in_acc_dt,
+    key_lnorm_tmp_diff_ss,
     key_reducer_space,
     key_reducer_space_bctx,
     key_reorder_space,
@@ -250,6 +250,9 @@ const char *mkldnn_prim_kind2str(mkldnn_primitive_kind_t v) {
     if (v == mkldnn_batch_normalization) return "batch_normalization";
     if (v == mkldnn_inner_product) return "inner_product";
     if (v == mkldnn_rnn) return "rnn";
+    if (v == mkldnn_matmul) return "matmul";
+    if (v == mkldnn_layer_normalization) return "layer_normalization";
+    if (v == mkldnn_binary) return "binary";
     assert(!"unknown prim_kind");
     return "unknown prim_kind";
 }
@@ -282,6 +285,12 @@ const char *mkldnn_alg_kind2str(mkldnn_alg_kind_t v) {
     if (v == mkldnn_vanilla_lstm) return "vanilla_lstm";
     if (v == mkldnn_vanilla_gru) return "vanilla_gru";
     if (v == mkldnn_gru_linear_before_reset) return "gru_linear_before_reset";
+    if (v == mkldnn_softmax_accurate) return "softmax_accurate";
+    if (v == mkldnn_softmax_log) return "softmax_log";
+    if (v == mkldnn_binary_add) return "binary_add";
+    if (v == mkldnn_binary_mul) return "binary_mul";
+    if (v == mkldnn_binary_max) return "binary_max";
+    if (v == mkldnn_binary_min) return "binary_min";
     assert(!"unknown alg_kind");
     return "unknown alg_kind";
 }
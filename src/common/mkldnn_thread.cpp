@@ -0,0 +1,127 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <vector>
+
+#include "mkldnn_thread.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+#if defined(__linux__)
+/* Reads a sysfs list such as "0-3" or "0,2,4-7", empty if the list can't be
+ * read. */
+std::vector<int> read_list(const char *path) {
+    std::vector<int> list;
+    FILE *fp = mkldnn_fopen(path, "r");
+    if (!fp) return list;
+
+    int first = 0, last = 0;
+    int n = fscanf(fp, "%d", &first);
+    while (n == 1) {
+        last = first;
+        int c = fgetc(fp);
+        if (c == '-') {
+            if (fscanf(fp, "%d", &last) != 1) break;
+            c = fgetc(fp);
+        }
+        for (int i = first; i <= last; i++)
+            list.push_back(i);
+        if (c != ',') break;
+        n = fscanf(fp, "%d", &first);
+    }
+    fclose(fp);
+    return list;
+}
+#endif
+
+struct cmg_topology_t {
+    int num_cmgs;
+    int cores_per_cmg;
+};
+
+/* Counts the NUMA nodes that hold cpus of the process affinity mask, and
+ * the cores of the largest of them. A node the process can't run on is not
+ * a CMG of its teams. */
+cmg_topology_t detect_cmgs() {
+    cmg_topology_t t = { 1, 1 };
+    int n_cpus = 1;
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    const bool has_mask = sched_getaffinity(0, sizeof(mask), &mask) == 0;
+    n_cpus = has_mask ? CPU_COUNT(&mask)
+        : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (n_cpus < 1) n_cpus = 1;
+    t.cores_per_cmg = n_cpus;
+
+    int num_cmgs = 0, cores_per_cmg = 0;
+    for (int node : read_list("/sys/devices/system/node/online")) {
+        char path[64];
+        snprintf(path, sizeof(path),
+                "/sys/devices/system/node/node%d/cpulist", node);
+        const std::vector<int> cpus = read_list(path);
+        bool used = !has_mask;
+        for (int cpu : cpus)
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &mask)) used = true;
+        if (!used || cpus.empty()) continue;
+        num_cmgs++;
+        if ((int)cpus.size() > cores_per_cmg) cores_per_cmg = (int)cpus.size();
+    }
+
+    if (num_cmgs > 0) {
+        t.num_cmgs = num_cmgs;
+        t.cores_per_cmg = cores_per_cmg;
+    }
+#endif
+
+    const int len = 8;
+    char env_cmgs[len] = {0};
+    if (mkldnn_getenv("MKLDNN_NUM_CMGS", env_cmgs, len) > 0) {
+        const int n = atoi(env_cmgs);
+        if (n > 0) {
+            /* the cpus of the process are taken to be split evenly */
+            t.num_cmgs = n;
+            t.cores_per_cmg = utils::div_up(n_cpus, n);
+        }
+    }
+    return t;
+}
+
+const cmg_topology_t &cmg_topology() {
+    static const cmg_topology_t t = detect_cmgs();
+    return t;
+}
+}
+
+int mkldnn_get_num_cmgs() { return cmg_topology().num_cmgs; }
+
+int mkldnn_get_cores_per_cmg() { return cmg_topology().cores_per_cmg; }
+
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -23,6 +23,7 @@
 #define MKLDNN_THR_SEQ 0
 #define MKLDNN_THR_OMP 1
 #define MKLDNN_THR_TBB 2
+#define MKLDNN_THR_THREADPOOL 3
 
 /* Ideally this condition below should never happen (if the library is built
  * using regular cmake). For the 3rd-party projects that build the library
@@ -74,6 +75,22 @@ inline void mkldnn_thr_barrier() { assert(!"no barrier in TBB"); }
 
 #define PRAGMA_OMP(...)
 
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+#include "mkldnn_threadpool.hpp"
+#define MKLDNN_THR_SYNC 0
+
+inline int mkldnn_get_max_threads()
+{ return mkldnn::impl::threadpool_utils::get_max_threads(); }
+inline int mkldnn_get_num_threads()
+{ return mkldnn::impl::threadpool_utils::get_num_threads(); }
+inline int mkldnn_get_thread_num()
+{ return mkldnn::impl::threadpool_utils::get_thread_num(); }
+inline int mkldnn_in_parallel()
+{ return mkldnn::impl::threadpool_utils::in_parallel(); }
+inline void mkldnn_thr_barrier() { assert(!"no barrier in the thread pool"); }
+
+#define PRAGMA_OMP(...)
+
 #endif
 
 /* MSVC still supports omp 2.0 only */
@@ -135,6 +152,96 @@ void balance2D(U nthr, U ithr, T ny, T &ny_start, T &ny_end,
     balance211(ny, grp_nthr, grp_ithr, ny_start, ny_end);
 }
 
+/* CMG (core memory group: the cores sharing one L2 and one memory stack,
+ * i.e. a NUMA node) layout of a team. Threads are assumed to be bound
+ * compactly (OMP_PROC_BIND=close), so a team of nthr threads is cut into
+ * consecutive per-CMG ranges with balance211.
+ *
+ * mkldnn_get_num_cmgs() counts the NUMA nodes holding cpus of the process
+ * affinity mask and mkldnn_get_cores_per_cmg() the cores of the largest of
+ * them; MKLDNN_NUM_CMGS overrides the count. */
+int mkldnn_get_num_cmgs();
+int mkldnn_get_cores_per_cmg();
+
+/* The CMGs a compactly bound team of nthr threads covers */
+inline int mkldnn_get_team_cmgs(int nthr) {
+    const int ncmg = utils::div_up(nthr, mkldnn_get_cores_per_cmg());
+    const int num_cmgs = mkldnn_get_num_cmgs();
+    return num_cmgs < ncmg ? num_cmgs : ncmg;
+}
+
+/* Maps thread ithr of a team of nthr threads spread over num_cmgs CMGs to
+ * its CMG icmg of ncmg and to its rank ithr_cmg of the nthr_cmg threads of
+ * that CMG. */
+inline void cmg_team(int nthr, int ithr, int num_cmgs, int &ncmg, int &icmg,
+        int &nthr_cmg, int &ithr_cmg) {
+    ncmg = num_cmgs < nthr ? num_cmgs : nthr;
+    if (ncmg <= 1) {
+        ncmg = 1;
+        icmg = 0;
+        nthr_cmg = nthr;
+        ithr_cmg = ithr;
+        return;
+    }
+
+    int start = 0, end = 0;
+    for (icmg = 0; icmg < ncmg; icmg++) {
+        balance211(nthr, ncmg, icmg, start, end);
+        if (ithr < end) break;
+    }
+    nthr_cmg = end - start;
+    ithr_cmg = ithr - start;
+}
+
+inline void cmg_team(int nthr, int ithr, int &ncmg, int &icmg,
+        int &nthr_cmg, int &ithr_cmg) {
+    cmg_team(nthr, ithr, mkldnn_get_team_cmgs(nthr), ncmg, icmg, nthr_cmg,
+            ithr_cmg);
+}
+
+/* balance211 in two levels: n is split among the CMGs of the team first,
+ * then among the threads of each CMG. When n is smaller than the team the
+ * work still spreads over all the CMGs (and their memory bandwidth)
+ * instead of going to the first threads, which share one CMG. */
+template <typename T, typename U>
+void balance_cmg(T n, U nthr, U ithr, int num_cmgs, T &n_start, T &n_end) {
+    int ncmg, icmg, nthr_cmg, ithr_cmg;
+    cmg_team((int)nthr, (int)ithr, num_cmgs, ncmg, icmg, nthr_cmg, ithr_cmg);
+
+    T cmg_start{0}, cmg_end{0};
+    balance211(n, ncmg, icmg, cmg_start, cmg_end);
+    balance211((T)(cmg_end - cmg_start), nthr_cmg, ithr_cmg, n_start, n_end);
+    n_start += cmg_start;
+    n_end += cmg_start;
+}
+
+template <typename T, typename U>
+void balance_cmg(T n, U nthr, U ithr, T &n_start, T &n_end) {
+    balance_cmg(n, nthr, ithr, mkldnn_get_team_cmgs((int)nthr), n_start,
+            n_end);
+}
+
+/* Renumbers thread ithr of a team of nthr threads of which only the ids
+ * below nwork get work (e.g. from a decomposition that leaves the last
+ * threads idle), so that the working ids spread over all the CMGs: each CMG
+ * takes a consecutive range of them (split with balance211) and gives the
+ * idle ids to the rest of its threads. */
+inline int cmg_spread_ithr(int nthr, int ithr, int nwork, int num_cmgs) {
+    if (nwork >= nthr) return ithr;
+    int ncmg, icmg, nthr_cmg, ithr_cmg;
+    cmg_team(nthr, ithr, num_cmgs, ncmg, icmg, nthr_cmg, ithr_cmg);
+
+    int work_s{0}, work_e{0};
+    balance211(nwork, ncmg, icmg, work_s, work_e);
+    const int nwork_cmg = work_e - work_s;
+    if (ithr_cmg < nwork_cmg) return work_s + ithr_cmg;
+    return nwork + (ithr - ithr_cmg - work_s) + (ithr_cmg - nwork_cmg);
+}
+
+inline int cmg_spread_ithr(int nthr, int ithr, int nwork) {
+    return cmg_spread_ithr(nthr, ithr, nwork, mkldnn_get_team_cmgs(nthr));
+}
+
 } // namespace impl
 } // namespace mkldnn
 
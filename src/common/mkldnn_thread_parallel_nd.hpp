@@ -28,6 +28,8 @@
  *                                     created threads
  *  - parallel_nd(dims..., f)        - creates a parallel section and then
  *                                     calls for_nd
+ *  - parallel_nd_cmg(D0, f)         - parallel_nd over one dimension with
+ *                                     the iterations split by balance_cmg
  *  - parallel_nd_in_omp(dims..., f) - queries current nthr and ithr and then
  *                                     calls for_nd (mostly for convenience)
  */
@@ -49,6 +51,11 @@ void parallel(int nthr, F f) {
 #elif MKLDNN_THR == MKLDNN_THR_TBB
     if (nthr == 1) { f(0, 1); return; }
     tbb::parallel_for(0, nthr, [&](int ithr) { f(ithr, nthr); });
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    if (nthr == 1) { f(0, 1); return; }
+    threadpool_utils::parallel_run(nthr, [](void *ctx, int ithr, int nthr) {
+        (*static_cast<F *>(ctx))(ithr, nthr);
+    }, &f);
 #endif
 }
 
@@ -165,6 +172,11 @@ void parallel_nd(Args &&...args) {
         const int ithr = !do_parallel ? 0 : mkldnn_get_thread_num();
         for_nd(ithr, nthr, utils::forward<Args>(args)...);
     }
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    const bool do_parallel = get_work_amount(utils::forward<Args>(args)...) > 1;
+    parallel(do_parallel ? 0 : 1, [&](const int ithr, const int nthr) {
+        for_nd(ithr, nthr, utils::forward<Args>(args)...);
+    });
 #endif
 }
 #else // MKLDNN_THR != MKLDNN_THR_TBB
@@ -225,6 +237,17 @@ void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
 }
 #endif
 
+/* Spreads the D0 iterations over the CMGs of the team first, so that a
+ * loop shorter than the team doesn't run on the first CMG only */
+template <typename T0, typename F>
+void parallel_nd_cmg(const T0 &D0, F f) {
+    parallel(D0 > 1 ? 0 : 1, [&](const int ithr, const int nthr) {
+        T0 start{0}, end{0};
+        balance_cmg(D0, nthr, ithr, start, end);
+        for (T0 d0 = start; d0 < end; ++d0) f(d0);
+    });
+}
+
 template <typename ...Args>
 void parallel_nd_in_omp(Args &&...args) {
 #if MKLDNN_THR == MKLDNN_THR_SEQ
@@ -232,6 +255,9 @@ void parallel_nd_in_omp(Args &&...args) {
 #elif MKLDNN_THR == MKLDNN_THR_OMP
     for_nd(mkldnn_get_thread_num(), mkldnn_get_num_threads(),
             utils::forward<Args>(args)...);
+#elif MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    for_nd(mkldnn_get_thread_num(), mkldnn_get_num_threads(),
+            utils::forward<Args>(args)...);
 #elif MKLDNN_THR == MKLDNN_THR_TBB
     assert(!"unsupported parallel_nd_in_omp()");
 #endif
@@ -0,0 +1,285 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_thread.hpp"
+
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace threadpool_utils {
+
+namespace {
+
+/* per thread state of the current parallel section */
+struct thread_state_t {
+    int ithr;
+    int nthr;
+    int in_parallel;
+    int max_threads; /* 0 -- pool size */
+};
+
+thread_local thread_state_t tls = { 0, 1, 0, 0 };
+
+/* At most max_runners threads, the submitter included, run the tasks of a
+ * job, so a thread limit also holds for the primitives that fixed their
+ * nthr when they were created: the work is split the same way, only fewer
+ * threads share the tasks. */
+struct job_t {
+    job_t(int nthr, task_fn_t fn, void *ctx, int max_runners)
+        : fn_(fn), ctx_(ctx), nthr_(nthr), max_runners_(max_runners)
+        , next_(0), done_(0), runners_(1) {}
+
+    /* admits one more worker unless the limit is reached */
+    bool join() {
+        int runners = runners_.load();
+        while (runners < max_runners_ && next_.load() < nthr_)
+            if (runners_.compare_exchange_weak(runners, runners + 1))
+                return true;
+        return false;
+    }
+
+    /* claims and runs the tasks left, returns the number of tasks run */
+    int run() {
+        int ran = 0;
+        for (int ithr = next_.fetch_add(1); ithr < nthr_;
+                ithr = next_.fetch_add(1)) {
+            const thread_state_t saved = tls;
+            tls.ithr = ithr;
+            tls.nthr = nthr_;
+            tls.in_parallel = 1;
+            fn_(ctx_, ithr, nthr_);
+            tls = saved;
+            ++ran;
+        }
+        if (ran) done_.fetch_add(ran);
+        return ran;
+    }
+
+    bool finished() const { return done_.load() == nthr_; }
+
+private:
+    task_fn_t fn_;
+    void *ctx_;
+    int nthr_;
+    int max_runners_;
+    std::atomic<int> next_;
+    std::atomic<int> done_;
+    std::atomic<int> runners_;
+};
+
+/* Parses a cpu list such as "0-3,8,10-11" */
+std::vector<int> parse_cpu_list(const char *s) {
+    std::vector<int> cpus;
+    while (*s) {
+        char *end;
+        long first = strtol(s, &end, 10), last = first;
+        if (end == s || first < 0) return std::vector<int>();
+        s = end;
+        if (*s == '-') {
+            ++s;
+            last = strtol(s, &end, 10);
+            if (end == s || last < first) return std::vector<int>();
+            s = end;
+        }
+        for (long c = first; c <= last; ++c) cpus.push_back((int)c);
+        if (*s == ',') ++s;
+        else if (*s) return std::vector<int>();
+    }
+    return cpus;
+}
+
+void bind_to_cpu(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    UNUSED(cpu);
+#endif
+}
+
+/* A job lives on the stack of its submitter. Workers announce themselves in
+ * users_[slot] before reading the slot, so once the submitter has cleared
+ * the slot and seen no users, nobody can touch the job anymore. */
+struct pool_t {
+    pool_t(): stop_(false), epoch_(0) {
+        for (int s = 0; s < max_jobs; ++s) {
+            slots_[s].store(nullptr);
+            users_[s].store(0);
+        }
+
+        const int len = 16;
+        char env[len] = {0};
+        int nthr = 0;
+        if (mkldnn_getenv("MKLDNN_NUM_THREADS", env, len) > 0)
+            nthr = atoi(env);
+        if (nthr <= 0) nthr = (int)std::thread::hardware_concurrency();
+        size_ = nthr > 0 ? nthr : 1;
+
+        const int cpus_len = 1024;
+        char env_cpus[cpus_len] = {0};
+        std::vector<int> cpus;
+        if (mkldnn_getenv("MKLDNN_THREADPOOL_CPUS", env_cpus, cpus_len) > 0)
+            cpus = parse_cpu_list(env_cpus);
+
+        /* the submitting thread is the team member 0, so the workers take
+         * the cpus starting from the second one */
+        for (int i = 1; i < size_; ++i) {
+            const int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+            workers_.emplace_back([this, cpu]() {
+                if (cpu >= 0) bind_to_cpu(cpu);
+                work();
+            });
+        }
+    }
+
+    ~pool_t() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_.store(true);
+        }
+        cv_.notify_all();
+        for (auto &w : workers_) w.join();
+    }
+
+    int size() const { return size_; }
+
+    void run(job_t &job) {
+        int slot = -1;
+        for (int s = 0; s < max_jobs && slot < 0; ++s) {
+            job_t *expected = nullptr;
+            if (slots_[s].compare_exchange_strong(expected, &job)) slot = s;
+        }
+
+        if (slot >= 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                epoch_.fetch_add(1);
+            }
+            cv_.notify_all();
+        }
+
+        job.run();
+        while (!job.finished()) std::this_thread::yield();
+
+        if (slot >= 0) {
+            slots_[slot].store(nullptr);
+            while (users_[slot].load() != 0) std::this_thread::yield();
+        }
+    }
+
+private:
+    enum { max_jobs = 16, spin_count = 4096 };
+
+    int try_run(int s) {
+        users_[s].fetch_add(1);
+        job_t *job = slots_[s].load();
+        const int ran = job && job->join() ? job->run() : 0;
+        users_[s].fetch_sub(1);
+        return ran;
+    }
+
+    void work() {
+        int spins = 0;
+        while (!stop_.load()) {
+            const unsigned epoch = epoch_.load();
+
+            int ran = 0;
+            for (int s = 0; s < max_jobs; ++s) ran += try_run(s);
+
+            if (ran) { spins = 0; continue; }
+            if (++spins < spin_count) { std::this_thread::yield(); continue; }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&]() {
+                return stop_.load() || epoch_.load() != epoch;
+            });
+            spins = 0;
+        }
+    }
+
+    int size_;
+    std::vector<std::thread> workers_;
+    std::atomic<job_t *> slots_[max_jobs];
+    std::atomic<int> users_[max_jobs];
+
+    std::atomic<bool> stop_;
+    std::atomic<unsigned> epoch_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+pool_t &pool() {
+    static pool_t p;
+    return p;
+}
+
+}
+
+int get_max_threads() {
+    const int size = pool().size();
+    const int max_threads = tls.max_threads;
+    return max_threads > 0 && max_threads < size ? max_threads : size;
+}
+
+int get_num_threads() { return tls.nthr; }
+int get_thread_num() { return tls.ithr; }
+int in_parallel() { return tls.in_parallel; }
+
+void parallel_run(int nthr, task_fn_t fn, void *ctx) {
+    if (nthr <= 1 || tls.in_parallel) {
+        /* as with OpenMP, a nested section is a team of one thread */
+        job_t job(1, fn, ctx, 1);
+        job.run();
+        return;
+    }
+
+    const int max_runners = get_max_threads();
+    job_t job(nthr, fn, ctx, max_runners);
+    if (max_runners <= 1) job.run();
+    else pool().run(job);
+}
+
+max_threads_scope_t::max_threads_scope_t(int nthr): saved_(tls.max_threads) {
+    if (nthr > 0) tls.max_threads = nthr;
+}
+
+max_threads_scope_t::~max_threads_scope_t() { tls.max_threads = saved_; }
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,75 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef MKLDNN_THREADPOOL_HPP
+#define MKLDNN_THREADPOOL_HPP
+
+/* This header must be included by mkldnn_thread.hpp only */
+
+/* Native threading runtime (MKLDNN_THR_THREADPOOL).
+ *
+ * A process wide pool of worker threads runs the parallel sections. A
+ * parallel(nthr, f) section becomes a job of nthr tasks (one per ithr)
+ * published in a lock-free job slot; the submitting thread and any idle
+ * worker claim the tasks with an atomic counter, so the threads that are
+ * free take over the work of the busy ones. Several application threads
+ * (e.g. one per stream) may submit jobs concurrently.
+ *
+ * Tasks of one job are not guaranteed to run concurrently, hence the runtime
+ * is not syncable (no mkldnn_thr_barrier()). Nested sections run
+ * sequentially in the calling task.
+ *
+ * The pool size comes from MKLDNN_NUM_THREADS (default: the number of online
+ * cpus) and the workers are bound to the cpus listed in
+ * MKLDNN_THREADPOOL_CPUS (e.g. "0-47" or "12-23,36-47") if it is set. */
+
+#include "mkldnn.h"
+
+namespace mkldnn {
+namespace impl {
+namespace threadpool_utils {
+
+/* The entry points are exported for the inline parallel() of the tests */
+
+typedef void (*task_fn_t)(void *ctx, int ithr, int nthr);
+
+MKLDNN_API int get_max_threads();
+MKLDNN_API int get_num_threads();
+MKLDNN_API int get_thread_num();
+MKLDNN_API int in_parallel();
+
+/** runs @p fn(@p ctx, ithr, @p nthr) for every ithr in [0, @p nthr) and
+ * returns when all the calls are done; the calling thread takes part, and
+ * at most get_max_threads() threads run the calls at a time */
+MKLDNN_API void parallel_run(int nthr, task_fn_t fn, void *ctx);
+
+/** limits the calling thread to @p nthr threads while in scope: both
+ * get_max_threads() and the threads that run the calls of parallel_run(),
+ * whatever nthr the section asks for; 0 keeps the pool size */
+struct MKLDNN_API max_threads_scope_t {
+    max_threads_scope_t(int nthr);
+    ~max_threads_scope_t();
+private:
+    int saved_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -74,6 +74,9 @@ PKIND_TRAITS_INST(lrn);
 PKIND_TRAITS_INST(batch_normalization);
 PKIND_TRAITS_INST(inner_product);
 PKIND_TRAITS_INST(rnn);
+PKIND_TRAITS_INST(matmul);
+PKIND_TRAITS_INST(layer_normalization);
+PKIND_TRAITS_INST(binary);
 #undef PKIND_TRAITS_INST
 
 }
@@ -81,6 +81,10 @@ struct mkldnn_primitive: public mkldnn::impl::c_compatible {
      */
     virtual void execute(mkldnn::impl::event_t *e) const = 0;
 
+    /** returns the size of the scratchpad the primitive borrows from the
+     * arena of the executing stream, 0 if it does not borrow one */
+    virtual size_t borrowed_scratchpad_size() const { return 0; }
+
     /** returns data handle. Applicable for memory primitives only. */
     virtual mkldnn::impl::status_t get_data_handle(void **handle) const {
         UNUSED(handle);
@@ -49,6 +49,38 @@ status_t scales_t::set(int count, int mask, const float *scales) {
     return status::success;
 }
 
+binary_po_bcast_t get_binary_po_bcast(const memory_desc_t &src1_md,
+        const memory_desc_t &dst_md, int oc_dim) {
+    const memory_desc_wrapper src1_d(&src1_md), dst_d(&dst_md);
+    const int ndims = dst_d.ndims();
+
+    bool ok = true
+        && src1_d.ndims() == ndims
+        && src1_d.data_type() == data_type::f32
+        && src1_d.is_blocking_desc()
+        && src1_d.blocking_desc().offset_padding == 0
+        && 0 <= oc_dim && oc_dim < ndims;
+    if (!ok) return binary_po_bcast_unsupported;
+
+    if (src1_d == dst_d) return binary_po_bcast_full;
+
+    /* the broadcast forms keep the src1 values contiguous */
+    if (!src1_d.is_plain() || !src1_d.is_dense())
+        return binary_po_bcast_unsupported;
+
+    bool per_tensor = true;
+    bool per_oc = src1_d.dims()[oc_dim] == dst_d.dims()[oc_dim];
+    for (int d = 0; d < ndims; ++d) {
+        if (src1_d.dims()[d] == 1) continue;
+        per_tensor = false;
+        if (d != oc_dim) per_oc = false;
+    }
+
+    if (per_tensor) return binary_po_bcast_per_tensor;
+    if (per_oc) return binary_po_bcast_per_oc;
+    return binary_po_bcast_unsupported;
+}
+
 }
 }
 
@@ -88,6 +120,50 @@ status_t post_ops_t::append_eltwise(float scale, alg_kind_t alg, float alpha,
     return success;
 }
 
+status_t post_ops_t::append_binary(alg_kind_t alg,
+        const memory_desc_t *src1_desc) {
+    using namespace mkldnn::impl::alg_kind;
+    bool ok = true
+        && one_of(alg, binary_add, binary_mul, binary_max, binary_min)
+        && src1_desc != nullptr
+        && src1_desc->format != memory_format::any;
+    if (!ok)
+        return invalid_arguments;
+
+    if (len_ == capacity)
+        return out_of_memory;
+
+    entry_[len_].kind = primitive_kind::binary;
+    entry_[len_].binary.alg = alg;
+    entry_[len_].binary.src1_desc = *src1_desc;
+
+    len_++;
+
+    return success;
+}
+
+status_t post_ops_t::append_dw(data_type_t wei_dt, data_type_t bias_dt,
+        data_type_t dst_dt, int stride) {
+    bool ok = true
+        && one_of(stride, 1, 2)
+        && !one_of(data_type::undef, wei_dt, dst_dt);
+    if (!ok)
+        return invalid_arguments;
+
+    if (len_ == capacity)
+        return out_of_memory;
+
+    entry_[len_].kind = primitive_kind::convolution;
+    entry_[len_].depthwise_conv.stride = stride;
+    entry_[len_].depthwise_conv.wei_dt = wei_dt;
+    entry_[len_].depthwise_conv.bias_dt = bias_dt;
+    entry_[len_].depthwise_conv.dst_dt = dst_dt;
+
+    len_++;
+
+    return success;
+}
+
 status_t primitive_attr_t::set_round_mode(round_mode_t round_mode) {
     using namespace mkldnn::impl::round_mode;
 
@@ -272,6 +348,79 @@ status_t mkldnn_post_ops_get_params_eltwise(const post_ops_t *post_ops,
     return success;
 }
 
+status_t mkldnn_post_ops_append_binary(post_ops_t *post_ops,
+        alg_kind_t alg, const memory_desc_t *src1_desc) {
+    if (post_ops == nullptr)
+        return invalid_arguments;
+
+    return post_ops->append_binary(alg, src1_desc);
+}
+
+status_t mkldnn_post_ops_get_params_binary(const post_ops_t *post_ops,
+        int index, alg_kind_t *alg, const memory_desc_t **src1_desc) {
+    bool ok = true
+        && simple_get_params_check(post_ops, index, primitive_kind::binary)
+        && !any_null(alg, src1_desc);
+    if (!ok)
+        return invalid_arguments;
+
+    const auto &e = post_ops->entry_[index].binary;
+    *alg = e.alg;
+    *src1_desc = &e.src1_desc;
+
+    return success;
+}
+
+namespace {
+status_t get_params_dw(const post_ops_t *post_ops, int index, int stride,
+        data_type_t *wei_dt, data_type_t *bias_dt, data_type_t *dst_dt) {
+    bool ok = true
+        && simple_get_params_check(post_ops, index,
+                primitive_kind::convolution)
+        && !any_null(wei_dt, bias_dt, dst_dt);
+    if (!ok)
+        return invalid_arguments;
+
+    const auto &e = post_ops->entry_[index].depthwise_conv;
+    if (e.stride != stride)
+        return invalid_arguments;
+
+    *wei_dt = e.wei_dt;
+    *bias_dt = e.bias_dt;
+    *dst_dt = e.dst_dt;
+
+    return success;
+}
+}
+
+status_t mkldnn_post_ops_append_dw_k3s1p1(post_ops_t *post_ops,
+        data_type_t wei_dt, data_type_t bias_dt, data_type_t dst_dt) {
+    if (post_ops == nullptr)
+        return invalid_arguments;
+
+    return post_ops->append_dw(wei_dt, bias_dt, dst_dt, 1);
+}
+
+status_t mkldnn_post_ops_get_params_dw_k3s1p1(const post_ops_t *post_ops,
+        int index, data_type_t *wei_dt, data_type_t *bias_dt,
+        data_type_t *dst_dt) {
+    return get_params_dw(post_ops, index, 1, wei_dt, bias_dt, dst_dt);
+}
+
+status_t mkldnn_post_ops_append_dw_k3s2p1(post_ops_t *post_ops,
+        data_type_t wei_dt, data_type_t bias_dt, data_type_t dst_dt) {
+    if (post_ops == nullptr)
+        return invalid_arguments;
+
+    return post_ops->append_dw(wei_dt, bias_dt, dst_dt, 2);
+}
+
+status_t mkldnn_post_ops_get_params_dw_k3s2p1(const post_ops_t *post_ops,
+        int index, data_type_t *wei_dt, data_type_t *bias_dt,
+        data_type_t *dst_dt) {
+    return get_params_dw(post_ops, index, 2, wei_dt, bias_dt, dst_dt);
+}
+
 status_t mkldnn_primitive_attr_set_rnn_data_qparams(
         primitive_attr_t *attr, const float scale, const float shift) {
     if (attr == nullptr)
@@ -86,6 +86,17 @@ private:
     }
 };
 
+/* Broadcast of the src1 of a binary post-op against the destination */
+enum binary_po_bcast_t {
+    binary_po_bcast_unsupported,
+    binary_po_bcast_full, /* src1 has the dims and the format of dst */
+    binary_po_bcast_per_oc, /* one value per channel (dim oc_dim of dst) */
+    binary_po_bcast_per_tensor, /* one value for the whole dst */
+};
+
+binary_po_bcast_t get_binary_po_bcast(const memory_desc_t &src1_md,
+        const memory_desc_t &dst_md, int oc_dim = 1);
+
 }
 }
 
@@ -96,10 +107,23 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
             float scale, alpha, beta;
         };
 
+        struct binary_t {
+            mkldnn::impl::alg_kind_t alg;
+            mkldnn::impl::memory_desc_t src1_desc;
+        };
+
+        /* 3x3 depthwise convolution with the padding of 1 */
+        struct depthwise_conv_t {
+            int stride;
+            mkldnn::impl::data_type_t wei_dt, bias_dt, dst_dt;
+        };
+
         mkldnn::impl::primitive_kind_t kind;
         union {
             struct { float scale; } sum;
             eltwise_t eltwise;
+            binary_t binary;
+            depthwise_conv_t depthwise_conv;
         };
 
         bool is_eltwise(bool require_scale_one = true) const {
@@ -121,6 +145,16 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
             return kind == primitive_kind::sum
                 && IMPLICATION(require_scale_one, sum.scale == 1.f);
         }
+
+        bool is_binary() const {
+            using namespace mkldnn::impl;
+            return kind == primitive_kind::binary;
+        }
+
+        bool is_convolution() const {
+            using namespace mkldnn::impl;
+            return kind == primitive_kind::convolution;
+        }
     };
 
     mkldnn_post_ops(): len_(0) {}
@@ -128,6 +162,11 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
     mkldnn::impl::status_t append_sum(float scale);
     mkldnn::impl::status_t append_eltwise(float scale,
             mkldnn::impl::alg_kind_t alg, float alpha, float beta);
+    mkldnn::impl::status_t append_binary(mkldnn::impl::alg_kind_t alg,
+            const mkldnn::impl::memory_desc_t *src1_desc);
+    mkldnn::impl::status_t append_dw(mkldnn::impl::data_type_t wei_dt,
+            mkldnn::impl::data_type_t bias_dt,
+            mkldnn::impl::data_type_t dst_dt, int stride);
 
     int find(mkldnn::impl::primitive_kind_t kind, int start = 0,
             int stop = -1) const {
@@ -138,6 +177,13 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
         return -1;
     }
 
+    int count(mkldnn::impl::primitive_kind_t kind) const {
+        int n = 0;
+        for (int idx = 0; idx < len_; ++idx)
+            n += entry_[idx].kind == kind;
+        return n;
+    }
+
     bool has_default_values() const { return len_ == 0; }
 
     bool contain(mkldnn::impl::primitive_kind_t kind, int index) const
@@ -0,0 +1,165 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <stdlib.h>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "mkldnn_thread.hpp"
+#include "primitive_cache.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+const int default_capacity = 1024;
+
+std::atomic<int> &capacity() {
+    static std::atomic<int> capacity_([]() {
+        const int len = 12;
+        char val[len] = {0};
+        int c = default_capacity;
+        if (mkldnn_getenv("MKLDNN_PRIMITIVE_CACHE_CAPACITY", val, len) > 0)
+            c = nstl::max(0, atoi(val));
+        return c;
+    }());
+    return capacity_;
+}
+
+template <typename T>
+void append(std::string &key, const T &value) {
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+size_t op_desc_size(primitive_kind_t kind) {
+    using namespace primitive_kind;
+    switch (kind) {
+    case convolution: return sizeof(convolution_desc_t);
+    case deconvolution: return sizeof(deconvolution_desc_t);
+    case shuffle: return sizeof(shuffle_desc_t);
+    case pooling: return sizeof(pooling_desc_t);
+    case eltwise: return sizeof(eltwise_desc_t);
+    case softmax: return sizeof(softmax_desc_t);
+    case lrn: return sizeof(lrn_desc_t);
+    case batch_normalization: return sizeof(batch_normalization_desc_t);
+    case inner_product: return sizeof(inner_product_desc_t);
+    case rnn: return sizeof(rnn_desc_t);
+    case matmul: return sizeof(matmul_desc_t);
+    case layer_normalization: return sizeof(layer_normalization_desc_t);
+    case binary: return sizeof(binary_desc_t);
+    default: return 0;
+    }
+}
+}
+
+int get_primitive_cache_capacity() { return capacity().load(); }
+
+lru_cache_t<pd_cache_entry_t> &primitive_desc_cache() {
+    static lru_cache_t<pd_cache_entry_t> cache;
+    return cache;
+}
+
+/* The attributes are appended field by field, the post-ops entries are a
+ * union which may hold padding. */
+void append_attr_to_key(std::string &key, const primitive_attr_t *attr) {
+    const primitive_attr_t default_attr;
+    if (attr == nullptr) attr = &default_attr;
+
+    append(key, attr->round_mode_);
+
+    auto append_scales = [&](const scales_t &s) {
+        append(key, s.count_);
+        append(key, s.mask_);
+        key.append(reinterpret_cast<const char *>(s.scales_),
+                sizeof(float) * s.count_);
+    };
+    append_scales(attr->output_scales_);
+    append_scales(attr->rnn_weights_qparams_);
+    append(key, attr->rnn_data_qparams_.scale_);
+    append(key, attr->rnn_data_qparams_.shift_);
+
+    const post_ops_t &p = attr->post_ops_;
+    append(key, p.len_);
+    for (int i = 0; i < p.len_; ++i) {
+        const auto &e = p.entry_[i];
+        append(key, e.kind);
+        if (e.kind == primitive_kind::sum) {
+            append(key, e.sum.scale);
+        } else if (e.kind == primitive_kind::eltwise) {
+            append(key, e.eltwise.alg);
+            append(key, e.eltwise.scale);
+            append(key, e.eltwise.alpha);
+            append(key, e.eltwise.beta);
+        } else if (e.kind == primitive_kind::binary) {
+            append(key, e.binary.alg);
+            append(key, e.binary.src1_desc);
+        } else if (e.kind == primitive_kind::convolution) {
+            append(key, e.depthwise_conv.stride);
+            append(key, e.depthwise_conv.wei_dt);
+            append(key, e.depthwise_conv.bias_dt);
+            append(key, e.depthwise_conv.dst_dt);
+        }
+    }
+}
+
+/* The op descriptor is compared bytewise: it is zero-initialized by the
+ * desc_init functions, so a difference in unused bytes can only cause a
+ * miss. The number of threads is part of the key since the implementations
+ * use it to choose their blocking and to book the scratchpad.
+ *
+ * Backward descriptors are not cached: they depend on the implementation and
+ * the formats chosen for the forward hint, not only on its op descriptor. */
+bool get_primitive_desc_key(std::string &key, const engine_t *engine,
+        const op_desc_t *op_desc, const primitive_attr_t *attr,
+        const primitive_desc_t *hint_fwd_pd) {
+    if (get_primitive_cache_capacity() == 0 || hint_fwd_pd != nullptr)
+        return false;
+
+    const size_t sz = op_desc_size(op_desc->kind);
+    if (sz == 0) return false;
+
+    key.clear();
+    key.reserve(sz + 128);
+    append(key, engine);
+    append(key, engine->kind());
+    append(key, mkldnn_get_max_threads());
+    key.append(reinterpret_cast<const char *>(op_desc), sz);
+    append_attr_to_key(key, attr);
+    return true;
+}
+
+}
+}
+
+mkldnn_status_t mkldnn_set_primitive_cache_capacity(int capacity) {
+    using namespace mkldnn::impl::status;
+    if (capacity < 0) return invalid_arguments;
+    mkldnn::impl::capacity().store(capacity);
+    return success;
+}
+
+mkldnn_status_t mkldnn_get_primitive_cache_capacity(int *capacity) {
+    using namespace mkldnn::impl::status;
+    if (capacity == nullptr) return invalid_arguments;
+    *capacity = mkldnn::impl::get_primitive_cache_capacity();
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
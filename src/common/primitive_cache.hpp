@@ -0,0 +1,105 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef PRIMITIVE_CACHE_HPP
+#define PRIMITIVE_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "primitive_attr.hpp"
+#include "primitive_desc.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/* Number of entries each cache of the library may hold, 0 disables the
+ * caching. Set by mkldnn_set_primitive_cache_capacity() or the
+ * MKLDNN_PRIMITIVE_CACHE_CAPACITY environment variable. */
+int get_primitive_cache_capacity();
+
+/* Thread-safe cache with least recently used eviction. The keys are byte
+ * strings built by the users of the cache, a change of the capacity is
+ * applied at the next access. */
+template <typename value_t>
+struct lru_cache_t: public c_compatible {
+    typedef std::string key_t;
+
+    bool get(const key_t &key, value_t &value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        evict(get_primitive_cache_capacity());
+        auto it = map_.find(key);
+        if (it == map_.end()) return false;
+        list_.splice(list_.begin(), list_, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    void add(const key_t &key, const value_t &value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const int capacity = get_primitive_cache_capacity();
+        /* another thread may have added the same entry meanwhile */
+        if (capacity == 0 || map_.count(key) != 0) return;
+        list_.emplace_front(key, value);
+        map_[key] = list_.begin();
+        evict(capacity);
+    }
+
+private:
+    typedef std::list<std::pair<key_t, value_t>> list_t;
+
+    void evict(int capacity) {
+        while ((int)list_.size() > capacity) {
+            map_.erase(list_.back().first);
+            list_.pop_back();
+        }
+    }
+
+    list_t list_;
+    std::unordered_map<key_t, typename list_t::iterator> map_;
+    std::mutex mutex_;
+};
+
+/* Primitive descriptors are cached with the index of their implementation in
+ * the engine list, so that iterating over the next implementations works on
+ * a cache hit too. */
+struct pd_cache_entry_t {
+    std::shared_ptr<primitive_desc_t> pd;
+    int impl_idx;
+};
+
+lru_cache_t<pd_cache_entry_t> &primitive_desc_cache();
+
+void append_attr_to_key(std::string &key, const primitive_attr_t *attr);
+
+/* Returns false if the primitive descriptor should not be cached */
+bool get_primitive_desc_key(std::string &key, const engine_t *engine,
+        const op_desc_t *op_desc, const primitive_attr_t *attr,
+        const primitive_desc_t *hint_fwd_pd);
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
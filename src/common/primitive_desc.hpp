@@ -62,12 +62,19 @@ struct mkldnn_primitive_desc: public mkldnn::impl::c_compatible {
     DECLARE_PD_STUB(src_pd); DECLARE_PD_STUB(diff_src_pd);
     DECLARE_PD_STUB(dst_pd); DECLARE_PD_STUB(diff_dst_pd);
     DECLARE_PD_STUB(weights_pd); DECLARE_PD_STUB(diff_weights_pd);
-    DECLARE_PD_STUB(workspace_pd);
+    DECLARE_PD_STUB(workspace_pd); DECLARE_PD_STUB(binary_po_pd);
 #   undef DECLARE_PD_STUB
 
     virtual int n_inputs() const { return 0; }
     virtual int n_outputs() const { return 0; }
 
+    /** the src1 memories of the binary post-ops are the last inputs */
+    int binary_po_input_index(int idx) const {
+        using namespace mkldnn::impl;
+        return n_inputs() - attr_.post_ops_.count(primitive_kind::binary)
+            + idx;
+    }
+
     virtual mkldnn::impl::status_t query(mkldnn::impl::query_t what, int idx,
             void *result) const;
 
@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <string>
 
 #include "mkldnn.h"
 
@@ -22,11 +23,42 @@
 #include "engine.hpp"
 #include "primitive_desc.hpp"
 #include "type_helpers.hpp"
+#include "primitive_cache.hpp"
 #include "primitive_iterator.hpp"
 
 using namespace mkldnn::impl;
 using namespace mkldnn::impl::status;
 
+primitive_desc_iterator_t &mkldnn_primitive_desc_iterator::operator++() {
+    if (pd_) { delete pd_; pd_ = nullptr; }
+
+    std::string key;
+    const bool use_cache = idx_ == -1 && get_primitive_desc_key(key,
+            engine_, op_desc_, &attr_, hint_fwd_pd_);
+    if (use_cache) {
+        pd_cache_entry_t e;
+        if (primitive_desc_cache().get(key, e)) {
+            pd_ = e.pd->clone();
+            idx_ = e.impl_idx;
+            return *this;
+        }
+    }
+
+    while (++idx_ != last_idx_) {
+        auto s = impl_list_[idx_](&pd_, op_desc_, &attr_, engine_,
+                hint_fwd_pd_);
+        if (s == success) break;
+    }
+
+    if (use_cache && pd_ != nullptr) {
+        pd_cache_entry_t e;
+        e.pd.reset(pd_->clone());
+        e.impl_idx = idx_;
+        primitive_desc_cache().add(key, e);
+    }
+    return *this;
+}
+
 status_t mkldnn_primitive_desc_iterator_create_v2(
         primitive_desc_iterator_t **iterator, const_c_op_desc_t c_op_desc,
         const primitive_attr_t *attr, engine_t *engine,
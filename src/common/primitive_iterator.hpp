@@ -44,15 +44,8 @@ struct mkldnn_primitive_desc_iterator: public mkldnn::impl::c_compatible {
     mkldnn::impl::primitive_desc_iterator_t end() const
     { return mkldnn_primitive_desc_iterator(engine_, last_idx_); }
 
-    mkldnn::impl::primitive_desc_iterator_t &operator++() {
-        if (pd_) { delete pd_; pd_ = nullptr; }
-        while (++idx_ != last_idx_) {
-            auto s = impl_list_[idx_](&pd_, op_desc_, &attr_, engine_,
-                    hint_fwd_pd_);
-            if (s ==  mkldnn::impl::status::success) break;
-        }
-        return *this;
-    }
+    /* The first step looks up the primitive descriptor cache */
+    mkldnn::impl::primitive_desc_iterator_t &operator++();
 
     mkldnn::impl::primitive_desc_t *operator*() const {
         if (*this == end() || pd_ == nullptr) return nullptr;
@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include "c_types_map.hpp"
 #include "mkldnn_thread.hpp"
 #include "utils.hpp"
 
@@ -25,79 +26,71 @@ namespace impl {
 /* Allocating memory buffers on a page boundary to reduce TLB/page misses */
 const size_t page_size = 2097152;
 
-/*
-  Implementation of the scratchpad_t interface that is compatible with
-  a concurrent execution
-*/
-struct concurent_scratchpad_t : public scratchpad_t {
-    concurent_scratchpad_t(size_t size) {
-        size_ = size;
-        scratchpad_ = (char *) malloc(size, page_size);
-        assert(scratchpad_ != nullptr);
-    }
+/* The per-thread parts of a scratchpad are laid out in thread order, so
+ * touching the pages of a new buffer the same way places every part in the
+ * memory of the CMG whose threads use it (first-touch policy). */
+static void first_touch(char *ptr, size_t size) {
+    if (ptr == nullptr || mkldnn_in_parallel()
+            || mkldnn_get_team_cmgs(mkldnn_get_max_threads()) == 1)
+        return;
+
+    const size_t touch_step = 4096;
+    const size_t nsteps = utils::div_up(size, touch_step);
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+        balance211(nsteps, nthr, ithr, start, end);
+        for (size_t i = start; i < end; i++)
+            ptr[i * touch_step] = 0;
+    });
+}
 
-    ~concurent_scratchpad_t() {
-        free(scratchpad_);
-    }
+scratchpad_arena_t::~scratchpad_arena_t() {
+    free(ptr_);
+}
 
-    virtual char *get() const {
-        return scratchpad_;
+status_t scratchpad_arena_t::set_user_memory(void *ptr, size_t size) {
+    if (ptr != nullptr && (size_t)ptr % 64 != 0)
+        return status::invalid_arguments;
+
+    user_ptr_ = (char *)ptr;
+    user_size_ = ptr ? size : 0;
+    if (user_ptr_ != nullptr) {
+        /* the own memory is not needed anymore */
+        free(ptr_);
+        ptr_ = nullptr;
+        size_ = 0;
     }
+    return status::success;
+}
 
-private:
-    char *scratchpad_;
-    size_t size_;
-};
-
-/*
-  Implementation of the scratchpad_t interface that uses a global
-  scratchpad
-*/
-
-struct global_scratchpad_t : public scratchpad_t {
-    global_scratchpad_t(size_t size) {
-        if (size > size_) {
-            if (scratchpad_ != nullptr) free(scratchpad_);
-            size_ = size;
-            scratchpad_ = (char *) malloc(size, page_size);
-            assert(scratchpad_ != nullptr);
-        }
-        reference_count_++;
-    }
+char *scratchpad_arena_t::get(size_t size) {
+    if (user_ptr_ != nullptr && size <= user_size_) return user_ptr_;
 
-    ~global_scratchpad_t() {
-        reference_count_--;
-        if (reference_count_ == 0) {
-            free(scratchpad_);
-            scratchpad_ = nullptr;
-            size_ = 0;
-        }
+    if (size > size_) {
+        free(ptr_);
+        ptr_ = (char *)malloc(size, page_size);
+        size_ = ptr_ ? size : 0;
+        first_touch(ptr_, size_);
     }
+    return ptr_;
+}
 
-    virtual char *get() const {
-        return scratchpad_;
-    }
+namespace {
+thread_local scratchpad_arena_t thread_arena;
+thread_local scratchpad_arena_t *stream_arena = nullptr;
+}
+
+scratchpad_arena_t *current_scratchpad_arena() {
+    return stream_arena ? stream_arena : &thread_arena;
+}
+
+scratchpad_arena_scope_t::scratchpad_arena_scope_t(scratchpad_arena_t *arena)
+    : saved_(stream_arena) {
+    stream_arena = arena;
+}
 
-private:
-    thread_local static char *scratchpad_;
-    thread_local static size_t size_;
-    thread_local static unsigned int reference_count_;
-};
-
-thread_local char *global_scratchpad_t::scratchpad_ = nullptr;
-thread_local size_t global_scratchpad_t::size_ = 0;
-thread_local unsigned int global_scratchpad_t::reference_count_ = 0;
-
-
-/*
-   Scratchpad creation routine
-*/
-scratchpad_t *create_scratchpad(size_t size) {
-#ifndef MKLDNN_ENABLE_CONCURRENT_EXEC
-    return new global_scratchpad_t(size);
-#else
-    return new concurent_scratchpad_t(size);
-#endif
+scratchpad_arena_scope_t::~scratchpad_arena_scope_t() {
+    stream_arena = saved_;
 }
 
 }
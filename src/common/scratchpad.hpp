@@ -17,17 +17,50 @@
 #ifndef COMMON_SCRATCHPAD_HPP
 #define COMMON_SCRATCHPAD_HPP
 
+#include "c_types_map.hpp"
 #include "utils.hpp"
 
 namespace mkldnn {
 namespace impl {
 
-struct scratchpad_t {
-    virtual ~scratchpad_t() {}
-    virtual char *get() const = 0;
+/* Scratchpad memory the primitives borrow while they execute. Every stream
+ * owns one, sized to the largest scratchpad of the primitives submitted to
+ * it, so primitives that are not executing hold no scratchpad memory and
+ * primitives of different streams can execute concurrently. The memory may
+ * be supplied by the user instead; when it is too small for a primitive the
+ * arena falls back to memory of its own. */
+struct scratchpad_arena_t: public c_compatible {
+    scratchpad_arena_t()
+        : user_ptr_(nullptr), user_size_(0), ptr_(nullptr), size_(0) {}
+    ~scratchpad_arena_t();
+
+    /** makes the arena use @p size bytes at @p ptr (64-byte aligned);
+     * nullptr returns to the memory owned by the arena */
+    status_t set_user_memory(void *ptr, size_t size);
+
+    /** returns at least @p size bytes, nullptr if out of memory */
+    char *get(size_t size);
+
+private:
+    char *user_ptr_;
+    size_t user_size_;
+    char *ptr_;
+    size_t size_;
+
+    scratchpad_arena_t(const scratchpad_arena_t &) = delete;
+    scratchpad_arena_t &operator=(const scratchpad_arena_t &) = delete;
 };
 
-scratchpad_t *create_scratchpad(size_t size);
+/* Arena of the stream the calling thread is executing, or a per-thread
+ * arena outside of streams */
+scratchpad_arena_t *current_scratchpad_arena();
+
+struct scratchpad_arena_scope_t {
+    scratchpad_arena_scope_t(scratchpad_arena_t *arena);
+    ~scratchpad_arena_scope_t();
+private:
+    scratchpad_arena_t *saved_;
+};
 
 }
 }
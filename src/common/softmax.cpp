@@ -30,7 +30,8 @@ using namespace mkldnn::impl::types;
 
 namespace {
 status_t softmax_desc_init(softmax_desc_t *softmax_desc, prop_kind_t prop_kind,
-        const memory_desc_t *data_desc, const memory_desc_t *diff_desc, int softmax_axis) {
+        alg_kind_t alg_kind, const memory_desc_t *data_desc,
+        const memory_desc_t *diff_desc, int softmax_axis) {
     bool args_ok = true
         && !any_null(softmax_desc, data_desc)
         && 0 <= softmax_axis
@@ -45,6 +46,7 @@ status_t softmax_desc_init(softmax_desc_t *softmax_desc, prop_kind_t prop_kind,
     sd.data_desc = *data_desc;
     sd.diff_desc = is_bwd ? *diff_desc : zero_md();
     sd.softmax_axis = softmax_axis;
+    sd.alg_kind = alg_kind;
 
     *softmax_desc = sd;
     return success;
@@ -56,13 +58,31 @@ status_t mkldnn_softmax_forward_desc_init(softmax_desc_t *softmax_desc,
         int softmax_axis) {
     if (!one_of(prop_kind, forward_inference, forward_training))
         return invalid_arguments;
-    return softmax_desc_init(softmax_desc, prop_kind, data_desc, nullptr, softmax_axis);
+    return softmax_desc_init(softmax_desc, prop_kind, softmax_accurate,
+            data_desc, nullptr, softmax_axis);
 }
 
 status_t mkldnn_softmax_backward_desc_init(softmax_desc_t *softmax_desc,
         const memory_desc_t *diff_desc, const mkldnn_memory_desc_t *data_desc,
         int softmax_axis) {
     return softmax_desc_init(softmax_desc, prop_kind::backward_data,
-            data_desc, diff_desc, softmax_axis);
+            softmax_accurate, data_desc, diff_desc, softmax_axis);
 }
+
+status_t mkldnn_logsoftmax_forward_desc_init(softmax_desc_t *softmax_desc,
+        prop_kind_t prop_kind, const memory_desc_t *data_desc,
+        int softmax_axis) {
+    if (!one_of(prop_kind, forward_inference, forward_training))
+        return invalid_arguments;
+    return softmax_desc_init(softmax_desc, prop_kind, softmax_log,
+            data_desc, nullptr, softmax_axis);
+}
+
+status_t mkldnn_logsoftmax_backward_desc_init(softmax_desc_t *softmax_desc,
+        const memory_desc_t *diff_desc, const mkldnn_memory_desc_t *data_desc,
+        int softmax_axis) {
+    return softmax_desc_init(softmax_desc, prop_kind::backward_data,
+            softmax_log, data_desc, diff_desc, softmax_axis);
+}
+
 // vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -92,6 +92,10 @@ struct softmax_fwd_pd_t: public primitive_desc_t {
     int axis() const { return desc_.softmax_axis; }
     int ndims() const { return desc_.data_desc.ndims; }
 
+    bool is_logsoftmax() const {
+        return desc_.alg_kind == alg_kind::softmax_log;
+    }
+
     bool is_fwd() const {
         return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
                 prop_kind::forward_inference);
@@ -172,6 +176,10 @@ struct softmax_bwd_pd_t: public primitive_desc_t {
     int axis() const { return desc_.softmax_axis; }
     int ndims() const { return desc_.data_desc.ndims; }
 
+    bool is_logsoftmax() const {
+        return desc_.alg_kind == alg_kind::softmax_log;
+    }
+
     bool is_fwd() const {
         return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
                 prop_kind::forward_inference);
@@ -19,6 +19,7 @@
 
 #include "c_types_map.hpp"
 #include "engine.hpp"
+#include "mkldnn_thread.hpp"
 #include "nstl.hpp"
 #include "stream.hpp"
 #include "type_helpers.hpp"
@@ -27,6 +28,24 @@
 using namespace mkldnn::impl;
 using namespace mkldnn::impl::status;
 
+namespace {
+/* the primitives executed by a stream borrow its scratchpad arena and obey
+ * its thread limit */
+struct stream_exec_scope_t {
+    stream_exec_scope_t(stream_t *s)
+        : arena_scope_(s->scratchpad_arena())
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+        , threads_scope_(s->max_threads())
+#endif
+    {}
+private:
+    scratchpad_arena_scope_t arena_scope_;
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    threadpool_utils::max_threads_scope_t threads_scope_;
+#endif
+};
+}
+
 status_t stream_t::submit(const nstl::vector<primitive_t *> &prims,
         primitive_t **error_prim) {
     if (!modifiable_) return invalid_arguments;
@@ -44,8 +63,26 @@ status_t stream_t::submit(const nstl::vector<primitive_t *> &prims,
         }
     }
 
+    /* size the arena to the largest scratchpad up front, so an out of
+     * memory is reported here rather than in the middle of the execution */
+    size_t scratchpad_size = 0;
+    primitive_t *largest = nullptr;
+    for (size_t i = 0; i < prims.size(); ++i) {
+        const size_t size = prims[i]->borrowed_scratchpad_size();
+        if (size > scratchpad_size) {
+            scratchpad_size = size;
+            largest = prims[i];
+        }
+    }
+    if (scratchpad_size != 0
+            && scratchpad_arena_.get(scratchpad_size) == nullptr) {
+        *error_prim = largest;
+        return out_of_memory;
+    }
+
     const size_t start = stream_.size();
     stream_.insert(stream_.end(), prims.begin(), prims.end());
+    stream_exec_scope_t scope(this);
     return submit_impl(start, stream_.size(), error_prim);
 }
 
@@ -61,6 +98,7 @@ status_t stream_t::wait(primitive_t **error_prim) {
 
     modifiable_ = false;
     state_ = stream_t::waiting;
+    stream_exec_scope_t scope(this);
     status_t status = wait_impl(error_prim);
     state_ = stream_t::stopped;
     return status;
@@ -73,9 +111,20 @@ status_t stream_t::rerun(primitive_t **error_prim) {
     if (error_prim == nullptr) error_prim = &error_primitive_stub;
 
     state_ = stream_t::running;
+    stream_exec_scope_t scope(this);
     return rerun_impl(error_prim);
 }
 
+status_t stream_t::set_max_threads(int nthr) {
+    if (nthr < 0) return invalid_arguments;
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    max_threads_ = nthr;
+    return success;
+#else
+    return unimplemented;
+#endif
+}
+
 /* API */
 
 status_t mkldnn_stream_create(stream_t **stream, stream_kind_t stream_kind) {
@@ -117,6 +166,17 @@ status_t mkldnn_stream_rerun(stream_t *stream, primitive_t **error_primitive) {
     return stream->rerun(error_primitive);
 }
 
+status_t mkldnn_stream_set_max_threads(stream_t *stream, int nthr) {
+    if (stream == nullptr) return invalid_arguments;
+    return stream->set_max_threads(nthr);
+}
+
+status_t mkldnn_stream_set_scratchpad(stream_t *stream, void *ptr,
+        size_t size) {
+    if (stream == nullptr) return invalid_arguments;
+    return stream->set_scratchpad(ptr, size);
+}
+
 status_t mkldnn_stream_destroy(stream_t *stream) {
     if (stream) delete stream;
     return success;
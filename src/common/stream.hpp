@@ -25,6 +25,7 @@
 #include "engine.hpp"
 #include "nstl.hpp"
 #include "primitive.hpp"
+#include "scratchpad.hpp"
 #include "utils.hpp"
 
 struct mkldnn_stream: public mkldnn::impl::c_compatible {
@@ -72,7 +73,8 @@ struct mkldnn_stream: public mkldnn::impl::c_compatible {
 #endif
     };
 
-    mkldnn_stream(): modifiable_(true), state_(mkldnn_stream::running) {}
+    mkldnn_stream(): modifiable_(true), state_(mkldnn_stream::running)
+        , max_threads_(0) {}
     virtual ~mkldnn_stream() {}
 
     /** submits vector of primitives @p prims to a stream
@@ -154,9 +156,24 @@ struct mkldnn_stream: public mkldnn::impl::c_compatible {
     virtual mkldnn::impl::status_t rerun_impl(
             mkldnn::impl::primitive_t **error_prim) = 0;
 
+    /** limits the number of threads the primitives of the stream run on,
+     * 0 means no limit; honored by the native thread pool runtime only */
+    mkldnn::impl::status_t set_max_threads(int nthr);
+    int max_threads() const { return max_threads_; }
+
+    /** makes the primitives of the stream borrow their scratchpads from
+     * @p size bytes of user memory at @p ptr; nullptr returns to memory
+     * owned by the stream */
+    mkldnn::impl::status_t set_scratchpad(void *ptr, size_t size)
+    { return scratchpad_arena_.set_user_memory(ptr, size); }
+    mkldnn::impl::scratchpad_arena_t *scratchpad_arena()
+    { return &scratchpad_arena_; }
+
 protected:
     bool modifiable_;
     state_t state_;
+    int max_threads_;
+    mkldnn::impl::scratchpad_arena_t scratchpad_arena_;
 
     primitive_vector stream_;
 };
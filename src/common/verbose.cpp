@@ -66,6 +66,12 @@ const verbose_t *mkldnn_verbose() {
                 mkldnn_version()->major, mkldnn_version()->minor,
                 mkldnn_version()->patch, mkldnn_version()->hash);
         printf("mkldnn_verbose,info,Detected ISA is %s\n", get_isa_info());
+#ifdef __ARM_ARCH
+        const int sve_len = cpu::get_sve_length();
+        if (sve_len != 0 && !cpu::sve_length_supported())
+            printf("mkldnn_verbose,info,%d-bit SVE vectors are not supported "
+                    "by the jit kernels\n", sve_len * 8);
+#endif
         version_printed = true;
     }
 #else
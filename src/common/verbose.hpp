@@ -311,12 +311,56 @@ template <typename pd_t> static void init_info_softmax(pd_t *s, char *buffer) {
     snprintf(dat_str, MKLDNN_VERBOSE_DAT_LEN, "fdata:%s fdiff:%s",
             mkldnn_fmt2str(fmt_data), mkldnn_fmt2str(fmt_diff));
 
+    snprintf(aux_str, MKLDNN_VERBOSE_AUX_LEN,
+            "alg:%s", mkldnn_alg_kind2str(s->desc()->alg_kind));
+
     format_mem_desc_str(prb_str, MKLDNN_VERBOSE_PRB_LEN, md);
 
     verbose_templ(buffer, s->kind(), s->name(), s->desc()->prop_kind, dat_str,
             aux_str, prb_str);
 }
 
+template <typename pd_t> static void init_info_matmul(pd_t *s, char *buffer) {
+    DECL_DAT_AUX_PRB_STRS();
+
+    auto fmt_bia = s->with_bias()
+        ? s->weights_pd(1)->desc()->format : memory_format::undef;
+    snprintf(dat_str, MKLDNN_VERBOSE_DAT_LEN,
+            "fsrc:%s fwei:%s fbia:%s fdst:%s",
+            mkldnn_fmt2str(s->src_pd()->desc()->format),
+            mkldnn_fmt2str(s->weights_pd(0)->desc()->format),
+            mkldnn_fmt2str(fmt_bia),
+            mkldnn_fmt2str(s->dst_pd()->desc()->format));
+
+    snprintf(prb_str, MKLDNN_VERBOSE_PRB_LEN, "b%dm%dn%dk%d",
+            s->batch(), s->M(), s->N(), s->K());
+
+    verbose_templ(buffer, s->kind(), s->name(), prop_kind::forward_inference,
+            dat_str, aux_str, prb_str);
+}
+
+template <typename pd_t> static void init_info_binary(pd_t *s, char *buffer) {
+    DECL_DAT_AUX_PRB_STRS();
+
+    snprintf(dat_str, MKLDNN_VERBOSE_DAT_LEN, "fsrc0:%s fsrc1:%s fdst:%s",
+            mkldnn_fmt2str(s->src_pd(0)->desc()->format),
+            mkldnn_fmt2str(s->src_pd(1)->desc()->format),
+            mkldnn_fmt2str(s->dst_pd()->desc()->format));
+
+    snprintf(aux_str, MKLDNN_VERBOSE_AUX_LEN,
+            "alg:%s", mkldnn_alg_kind2str(s->desc()->alg_kind));
+
+    /* dims of src0 and src1, e.g. 2x64x7x7:1x64x1x1 */
+    const int len = MKLDNN_VERBOSE_PRB_LEN / 2;
+    char src0_str[len], src1_str[len];
+    format_mem_desc_str_generic(src0_str, len, s->src_pd(0)->desc());
+    format_mem_desc_str_generic(src1_str, len, s->src_pd(1)->desc());
+    snprintf(prb_str, MKLDNN_VERBOSE_PRB_LEN, "%s:%s", src0_str, src1_str);
+
+    verbose_templ(buffer, s->kind(), s->name(), prop_kind::forward_inference,
+            dat_str, aux_str, prb_str);
+}
+
 /// @todo print meaningful data
 template <typename pd_t> static void init_info_rnn(pd_t *s, char *buffer) {
     DECL_DAT_AUX_PRB_STRS();
@@ -378,11 +422,13 @@ template <typename pd_t> static void init_info_rnn(pd_t *s, char *buffer) {
     static void CONCAT2(init_info_, name)(pd_t *s, char *buffer) \
     { UNUSED(s); UNUSED(buffer); }
 
+DEFINE_STUB(binary);
 DEFINE_STUB(bnorm);
 DEFINE_STUB(conv);
 DEFINE_STUB(eltwise);
 DEFINE_STUB(iprod);
 DEFINE_STUB(lrn);
+DEFINE_STUB(matmul);
 DEFINE_STUB(mem);
 DEFINE_STUB(pool);
 DEFINE_STUB(softmax);
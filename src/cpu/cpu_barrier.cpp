@@ -103,6 +103,58 @@ void generate(jit_generator &code, Xbyak::Reg64 reg_ctx,
 #    undef BAR_SENSE_OFF
 }
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+void generate(jit_generator_aarch64 &code,
+        const Xbyak::Xbyak_aarch64::XReg &reg_ctx,
+        const Xbyak::Xbyak_aarch64::XReg &reg_nthr,
+        const Xbyak::Xbyak_aarch64::XReg &reg_tmp0,
+        const Xbyak::Xbyak_aarch64::XReg &reg_tmp1,
+        const Xbyak::Xbyak_aarch64::XReg &reg_tmp2) {
+#   define BAR_CTR_OFF offsetof(ctx_t, ctr)
+#   define BAR_SENSE_OFF offsetof(ctx_t, sense)
+    using namespace Xbyak::Xbyak_aarch64;
+
+    const XReg &reg_sense = reg_tmp0;
+    const XReg &reg_sense_addr = reg_tmp1;
+    const XReg &reg_tmp = reg_tmp2;
+
+    LabelAArch64 barrier_exit_label, spin_label;
+
+    code.cmp(reg_nthr, 1);
+    code.b(LS, barrier_exit_label);
+
+    /* take current sense */
+    code.add(reg_sense_addr, reg_ctx, BAR_SENSE_OFF);
+    code.ldr(reg_sense, ptr(reg_sense_addr));
+
+    static_assert(BAR_CTR_OFF == 0, "ctr is addressed without offset");
+    code.mov(reg_tmp, 1);
+    code.ldaddal(reg_tmp, reg_tmp, ptr(reg_ctx));
+    code.add(reg_tmp, reg_tmp, 1);
+    code.cmp(reg_tmp, reg_nthr);
+    code.b(NE, spin_label);
+
+    /* the last thread {{{ */
+    code.str(code.xzr, ptr(reg_ctx)); // reset ctx
+
+    // notify waiting threads, the release store orders the reset before
+    code.mvn(reg_sense, reg_sense);
+    code.stlr(reg_sense, ptr(reg_sense_addr));
+    code.b(barrier_exit_label);
+    /* }}} the last thread */
+
+    code.L_aarch64(spin_label);
+    code.yield();
+    code.ldar(reg_tmp, ptr(reg_sense_addr));
+    code.cmp(reg_tmp, reg_sense);
+    code.b(EQ, spin_label);
+
+    code.L_aarch64(barrier_exit_label);
+#    undef BAR_CTR_OFF
+#    undef BAR_SENSE_OFF
+}
+#endif
+
 /** jit barrier generator */
 struct jit_t: public jit_generator {
     void (*barrier)(ctx_t *ctx, size_t nthr);
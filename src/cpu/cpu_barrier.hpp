@@ -22,6 +22,10 @@
 #include "jit_generator.hpp"
 #include "utils.hpp"
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "jit_generator_aarch64.hpp"
+#endif
+
 namespace mkldnn {
 namespace impl {
 namespace cpu {
@@ -49,6 +53,19 @@ void barrier(ctx_t *ctx, int nthr);
 void generate(jit_generator &code, Xbyak::Reg64 reg_ctx,
         Xbyak::Reg64 reg_nthr);
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+/** same as above for native AArch64 code
+ * @params:
+ *   reg_tmp0, reg_tmp1, reg_tmp2 -- scratch registers, clobbered
+ */
+void generate(jit_generator_aarch64 &code,
+        const Xbyak::Xbyak_aarch64::XReg &reg_ctx,
+        const Xbyak::Xbyak_aarch64::XReg &reg_nthr,
+        const Xbyak::Xbyak_aarch64::XReg &reg_tmp0,
+        const Xbyak::Xbyak_aarch64::XReg &reg_tmp1,
+        const Xbyak::Xbyak_aarch64::XReg &reg_tmp2);
+#endif
+
 }
 
 }
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_BINARY_PD_HPP
+#define CPU_BINARY_PD_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "binary_pd.hpp"
+#include "cpu_engine.hpp"
+#include "cpu_memory.hpp"
+#include "cpu_primitive.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+struct cpu_binary_pd_t: public binary_pd_t {
+    using cpu_memory_pd_t = cpu_memory_t::pd_t;
+
+    cpu_binary_pd_t(engine_t *engine, const binary_desc_t *adesc,
+            const primitive_attr_t *attr, const binary_pd_t *hint_pd)
+        : binary_pd_t(engine, adesc, attr, hint_pd)
+        , src0_pd_(engine_, &desc_.src_desc[0])
+        , src1_pd_(engine_, &desc_.src_desc[1])
+        , dst_pd_(engine_, &desc_.dst_desc) {}
+    virtual ~cpu_binary_pd_t() {}
+
+    virtual const cpu_memory_pd_t *src_pd(int index = 0) const override {
+        if (index == 0) return &src0_pd_;
+        if (index == 1) return &src1_pd_;
+        return nullptr;
+    }
+    virtual const cpu_memory_pd_t *dst_pd(int index = 0) const override
+    { return index == 0 ? &dst_pd_ : nullptr; }
+
+protected:
+    cpu_memory_pd_t src0_pd_, src1_pd_, dst_pd_;
+
+    /* src0 and dst follow each other, any being the plain layout; src1
+     * follows dst unless it is broadcast, then it is plain */
+    virtual status_t set_default_params() {
+        using namespace memory_format;
+        const memory_format_t plain_fmt
+            = utils::pick(ndims() - 1, x, nc, ncw, nchw, ncdhw);
+        if (dst_pd_.desc()->format == any)
+            CHECK(dst_pd_.set_format(src0_pd_.desc()->format == any
+                        ? plain_fmt : src0_pd_.desc()->format));
+        if (src0_pd_.desc()->format == any)
+            CHECK(src0_pd_.set_format(dst_pd_.desc()->format));
+        if (src1_pd_.desc()->format == any)
+            CHECK(src1_pd_.set_format(is_src1_same_dims()
+                        ? dst_pd_.desc()->format : plain_fmt));
+        return status::success;
+    }
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -42,7 +42,8 @@ struct cpu_convolution_fwd_pd_t: public convolution_fwd_pd_t {
         , src_pd_(this->engine_, &this->desc()->src_desc)
         , dst_pd_(this->engine_, &this->desc()->dst_desc)
         , weights_pd_(this->engine_, &this->desc()->weights_desc)
-        , bias_pd_(this->engine_, &this->desc()->bias_desc) {}
+        , bias_pd_(this->engine_, &this->desc()->bias_desc)
+    { init_binary_po_pds(binary_po_pds_, this->engine_, this->attr()); }
     virtual ~cpu_convolution_fwd_pd_t() {}
 
     virtual const cpu_memory_pd_t *src_pd(int index = 0) const override
@@ -54,6 +55,11 @@ struct cpu_convolution_fwd_pd_t: public convolution_fwd_pd_t {
         if (index == 1 && this->with_bias()) return &bias_pd_;
         return nullptr;
     }
+    virtual const cpu_memory_pd_t *binary_po_pd(int index = 0) const override
+    {
+        return index >= 0 && index < (int)binary_po_pds_.size()
+            ? &binary_po_pds_[index] : nullptr;
+    }
 
     bool has_padded_dst() const {
         memory_desc_wrapper dst_d(&dst_pd_);
@@ -78,6 +84,7 @@ struct cpu_convolution_fwd_pd_t: public convolution_fwd_pd_t {
 protected:
     cpu_memory_pd_t src_pd_, dst_pd_;
     cpu_memory_pd_t weights_pd_, bias_pd_;
+    nstl::vector<cpu_memory_pd_t> binary_po_pds_;
 
     inline memory_format_t src_format()
     {
@@ -50,7 +50,13 @@
 #include "cpu/jit_avx512_core_x8s8s32x_1x1_deconvolution.hpp"
 #else // #ifndef DNNL_NATIVE_JIT_AARCH64
 #include "cpu/jit_sve_1x1_convolution.hpp"
+#include "cpu/jit_sve_batch_normalization.hpp"
+#include "cpu/jit_sve_batch_normalization_s8.hpp"
+#include "cpu/jit_sve_softmax.hpp"
+#include "cpu/jit_sve_layer_normalization.hpp"
+#include "cpu/jit_sve_binary.hpp"
 #include "cpu/jit_sve_convolution.hpp"
+#include "cpu/jit_sve_fp32_wino_conv_4x3.hpp"
 #include "cpu/jit_sve_x8s8s32x_1x1_convolution.hpp"
 #include "cpu/jit_sve_x8s8s32x_convolution.hpp"
 #endif // #ifndef DNNL_NATIVE_JIT_AARCH64
@@ -86,10 +92,13 @@
 #include "cpu/ref_batch_normalization.hpp"
 #include "cpu/ncsp_batch_normalization.hpp"
 #include "cpu/nspc_batch_normalization.hpp"
+#include "cpu/ref_layer_normalization.hpp"
+#include "cpu/ref_binary.hpp"
 #include "cpu/ref_inner_product.hpp"
 #include "cpu/gemm_inner_product.hpp"
 #include "cpu/gemm_bf16_inner_product.hpp"
 #include "cpu/gemm_x8s8s32x_inner_product.hpp"
+#include "cpu/gemm_matmul.hpp"
 #include "cpu/jit_uni_dw_convolution.hpp"
 #include "cpu/jit_avx512_core_u8s8s32x_wino_convolution.hpp"
 #include "cpu/jit_avx512_core_fp32_wino_conv_2x3.hpp"
@@ -166,9 +175,13 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_avx2_convolution_bwd_weights_t),
     INSTANCE(jit_sse42_convolution_fwd_t),
 #else // #ifndef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(jit_sve_dw_convolution_fwd_t),
+    INSTANCE(jit_sve_dw_convolution_bwd_data_t),
+    INSTANCE(jit_sve_dw_convolution_bwd_weights_t),
     INSTANCE(jit_sve_1x1_convolution_fwd_f32_t),
     INSTANCE(jit_sve_1x1_convolution_bwd_data_f32_t),
     INSTANCE(jit_sve_1x1_convolution_bwd_weights_t),
+    INSTANCE(jit_sve_fp32_wino_conv_4x3_fwd_t),
     INSTANCE(jit_sve_convolution_fwd_t<f32>),
     INSTANCE(jit_sve_convolution_bwd_data_t<f32>),
     INSTANCE(jit_sve_convolution_bwd_weights_t<f32>),
@@ -320,6 +333,10 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_eltwise_bwd_t<s32>),
     INSTANCE(ref_eltwise_bwd_t<s16>),
     /* softmax */
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(jit_sve_softmax_fwd_t),
+    INSTANCE(jit_sve_softmax_bwd_t),
+#endif // #ifdef DNNL_NATIVE_JIT_AARCH64
     INSTANCE(jit_uni_softmax_fwd_t<avx512_common>),
     INSTANCE(jit_uni_softmax_fwd_t<avx2>),
     INSTANCE(jit_uni_softmax_fwd_t<sse42>),
@@ -382,6 +399,10 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_lrn_fwd_t<bf16>),
     INSTANCE(ref_lrn_bwd_t<bf16>),
     /* batch normalization */
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(jit_sve_batch_normalization_fwd_t),
+    INSTANCE(jit_sve_batch_normalization_bwd_t),
+#endif // #ifdef DNNL_NATIVE_JIT_AARCH64
     INSTANCE(jit_uni_batch_normalization_fwd_t<avx512_common, f32>),
     INSTANCE(jit_uni_batch_normalization_bwd_t<avx512_common, f32>),
 #ifndef __ARM_ARCH
@@ -413,7 +434,22 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_uni_batch_normalization_s8_fwd_t<avx512_core>),
     INSTANCE(jit_uni_batch_normalization_s8_fwd_t<avx2>),
 #endif //#ifndef __ARM_ARCH
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(jit_sve_batch_normalization_s8_fwd_t),
+#endif // #ifdef DNNL_NATIVE_JIT_AARCH64
     INSTANCE(ref_batch_normalization_fwd_t<s8>),
+    /* layer normalization */
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(jit_sve_layer_normalization_fwd_t),
+    INSTANCE(jit_sve_layer_normalization_bwd_t),
+#endif // #ifdef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(ref_layer_normalization_fwd_t),
+    INSTANCE(ref_layer_normalization_bwd_t),
+    /* binary */
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(jit_sve_binary_t),
+#endif // #ifdef DNNL_NATIVE_JIT_AARCH64
+    INSTANCE(ref_binary_t),
     /* inner product */
     INSTANCE(gemm_inner_product_fwd_t<f32>),
     INSTANCE(gemm_inner_product_bwd_data_t<f32>),
@@ -445,6 +481,8 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_inner_product_fwd_t<u8, s8, f32, s32>),
     INSTANCE(ref_inner_product_fwd_t<s16, s16, s32, s32>),
     INSTANCE(ref_inner_product_bwd_data_t<s32, s16, s16, s32>),
+    /* matmul */
+    INSTANCE(gemm_matmul_t),
     /* eol */
     nullptr,
 };
@@ -93,7 +93,8 @@ struct cpu_inner_product_fwd_pd_t: public inner_product_fwd_pd_t {
         : inner_product_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
         , src_pd_(engine_, &desc_.src_desc), dst_pd_(engine_, &desc_.dst_desc)
         , weights_pd_(engine_, &desc_.weights_desc)
-        , bias_pd_(engine_, &desc_.bias_desc) {}
+        , bias_pd_(engine_, &desc_.bias_desc)
+    { init_binary_po_pds(binary_po_pds_, engine_, this->attr()); }
     virtual ~cpu_inner_product_fwd_pd_t() {}
 
     virtual const cpu_memory_pd_t *src_pd(int index = 0) const override
@@ -105,6 +106,11 @@ struct cpu_inner_product_fwd_pd_t: public inner_product_fwd_pd_t {
         if (index == 1 && with_bias()) return &bias_pd_;
         return nullptr;
     }
+    virtual const cpu_memory_pd_t *binary_po_pd(int index = 0) const override
+    {
+        return index >= 0 && index < (int)binary_po_pds_.size()
+            ? &binary_po_pds_[index] : nullptr;
+    }
 
     int IC_total_padded() const {
         auto src_md = memory_desc_wrapper(src_pd());
@@ -119,6 +125,7 @@ struct cpu_inner_product_fwd_pd_t: public inner_product_fwd_pd_t {
 protected:
     cpu_memory_pd_t src_pd_, dst_pd_;
     cpu_memory_pd_t weights_pd_, bias_pd_;
+    nstl::vector<cpu_memory_pd_t> binary_po_pds_;
 
     virtual status_t set_default_params() {
         using namespace memory_format;
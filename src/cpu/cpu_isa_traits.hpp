@@ -50,6 +50,16 @@
 #include "xbyak/xbyak.h"
 #include "xbyak/xbyak_util.h"
 
+#if defined(__ARM_ARCH) && defined(__linux__)
+#include <sys/prctl.h>
+#ifndef PR_SVE_GET_VL
+#define PR_SVE_GET_VL 51
+#endif
+#ifndef PR_SVE_VL_LEN_MASK
+#define PR_SVE_VL_LEN_MASK 0xffff
+#endif
+#endif
+
 namespace mkldnn {
 namespace impl {
 namespace cpu {
@@ -118,8 +128,14 @@ struct cpu_isa_traits<simd> {
 template <> struct cpu_isa_traits<sve> {
     typedef Xbyak::Xbyak_aarch64::ZRegS Vmm;
 	typedef Xbyak::Xbyak_aarch64::AdrScImm uni_ldst_addressing;
+	/* vlen is the 512-bit length the fixed-width kernels (translated code,
+	 * eltwise injector, int8) are written for. SVE allows any multiple of
+	 * 128 bits up to 2048 bits: the length of the running machine is given
+	 * by get_sve_length() and buffers that hold a vector of any machine are
+	 * sized with max_vlen. */
 	static constexpr int vlen_shift = 5;
 	static constexpr int vlen = 64;
+	static constexpr int max_vlen = 256;
 	static constexpr int n_vregs = 32;
 };
 #endif // #ifdef __ARM_ARCH
@@ -181,6 +197,40 @@ static inline bool mayiuse(const cpu_isa_t cpu_isa) {
     return false;
 }
 
+#ifdef __ARM_ARCH
+/* SVE vector length of the running machine in bytes, 0 if SVE is not
+ * available. The value is fixed for the life of the process. */
+static inline int get_sve_length() {
+    static const int sve_length = []() {
+        if (!mayiuse(sve)) return 0;
+#ifdef __linux__
+        int ret = prctl(PR_SVE_GET_VL);
+        if (ret > 0) return ret & PR_SVE_VL_LEN_MASK;
+#endif
+        return cpu_isa_traits<sve>::vlen;
+    }();
+    return sve_length;
+}
+
+/* The jit kernels that follow get_sve_length() are generated for 256-bit
+ * and 512-bit vectors only. On other lengths they are rejected and the
+ * reference implementations are used (MKLDNN_VERBOSE reports it). */
+static inline bool sve_length_supported() {
+    const int len = get_sve_length();
+    return len == 32 || len == 64;
+}
+
+/* log2 of get_sve_length(), used to turn byte offsets into VL multiples */
+static inline int get_sve_length_shift() {
+    static const int shift = [](int len) {
+        int s = 0;
+        while (len > 1) { len >>= 1; s++; }
+        return s;
+    }(get_sve_length());
+    return shift;
+}
+#endif // #ifdef __ARM_ARCH
+
 inline bool isa_has_bf16(cpu_isa_t isa) {
     return isa == avx512_core_bf16;
 }
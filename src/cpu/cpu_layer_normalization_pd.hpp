@@ -0,0 +1,170 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_LAYER_NORMALIZATION_PD_HPP
+#define CPU_LAYER_NORMALIZATION_PD_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "layer_normalization_pd.hpp"
+#include "cpu_engine.hpp"
+#include "cpu_memory.hpp"
+#include "cpu_primitive.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+/* any stands for the dense row major layout, for data and statistics */
+inline status_t ln_set_default_formats(int ndims,
+        cpu_memory_t::pd_t &data_pd, cpu_memory_t::pd_t &stat_pd) {
+    using namespace memory_format;
+    if (data_pd.desc()->format == any)
+        CHECK(data_pd.set_format(
+                    utils::pick(ndims - 2, nc, ncw, nchw, ncdhw)));
+    if (stat_pd.desc()->format == any)
+        CHECK(stat_pd.set_format(utils::pick(ndims - 2, x, nc, ncw, nchw)));
+    return status::success;
+}
+}
+
+struct cpu_layer_normalization_fwd_pd_t: public layer_normalization_fwd_pd_t {
+    using cpu_memory_pd_t = cpu_memory_t::pd_t;
+
+    cpu_layer_normalization_fwd_pd_t(engine_t *engine,
+            const layer_normalization_desc_t *adesc,
+            const primitive_attr_t *attr,
+            const layer_normalization_fwd_pd_t *hint_fwd_pd)
+        : layer_normalization_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+        , data_pd_(engine_, &desc_.data_desc)
+        , mean_pd_(engine_, &desc_.stat_desc)
+        , variance_pd_(engine_, &desc_.stat_desc)
+        , scaleshift_pd_(engine_, &desc_.data_scaleshift_desc) {}
+    virtual ~cpu_layer_normalization_fwd_pd_t() {}
+
+    virtual const cpu_memory_pd_t *src_pd(int index = 0) const override {
+        if (index == 0) return &data_pd_;
+        if (stats_is_src()) {
+            if (index == 1) return &mean_pd_;
+            if (index == 2) return &variance_pd_;
+        }
+        return nullptr;
+    }
+
+    virtual const cpu_memory_pd_t *dst_pd(int index = 0) const override {
+        if (index == 0)  return &data_pd_;
+        if (!stats_is_src() && is_training()) {
+            if (index == 1) return &mean_pd_;
+            if (index == 2) return &variance_pd_;
+        }
+        return nullptr;
+    }
+
+    virtual const cpu_memory_pd_t *weights_pd(int index = 0) const override
+    { return index == 0 ? &scaleshift_pd_ : nullptr; }
+    virtual const cpu_memory_pd_t *stat_pd() const override
+    { return &mean_pd_; }
+
+protected:
+    cpu_memory_pd_t data_pd_;
+    cpu_memory_pd_t mean_pd_;
+    cpu_memory_pd_t variance_pd_;
+    cpu_memory_pd_t scaleshift_pd_;
+
+    virtual status_t set_default_params() {
+        CHECK(ln_set_default_formats(ndims(), data_pd_, mean_pd_));
+        if (variance_pd_.desc()->format == memory_format::any)
+            CHECK(variance_pd_.set_format(mean_pd_.desc()->format));
+        return status::success;
+    }
+
+    virtual status_t init() = 0;
+};
+
+struct cpu_layer_normalization_bwd_pd_t: public layer_normalization_bwd_pd_t {
+    using cpu_memory_pd_t = cpu_memory_t::pd_t;
+
+    cpu_layer_normalization_bwd_pd_t(engine_t *engine,
+            const layer_normalization_desc_t *adesc,
+            const primitive_attr_t *attr,
+            const layer_normalization_fwd_pd_t *hint_fwd_pd)
+        : layer_normalization_bwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+        , data_pd_(engine_, &desc_.data_desc)
+        , mean_pd_(engine_, &desc_.stat_desc)
+        , variance_pd_(engine_, &desc_.stat_desc)
+        , diff_data_pd_(engine_, &desc_.diff_data_desc)
+        , scaleshift_pd_(engine_, &desc_.data_scaleshift_desc)
+        , diff_scaleshift_pd_(engine_, &desc_.diff_data_scaleshift_desc) {}
+    virtual ~cpu_layer_normalization_bwd_pd_t() {}
+
+    virtual const cpu_memory_pd_t *src_pd(int index = 0) const override {
+        if (index == 0) return &data_pd_;
+        if (index == 1) return &mean_pd_;
+        if (index == 2) return &variance_pd_;
+
+        return nullptr;
+    }
+
+    virtual const cpu_memory_pd_t *diff_dst_pd(int index = 0) const override
+    { return index == 0 ? &diff_data_pd_ : nullptr; }
+    virtual const cpu_memory_pd_t *weights_pd(int index = 0) const override
+    { return index == 0 ? &scaleshift_pd_ : nullptr; }
+    virtual const cpu_memory_pd_t *diff_weights_pd(int index = 0) const
+        override {
+        return index == 0 && use_diff_scaleshift()
+            ? &diff_scaleshift_pd_ : nullptr;
+    }
+    virtual const cpu_memory_pd_t *diff_src_pd(int index = 0) const override
+    { return index == 0 ? &diff_data_pd_ : nullptr; }
+    virtual const cpu_memory_pd_t *stat_pd() const override
+    { return &mean_pd_; }
+
+protected:
+    cpu_memory_pd_t data_pd_;
+    cpu_memory_pd_t mean_pd_;
+    cpu_memory_pd_t variance_pd_;
+    cpu_memory_pd_t diff_data_pd_;
+    cpu_memory_pd_t scaleshift_pd_;
+    cpu_memory_pd_t diff_scaleshift_pd_;
+
+    /* diff_src and diff_dst share diff_data_pd_ */
+    virtual status_t set_default_params() {
+        if (data_pd_.desc()->format == memory_format::any
+                && hint_fwd_pd_ != nullptr)
+            CHECK(data_pd_.set_format(
+                        hint_fwd_pd_->src_pd()->desc()->format));
+        CHECK(ln_set_default_formats(ndims(), data_pd_, mean_pd_));
+        if (variance_pd_.desc()->format == memory_format::any)
+            CHECK(variance_pd_.set_format(mean_pd_.desc()->format));
+        if (diff_data_pd_.desc()->format == memory_format::any)
+            CHECK(diff_data_pd_.set_format(data_pd_.desc()->format));
+        return status::success;
+    }
+
+    virtual status_t init() = 0;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_MATMUL_PD_HPP
+#define CPU_MATMUL_PD_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "matmul_pd.hpp"
+#include "cpu_engine.hpp"
+#include "cpu_memory.hpp"
+#include "cpu_primitive.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+struct cpu_matmul_pd_t: public matmul_pd_t {
+    using cpu_memory_pd_t = cpu_memory_t::pd_t;
+
+    cpu_matmul_pd_t(engine_t *engine, const matmul_desc_t *adesc,
+            const primitive_attr_t *attr, const matmul_pd_t *hint_pd)
+        : matmul_pd_t(engine, adesc, attr, hint_pd)
+        , src_pd_(engine_, &desc_.src_desc)
+        , weights_pd_(engine_, &desc_.weights_desc)
+        , bias_pd_(engine_, &desc_.bias_desc)
+        , dst_pd_(engine_, &desc_.dst_desc)
+    { init_binary_po_pds(binary_po_pds_, engine_, this->attr()); }
+    virtual ~cpu_matmul_pd_t() {}
+
+    virtual const cpu_memory_pd_t *src_pd(int index = 0) const override
+    { return index == 0 ? &src_pd_ : nullptr; }
+    virtual const cpu_memory_pd_t *dst_pd(int index = 0) const override
+    { return index == 0 ? &dst_pd_ : nullptr; }
+    virtual const cpu_memory_pd_t *weights_pd(int index = 0) const override {
+        if (index == 0) return &weights_pd_;
+        if (index == 1 && with_bias()) return &bias_pd_;
+        return nullptr;
+    }
+    virtual const cpu_memory_pd_t *binary_po_pd(int index = 0) const override
+    {
+        return index >= 0 && index < (int)binary_po_pds_.size()
+            ? &binary_po_pds_[index] : nullptr;
+    }
+
+protected:
+    cpu_memory_pd_t src_pd_, weights_pd_, bias_pd_, dst_pd_;
+    nstl::vector<cpu_memory_pd_t> binary_po_pds_;
+
+    /* any stands for row major */
+    virtual status_t set_default_params() {
+        using namespace memory_format;
+        const memory_format_t plain_fmt
+            = utils::pick(ndims() - 2, nc, ncw, nchw, ncdhw);
+        if (src_pd_.desc()->format == any)
+            CHECK(src_pd_.set_format(plain_fmt));
+        if (weights_pd_.desc()->format == any)
+            CHECK(weights_pd_.set_format(plain_fmt));
+        if (dst_pd_.desc()->format == any)
+            CHECK(dst_pd_.set_format(plain_fmt));
+        if (bias_pd_.desc()->format == any)
+            CHECK(bias_pd_.set_format(plain_fmt));
+        return status::success;
+    }
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -81,6 +81,17 @@ private:
     mkldnn::impl::status_t typed_zero_pad() const;
 };
 
+/* appends to pds the memory pds of the src1 of the binary post-ops */
+inline void init_binary_po_pds(nstl::vector<cpu_memory_t::pd_t> &pds,
+        engine_t *engine, const primitive_attr_t *attr) {
+    const auto &po = attr->post_ops_;
+    for (int idx = 0; idx < po.len_; ++idx) {
+        if (!po.entry_[idx].is_binary()) continue;
+        pds.push_back(cpu_memory_t::pd_t(engine,
+                    &po.entry_[idx].binary.src1_desc));
+    }
+}
+
 struct cpu_view_t: public cpu_primitive_t {
     struct pd_t: public view_pd_t {
         pd_t(engine_t *engine)
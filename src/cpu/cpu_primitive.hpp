@@ -35,20 +35,24 @@ struct cpu_primitive_t: public primitive_t {
     cpu_primitive_t(const primitive_desc_t *pd, const input_vector &inputs,
             const output_vector &outputs, bool use_global_scratchpad = false)
         : primitive_t(pd, inputs, outputs), scratchpad_buffer_(nullptr)
-        , global_scratchpad_(nullptr)
+        , use_arena_(use_global_scratchpad)
     {
-        size_t scratchpad_size = this->pd()->scratchpad_registry().size();
-        if (use_global_scratchpad)
-            global_scratchpad_ = create_scratchpad(scratchpad_size);
-        else
+        /* primitives with a shareable scratchpad borrow it from the arena of
+         * the executing stream instead of holding one */
+        if (!use_arena_) {
+            size_t scratchpad_size = this->pd()->scratchpad_registry().size();
             scratchpad_buffer_ = malloc(scratchpad_size, 64);
+        }
     }
 
     virtual ~cpu_primitive_t() {
-        delete global_scratchpad_;
         free(scratchpad_buffer_);
     }
 
+    virtual size_t borrowed_scratchpad_size() const override {
+        return use_arena_ ? pd()->scratchpad_registry().size() : 0;
+    }
+
     virtual char *memory(size_t output_index = 0) const {
         if (output_index >= this->outputs().size()) return nullptr;
         auto p = static_cast<const cpu_primitive_t *>(
@@ -73,15 +77,19 @@ struct cpu_primitive_t: public primitive_t {
     const cpu_memory_t *output_memory_primitive(size_t index = 0) const;
 
 protected:
+    /* with an arena the scratchpad is only valid during the execution and
+     * must be queried by the executing thread, outside of parallel sections */
     memory_tracking::grantor_t scratchpad() const {
-        return pd()->scratchpad_registry().grantor(global_scratchpad_
-                ? global_scratchpad_->get() : scratchpad_buffer_);
+        const auto &registry = pd()->scratchpad_registry();
+        return registry.grantor(use_arena_
+                ? current_scratchpad_arena()->get(registry.size())
+                : scratchpad_buffer_);
     }
 
 private:
     /* quite ugly, but luckily both will get away in v1.0 */
     void *scratchpad_buffer_;
-    scratchpad_t *global_scratchpad_;
+    bool use_arena_;
 };
 
 }
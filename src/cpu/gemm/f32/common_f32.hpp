@@ -18,6 +18,9 @@
 #define COMMON_F32_HPP
 
 #include "jit_generator.hpp"
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "jit_generator_aarch64.hpp"
+#endif
 
 #ifdef DNNL_INDIRECT_JIT_AARCH64
 #define F32_COPY_KERNEL_CODE_SIZE          (4096L * 10 * 100)
@@ -85,6 +88,38 @@ class jit_avx2_f32_copy_bt_kern : public jit_generator {
         jit_avx2_f32_copy_bt_kern();
 };
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+/* Copy routines packing f32 matrices for jit_sve_kernel_sgemm_kern. The
+ * packed formats are described along with the compute kernel. */
+class jit_sve_f32_copy_an_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_f32_copy_an_kern);
+
+    public:
+        jit_sve_f32_copy_an_kern();
+};
+
+class jit_sve_f32_copy_at_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_f32_copy_at_kern);
+
+    public:
+        jit_sve_f32_copy_at_kern();
+};
+
+class jit_sve_f32_copy_bn_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_f32_copy_bn_kern);
+
+    public:
+        jit_sve_f32_copy_bn_kern();
+};
+
+class jit_sve_f32_copy_bt_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_f32_copy_bt_kern);
+
+    public:
+        jit_sve_f32_copy_bt_kern();
+};
+#endif // #ifdef DNNL_NATIVE_JIT_AARCH64
+
 }
 }
 }
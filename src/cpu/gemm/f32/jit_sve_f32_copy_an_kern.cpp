@@ -0,0 +1,125 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "common_f32.hpp"
+#include "jit_generator.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Packs a column-major (non-transposed) block of A. Every panel holds up to
+ * three vectors of rows for each k; the m tail is stored compactly. */
+jit_sve_f32_copy_an_kern::jit_sve_f32_copy_an_kern() :
+    jit_generator_aarch64(nullptr, F32_COPY_KERNEL_CODE_SIZE) {
+
+    const XReg M = x8; // number of k
+    const XReg N = x9; // number of rows
+    const XReg A = x2;
+    const XReg LDA = x10;
+    const XReg B = x5;
+
+    const XReg A1 = x11;
+    const XReg I = x12;
+    const XReg VL = x13;
+    const XReg VL2 = x14;
+    const XReg UM = x15;
+    const XReg UM_BYTES = x16;
+    const XReg TAIL_BYTES = x17;
+
+    const PReg p_all = p0;
+    const ZRegS z_alpha = z31.s;
+
+    auto copy_panel = [&](int nv, bool is_tail) {
+        LabelAArch64 loop, done;
+
+        mov(A1, A);
+        mov(I, M);
+        cbz(I, done);
+        L_aarch64(loop);
+        for (int i = 0; i < nv; i++) {
+            PReg p = is_tail ? PReg(1 + i) : p_all;
+            ld1w(ZRegS(i), p / T_z, ptr(A1, i, MUL_VL));
+            fmul(ZRegS(i), ZRegS(i), z_alpha);
+            st1w(ZRegS(i), p, ptr(B, i, MUL_VL));
+        }
+        if (is_tail)
+            add(B, B, TAIL_BYTES);
+        else
+            addvl(B, B, nv);
+        add(A1, A1, LDA);
+        subs(I, I, 1);
+        b(NE, loop);
+        L_aarch64(done);
+    };
+
+    LabelAArch64 m_loop, m_tail, m_tail_2, m_tail_3, end_label;
+
+    preamble();
+
+    ldr(M, ptr(x0));
+    ldr(N, ptr(x1));
+    ldr(LDA, ptr(x3));
+    lsl(LDA, LDA, 2);
+
+    ptrue(p_all.s);
+    ld1rw(z_alpha, p_all, ptr(x4));
+
+    cntw(VL);
+    lsl(VL2, VL, 1);
+    add(UM, VL2, VL);
+    lsl(UM_BYTES, UM, 2);
+
+    L_aarch64(m_loop);
+    cmp(N, UM);
+    b(LT, m_tail);
+    copy_panel(3, false);
+    add(A, A, UM_BYTES);
+    sub(N, N, UM);
+    b(m_loop);
+
+    L_aarch64(m_tail);
+    cbz(N, end_label);
+    lsl(TAIL_BYTES, N, 2);
+    whilelt(PRegS(1), xzr, N);
+    whilelt(PRegS(2), VL, N);
+    whilelt(PRegS(3), VL2, N);
+    cmp(N, VL2);
+    b(GT, m_tail_3);
+    cmp(N, VL);
+    b(GT, m_tail_2);
+    copy_panel(1, true);
+    b(end_label);
+
+    L_aarch64(m_tail_2);
+    copy_panel(2, true);
+    b(end_label);
+
+    L_aarch64(m_tail_3);
+    copy_panel(3, true);
+
+    L_aarch64(end_label);
+    postamble();
+
+    ready();
+}
+
+}
+}
+}
@@ -0,0 +1,135 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "common_f32.hpp"
+#include "jit_generator.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Packs a row-major (transposed) block of A into the same layout as
+ * jit_sve_f32_copy_an_kern. The rows of one vector are lda apart in memory,
+ * so they are collected with a gather load. */
+jit_sve_f32_copy_at_kern::jit_sve_f32_copy_at_kern() :
+    jit_generator_aarch64(nullptr, F32_COPY_KERNEL_CODE_SIZE) {
+
+    const XReg M = x8; // number of k
+    const XReg N = x9; // number of rows
+    const XReg A = x2;
+    const XReg LDA = x10;
+    const XReg B = x5;
+
+    const XReg A1 = x11;
+    const XReg I = x12;
+    const XReg VL = x13;
+    const XReg VL2 = x14;
+    const XReg UM = x15;
+    const XReg UM_STRIDE = x16;
+    const XReg TAIL_BYTES = x17;
+    const XReg VEC_STRIDE = x20;
+    const XReg A2 = x19;
+
+    const PReg p_all = p0;
+    const ZRegS z_alpha = z31.s;
+    const ZRegS z_idx = z30.s;
+
+    auto copy_panel = [&](int nv, bool is_tail) {
+        LabelAArch64 loop, done;
+
+        mov(A1, A);
+        mov(I, M);
+        cbz(I, done);
+        L_aarch64(loop);
+        mov(A2, A1);
+        for (int i = 0; i < nv; i++) {
+            PReg p = is_tail ? PReg(1 + i) : p_all;
+            ld1w(ZRegS(i), p / T_z, ptr(A2, z_idx, UXTW, 2));
+            fmul(ZRegS(i), ZRegS(i), z_alpha);
+            st1w(ZRegS(i), p, ptr(B, i, MUL_VL));
+            if (i < nv - 1)
+                add(A2, A2, VEC_STRIDE);
+        }
+        if (is_tail)
+            add(B, B, TAIL_BYTES);
+        else
+            addvl(B, B, nv);
+        add(A1, A1, 4);
+        subs(I, I, 1);
+        b(NE, loop);
+        L_aarch64(done);
+    };
+
+    LabelAArch64 m_loop, m_tail, m_tail_2, m_tail_3, end_label;
+
+    preamble();
+
+    ldr(M, ptr(x0));
+    ldr(N, ptr(x1));
+    ldr(LDA, ptr(x3));
+
+    ptrue(p_all.s);
+    ld1rw(z_alpha, p_all, ptr(x4));
+    /* element offsets of the rows held by one vector: 0, lda, 2 * lda, ... */
+    index(z_idx, 0, WReg(LDA.getIdx()));
+    lsl(LDA, LDA, 2);
+
+    cntw(VL);
+    lsl(VL2, VL, 1);
+    add(UM, VL2, VL);
+    mul(VEC_STRIDE, VL, LDA);
+    mul(UM_STRIDE, UM, LDA);
+
+    L_aarch64(m_loop);
+    cmp(N, UM);
+    b(LT, m_tail);
+    copy_panel(3, false);
+    add(A, A, UM_STRIDE);
+    sub(N, N, UM);
+    b(m_loop);
+
+    L_aarch64(m_tail);
+    cbz(N, end_label);
+    lsl(TAIL_BYTES, N, 2);
+    whilelt(PRegS(1), xzr, N);
+    whilelt(PRegS(2), VL, N);
+    whilelt(PRegS(3), VL2, N);
+    cmp(N, VL2);
+    b(GT, m_tail_3);
+    cmp(N, VL);
+    b(GT, m_tail_2);
+    copy_panel(1, true);
+    b(end_label);
+
+    L_aarch64(m_tail_2);
+    copy_panel(2, true);
+    b(end_label);
+
+    L_aarch64(m_tail_3);
+    copy_panel(3, true);
+
+    L_aarch64(end_label);
+    postamble();
+
+    ready();
+}
+
+}
+}
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "common_f32.hpp"
+#include "jit_generator.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Packs a column-major (non-transposed) block of B into panels of up to
+ * eight columns stored k-major. Each column is read one vector of k at a
+ * time and scattered into the panel with a stride of the panel width. */
+jit_sve_f32_copy_bn_kern::jit_sve_f32_copy_bn_kern() :
+    jit_generator_aarch64(nullptr, F32_COPY_KERNEL_CODE_SIZE) {
+
+    const int unroll_n = 8;
+
+    const XReg M = x8; // number of k
+    const XReg N = x9; // number of columns
+    const XReg A = x2;
+    const XReg LDA = x10;
+    const XReg B = x5;
+
+    const XReg W = x11; // width of the current panel
+    const XReg J = x12;
+    const XReg A1 = x13;
+    const XReg B1 = x14;
+    const XReg A2 = x15;
+    const XReg B2 = x16;
+    const XReg KK = x17;
+    const XReg VEC_STRIDE = x19;
+    const XReg PANEL_BYTES = x20;
+
+    const PReg p_all = p0;
+    const PReg p_k = p1;
+    const ZRegS z_alpha = z31.s;
+    const ZRegS z_idx = z30.s;
+
+    LabelAArch64 n_loop, n_width_done, col_loop, k_loop, k_done, end_label;
+
+    preamble();
+
+    ldr(M, ptr(x0));
+    ldr(N, ptr(x1));
+    ldr(LDA, ptr(x3));
+    lsl(LDA, LDA, 2);
+
+    ptrue(p_all.s);
+    ld1rw(z_alpha, p_all, ptr(x4));
+
+    L_aarch64(n_loop);
+    cbz(N, end_label);
+    mov(W, unroll_n);
+    cmp(N, W);
+    b(GE, n_width_done);
+    mov(W, N);
+    L_aarch64(n_width_done);
+
+    /* k-th element of a column lands at k * W in the panel */
+    index(z_idx, 0, WReg(W.getIdx()));
+    cntw(VEC_STRIDE);
+    mul(VEC_STRIDE, VEC_STRIDE, W);
+    lsl(VEC_STRIDE, VEC_STRIDE, 2);
+
+    mov(A1, A);
+    mov(B1, B);
+    mov(J, W);
+    L_aarch64(col_loop);
+    {
+        mov(A2, A1);
+        mov(B2, B1);
+        mov(KK, xzr);
+        L_aarch64(k_loop);
+        cmp(KK, M);
+        b(GE, k_done);
+        whilelt(p_k.s, KK, M);
+        ld1w(z0.s, p_k / T_z, ptr(A2));
+        fmul(z0.s, z0.s, z_alpha);
+        st1w(z0.s, p_k, ptr(B2, z_idx, UXTW, 2));
+        addvl(A2, A2, 1);
+        add(B2, B2, VEC_STRIDE);
+        incw(KK);
+        b(k_loop);
+        L_aarch64(k_done);
+
+        add(A1, A1, LDA);
+        add(B1, B1, 4);
+        subs(J, J, 1);
+        b(NE, col_loop);
+    }
+
+    /* move to the next panel */
+    mul(PANEL_BYTES, M, W);
+    add(B, B, PANEL_BYTES, LSL, 2);
+    mov(A, A1);
+    sub(N, N, W);
+    b(n_loop);
+
+    L_aarch64(end_label);
+    postamble();
+
+    ready();
+}
+
+}
+}
+}
@@ -0,0 +1,107 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "common_f32.hpp"
+#include "jit_generator.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Packs a row-major (transposed) block of B into panels of up to eight
+ * columns stored k-major. A panel row is contiguous in the source, so it is
+ * moved with two predicated vectors, which also covers 128-bit SVE. */
+jit_sve_f32_copy_bt_kern::jit_sve_f32_copy_bt_kern() :
+    jit_generator_aarch64(nullptr, F32_COPY_KERNEL_CODE_SIZE) {
+
+    const int unroll_n = 8;
+
+    const XReg M = x8; // number of k
+    const XReg N = x9; // number of columns
+    const XReg A = x2;
+    const XReg LDA = x10;
+    const XReg B = x5;
+
+    const XReg W = x11; // width of the current panel
+    const XReg I = x12;
+    const XReg A1 = x13;
+    const XReg VL = x14;
+    const XReg W_BYTES = x15;
+
+    const PReg p_all = p0;
+    const PReg p_lo = p1;
+    const PReg p_hi = p2;
+    const ZRegS z_alpha = z31.s;
+
+    LabelAArch64 n_loop, n_width_done, k_loop, k_done, end_label;
+
+    preamble();
+
+    ldr(M, ptr(x0));
+    ldr(N, ptr(x1));
+    ldr(LDA, ptr(x3));
+    lsl(LDA, LDA, 2);
+
+    ptrue(p_all.s);
+    ld1rw(z_alpha, p_all, ptr(x4));
+    cntw(VL);
+
+    L_aarch64(n_loop);
+    cbz(N, end_label);
+    mov(W, unroll_n);
+    cmp(N, W);
+    b(GE, n_width_done);
+    mov(W, N);
+    L_aarch64(n_width_done);
+
+    whilelt(p_lo.s, xzr, W);
+    whilelt(p_hi.s, VL, W);
+    lsl(W_BYTES, W, 2);
+
+    mov(A1, A);
+    mov(I, M);
+    cbz(I, k_done);
+    L_aarch64(k_loop);
+    {
+        ld1w(z0.s, p_lo / T_z, ptr(A1));
+        ld1w(z1.s, p_hi / T_z, ptr(A1, 1, MUL_VL));
+        fmul(z0.s, z0.s, z_alpha);
+        fmul(z1.s, z1.s, z_alpha);
+        st1w(z0.s, p_lo, ptr(B));
+        st1w(z1.s, p_hi, ptr(B, 1, MUL_VL));
+        add(A1, A1, LDA);
+        add(B, B, W_BYTES);
+        subs(I, I, 1);
+        b(NE, k_loop);
+    }
+    L_aarch64(k_done);
+
+    add(A, A, W_BYTES);
+    sub(N, N, W);
+    b(n_loop);
+
+    L_aarch64(end_label);
+    postamble();
+
+    ready();
+}
+
+}
+}
+}
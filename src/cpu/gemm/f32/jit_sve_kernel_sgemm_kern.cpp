@@ -0,0 +1,204 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "jit_sve_kernel_sgemm_kern.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* One k-step of the micro-kernel: nv vectors of A against un broadcast
+ * elements of B. k_idx selects the position inside the unrolled k-loop.
+ * The m-tail panel of A is packed compactly, so it is read with the tail
+ * predicates and the pointer is moved after every step. */
+void jit_sve_kernel_sgemm_kern::kernel_loop_body(
+        int nv, int un, int k_idx, bool is_m_tail) {
+    for (int i = 0; i < nv; i++) {
+        if (is_m_tail)
+            ld1w(ZRegS(a_idx(i)), PReg(1 + i) / T_z,
+                    ptr(reg_ao, i, MUL_VL));
+        else
+            ldr(ZReg(a_idx(i)), ptr(reg_ao, k_idx * nv + i, MUL_VL));
+    }
+    if (is_m_tail)
+        add(reg_ao, reg_ao, reg_m_tail_bytes);
+
+    for (int j = 0; j < un; j++) {
+        ld1rw(ZRegS(b_idx(j)), reg_p_all,
+                ptr(reg_bo, static_cast<int32_t>((k_idx * un + j) * 4)));
+        for (int i = 0; i < nv; i++)
+            fmla(ZRegS(acc_idx(i, j)), reg_p_all, ZRegS(a_idx(i)),
+                    ZRegS(b_idx(j)));
+    }
+}
+
+void jit_sve_kernel_sgemm_kern::compute_block(
+        int nv, int un, bool is_m_tail) {
+    LabelAArch64 unroll_loop, tail_loop, tail_label, store_label;
+
+    for (int j = 0; j < un; j++)
+        for (int i = 0; i < nv; i++)
+            eor(ZRegD(acc_idx(i, j)), ZRegD(acc_idx(i, j)),
+                    ZRegD(acc_idx(i, j)));
+
+    mov(reg_bo, reg_b);
+
+    lsr(reg_kk, reg_k, 2);
+    cbz(reg_kk, tail_label);
+    L_aarch64(unroll_loop);
+    {
+        prfm(PLDL1KEEP, ptr(reg_ao, 1024));
+        for (int k_idx = 0; k_idx < unroll_k_; k_idx++)
+            kernel_loop_body(nv, un, k_idx, is_m_tail);
+        if (!is_m_tail)
+            addvl(reg_ao, reg_ao, unroll_k_ * nv);
+        add_imm(reg_bo, reg_bo, unroll_k_ * un * 4, reg_tmp);
+        subs(reg_kk, reg_kk, 1);
+        b(NE, unroll_loop);
+    }
+
+    L_aarch64(tail_label);
+    and_(reg_kk, reg_k, unroll_k_ - 1);
+    cbz(reg_kk, store_label);
+    L_aarch64(tail_loop);
+    {
+        kernel_loop_body(nv, un, 0, is_m_tail);
+        if (!is_m_tail)
+            addvl(reg_ao, reg_ao, nv);
+        add_imm(reg_bo, reg_bo, un * 4, reg_tmp);
+        subs(reg_kk, reg_kk, 1);
+        b(NE, tail_loop);
+    }
+
+    L_aarch64(store_label);
+    mov(reg_co_j, reg_co);
+    for (int j = 0; j < un; j++) {
+        for (int i = 0; i < nv; i++) {
+            /* p1 - p3 hold the m-tail masks of the three vectors */
+            PReg p_store = is_m_tail ? PReg(1 + i) : reg_p_all;
+            if (!beta_zero_) {
+                ld1w(ZRegS(a_idx(i)), p_store / T_z,
+                        ptr(reg_co_j, i, MUL_VL));
+                fadd(ZRegS(acc_idx(i, j)), ZRegS(acc_idx(i, j)),
+                        ZRegS(a_idx(i)));
+            }
+            st1w(ZRegS(acc_idx(i, j)), p_store, ptr(reg_co_j, i, MUL_VL));
+        }
+        if (j < un - 1)
+            add(reg_co_j, reg_co_j, reg_ldc);
+    }
+}
+
+/* Walks all the A panels against one (possibly narrow) panel of B. */
+void jit_sve_kernel_sgemm_kern::n_panel(int un) {
+    LabelAArch64 m_loop, m_tail, m_tail_2, m_tail_3, done;
+
+    mov(reg_ao, reg_a);
+    mov(reg_co, reg_c);
+    mov(reg_i, reg_m);
+
+    L_aarch64(m_loop);
+    cmp(reg_i, reg_um);
+    b(LT, m_tail);
+    compute_block(unroll_m_reg_, un, false);
+    add(reg_co, reg_co, reg_um_bytes);
+    sub(reg_i, reg_i, reg_um);
+    b(m_loop);
+
+    L_aarch64(m_tail);
+    cbz(reg_i, done);
+    lsl(reg_m_tail_bytes, reg_i, 2);
+    whilelt(PRegS(1), xzr, reg_i);
+    whilelt(PRegS(2), reg_vl, reg_i);
+    whilelt(PRegS(3), reg_vl2, reg_i);
+    cmp(reg_i, reg_vl2);
+    b(GT, m_tail_3);
+    cmp(reg_i, reg_vl);
+    b(GT, m_tail_2);
+    compute_block(1, un, true);
+    b(done);
+
+    L_aarch64(m_tail_2);
+    compute_block(2, un, true);
+    b(done);
+
+    L_aarch64(m_tail_3);
+    compute_block(3, un, true);
+
+    L_aarch64(done);
+}
+
+void jit_sve_kernel_sgemm_kern::generate() {
+    LabelAArch64 n_loop, n_tail, end_label;
+    LabelAArch64 n_tail_labels[unroll_n_];
+
+    preamble();
+
+    ldr(reg_m, ptr(x0));
+    ldr(reg_n, ptr(x1));
+    ldr(reg_k, ptr(x2));
+    lsl(reg_ldc, reg_ldc, 2);
+
+    ptrue(reg_p_all.s);
+
+    /* The panel height follows the vector length of the machine. */
+    cntw(reg_vl);
+    lsl(reg_vl2, reg_vl, 1);
+    add(reg_um, reg_vl2, reg_vl);
+    lsl(reg_um_bytes, reg_um, 2);
+
+    /* Distance between two consecutive full panels of B and C */
+    lsl(reg_b_stride, reg_k, 5); // k * unroll_n_ * sizeof(float)
+    lsl(reg_c_stride, reg_ldc, 3); // ldc * unroll_n_
+
+    mov(reg_j, reg_n);
+    L_aarch64(n_loop);
+    cmp(reg_j, unroll_n_);
+    b(LT, n_tail);
+    n_panel(unroll_n_);
+    add(reg_b, reg_b, reg_b_stride);
+    add(reg_c, reg_c, reg_c_stride);
+    sub(reg_j, reg_j, unroll_n_);
+    b(n_loop);
+
+    L_aarch64(n_tail);
+    for (int un = unroll_n_ - 1; un > 0; un--) {
+        cmp(reg_j, un);
+        b(EQ, n_tail_labels[un]);
+    }
+    b(end_label);
+
+    for (int un = unroll_n_ - 1; un > 0; un--) {
+        L_aarch64(n_tail_labels[un]);
+        n_panel(un);
+        b(end_label);
+    }
+
+    L_aarch64(end_label);
+    postamble();
+}
+
+jit_sve_kernel_sgemm_kern::jit_sve_kernel_sgemm_kern(bool beta_zero)
+    : jit_generator_aarch64(nullptr, 256 * 1024), beta_zero_(beta_zero) {
+    generate();
+    ready();
+}
+
+}
+}
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_KERNEL_SGEMM_KERN_HPP
+#define JIT_SVE_KERNEL_SGEMM_KERN_HPP
+
+#include "jit_generator.hpp"
+#include "jit_generator_aarch64.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* SVE sgemm micro-kernel working on the buffers packed by the
+ * jit_sve_f32_copy_*_kern routines.
+ *
+ * Packed A is a sequence of panels of unroll_m_reg_ vectors (um rows), each
+ * stored k-major. The last panel holds the m tail compactly, i.e. only the
+ * remaining rows are stored for every k.
+ * Packed B is a sequence of panels of unroll_n_ columns stored k-major; the
+ * last panel is compacted to the n tail width.
+ *
+ * The kernel computes C = A * B (beta == 0) or C += A * B, alpha has
+ * already been applied by the copy routine of A. */
+class jit_sve_kernel_sgemm_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_kernel_sgemm_kern);
+
+public:
+    enum {
+        unroll_m_reg_ = 3,
+        unroll_n_ = 8,
+        unroll_k_ = 4,
+    };
+
+    jit_sve_kernel_sgemm_kern(bool beta_zero);
+
+private:
+    using xreg_t = const Xbyak::Xbyak_aarch64::XReg;
+    using preg_t = const Xbyak::Xbyak_aarch64::PReg;
+
+    bool beta_zero_;
+
+    xreg_t reg_m = x8;
+    xreg_t reg_n = x9;
+    xreg_t reg_k = x10;
+    xreg_t reg_a = x4;
+    xreg_t reg_b = x5;
+    xreg_t reg_c = x6;
+    xreg_t reg_ldc = x7;
+
+    xreg_t reg_ao = x11;
+    xreg_t reg_bo = x12;
+    xreg_t reg_co = x13;
+    xreg_t reg_i = x14;
+    xreg_t reg_j = x15;
+    xreg_t reg_kk = x16;
+    xreg_t reg_co_j = x17;
+    xreg_t reg_vl = x19;
+    xreg_t reg_vl2 = x20;
+    xreg_t reg_um = x21;
+    xreg_t reg_um_bytes = x22;
+    xreg_t reg_b_stride = x23;
+    xreg_t reg_c_stride = x24;
+    xreg_t reg_tmp = x25;
+    xreg_t reg_m_tail_bytes = x26;
+
+    preg_t reg_p_all = p0;
+
+    /* z0 - z23 : accumulators, z24 - z26 : A, z27 - z31 : B broadcasts */
+    int acc_idx(int i, int j) const { return j * unroll_m_reg_ + i; }
+    int a_idx(int i) const { return 24 + i; }
+    int b_idx(int j) const { return 27 + j % 5; }
+
+    void kernel_loop_body(int nv, int un, int k_idx, bool is_m_tail);
+    void compute_block(int nv, int un, bool is_m_tail);
+    void n_panel(int un);
+    void generate();
+};
+
+}
+}
+}
+
+#endif // JIT_SVE_KERNEL_SGEMM_KERN_HPP
@@ -28,6 +28,7 @@
 #include "f32/ref_gemm_f32.hpp"
 
 #include "gemm_driver.hpp"
+#include "gemm_info.hpp"
 #include "s8x8s32/ref_gemm_s8x8s32.hpp"
 #include "s8x8s32/simple_gemm_s8s8s32.hpp"
 
@@ -120,6 +121,28 @@ mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
     }
 #endif
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    if (use_sve_gemm_kernels()) {
+        float *dummy_ao = NULL;
+        float *dummy_bo = NULL;
+
+        // The SVE kernels have no bias support, so bias is added afterwards.
+        status = gemm_driver(transa, transb, NULL, M, N, K, alpha,
+                A, lda, dummy_ao, B, ldb, dummy_bo, beta, C, ldc,
+                (float *) NULL, false);
+        if (status != mkldnn_success || !bias)
+            return status;
+
+        parallel_nd(*N, [&](int n) {
+            float *c_n = C + (ptrdiff_t)n * (*ldc);
+            PRAGMA_OMP_SIMD()
+            for (int m = 0; m < *M; m++)
+                c_n[m] += bias[m];
+        });
+        return mkldnn_success;
+    }
+#endif
+
 #ifndef __ARM_ARCH
     if (mayiuse(avx512_mic)) {
         return jit_avx512_common_gemm_f32(transa, transb,
@@ -184,7 +207,7 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
     if (status == mkldnn_success)
         return status;
 
-    if (mayiuse(avx512_core))
+    if (mayiuse(avx512_core) || use_sve_gemm_kernels())
         status = gemm_driver(transa, transb, offsetc, M, N, K,
                 alpha, A, LDA, ao, B, LDB, bo, beta, C, LDC, co, false);
     else
@@ -208,9 +231,9 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
     if (*M == 0 || *N == 0 || *K == 0)
         return mkldnn_success;
 
-    bool use_jit = true
+    bool use_jit = use_sve_gemm_kernels() || (true
         && mayiuse(avx512_core)
-        && ((*M) * (*N) > 1); // TODO: handle s8-case in gemv
+        && ((*M) * (*N) > 1)); // TODO: handle s8-case in gemv
 
     bool use_s8u8 = true
         && utils::everyone_is(0, *ao, *bo) // so far a requirement
@@ -229,6 +252,109 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
     return status;
 }
 
+bool pack_gemm_available(data_type_t a_dt) {
+    switch (a_dt) {
+    case data_type::f32: return use_sve_gemm_kernels() || mayiuse(avx2);
+    case data_type::s8: return use_sve_gemm_kernels() || mayiuse(avx512_core);
+    default: return false;
+    }
+}
+
+size_t sgemm_pack_get_size(const int *M, const int *N, const int *K) {
+    if (!pack_gemm_available(data_type::f32))
+        return 0;
+    return gemm_pack_get_size_driver<float, float, float>(M, N, K);
+}
+
+mkldnn_status_t sgemm_pack(const char *transa, const int *M, const int *N,
+        const int *K, const float *A, const int *lda, void *packed_A) {
+    if (utils::any_null(transa, M, N, K, A, lda, packed_A))
+        return mkldnn_invalid_arguments;
+    if (!pack_gemm_available(data_type::f32))
+        return mkldnn_unimplemented;
+    return gemm_pack_driver<float, float, float>(
+            transa, M, N, K, A, lda, packed_A);
+}
+
+mkldnn_status_t sgemm_compute(const char *transb, const int *M,
+        const int *N, const int *K, const void *packed_A, const float *B,
+        const int *ldb, const float *beta, float *C, const int *ldc) {
+    if (utils::any_null(M, packed_A))
+        return mkldnn_invalid_arguments;
+    const float one = 1.0f;
+    const int lda = nstl::max(*M, 1);
+    mkldnn_status_t status = check_gemm_input("N", transb, M, N, K, &lda,
+            ldb, ldc, &one, beta, false);
+    if (status != mkldnn_success)
+        return status;
+    if (!pack_gemm_available(data_type::f32))
+        return mkldnn_unimplemented;
+    return gemm_compute_driver<float, float, float>(
+            transb, M, N, K, packed_A, B, ldb, beta, C, ldc);
+}
+
+bool implicit_sgemm_available() {
+    return use_sve_gemm_kernels();
+}
+
+size_t sgemm_implicit_a_ws_size(const int *M, const int *N, const int *K) {
+    if (!implicit_sgemm_available())
+        return 0;
+    return sgemm_implicit_a_ws_size_driver(M, N, K);
+}
+
+mkldnn_status_t sgemm_implicit_a(const char *transb, const int *M,
+        const int *N, const int *K, sgemm_pack_a_t pack_a, const void *ctx,
+        const float *B, const int *ldb, const float *beta, float *C,
+        const int *ldc, void *ws) {
+    if (utils::any_null(M, pack_a))
+        return mkldnn_invalid_arguments;
+    const float one = 1.0f;
+    const int lda = nstl::max(*M, 1);
+    mkldnn_status_t status = check_gemm_input("N", transb, M, N, K, &lda,
+            ldb, ldc, &one, beta, false);
+    if (status != mkldnn_success)
+        return status;
+    if (!implicit_sgemm_available())
+        return mkldnn_unimplemented;
+    return sgemm_implicit_a_driver(transb, M, N, K, pack_a, ctx, B, ldb, beta,
+            C, ldc, ws);
+}
+
+size_t gemm_s8u8s32_pack_get_size(const int *M, const int *N, const int *K) {
+    if (!pack_gemm_available(data_type::s8))
+        return 0;
+    return gemm_pack_get_size_driver<int8_t, uint8_t, int32_t>(M, N, K);
+}
+
+mkldnn_status_t gemm_s8u8s32_pack(const char *transa, const int *M,
+        const int *N, const int *K, const int8_t *A, const int *lda,
+        void *packed_A) {
+    if (utils::any_null(transa, M, N, K, A, lda, packed_A))
+        return mkldnn_invalid_arguments;
+    if (!pack_gemm_available(data_type::s8))
+        return mkldnn_unimplemented;
+    return gemm_pack_driver<int8_t, uint8_t, int32_t>(
+            transa, M, N, K, A, lda, packed_A);
+}
+
+mkldnn_status_t gemm_s8u8s32_compute(const char *transb, const int *M,
+        const int *N, const int *K, const void *packed_A, const uint8_t *B,
+        const int *ldb, const float *beta, int32_t *C, const int *ldc) {
+    if (utils::any_null(M, packed_A))
+        return mkldnn_invalid_arguments;
+    const float one = 1.0f;
+    const int lda = nstl::max(*M, 1);
+    mkldnn_status_t status = check_gemm_input("N", transb, M, N, K, &lda,
+            ldb, ldc, &one, beta, false);
+    if (status != mkldnn_success)
+        return status;
+    if (!pack_gemm_available(data_type::s8))
+        return mkldnn_unimplemented;
+    return gemm_compute_driver<int8_t, uint8_t, int32_t>(
+            transb, M, N, K, packed_A, B, ldb, beta, C, ldc);
+}
+
 }
 }
 }
@@ -18,7 +18,9 @@
 #define GEMM_HPP
 
 #include "mkldnn_types.h"
+#include "c_types_map.hpp"
 #include "os_blas.hpp"
+#include "gemm_driver.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -37,6 +39,45 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
         const b_dt *B, const int *ldb, const int8_t *bo, const float *beta,
         int32_t *c, const int *ldc, const int32_t *co);
 
+/* Pack-once / compute-many gemm for weights that are reused across many
+ * calls (e.g. RNN). A is packed once, every compute call then performs
+ * C = A * B + beta * C in column major order without copying A again.
+ * alpha is fixed to 1 and integer gemm has no offsets. */
+bool pack_gemm_available(data_type_t a_dt);
+
+size_t sgemm_pack_get_size(const int *M, const int *N, const int *K);
+mkldnn_status_t sgemm_pack(const char *transa, const int *M, const int *N,
+        const int *K, const float *A, const int *lda, void *packed_A);
+mkldnn_status_t sgemm_compute(const char *transb, const int *M,
+        const int *N, const int *K, const void *packed_A, const float *B,
+        const int *ldb, const float *beta, float *C, const int *ldc);
+
+size_t gemm_s8u8s32_pack_get_size(const int *M, const int *N, const int *K);
+mkldnn_status_t gemm_s8u8s32_pack(const char *transa, const int *M,
+        const int *N, const int *K, const int8_t *A, const int *lda,
+        void *packed_A);
+mkldnn_status_t gemm_s8u8s32_compute(const char *transb, const int *M,
+        const int *N, const int *K, const void *packed_A, const uint8_t *B,
+        const int *ldb, const float *beta, int32_t *C, const int *ldc);
+
+/* Implicit gemm for operands that are cheaper to form than to store, e.g.
+ * the im2col matrix of a convolution: C = A * B + beta * C in column major
+ * order, with the panels of A written by pack_a (see sgemm_pack_a_t).
+ * alpha is fixed to 1 and A is not transposed.
+ *
+ * ws holds the packing buffers: sgemm_implicit_a_ws_size() bytes (good for
+ * any M' <= M, N' <= N, K' <= K) for each thread of the call, that is one
+ * inside a parallel region and mkldnn_get_max_threads() outside, starting
+ * at a 4K boundary. With ws == nullptr the call allocates them itself. */
+bool implicit_sgemm_available();
+
+size_t sgemm_implicit_a_ws_size(const int *M, const int *N, const int *K);
+
+mkldnn_status_t sgemm_implicit_a(const char *transb, const int *M,
+        const int *N, const int *K, sgemm_pack_a_t pack_a, const void *ctx,
+        const float *B, const int *ldb, const float *beta, float *C,
+        const int *ldc, void *ws = nullptr);
+
 #ifdef USE_CBLAS
 #define GEMM_IMPL_STR "gemm:blas"
 #else
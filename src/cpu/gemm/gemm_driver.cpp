@@ -48,7 +48,9 @@ template <typename T>
 int get_vector_length() {
     int v_bytes;
 
-    if (mayiuse(avx512_core))
+    if (use_sve_gemm_kernels())
+        v_bytes = get_sve_length();
+    else if (mayiuse(avx512_core))
         v_bytes = cpu_isa_traits<avx512_core>::vlen;
     else if (mayiuse(avx))
         v_bytes = cpu_isa_traits<avx>::vlen;
@@ -372,6 +374,9 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
             if (sizeK > k_padd)
                 sizeK = k_padd;
 
+            // Packed A panels hold k rounded up to the kernel k unroll.
+            dim_t sizeK_padd = utils::rnd_up(sizeK, arg->uk);
+
             // Scale C blocks by beta only for the first time
             if (Bk == 0)
                 beta = beta_saved;
@@ -420,7 +425,7 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
                          * copy kernels.
                          */
                         arg->copyA(&sizeK, &sizeUM, a_block, &lda, &alpha,
-                                bufferA + Um_forA * sizeK, NULL, NULL,
+                                bufferA + Um_forA * sizeK_padd, NULL, NULL,
                                 a_row_sum + Um_forA);
                     }
 
@@ -437,7 +442,7 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
                     }
                     if (need_c_buffer) {
                         gemm_kernel(sizeUM, sizeN, sizeK, 1.0f,
-                                bufferA + Um_forA * sizeK, bufferB, 0.0f,
+                                bufferA + Um_forA * sizeK_padd, bufferB, 0.0f,
                                 bufferC + Um, ldc_buf, a_row_sum + Um_forA,
                                 b_col_sum, (c_type *) NULL, NO_OFFSET, arg);
 
@@ -449,7 +454,7 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
                                 offsetc);
                     } else {
                         gemm_kernel(sizeUM, sizeN, sizeK, alpha,
-                                bufferA + Um_forA * sizeK, bufferB, beta,
+                                bufferA + Um_forA * sizeK_padd, bufferB, beta,
                                 c_block, ldc, a_row_sum + Um_forA, b_col_sum,
                                 co + co_stride, offsetc, arg);
                     }
@@ -496,7 +501,8 @@ static mkldnn_status_t kernel_driver_parallel_acopiedbcopy(const dim_t m,
 
     dim_t strideBn = (arg->transb != 0)? 1 : ldb;
 
-    size_t b_buf_nelems = k * n_padd;
+    // The copy routines pad the K dimension to a multiple of uk.
+    size_t b_buf_nelems = utils::rnd_up(k, arg->uk) * n_padd;
     size_t b_col_sum_nelems = n_padd;
 
     size_t mem_size = b_buf_nelems * sizeof(*b) + PAGE_4K;
@@ -663,7 +669,10 @@ static inline int nocopy_checker(const int nthr, const int transa,
         const int transb, const dim_t m, const dim_t n, const dim_t k,
         const dim_t lda, const dim_t ldb, const dim_t ldc) {
 
-    if (mayiuse(avx512_core)) {
+    if (use_sve_gemm_kernels()) {
+        // There is no nocopy sgemm for SVE.
+        return 0;
+    } else if (mayiuse(avx512_core)) {
         return nocopy_checker_avx512(nthr, transa, transb, m, n, k, lda, ldb,
                 ldc);
     } else if (mayiuse(avx2)) {
@@ -827,7 +836,8 @@ static inline void set_min_blk_2d_partition(int nthrs,
     };
 
     // Choose m/n blocking.
-    auto min_mblk = mayiuse(avx512_core) ? (MBLK / 2) : arg->um;
+    auto min_mblk = (mayiuse(avx512_core) || use_sve_gemm_kernels())
+        ? (MBLK / 2) : arg->um;
     std::tie(nthr_m, nthr_n) = partition_2d_minblk(
             m, n, MBLK, NBLK, min_mblk, NBLK / 2, nthrs);
 
@@ -916,6 +926,8 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
 
     bool isInteger = data_traits<a_type>::data_type == data_type::s8;
     bool isSgemm = data_traits<a_type>::data_type == data_type::f32;
+    // SVE kernels follow the heuristics tuned for wide vectors.
+    bool isWideVec = mayiuse(avx512_core) || use_sve_gemm_kernels();
 
     if (isSgemm &&
             nocopy_checker(nthrs, transa, transb, m, n, k, lda, ldb, ldc)) {
@@ -955,7 +967,7 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
     int condition_2D_bsrc = -1;
     if (isSgemm) {
         // If m is large and n is small then do 1D partitioning for Intel AVX2.
-        if (!mayiuse(avx512_core) && n <= N2D_MAX && (m >= nthrs * M2D_MIN)) {
+        if (!isWideVec && n <= N2D_MAX && (m >= nthrs * M2D_MIN)) {
             condition_2D_bsrc = 0;
         } else {
             condition_2D_bsrc = ((n > nthrs * N2D_MAX) ||
@@ -968,7 +980,7 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
     // TODO Check if we shoud use k-partitioning.
 
     int condition_1D_copya = 0;
-    if (mayiuse(avx512_core)) {
+    if (isWideVec) {
         const dim_t thresh = isSgemm ? N2D_MAX / 4 : 68;
         if (m >= 1000 && (n >= nthrs * thresh)) {
             condition_2D_bsrc = 0;
@@ -1040,7 +1052,9 @@ static inline void set_thread_opts(int *p_nthrs, blas_thread_t *thread_info,
         thread_info->partition = PARTITION_1D_COL;
     } else {
         int veclen = 0;
-        if (mayiuse(avx512_core)) {
+        if (use_sve_gemm_kernels()) {
+            veclen = get_sve_length() / (int) sizeof(c_type);
+        } else if (mayiuse(avx512_core)) {
             veclen = cpu_isa_traits<avx512_core>::vlen / (int) sizeof(c_type);
         } else {
             veclen = cpu_isa_traits<avx2>::vlen / (int) sizeof(c_type);
@@ -1462,6 +1476,9 @@ static mkldnn_status_t parallel_a_copy(const int ithr, const int nthrs,
         if (sizeK > k_padd)
             sizeK = k_padd;
 
+        // Packed A panels hold k rounded up to the kernel k unroll.
+        dim_t sizeK_padd = utils::rnd_up(sizeK, arg->uk);
+
         // Scale C blocks by beta only for the first term of partial sum.
         if (Bk == 0)
             beta = beta_saved;
@@ -1505,7 +1522,7 @@ static mkldnn_status_t parallel_a_copy(const int ithr, const int nthrs,
                      * kernels.
                      */
                     arg->copyA(&sizeK, &band, a_block, &lda, &alpha,
-                            bufferA + offset * sizeK, NULL, NULL,
+                            bufferA + offset * sizeK_padd, NULL, NULL,
                             a_row_sum + offset);
                 }
             }
@@ -1549,7 +1566,9 @@ static inline void get_omp_thread_count(dim_t m, dim_t n, dim_t k, int *nthrs) {
     const double omp_slope_big_core = 5.0e+2;
 
     int veclen = 0;
-    if (mayiuse(avx512_core)) {
+    if (use_sve_gemm_kernels()) {
+        veclen = get_sve_length() / (int) sizeof(T);
+    } else if (mayiuse(avx512_core)) {
         veclen = cpu_isa_traits<avx512_core>::vlen / (int) sizeof(T);
     } else {
         veclen = cpu_isa_traits<avx2>::vlen / (int) sizeof(T);
@@ -1657,7 +1676,7 @@ static mkldnn_status_t gemm_threading_driver(
     int nthr = (mkldnn_in_parallel()) ? 1 : mkldnn_get_max_threads();
 
     // Check if thread is beneficial.
-    if (mayiuse(avx2) && !mayiuse(avx512_core)) {
+    if (mayiuse(avx2) && !mayiuse(avx512_core) && !use_sve_gemm_kernels()) {
         if (arg->m > 10 * arg->n && arg->n < nthr) {
             const int veclen = cpu_isa_traits<avx2>::vlen / (int)sizeof(c_type);
             if (arg->m / nthr < veclen * 3) {
@@ -1784,13 +1803,14 @@ mkldnn_status_t gemm_driver(
     assert(IMPLICATION(data_traits<a_type>::data_type == data_type::bf16,
                 mayiuse(avx512_core) && !force_nocopy));
 
-    // gemm_driver supports 8-bit integer for Intel AVX512 and above.
+    // gemm_driver supports 8-bit integer for Intel AVX512 and above and SVE.
     assert(IMPLICATION(data_traits<a_type>::data_type == data_type::s8,
-                mayiuse(avx512_core) && !force_nocopy));
+                (mayiuse(avx512_core) || use_sve_gemm_kernels())
+                && !force_nocopy));
 
-    // gemm_driver supports sgemm for Intel AVX.
+    // gemm_driver supports sgemm for Intel AVX and SVE.
     assert(IMPLICATION(data_traits<a_type>::data_type == data_type::f32,
-            mayiuse(avx)));
+            mayiuse(avx) || use_sve_gemm_kernels()));
 
     gemm_info_t<a_type, b_type, c_type> args(transA, transB, offsetC, m, n, k,
             alpha, a, lda, oa, b, ldb, ob, beta, c, ldc, oc, force_nocopy);
@@ -1801,6 +1821,382 @@ mkldnn_status_t gemm_driver(
     return gemm_threading_driver(&args);
 }
 
+/* Pack-once / compute-many interface.
+ *
+ * The packed buffer starts with gemm_pack_header_t, followed by the panels
+ * of A as produced by the copy routine of the kernels: for every k-block,
+ * div_up(m, um) panels of um rows, each followed by its row sums (used by
+ * the integer kernels only). Panels are aligned on a cache line. */
+struct gemm_pack_header_t {
+    dim_t m, k;
+    dim_t um, uk, bk;
+    size_t panel_stride; // bytes between two panels of a full k-block
+    size_t size;
+};
+
+static const size_t pack_align = 64;
+
+// Same k-blocking as gemm_kernel_driver()
+template <typename a_type, typename b_type, typename c_type>
+static inline dim_t get_k_block(const dim_t k,
+        const gemm_info_t<a_type, b_type, c_type> *arg) {
+    if (k <= arg->bk_traditional)
+        return nstl::max(k, 1LL);
+    else if (k < 2 * arg->bk)
+        return utils::rnd_up((k + 1) / 2, arg->uk);
+    else
+        return arg->bk;
+}
+
+template <typename a_type, typename b_type, typename c_type>
+static void gemm_pack_init_header(gemm_pack_header_t &hdr, const dim_t m,
+        const dim_t k, const gemm_info_t<a_type, b_type, c_type> *arg) {
+    hdr.m = m;
+    hdr.k = k;
+    hdr.um = arg->um;
+    hdr.uk = arg->uk;
+    hdr.bk = get_k_block(k, arg);
+
+    const size_t a_sz = sizeof(a_type) * hdr.um
+        * utils::rnd_up(hdr.bk, hdr.uk);
+    hdr.panel_stride = utils::rnd_up(a_sz + sizeof(c_type) * hdr.um,
+            pack_align);
+
+    const dim_t nb_m = utils::div_up(m, hdr.um);
+    const dim_t nb_k = utils::div_up(k, hdr.bk);
+    hdr.size = utils::rnd_up(sizeof(hdr), pack_align)
+        + nb_m * nb_k * hdr.panel_stride;
+}
+
+static inline size_t gemm_pack_panel_offset(const gemm_pack_header_t &hdr,
+        const dim_t Bk, const dim_t Um) {
+    // All k-blocks but the last one are full, so every panel of the last
+    // k-block fits into panel_stride as well.
+    const dim_t nb_m = utils::div_up(hdr.m, hdr.um);
+    return utils::rnd_up(sizeof(hdr), pack_align)
+        + ((Bk / hdr.bk) * nb_m + Um / hdr.um) * hdr.panel_stride;
+}
+
+template <typename a_type, typename b_type, typename c_type>
+size_t gemm_pack_get_size_driver(const int *m, const int *n, const int *k) {
+    const float one = 1.0f, zero = 0.0f;
+    const int dummy_ld = 1;
+    gemm_info_t<a_type, b_type, c_type> args("N", "N", NULL, m, n, k, &one,
+            (const a_type *)NULL, &dummy_ld, NULL, (const b_type *)NULL,
+            &dummy_ld, NULL, &zero, (c_type *)NULL, &dummy_ld, NULL, false);
+    if (!args.hasKernels())
+        return 0;
+
+    gemm_pack_header_t hdr;
+    gemm_pack_init_header(hdr, (dim_t)*m, (dim_t)*k, &args);
+    return hdr.size;
+}
+
+template <typename a_type, typename b_type, typename c_type>
+mkldnn_status_t gemm_pack_driver(const char *transA, const int *m,
+        const int *n, const int *k, const a_type *a, const int *lda,
+        void *packed) {
+    const float one = 1.0f, zero = 0.0f;
+    const int dummy_ld = 1;
+    gemm_info_t<a_type, b_type, c_type> args(transA, "N", NULL, m, n, k, &one,
+            a, lda, NULL, (const b_type *)NULL, &dummy_ld, NULL, &zero,
+            (c_type *)NULL, &dummy_ld, NULL, false);
+    if (!args.hasKernels())
+        return mkldnn_unimplemented;
+
+    auto &hdr = *(gemm_pack_header_t *)packed;
+    gemm_pack_init_header(hdr, args.m, args.k, &args);
+
+    const dim_t strideAm = (args.transa == no_trans) ? 1 : args.lda;
+    const dim_t strideAn = (args.transa != no_trans) ? 1 : args.lda;
+    const dim_t nb_m = utils::div_up(args.m, hdr.um);
+    const dim_t nb_k = utils::div_up(args.k, hdr.bk);
+
+    // alpha is applied by the compute call, so A is copied unscaled.
+    parallel_nd(nb_k, nb_m, [&](dim_t kb, dim_t mb) {
+        const dim_t Bk = kb * hdr.bk;
+        const dim_t Um = mb * hdr.um;
+        const dim_t sizeK = nstl::min(hdr.bk, args.k - Bk);
+        const dim_t sizeUM = nstl::min(hdr.um, args.m - Um);
+
+        char *panel = (char *)packed
+            + gemm_pack_panel_offset(hdr, Bk, Um);
+        a_type *bufferA = (a_type *)panel;
+        c_type *a_row_sum = (c_type *)(panel + sizeof(a_type) * hdr.um
+                * utils::rnd_up(sizeK, hdr.uk));
+
+        args.copyA(&sizeK, &sizeUM, a + Um * strideAm + Bk * strideAn,
+                &args.lda, &one, bufferA, NULL, NULL, a_row_sum);
+    });
+
+    return mkldnn_success;
+}
+
+template <typename a_type, typename b_type, typename c_type>
+mkldnn_status_t gemm_compute_driver(const char *transB, const int *m,
+        const int *n, const int *k, const void *packed, const b_type *b,
+        const int *ldb, const float *beta, c_type *c, const int *ldc) {
+    const float one = 1.0f;
+    const int dummy_ld = nstl::max(*m, 1);
+    gemm_info_t<a_type, b_type, c_type> args("N", transB, NULL, m, n, k,
+            &one, (const a_type *)NULL, &dummy_ld, NULL, b, ldb, NULL, beta,
+            c, ldc, NULL, false);
+    if (!args.hasKernels())
+        return mkldnn_unimplemented;
+
+    const auto &hdr = *(const gemm_pack_header_t *)packed;
+    if (hdr.m != args.m || hdr.k != args.k || hdr.um != args.um
+            || hdr.uk != args.uk)
+        return mkldnn_invalid_arguments;
+
+    if (args.m <= 0 || args.n <= 0)
+        return mkldnn_success;
+
+    const bool isInteger = (data_traits<a_type>::data_type == data_type::s8);
+    float beta_f = *beta;
+    // Integer kernels can only overwrite or accumulate into C.
+    if (isInteger && beta_f != 0.0f && beta_f != 1.0f)
+        return mkldnn_unimplemented;
+
+    const dim_t strideBm = (args.transb == no_trans) ? 1 : args.ldb;
+    const dim_t strideBn = (args.transb != no_trans) ? 1 : args.ldb;
+
+    const dim_t nb_m = utils::div_up(args.m, hdr.um);
+    const dim_t nb_n = utils::div_up(args.n, args.un);
+    const dim_t k_padd = utils::rnd_up(hdr.bk, hdr.uk);
+    const dim_t bn = args.k < args.blocking_small_k ? args.bn_small_k
+        : args.bn;
+
+    int nthr = (mkldnn_in_parallel()) ? 1 : mkldnn_get_max_threads();
+    get_omp_thread_count<c_type>(args.m, args.n, args.k, &nthr);
+
+    // A is already packed, so threads split the panels of A first and
+    // then the columns of B.
+    const int nthr_m = (int)nstl::min((dim_t)nthr, nb_m);
+    const int nthr_n = (int)nstl::max(1LL,
+            nstl::min((dim_t)(nthr / nthr_m), nb_n));
+
+    mkldnn_status_t *results = (mkldnn_status_t *)malloc(
+            sizeof(*results) * nthr_m * nthr_n, PAGE_4K);
+    if (!results)
+        return mkldnn_out_of_memory;
+
+    parallel(nthr_m * nthr_n, [&](const int ithr, const int nthr) {
+        results[ithr] = mkldnn_success;
+        if (ithr >= nthr_m * nthr_n) return;
+
+        const int ithr_m = ithr % nthr_m;
+        const int ithr_n = ithr / nthr_m;
+        dim_t mb_s = 0, mb_e = 0, nb_s = 0, nb_e = 0;
+        balance211(nb_m, nthr_m, ithr_m, mb_s, mb_e);
+        balance211(nb_n, nthr_n, ithr_n, nb_s, nb_e);
+
+        const dim_t m_s = mb_s * hdr.um;
+        const dim_t m_e = nstl::min(args.m, mb_e * hdr.um);
+        const dim_t n_s = nb_s * args.un;
+        const dim_t n_e = nstl::min(args.n, nb_e * args.un);
+        if (m_s >= m_e || n_s >= n_e) return;
+
+        const dim_t n_padd = utils::rnd_up(
+                nstl::min(nstl::max(n_e - n_s, args.un), bn), args.un);
+
+        size_t mem_size = sizeof(b_type) * k_padd * n_padd + PAGE_4K;
+        if (isInteger)
+            mem_size += sizeof(c_type) * n_padd + PAGE_4K;
+        char *mem = (char *)malloc(mem_size, 128);
+        if (!mem) {
+            results[ithr] = mkldnn_out_of_memory;
+            return;
+        }
+        b_type *bufferB = (b_type *)align(mem, PAGE_4K);
+        c_type *b_col_sum = isInteger
+            ? (c_type *)align(bufferB + k_padd * n_padd, PAGE_4K)
+            : NULL;
+
+        float beta_t = beta_f;
+        if (!isInteger && beta_t != 0.0f && beta_t != 1.0f) {
+            scale_matrix(m_e - m_s, n_e - n_s, beta_t,
+                    c + m_s + n_s * args.ldc, args.ldc);
+            beta_t = 1.0f;
+        }
+
+        dim_t sizeN = 0;
+        for (dim_t Bn = n_s; Bn < n_e; Bn += sizeN) {
+            sizeN = nstl::min(n_padd, n_e - Bn);
+
+            dim_t sizeK = 0;
+            for (dim_t Bk = 0; Bk < args.k; Bk += sizeK) {
+                sizeK = nstl::min(hdr.bk, args.k - Bk);
+                const float beta_k = Bk == 0 ? beta_t : 1.0f;
+
+                args.copyB(&sizeK, &sizeN, b + Bk * strideBm + Bn * strideBn,
+                        &args.ldb, &one, bufferB, NULL, NULL, b_col_sum);
+
+                for (dim_t Um = m_s; Um < m_e; Um += hdr.um) {
+                    const dim_t sizeUM = nstl::min(hdr.um, m_e - Um);
+                    const char *panel = (const char *)packed
+                        + gemm_pack_panel_offset(hdr, Bk, Um);
+                    const a_type *bufferA = (const a_type *)panel;
+                    const c_type *a_row_sum = (const c_type *)(panel
+                            + sizeof(a_type) * hdr.um
+                                    * utils::rnd_up(sizeK, hdr.uk));
+
+                    gemm_kernel(sizeUM, sizeN, sizeK, one, bufferA, bufferB,
+                            beta_k, c + Um + Bn * args.ldc, args.ldc,
+                            a_row_sum, b_col_sum, (const c_type *)NULL,
+                            NO_OFFSET, &args);
+                }
+            }
+        }
+
+        mkldnn::impl::free(mem);
+    });
+
+    mkldnn_status_t result = mkldnn_success;
+    for (int i = 0; i < nthr_m * nthr_n; i++)
+        if (results[i] != mkldnn_success) {
+            result = results[i];
+            break;
+        }
+
+    mkldnn::impl::free(results);
+
+    return result;
+}
+
+/* The packing buffers one thread of sgemm_implicit_a_driver() works in.
+ * The k-block and the padded n-block of a call never exceed the bounds
+ * used here for any k' <= k and n' <= n, so the size covers every smaller
+ * problem as well. */
+static size_t sgemm_implicit_a_thr_size(
+        const gemm_info_t<float, float, float> &args) {
+    const dim_t bk = nstl::max(1LL,
+            nstl::min(args.k, nstl::max(args.bk_traditional, args.bk)));
+    const dim_t bn = nstl::max(args.bn, args.bn_small_k);
+    const dim_t n_padd = utils::rnd_up(
+            nstl::min(nstl::max(args.n, args.un), bn), args.un);
+    return utils::rnd_up(sizeof(float) * bk * n_padd, PAGE_4K)
+        + utils::rnd_up(sizeof(float) * args.um * bk, PAGE_4K);
+}
+
+size_t sgemm_implicit_a_ws_size_driver(const int *m, const int *n,
+        const int *k) {
+    const float one = 1.0f, zero = 0.0f;
+    const int dummy_ld = nstl::max(*m, 1);
+    gemm_info_t<float, float, float> args("N", "N", NULL, m, n, k, &one,
+            (const float *)NULL, &dummy_ld, NULL, (const float *)NULL,
+            &dummy_ld, NULL, &zero, (float *)NULL, &dummy_ld, NULL, false);
+    if (!use_sve_gemm_kernels() || !args.hasKernels())
+        return 0;
+    return sgemm_implicit_a_thr_size(args);
+}
+
+/* Implicit-A sgemm. The loops are the ones of gemm_compute_driver(), but
+ * every panel of A is formed by pack_a right before the kernel uses it, in
+ * the layout of jit_sve_f32_copy_an_kern: k-major, with sizeUM rows per k
+ * for the tail panel as well. */
+mkldnn_status_t sgemm_implicit_a_driver(const char *transB, const int *m,
+        const int *n, const int *k, sgemm_pack_a_t pack_a, const void *ctx,
+        const float *b, const int *ldb, const float *beta, float *c,
+        const int *ldc, void *ws) {
+    const float one = 1.0f;
+    const int dummy_ld = nstl::max(*m, 1);
+    gemm_info_t<float, float, float> args("N", transB, NULL, m, n, k, &one,
+            (const float *)NULL, &dummy_ld, NULL, b, ldb, NULL, beta, c, ldc,
+            NULL, false);
+    if (!use_sve_gemm_kernels() || !args.hasKernels())
+        return mkldnn_unimplemented;
+
+    if (args.m <= 0 || args.n <= 0)
+        return mkldnn_success;
+
+    const dim_t strideBm = (args.transb == no_trans) ? 1 : args.ldb;
+    const dim_t strideBn = (args.transb != no_trans) ? 1 : args.ldb;
+
+    const dim_t bk = get_k_block(args.k, &args);
+    const dim_t nb_m = utils::div_up(args.m, args.um);
+    const dim_t nb_n = utils::div_up(args.n, args.un);
+    const dim_t bn = args.k < args.blocking_small_k ? args.bn_small_k
+        : args.bn;
+
+    int nthr = (mkldnn_in_parallel()) ? 1 : mkldnn_get_max_threads();
+    get_omp_thread_count<float>(args.m, args.n, args.k, &nthr);
+
+    const int nthr_m = (int)nstl::min((dim_t)nthr, nb_m);
+    const int nthr_n = (int)nstl::max(1LL,
+            nstl::min((dim_t)(nthr / nthr_m), nb_n));
+
+    // The buffers of all the threads come from the caller or from a single
+    // allocation, never from the k and n loops.
+    const size_t thr_size = sgemm_implicit_a_thr_size(args);
+    char *mem = NULL;
+    if (!ws) {
+        mem = (char *)malloc(thr_size * nthr_m * nthr_n, PAGE_4K);
+        if (!mem)
+            return mkldnn_out_of_memory;
+        ws = mem;
+    }
+
+    parallel(nthr_m * nthr_n, [&](const int ithr, const int nthr) {
+        if (ithr >= nthr_m * nthr_n) return;
+
+        const int ithr_m = ithr % nthr_m;
+        const int ithr_n = ithr / nthr_m;
+        dim_t mb_s = 0, mb_e = 0, nb_s = 0, nb_e = 0;
+        balance211(nb_m, nthr_m, ithr_m, mb_s, mb_e);
+        balance211(nb_n, nthr_n, ithr_n, nb_s, nb_e);
+
+        const dim_t m_s = mb_s * args.um;
+        const dim_t m_e = nstl::min(args.m, mb_e * args.um);
+        const dim_t n_s = nb_s * args.un;
+        const dim_t n_e = nstl::min(args.n, nb_e * args.un);
+        if (m_s >= m_e || n_s >= n_e) return;
+
+        const dim_t n_padd = utils::rnd_up(
+                nstl::min(nstl::max(n_e - n_s, args.un), bn), args.un);
+
+        // A single panel of A is live at a time, it stays in L1.
+        float *bufferB = (float *)((char *)ws + thr_size * ithr);
+        float *bufferA = (float *)align(bufferB + bk * n_padd, PAGE_4K);
+
+        float beta_t = *beta;
+        if (beta_t != 0.0f && beta_t != 1.0f) {
+            scale_matrix(m_e - m_s, n_e - n_s, beta_t,
+                    c + m_s + n_s * args.ldc, args.ldc);
+            beta_t = 1.0f;
+        }
+
+        dim_t sizeN = 0;
+        for (dim_t Bn = n_s; Bn < n_e; Bn += sizeN) {
+            sizeN = nstl::min(n_padd, n_e - Bn);
+
+            dim_t sizeK = 0;
+            for (dim_t Bk = 0; Bk < args.k; Bk += sizeK) {
+                sizeK = nstl::min(bk, args.k - Bk);
+                const float beta_k = Bk == 0 ? beta_t : 1.0f;
+
+                args.copyB(&sizeK, &sizeN, b + Bk * strideBm + Bn * strideBn,
+                        &args.ldb, &one, bufferB, NULL, NULL, NULL);
+
+                for (dim_t Um = m_s; Um < m_e; Um += args.um) {
+                    const dim_t sizeUM = nstl::min(args.um, m_e - Um);
+                    pack_a(ctx, (int)Um, (int)sizeUM, (int)Bk, (int)sizeK,
+                            bufferA);
+
+                    gemm_kernel(sizeUM, sizeN, sizeK, one, bufferA, bufferB,
+                            beta_k, c + Um + Bn * args.ldc, args.ldc,
+                            (const float *)NULL, (const float *)NULL,
+                            (const float *)NULL, NO_OFFSET, &args);
+                }
+            }
+        }
+    });
+
+    mkldnn::impl::free(mem);
+
+    return mkldnn_success;
+}
+
 template // Instantiate gemm_bf16bf16f32
 mkldnn_status_t gemm_driver<mkldnn_bfloat16_t, mkldnn_bfloat16_t, float>(
         const char *transA, const char *transB, const char *offsetC,
@@ -1837,6 +2233,21 @@ mkldnn_status_t gemm_driver<float, float, float>(
         const float *beta, float *c, const int *ldc, const float *oc,
         const bool force_nocopy);
 
+#define INSTANTIATE_GEMM_PACK(a_type, b_type, c_type) \
+template size_t gemm_pack_get_size_driver<a_type, b_type, c_type>( \
+        const int *m, const int *n, const int *k); \
+template mkldnn_status_t gemm_pack_driver<a_type, b_type, c_type>( \
+        const char *transA, const int *m, const int *n, const int *k, \
+        const a_type *a, const int *lda, void *packed); \
+template mkldnn_status_t gemm_compute_driver<a_type, b_type, c_type>( \
+        const char *transB, const int *m, const int *n, const int *k, \
+        const void *packed, const b_type *b, const int *ldb, \
+        const float *beta, c_type *c, const int *ldc);
+
+INSTANTIATE_GEMM_PACK(float, float, float)
+INSTANTIATE_GEMM_PACK(int8_t, uint8_t, int32_t)
+#undef INSTANTIATE_GEMM_PACK
+
 }
 }
 }
@@ -32,6 +32,39 @@ mkldnn_status_t gemm_driver(
         const float *beta, c_type *c, const int *ldc, const c_type *oc,
         const bool force_jit_nocopy_gemm);
 
+/* Pack-once / compute-many gemm built on the copy based kernels: A is
+ * copied once by gemm_pack_driver(), gemm_compute_driver() then computes
+ * C = A * B + beta * C copying only B. The packed buffer is tied to the
+ * running ISA and to m and k. */
+template <typename a_type, typename b_type, typename c_type>
+size_t gemm_pack_get_size_driver(const int *m, const int *n, const int *k);
+
+template <typename a_type, typename b_type, typename c_type>
+mkldnn_status_t gemm_pack_driver(const char *transA, const int *m,
+        const int *n, const int *k, const a_type *a, const int *lda,
+        void *packed);
+
+template <typename a_type, typename b_type, typename c_type>
+mkldnn_status_t gemm_compute_driver(const char *transB, const int *m,
+        const int *n, const int *k, const void *packed, const b_type *b,
+        const int *ldb, const float *beta, c_type *c, const int *ldc);
+
+/* Implicit-A sgemm: C = A * B + beta * C where the column major m x k
+ * matrix A is never stored. pack_a(ctx, m_s, m, k_s, k, panel) writes the
+ * rows [m_s, m_s + m) of the columns [k_s, k_s + k) of A to panel, k-major
+ * with m values per column, which is the packed A layout of the native SVE
+ * kernels; other kernels are unimplemented. */
+typedef void (*sgemm_pack_a_t)(const void *ctx, int m_s, int m, int k_s,
+        int k, float *panel);
+
+size_t sgemm_implicit_a_ws_size_driver(const int *m, const int *n,
+        const int *k);
+
+mkldnn_status_t sgemm_implicit_a_driver(const char *transB, const int *m,
+        const int *n, const int *k, sgemm_pack_a_t pack_a, const void *ctx,
+        const float *b, const int *ldb, const float *beta, float *c,
+        const int *ldc, void *ws);
+
 }
 }
 }
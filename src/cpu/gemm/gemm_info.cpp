@@ -27,9 +27,15 @@
 #include "bf16/jit_avx512_core_gemm_bf16bf16f32_kern.hpp"
 #include "f32/common_f32.hpp"
 #include "f32/jit_avx2_kernel_sgemm_kern.hpp"
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "f32/jit_sve_kernel_sgemm_kern.hpp"
+#endif
 #include "s8x8s32/common_u8.hpp"
 #include "s8x8s32/jit_avx512_core_gemm_s8u8s32_kern.hpp"
 #include "s8x8s32/jit_avx512_core_kernel_gemv_s8u8s32_kern.hpp"
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "s8x8s32/jit_sve_gemm_s8s8s32_kern.hpp"
+#endif
 
 namespace mkldnn {
 namespace impl {
@@ -75,7 +81,12 @@ gemm_info_t<a_type, b_type, c_type>::gemm_info_t(const char *transA,
         this->bo = ob ? *ob : c_type(0);
     }
 
-    if (data_traits<b_type>::data_type == data_type::s8) {
+    if (use_sve_gemm_kernels()) {
+        // SVE kernels multiply signed bytes, so u8 B is packed shifted by
+        // -128 while s8 B is packed as is.
+        if (data_traits<b_type>::data_type == data_type::u8)
+            this->bo += 128;
+    } else if (data_traits<b_type>::data_type == data_type::s8) {
         this->bo -= 128;
     }
 
@@ -95,7 +106,8 @@ gemm_info_t<a_type, b_type, c_type>::gemm_info_t(const char *transA,
     bool has_bias = (is_sgemm && this->co && this->offsetc == COL_OFFSET);
 
     // Use nocopy for sgemm if requested, if there is bias or if under avx ISA.
-    this->force_nocopy = is_sgemm &&
+    // There is no nocopy sgemm for SVE, so the copy-based kernels are used.
+    this->force_nocopy = is_sgemm && !use_sve_gemm_kernels() &&
         (force_nocopy || has_bias || (mayiuse(avx) && !mayiuse(avx2)));
 
     if (!this->force_nocopy) {
@@ -131,7 +143,19 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
 
     switch (data_traits<a_type>::data_type) {
     case data_type::s8:
-        if (mayiuse(avx512_core)) {
+        if (use_sve_gemm_kernels()) {
+            this->um = jit_sve_gemm_s8s8s32_kern::unroll_m_reg_
+                * get_sve_length() / (int) sizeof(int32_t);
+            this->un = jit_sve_gemm_s8s8s32_kern::unroll_n_;
+            this->uk = jit_sve_gemm_s8s8s32_kern::k_group_;
+            this->bm = 9984;
+            this->bn = 384;
+            this->bk = 768;
+
+            this->bk_traditional = 384;
+            this->blocking_small_k =  48;
+            this->bn_small_k =  24;
+        } else if (mayiuse(avx512_core)) {
             this->um = 48;
             this->un = 8;
             this->uk = 1;
@@ -161,7 +185,20 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
         break;
 
     case data_type::f32:
-        if (mayiuse(avx512_core)) {
+        if (use_sve_gemm_kernels()) {
+            this->um = jit_sve_kernel_sgemm_kern::unroll_m_reg_
+                * get_sve_length() / (int) sizeof(float);
+            this->un = jit_sve_kernel_sgemm_kern::unroll_n_;
+            this->uk = 1;
+            this->bm = 9984;
+            this->bn = 384;
+            this->bk = 384;
+
+            this->bk_traditional = 384;
+            this->blocking_small_k =  48;
+            this->bn_small_k =  24;
+
+        } else if (mayiuse(avx512_core)) {
             this->um = 48;
             this->un = 8;
             this->uk = 1;
@@ -197,7 +234,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
 
         switch (data_traits<a_type>::data_type) {
         case data_type::s8:
-            if (mayiuse(avx512_core)) {
+            if (use_sve_gemm_kernels()) {
+                // SVE kernels are picked up below.
+            } else if (mayiuse(avx512_core)) {
                 copy_a[no_trans][no_sum] =
                     new jit_avx512_core_u8_copy_an_kern();
                 copy_a[do_trans][no_sum] =
@@ -235,7 +274,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
             break;
 
         case data_type::f32:
-            if (mayiuse(avx512_core)) {
+            if (use_sve_gemm_kernels()) {
+                // SVE kernels are picked up below.
+            } else if (mayiuse(avx512_core)) {
                 copy_a[no_trans][no_sum] =
                     new jit_avx512_core_f32_copy_an_kern();
                 copy_a[do_trans][no_sum] =
@@ -258,7 +299,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
         static jit_generator *kernel[2][2][2] = {{{NULL}}};
         switch (data_traits<a_type>::data_type) {
         case data_type::s8:
-            if (mayiuse(avx512_core)) {
+            if (use_sve_gemm_kernels()) {
+                // SVE kernels are picked up below.
+            } else if (mayiuse(avx512_core)) {
                 for (int isBeta0 : {no_beta0, do_beta0})
                     for (int isColOffset : {no_col_offset, do_col_offset})
                         for (int isRowOffset : {no_row_offset, do_row_offset}) {
@@ -279,7 +322,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
             break;
 
         case data_type::f32:
-            if (mayiuse(avx2)) {
+            if (use_sve_gemm_kernels()) {
+                // SVE kernels are picked up below.
+            } else if (mayiuse(avx2)) {
                 for (int isBeta0 : {no_beta0, do_beta0}) {
                     kernel[isBeta0][no_col_offset][no_row_offset] =
                         new jit_avx2_kernel_sgemm_kern(isBeta0);
@@ -291,7 +336,7 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
         static jit_avx512_core_gemv_s8u8s32_kern *gemv_s8u8s32_kernel = NULL;
         static jit_avx512_core_gemv_s8u8s32_kern *gemv_u8s8s32_kernel = NULL;
         if (data_traits<a_type>::data_type == data_type::s8) {
-            if (mayiuse(avx512_core)) {
+            if (mayiuse(avx512_core) && !use_sve_gemm_kernels()) {
                 gemv_s8u8s32_kernel = new jit_avx512_core_gemv_s8u8s32_kern();
                 gemv_u8s8s32_kernel = new jit_avx512_core_gemv_s8u8s32_kern();
             }
@@ -314,6 +359,81 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
                                 const dim_t *, const dim_t *, c_type *)>();
             }
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+        // SVE kernels do not share the x86 generator base, so their entry
+        // points are set separately.
+        static jit_generator_aarch64 *sve_copy_a[2][2] = {{NULL}};
+        static jit_generator_aarch64 *sve_copy_b[2][2] = {{NULL}};
+        static jit_generator_aarch64 *sve_kernel[2][2][2] = {{{NULL}}};
+
+        if (use_sve_gemm_kernels()
+                && data_traits<a_type>::data_type == data_type::f32) {
+            sve_copy_a[no_trans][no_sum] = new jit_sve_f32_copy_an_kern();
+            sve_copy_a[do_trans][no_sum] = new jit_sve_f32_copy_at_kern();
+
+            sve_copy_b[no_trans][no_sum] = new jit_sve_f32_copy_bn_kern();
+            sve_copy_b[do_trans][no_sum] = new jit_sve_f32_copy_bt_kern();
+
+            for (int isBeta0 : {no_beta0, do_beta0})
+                sve_kernel[isBeta0][no_col_offset][no_row_offset] =
+                    new jit_sve_kernel_sgemm_kern(isBeta0);
+        }
+
+        if (use_sve_gemm_kernels()
+                && data_traits<a_type>::data_type == data_type::s8) {
+            for (int isSum : {no_sum, do_sum}) {
+                sve_copy_a[no_trans][isSum] =
+                    new jit_sve_u8_copy_an_kern(isSum);
+                sve_copy_a[do_trans][isSum] =
+                    new jit_sve_u8_copy_at_kern(isSum);
+
+                sve_copy_b[no_trans][isSum] =
+                    new jit_sve_u8_copy_bn_kern(b_is_s8, isSum);
+                sve_copy_b[do_trans][isSum] =
+                    new jit_sve_u8_copy_bt_kern(b_is_s8, isSum);
+            }
+
+            for (int isBeta0 : {no_beta0, do_beta0})
+                for (int isColOffset : {no_col_offset, do_col_offset})
+                    for (int isRowOffset : {no_row_offset, do_row_offset}) {
+                        sve_kernel[isBeta0][isColOffset][isRowOffset] =
+                            new jit_sve_gemm_s8s8s32_kern(isBeta0,
+                                    isColOffset, isRowOffset);
+                    }
+        }
+
+        for (int isTrans : {no_trans, do_trans})
+            for (int isSum : {no_sum, do_sum}) {
+                auto *p_copy_a = sve_copy_a[isTrans][isSum];
+                if (p_copy_a != NULL)
+                    copyA[isTrans][isSum] = p_copy_a->getCode<
+                        void (*)(const dim_t *, const dim_t *, const a_type *,
+                                const dim_t *, const float *, a_type *,
+                                const dim_t *, const dim_t *, c_type *)>();
+                auto *p_copy_b = sve_copy_b[isTrans][isSum];
+                if (p_copy_b != NULL)
+                    copyB[isTrans][isSum] = p_copy_b->getCode<
+                        void (*)(const dim_t *, const dim_t *, const b_type *,
+                                const dim_t *, const float *, b_type *,
+                                const dim_t *, const dim_t *, c_type *)>();
+            }
+
+        for (int isBeta0 : {no_beta0, do_beta0})
+            for (int isColOffset : {no_col_offset, do_col_offset})
+                for (int isRowOffset : {no_row_offset, do_row_offset}) {
+                    auto *p_kernel
+                        = sve_kernel[isBeta0][isColOffset][isRowOffset];
+                    if (p_kernel != NULL)
+                        kern[isBeta0][isColOffset][isRowOffset] =
+                            p_kernel->getCode<
+                            void (*)(const dim_t *, const dim_t *,
+                                    const dim_t *, const float *,
+                                    const a_type *, const b_type *, c_type *,
+                                    const dim_t, const c_type *,
+                                    const c_type *)>();
+                }
+#endif
+
         // Set compute kernel function pointer table
         for (int isBeta0 : {no_beta0, do_beta0})
             for (int isColOffset : {no_col_offset, do_col_offset})
@@ -330,7 +450,8 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
                 }
 
         // Set gemv integer gemm kernels
-        if (data_traits<a_type>::data_type == data_type::s8) {
+        if (data_traits<a_type>::data_type == data_type::s8
+                && gemv_s8u8s32_kernel != NULL) {
             gemv_s8u8s32_kern = gemv_s8u8s32_kernel->generate<
                 jit_avx512_core_gemv_s8u8s32_kern::gemv_s8u8s32_kernel_t>(
                         mayiuse(avx512_core_vnni));
@@ -363,21 +484,23 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
 
 // Check if copy algorithm kernels were generated on supported ISAs.
 // Copy algorithm supported for:
-//      s8   : avx512_core, avx512_core_vnni
+//      s8   : avx512_core, avx512_core_vnni, sve
 //      bf16 : avx512_core, avx512_core_bf16
-//      f32  : avx2, avx512_core
+//      f32  : avx2, avx512_core, sve
 template <typename a_type, typename b_type, typename c_type>
 bool gemm_info_t<a_type, b_type, c_type>::hasKernels(void) {
     switch (data_traits<a_type>::data_type) {
     case data_type::s8:
-        if (mayiuse(avx512_core)) {
+        if (use_sve_gemm_kernels() || mayiuse(avx512_core)) {
             for (int isBeta0 : {no_beta0, do_beta0})
                 for (int isColOffset : {no_col_offset, do_col_offset})
                     for (int isRowOffset : {no_row_offset, do_row_offset})
                         if (!this->kernel[isBeta0][isColOffset][isRowOffset])
                             return false;
 
-            if (!this->gemv_s8u8s32_kernel || !this->gemv_u8s8s32_kernel)
+            // There are no gemv kernels for SVE.
+            if (!use_sve_gemm_kernels() && (!this->gemv_s8u8s32_kernel
+                        || !this->gemv_u8s8s32_kernel))
                 return false;
 
             if (!this->copyA || !this->copyB)
@@ -398,7 +521,8 @@ bool gemm_info_t<a_type, b_type, c_type>::hasKernels(void) {
         break;
 
     case data_type::f32:
-        if (mayiuse(avx2) && !this->force_nocopy) {
+        if ((use_sve_gemm_kernels() || mayiuse(avx2))
+                && !this->force_nocopy) {
             for (int isBeta0 : {no_beta0, do_beta0})
                 if (!this->kernel[isBeta0][no_col_offset][no_row_offset])
                     return false;
@@ -19,6 +19,8 @@
 
 #include <cstdint>
 
+#include "cpu_isa_traits.hpp"
+
 namespace mkldnn {
 namespace impl {
 namespace cpu {
@@ -55,6 +57,15 @@ enum {no_row_offset = 0, do_row_offset = 1};
 // Alias for any dimension related variable.
 typedef long long int dim_t;
 
+// Native SVE kernels take precedence over the translated x86 ones.
+static inline bool use_sve_gemm_kernels() {
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    return mayiuse(sve);
+#else
+    return false;
+#endif
+}
+
 template <typename a_type, typename b_type, typename c_type>
 struct gemm_info_t {
 
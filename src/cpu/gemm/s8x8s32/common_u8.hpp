@@ -18,6 +18,9 @@
 #define COMMON_U8_HPP
 
 #include "jit_generator.hpp"
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "jit_generator_aarch64.hpp"
+#endif
 
 #ifdef DNNL_INDIRECT_JIT_AARCH64
 #define U8_COPY_KERNEL_CODE_SIZE          (4096L * 512 * 8)
@@ -90,6 +93,39 @@ class jit_avx512_core_u8_copy_sum_bt_kern : public jit_generator {
         jit_avx512_core_u8_copy_sum_bt_kern(bool s8 = false);
 };
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+/* Copy routines packing int8 matrices for jit_sve_gemm_s8s8s32_kern. With
+ * do_sum set they also store the row sums of A or the column sums of B that
+ * are needed for the offset compensation. */
+class jit_sve_u8_copy_an_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_u8_copy_an_kern);
+
+    public:
+        jit_sve_u8_copy_an_kern(bool do_sum = false);
+};
+
+class jit_sve_u8_copy_at_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_u8_copy_at_kern);
+
+    public:
+        jit_sve_u8_copy_at_kern(bool do_sum = false);
+};
+
+class jit_sve_u8_copy_bn_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_u8_copy_bn_kern);
+
+    public:
+        jit_sve_u8_copy_bn_kern(bool s8 = false, bool do_sum = false);
+};
+
+class jit_sve_u8_copy_bt_kern : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_u8_copy_bt_kern);
+
+    public:
+        jit_sve_u8_copy_bt_kern(bool s8 = false, bool do_sum = false);
+};
+#endif // #ifdef DNNL_NATIVE_JIT_AARCH64
+
 }
 }
 }
@@ -47,6 +47,10 @@ template <>
 int gemm_s8u8s32_jump_to_gemv_s8u8s32(
         gemm_info_t<int8_t, uint8_t, int32_t> *arg) {
 
+    // There are no gemv kernels for SVE.
+    if (use_sve_gemm_kernels())
+        return 0;
+
     gemm_info_t<int8_t, uint8_t, int32_t> arg_gemv = *arg;
 
     if ((arg->offsetc == FIX_OFFSET) && // Fix offset
@@ -0,0 +1,194 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "common_u8.hpp"
+#include "jit_generator.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Packs a row-major (transposed) block of int8 A into the same layout as
+ * jit_sve_u8_copy_an_kern. Four consecutive k values of a row are one word
+ * in memory, so full k groups are gathered as words and only the k tail is
+ * gathered byte by byte. */
+jit_sve_u8_copy_at_kern::jit_sve_u8_copy_at_kern(bool do_sum) :
+    jit_generator_aarch64(nullptr, U8_COPY_KERNEL_CODE_SIZE) {
+
+    const XReg M = x8; // number of k
+    const XReg N = x9; // number of rows
+    const XReg A = x2;
+    const XReg LDA = x10;
+    const XReg B = x5;
+    const XReg SUM = x6;
+
+    const XReg G = x11; // number of full k groups
+    const XReg KR = x12; // k tail
+    const XReg I = x13;
+    const XReg VL = x14;
+    const XReg VL2 = x15;
+    const XReg UM = x16;
+    const XReg TAIL_BYTES = x17;
+    const XReg VEC_STRIDE = x19;
+    const XReg UM_STRIDE = x20;
+    const XReg A1 = x21;
+    const XReg A2 = x22;
+    const XReg A3 = x23;
+
+    const PReg p_all = p0;
+    const ZRegB z_ones = z31.b;
+    const ZRegS z_idx = z30.s;
+
+    auto sum_reg = [&](int i) { return ZRegS(20 + i); };
+
+    /* Packs one k group made of n_cols (<= 4) valid k values. */
+    auto copy_group = [&](int nv, bool is_tail, int n_cols) {
+        mov(A2, A1);
+        for (int i = 0; i < nv; i++) {
+            PReg p = is_tail ? PReg(1 + i) : p_all;
+            if (n_cols == 4) {
+                ld1w(z0.s, p / T_z, ptr(A2, z_idx, UXTW));
+            } else {
+                mov(A3, A2);
+                for (int t = 0; t < n_cols; t++) {
+                    ld1b(ZRegS(t), p / T_z, ptr(A3, z_idx, UXTW));
+                    if (t < n_cols - 1)
+                        add(A3, A3, 1);
+                }
+                for (int t = 1; t < n_cols; t++) {
+                    lsl(ZRegS(t), ZRegS(t), 8 * t);
+                    orr(z0.d, z0.d, ZRegD(t));
+                }
+            }
+            if (do_sum)
+                sdot(sum_reg(i), z0.b, z_ones);
+            st1w(z0.s, p, ptr(B, i, MUL_VL));
+            if (i < nv - 1)
+                add(A2, A2, VEC_STRIDE);
+        }
+        if (is_tail)
+            add(B, B, TAIL_BYTES);
+        else
+            addvl(B, B, nv);
+    };
+
+    auto copy_panel = [&](int nv, bool is_tail) {
+        LabelAArch64 loop, k_tail, k_tail_1, k_tail_2, done;
+
+        if (do_sum)
+            for (int i = 0; i < nv; i++)
+                eor(ZRegD(sum_reg(i).getIdx()), ZRegD(sum_reg(i).getIdx()),
+                        ZRegD(sum_reg(i).getIdx()));
+
+        mov(A1, A);
+        mov(I, G);
+        cbz(I, k_tail);
+        L_aarch64(loop);
+        copy_group(nv, is_tail, 4);
+        add(A1, A1, 4);
+        subs(I, I, 1);
+        b(NE, loop);
+
+        L_aarch64(k_tail);
+        cbz(KR, done);
+        cmp(KR, 1);
+        b(EQ, k_tail_1);
+        cmp(KR, 2);
+        b(EQ, k_tail_2);
+        copy_group(nv, is_tail, 3);
+        b(done);
+        L_aarch64(k_tail_1);
+        copy_group(nv, is_tail, 1);
+        b(done);
+        L_aarch64(k_tail_2);
+        copy_group(nv, is_tail, 2);
+
+        L_aarch64(done);
+        if (do_sum) {
+            for (int i = 0; i < nv; i++) {
+                PReg p = is_tail ? PReg(1 + i) : p_all;
+                st1w(sum_reg(i), p, ptr(SUM, i, MUL_VL));
+            }
+        }
+    };
+
+    LabelAArch64 m_loop, m_tail, m_tail_2, m_tail_3, end_label;
+
+    /* The row sum pointer is the first argument on the stack. */
+    if (do_sum)
+        ldr(SUM, ptr(sp));
+
+    preamble();
+
+    ldr(M, ptr(x0));
+    ldr(N, ptr(x1));
+    ldr(LDA, ptr(x3));
+    lsr(G, M, 2);
+    and_(KR, M, 3);
+
+    ptrue(p_all.s);
+    dup(z_ones, 1);
+    /* byte offsets of the rows held by one vector: 0, lda, 2 * lda, ... */
+    index(z_idx, 0, WReg(LDA.getIdx()));
+
+    cntw(VL);
+    lsl(VL2, VL, 1);
+    add(UM, VL2, VL);
+    mul(VEC_STRIDE, VL, LDA);
+    mul(UM_STRIDE, UM, LDA);
+
+    L_aarch64(m_loop);
+    cmp(N, UM);
+    b(LT, m_tail);
+    copy_panel(3, false);
+    add(A, A, UM_STRIDE);
+    if (do_sum)
+        add(SUM, SUM, UM, LSL, 2);
+    sub(N, N, UM);
+    b(m_loop);
+
+    L_aarch64(m_tail);
+    cbz(N, end_label);
+    lsl(TAIL_BYTES, N, 2);
+    whilelt(PRegS(1), xzr, N);
+    whilelt(PRegS(2), VL, N);
+    whilelt(PRegS(3), VL2, N);
+    cmp(N, VL2);
+    b(GT, m_tail_3);
+    cmp(N, VL);
+    b(GT, m_tail_2);
+    copy_panel(1, true);
+    b(end_label);
+
+    L_aarch64(m_tail_2);
+    copy_panel(2, true);
+    b(end_label);
+
+    L_aarch64(m_tail_3);
+    copy_panel(3, true);
+
+    L_aarch64(end_label);
+    postamble();
+
+    ready();
+}
+
+}
+}
+}
@@ -0,0 +1,194 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "common_u8.hpp"
+#include "jit_generator.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Packs a column-major (non-transposed) block of int8 B into panels of up to
+ * eight columns. Four consecutive k values of a column are one word in
+ * memory: full k groups are moved a vector of words at a time and scattered
+ * into the panel, the k tail is assembled with scalar code. u8 data is
+ * shifted to s8 by flipping the sign bit of every valid byte. */
+jit_sve_u8_copy_bn_kern::jit_sve_u8_copy_bn_kern(bool s8, bool do_sum) :
+    jit_generator_aarch64(nullptr, U8_COPY_KERNEL_CODE_SIZE) {
+
+    const int unroll_n = 8;
+
+    const XReg M = x8; // number of k
+    const XReg N = x9; // number of columns
+    const XReg A = x2;
+    const XReg LDA = x10;
+    const XReg B = x5;
+    const XReg SUM = x6;
+
+    const XReg G = x11; // number of full k groups
+    const XReg KR = x12; // k tail
+    const XReg W = x13; // width of the current panel
+    const XReg J = x14;
+    const XReg A1 = x15;
+    const XReg B1 = x16;
+    const XReg A2 = x17;
+    const XReg B2 = x19;
+    const XReg GG = x20;
+    const XReg VEC_STRIDE = x21;
+    const XReg TAIL_OFF = x22; // offset of the k tail word in the panel
+    const XReg CNT = x23;
+    const XReg SHIFT = x24;
+    const XReg COL_SUM = x25;
+    const XReg TMP = x26;
+    const WReg W_WORD = w27;
+    const WReg W_BYTE = w28;
+    const WReg W_VAL = w3;
+    const WReg W_COL_SUM = WReg(COL_SUM.getIdx());
+
+    const PReg p_all = p0;
+    const PReg p_k = p1;
+    const ZRegB z_ones = z31.b;
+    const ZRegS z_idx = z30.s;
+    const ZRegS z_sign = z29.s;
+    const ZRegS z_sum = z20.s;
+
+    LabelAArch64 n_loop, n_width_done, col_loop, g_loop, g_done, k_tail_loop;
+    LabelAArch64 col_done, end_label;
+
+    /* The column sum pointer is the first argument on the stack. */
+    if (do_sum)
+        ldr(SUM, ptr(sp));
+
+    preamble();
+
+    ldr(M, ptr(x0));
+    ldr(N, ptr(x1));
+    ldr(LDA, ptr(x3));
+    lsr(G, M, 2);
+    and_(KR, M, 3);
+
+    ptrue(p_all.s);
+    dup(z_ones, 1);
+    dup(ZRegB(z_sign.getIdx()), -128);
+
+    L_aarch64(n_loop);
+    cbz(N, end_label);
+    mov(W, unroll_n);
+    cmp(N, W);
+    b(GE, n_width_done);
+    mov(W, N);
+    L_aarch64(n_width_done);
+
+    /* g-th word of a column lands at g * W in the panel */
+    index(z_idx, 0, WReg(W.getIdx()));
+    cntw(VEC_STRIDE);
+    mul(VEC_STRIDE, VEC_STRIDE, W);
+    lsl(VEC_STRIDE, VEC_STRIDE, 2);
+    mul(TAIL_OFF, G, W);
+    lsl(TAIL_OFF, TAIL_OFF, 2);
+
+    mov(A1, A);
+    mov(B1, B);
+    mov(J, W);
+    L_aarch64(col_loop);
+    {
+        if (do_sum)
+            eor(ZRegD(z_sum.getIdx()), ZRegD(z_sum.getIdx()),
+                    ZRegD(z_sum.getIdx()));
+
+        mov(A2, A1);
+        mov(B2, B1);
+        mov(GG, xzr);
+        L_aarch64(g_loop);
+        cmp(GG, G);
+        b(GE, g_done);
+        whilelt(p_k.s, GG, G);
+        ld1w(z0.s, p_k / T_z, ptr(A2));
+        if (!s8)
+            eor(z0.s, p_k, z_sign);
+        if (do_sum)
+            sdot(z_sum, z0.b, z_ones);
+        st1w(z0.s, p_k, ptr(B2, z_idx, UXTW, 2));
+        addvl(A2, A2, 1);
+        add(B2, B2, VEC_STRIDE);
+        incw(GG);
+        b(g_loop);
+        L_aarch64(g_done);
+
+        mov(COL_SUM, xzr);
+        if (do_sum) {
+            saddv(d0, p_all, z_sum);
+            fmov(COL_SUM, d0);
+        }
+
+        /* k tail: up to three bytes are merged into one zero-padded word */
+        cbz(KR, col_done);
+        add(A2, A1, G, LSL, 2);
+        mov(W_WORD, wzr);
+        mov(SHIFT, xzr);
+        mov(CNT, KR);
+        L_aarch64(k_tail_loop);
+        ldrb(W_BYTE, ptr(A2));
+        if (s8) {
+            sxtb(W_VAL, W_BYTE);
+        } else {
+            sub(W_VAL, W_BYTE, 128);
+            eor(W_BYTE, W_BYTE, 0x80);
+        }
+        if (do_sum)
+            add(W_COL_SUM, W_COL_SUM, W_VAL);
+        lslv(W_BYTE, W_BYTE, WReg(SHIFT.getIdx()));
+        orr(W_WORD, W_WORD, W_BYTE);
+        add(SHIFT, SHIFT, 8);
+        add(A2, A2, 1);
+        subs(CNT, CNT, 1);
+        b(NE, k_tail_loop);
+        add(TMP, B1, TAIL_OFF);
+        str(W_WORD, ptr(TMP));
+
+        L_aarch64(col_done);
+        if (do_sum) {
+            str(W_COL_SUM, ptr(SUM));
+            add(SUM, SUM, 4);
+        }
+
+        add(A1, A1, LDA);
+        add(B1, B1, 4);
+        subs(J, J, 1);
+        b(NE, col_loop);
+    }
+
+    /* move to the next panel: (G + (KR != 0)) * W words */
+    cmp(KR, 0);
+    cinc(TMP, G, NE);
+    mul(TMP, TMP, W);
+    add(B, B, TMP, LSL, 2);
+    mov(A, A1);
+    sub(N, N, W);
+    b(n_loop);
+
+    L_aarch64(end_label);
+    postamble();
+
+    ready();
+}
+
+}
+}
+}
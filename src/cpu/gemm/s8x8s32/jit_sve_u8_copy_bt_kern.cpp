@@ -0,0 +1,168 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+
+#include "common_u8.hpp"
+#include "jit_generator.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Packs a row-major (transposed) block of int8 B into panels of up to eight
+ * columns. The columns of a panel are the lanes of two predicated vectors,
+ * which also covers 128-bit SVE; four k rows are widened and merged into one
+ * word per lane. u8 data is shifted to s8 by flipping the sign bit of every
+ * valid byte. */
+jit_sve_u8_copy_bt_kern::jit_sve_u8_copy_bt_kern(bool s8, bool do_sum) :
+    jit_generator_aarch64(nullptr, U8_COPY_KERNEL_CODE_SIZE) {
+
+    const int unroll_n = 8;
+
+    const XReg M = x8; // number of k
+    const XReg N = x9; // number of columns
+    const XReg A = x2;
+    const XReg LDA = x10;
+    const XReg B = x5;
+    const XReg SUM = x6;
+
+    const XReg G = x11; // number of full k groups
+    const XReg KR = x12; // k tail
+    const XReg W = x13; // width of the current panel
+    const XReg I = x14;
+    const XReg VL = x15;
+    const XReg W_BYTES = x16;
+    const XReg LDA4 = x17;
+    const XReg A_ROW[4] = {x19, x20, x21, x22};
+
+    const PReg p_all = p0;
+    const PReg p_lo = p1;
+    const PReg p_hi = p2;
+    const ZRegB z_ones = z31.b;
+    const ZRegS z_sign = z30.s;
+    const ZRegS z_sum_lo = z20.s;
+    const ZRegS z_sum_hi = z21.s;
+
+    /* Packs one k group made of n_rows (<= 4) valid k rows; the low and high
+     * halves of the panel are built in z0 and z4. */
+    auto copy_group = [&](int n_rows) {
+        for (int t = 1; t < n_rows; t++)
+            add(A_ROW[t], A_ROW[t - 1], LDA);
+        for (int h = 0; h < 2; h++) {
+            PReg p = h == 0 ? p_lo : p_hi;
+            int base = 4 * h;
+            for (int t = 0; t < n_rows; t++) {
+                ld1b(ZRegS(base + t), p / T_z, ptr(A_ROW[t], h, MUL_VL));
+                if (!s8)
+                    eor(ZRegS(base + t), p, z_sign);
+            }
+            for (int t = 1; t < n_rows; t++) {
+                lsl(ZRegS(base + t), ZRegS(base + t), 8 * t);
+                orr(ZRegD(base), ZRegD(base), ZRegD(base + t));
+            }
+            if (do_sum)
+                sdot(h == 0 ? z_sum_lo : z_sum_hi, ZRegB(base), z_ones);
+            st1w(ZRegS(base), p, ptr(B, h, MUL_VL));
+        }
+        add(B, B, W_BYTES);
+    };
+
+    LabelAArch64 n_loop, n_width_done, k_loop, k_tail, k_tail_1, k_tail_2;
+    LabelAArch64 k_done, end_label;
+
+    /* The column sum pointer is the first argument on the stack. */
+    if (do_sum)
+        ldr(SUM, ptr(sp));
+
+    preamble();
+
+    ldr(M, ptr(x0));
+    ldr(N, ptr(x1));
+    ldr(LDA, ptr(x3));
+    lsl(LDA4, LDA, 2);
+    lsr(G, M, 2);
+    and_(KR, M, 3);
+
+    ptrue(p_all.s);
+    dup(z_ones, 1);
+    mov(w3, 0x80);
+    dup(z_sign, w3);
+    cntw(VL);
+
+    L_aarch64(n_loop);
+    cbz(N, end_label);
+    mov(W, unroll_n);
+    cmp(N, W);
+    b(GE, n_width_done);
+    mov(W, N);
+    L_aarch64(n_width_done);
+
+    whilelt(p_lo.s, xzr, W);
+    whilelt(p_hi.s, VL, W);
+    lsl(W_BYTES, W, 2);
+
+    if (do_sum) {
+        eor(ZRegD(z_sum_lo.getIdx()), ZRegD(z_sum_lo.getIdx()),
+                ZRegD(z_sum_lo.getIdx()));
+        eor(ZRegD(z_sum_hi.getIdx()), ZRegD(z_sum_hi.getIdx()),
+                ZRegD(z_sum_hi.getIdx()));
+    }
+
+    mov(A_ROW[0], A);
+    mov(I, G);
+    cbz(I, k_tail);
+    L_aarch64(k_loop);
+    copy_group(4);
+    add(A_ROW[0], A_ROW[0], LDA4);
+    subs(I, I, 1);
+    b(NE, k_loop);
+
+    L_aarch64(k_tail);
+    cbz(KR, k_done);
+    cmp(KR, 1);
+    b(EQ, k_tail_1);
+    cmp(KR, 2);
+    b(EQ, k_tail_2);
+    copy_group(3);
+    b(k_done);
+    L_aarch64(k_tail_1);
+    copy_group(1);
+    b(k_done);
+    L_aarch64(k_tail_2);
+    copy_group(2);
+
+    L_aarch64(k_done);
+    if (do_sum) {
+        st1w(z_sum_lo, p_lo, ptr(SUM));
+        st1w(z_sum_hi, p_hi, ptr(SUM, 1, MUL_VL));
+        add(SUM, SUM, W_BYTES);
+    }
+
+    add(A, A, W);
+    sub(N, N, W);
+    b(n_loop);
+
+    L_aarch64(end_label);
+    postamble();
+
+    ready();
+}
+
+}
+}
+}
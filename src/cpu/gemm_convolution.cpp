@@ -42,15 +42,32 @@ struct im_pos_t {
                            || ic != prev.ic);
     }
 };
+
+struct im2col_panel_ctx_t {
+    const jit_gemm_conv_conf_t *jcp;
+    const float *src;
+    int sp, k;
+};
+
+void pack_im2col_panel(const void *ctx, int m_s, int m, int k_s, int k,
+        float *panel) {
+    auto c = (const im2col_panel_ctx_t *)ctx;
+    jit_gemm_convolution_utils::im2col_panel(*c->jcp, c->src, panel,
+            c->sp + m_s, m, c->k + k_s, k);
+}
 } // namespace
 
 void gemm_convolution_fwd_t::execute_forward() const {
     auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
     auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
-    auto bias = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto bias = pd()->with_bias()
+        ? reinterpret_cast<const data_t *>(this->input_memory(2)) : nullptr;
+    auto binary_src1 = reinterpret_cast<const data_t *>(
+            this->input_memory(pd()->binary_po_input_index(0)));
     auto dst = reinterpret_cast<data_t*>(this->memory());
 
     auto col = scratchpad().get<data_t>(key_conv_gemm_col);
+    auto implicit_a_ws = scratchpad().get<char>(key_conv_gemm_implicit_a);
 
     const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
 
@@ -112,8 +129,15 @@ void gemm_convolution_fwd_t::execute_forward() const {
             const data_t *_weights = weights + curr.g * weights_g_size
                     + curr.oc * weights_oc_size + curr.ic * jcp.ks;
 
-            extended_sgemm("N", "N", &m, &N, &K, &one, _source, &LDA, _weights,
-                    &LDB, &beta, _dst, &M);
+            if (jcp.use_implicit_gemm) {
+                const im2col_panel_ctx_t ctx
+                        = { &jcp, _src, curr.sp, curr.ic * jcp.ks };
+                sgemm_implicit_a("N", &m, &N, &K, pack_im2col_panel, &ctx,
+                        _weights, &LDB, &beta, _dst, &M,
+                        implicit_a_ws + ithr * jcp.implicit_a_ws_sz);
+            } else
+                extended_sgemm("N", "N", &m, &N, &K, &one, _source, &LDA,
+                        _weights, &LDB, &beta, _dst, &M);
             if (curr.ic == jcp.ic - step.ic) {
                 // TODO: for "outer threading" we have parallel section within
                 // outermost "parallel". It is not good. Consider to use
@@ -153,6 +177,15 @@ void gemm_convolution_fwd_t::execute_forward() const {
                         }
                     });
                 }
+                if (binary_) {
+                    parallel_nd(step.oc, [&](const int oc) {
+                        data_t *d_ = _dst + oc * M;
+                        const size_t off = d_ - dst;
+                        for (int oS = 0; oS < m; ++oS)
+                            d_[oS] = binary_->compute_scalar(d_[oS],
+                                    binary_src1, off + oS, oc_start + oc);
+                    });
+                }
             }
         };
         im_pos_t start, end;
@@ -228,7 +261,7 @@ void gemm_convolution_bwd_data_t::execute_backward_data() const {
 
         int g{0}, n{0};
         size_t start = 0, end = 0;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance_cmg(work_amount, nthr, ithr, start, end);
         nd_iterator_init(start, g, jcp.ngroups, n, jcp.mb);
         for (size_t iwork = start; iwork < end; ++iwork) {
 
@@ -287,12 +320,17 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights() const {
     const bool is_problem_3d = pd()->ndims() == 5;
 
     parallel(jcp.nthr, [&](const int ithr, const int nthr) {
-        int ithr_g, nthr_g, ithr_mb, nthr_mb;
+        int ithr_g, nthr_g, ithr_mb, nthr_mb, ithr_ic, nthr_ic;
         size_t g_start{0}, g_end{0}, mb_start{0}, mb_end{0};
+        int ic_start{0}, ic_end{0};
 
+        // The threads a group has left after the split over the batch take
+        // disjoint ic ranges, i.e. disjoint rows of the diff weights
         const int mb_for_balance = jcp.need_wei_reduction ? jcp.mb : 1;
+        const int ic_for_balance = is_problem_3d ? 1 : jcp.ic;
         jit_gemm_convolution_utils::bwd_weights_balance(ithr, nthr, jcp.ngroups,
-                mb_for_balance, ithr_g, nthr_g, ithr_mb, nthr_mb);
+                mb_for_balance, ic_for_balance, ithr_g, nthr_g, ithr_mb,
+                nthr_mb, ithr_ic, nthr_ic);
 
         assert(IMPLICATION(!jcp.need_wei_reduction, nthr_mb == 1));
         const int need_reduction = nthr_mb != 1;
@@ -300,6 +338,8 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights() const {
         if (ithr_g != -1 && ithr_mb != -1) {
             balance211((size_t)jcp.ngroups, nthr_g, ithr_g, g_start, g_end);
             balance211((size_t)jcp.mb, nthr_mb, ithr_mb, mb_start, mb_end);
+            balance211(ic_for_balance, nthr_ic, ithr_ic, ic_start, ic_end);
+            if (is_problem_3d) ic_end = jcp.ic;
 
             assert(IMPLICATION((g_end - g_start) > 1, need_reduction == 0));
 
@@ -316,9 +356,11 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights() const {
             data_t *weights_reduce = weights_reduce_base
                     + ithr_mb * weights_g_size;
 
+            const int m = (ic_end - ic_start) * jcp.ks;
             for (size_t g = g_start; g < g_end; ++g) {
-                data_t *_diff_weights = need_reduction
-                        ? weights_reduce : (diff_weights + g * weights_g_size);
+                data_t *_diff_weights = (need_reduction
+                        ? weights_reduce : (diff_weights + g * weights_g_size))
+                        + ic_start * jcp.ks;
                 for (size_t mb = mb_start; mb < mb_end; ++mb) {
                     const data_t *_src = src + (mb*jcp.ngroups+g)*src_step;
                     for (int od = 0; od < jcp.od; ++od) {
@@ -328,7 +370,8 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights() const {
                     if (jcp.im2col_sz) {
                         if (!is_problem_3d)
                             jit_gemm_convolution_utils::im2col<float>(
-                                    jcp, _src, _col, 0, jcp.os, 0, jcp.ic);
+                                    jcp, _src, _col, 0, jcp.os, ic_start,
+                                    ic_end - ic_start);
                         else
                             jit_gemm_convolution_utils::im2col_3d<float>(
                                     jcp, _src, _col, od);
@@ -336,8 +379,8 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights() const {
 
                     const data_t zero = 0.0, one = 1.0;
                     extended_sgemm(
-                        "T", "N", &M, &N, &k, &one,
-                        jcp.im2col_sz ? _col : _src + od * k,
+                        "T", "N", &m, &N, &k, &one,
+                        jcp.im2col_sz ? _col : _src + ic_start * K + od * k,
                         &LDA, _diff_dst, &K,
                         mb == mb_start && od == 0 ? &zero : &one,
                         _diff_weights, &M);
@@ -348,7 +391,8 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights() const {
                 mkldnn_thr_barrier();
                 data_t *weights_base = diff_weights + g_start * weights_g_size;
                 jit_gemm_convolution_utils::bwd_weights_reduction_par(
-                    ithr_mb, nthr_mb, jcp, weights_reduce_base, weights_base);
+                    ithr_ic * nthr_mb + ithr_mb, nthr_ic * nthr_mb, nthr_mb,
+                    jcp, weights_reduce_base, weights_base);
             }
         } else
             if (need_reduction) { mkldnn_thr_barrier(); }
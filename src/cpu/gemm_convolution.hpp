@@ -24,6 +24,7 @@
 #include "cpu_engine.hpp"
 #include "gemm_convolution_utils.hpp"
 #include "gemm/gemm.hpp"
+#include "ref_binary.hpp"
 #include "ref_eltwise.hpp"
 
 namespace mkldnn {
@@ -110,7 +111,17 @@ struct gemm_convolution_fwd_t: public cpu_primitive_t {
             { return po.entry_[idx].is_eltwise(); };
             auto is_sum = [&](int idx) { return po.entry_[idx].is_sum(); };
 
-            switch (po.len_) {
+            /* a binary post-op may close the chain */
+            int len = po.len_;
+            if (len > 0 && po.entry_[len - 1].is_binary()) {
+                if (get_binary_po_bcast(po.entry_[len - 1].binary.src1_desc,
+                            *this->dst_pd()->desc())
+                        == binary_po_bcast_unsupported)
+                    return false;
+                --len;
+            }
+
+            switch (len) {
             case 0: return true; // no post_ops
             case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
             case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
@@ -123,6 +134,7 @@ struct gemm_convolution_fwd_t: public cpu_primitive_t {
     gemm_convolution_fwd_t(const pd_t *apd, const input_vector &inputs,
            const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs, true), eltwise_(nullptr)
+        , binary_(nullptr)
     {
         const auto &post_ops = pd()->attr()->post_ops_;
         const data_t one = 1.0, zero = 0.0;
@@ -131,10 +143,15 @@ struct gemm_convolution_fwd_t: public cpu_primitive_t {
         const int entry_idx = post_ops.find(primitive_kind::eltwise);
         if (entry_idx != -1) eltwise_ = new ref_eltwise_scalar_fwd_t(
                 post_ops.entry_[entry_idx].eltwise);
+
+        const int binary_idx = post_ops.find(primitive_kind::binary);
+        if (binary_idx != -1) binary_ = new ref_binary_po_t(
+                post_ops.entry_[binary_idx].binary, *pd()->dst_pd()->desc());
     }
 
     ~gemm_convolution_fwd_t() {
         delete eltwise_;
+        delete binary_;
     }
 
     typedef typename prec_traits<data_type::f32>::type data_t;
@@ -151,6 +168,7 @@ private:
     data_t beta_;
 
     ref_eltwise_scalar_fwd_t* eltwise_;
+    ref_binary_po_t *binary_;
 };
 
 struct gemm_convolution_bwd_data_t: public cpu_primitive_t {
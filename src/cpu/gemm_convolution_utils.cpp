@@ -23,6 +23,7 @@
 #include "cpu_isa_traits.hpp"
 
 #include "gemm_convolution_utils.hpp"
+#include "gemm/gemm.hpp"
 #include "jit_generator.hpp"
 
 namespace mkldnn {
@@ -289,6 +290,44 @@ void im2col(const jit_gemm_conv_conf_t &jcp,
        const mkldnn_bfloat16_t *__restrict im,
        mkldnn_bfloat16_t *__restrict col, int hs, int hb, int ws, int wb);
 
+void im2col_panel(const jit_gemm_conv_conf_t &jcp, const float *__restrict im,
+        float *__restrict panel, int ss, int sb, int ks, int kb) {
+    const int dh = 1 + jcp.dilate_h;
+    const int dw = 1 + jcp.dilate_w;
+    const int sh = jcp.stride_h;
+    const int sw = jcp.stride_w;
+    const int tp = jcp.t_pad;
+    const int lp = jcp.l_pad;
+
+    for (int kk = 0; kk < kb; kk++) {
+        const int k = ks + kk;
+        const int ic = k / jcp.ks;
+        const int kh = (k % jcp.ks) / jcp.kw;
+        const int kw = k % jcp.kw;
+        const float *__restrict im_ic = im + (ptrdiff_t)ic * jcp.is;
+        float *__restrict col = panel + (ptrdiff_t)kk * sb;
+        const int iw_shift = kw * dw - lp;
+
+        int oh = ss / jcp.ow;
+        int ow = ss % jcp.ow;
+        for (int i = 0; i < sb; oh++, ow = 0) {
+            const int len = nstl::min(sb - i, jcp.ow - ow);
+            const int ih = oh * sh - tp + kh * dh;
+            if (ih < 0 || ih >= jcp.ih) {
+                for (int j = 0; j < len; j++)
+                    col[i + j] = 0.f;
+            } else {
+                const float *__restrict im_ = im_ic + ih * jcp.iw;
+                for (int j = 0; j < len; j++) {
+                    const int iw = (ow + j) * sw + iw_shift;
+                    col[i + j] = (iw < 0 || iw >= jcp.iw) ? 0.f : im_[iw];
+                }
+            }
+            i += len;
+        }
+    }
+}
+
 /* col[kh][kw][ic][oh][ow] <-- im2col_u8(im[ih][iw][ic]) */
 template <typename T>
 void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
@@ -467,78 +506,75 @@ void col2im_s32(const jit_gemm_conv_conf_t &jcp, const int32_t *__restrict col,
     });
 }
 
+/* Both col2im versions gather instead of scatter: every row of im is owned
+ * by one thread, which adds all the (kh, oh) contributions to it. Threads
+ * never write the same data, and the work splits over ic and the rows
+ * instead of over ic only. */
 void col2im_3d(const jit_gemm_conv_conf_t &jcp, const float *col, float *im,
         int od)
 {
-    parallel_nd(jcp.ic, [&](int ic) {
-        const float *__restrict col_ = col + (size_t)ic * jcp.ks * jcp.os;
-        float *__restrict im_ic = im + (size_t)ic * jcp.ih * jcp.iw * jcp.id;
+    const size_t col_step = (size_t)jcp.ks * jcp.os;
+    const size_t im_step = (size_t)jcp.ih * jcp.iw * jcp.id;
+    const int dh = 1 + jcp.dilate_h;
+    const int dw = 1 + jcp.dilate_w;
 
-        int id = od * jcp.stride_d - jcp.f_pad;
-        for (int kd = 0; kd < jcp.kd; ++kd) {
-            if (id < 0 || id >= jcp.id) {
-                col_ += jcp.kh * jcp.kw * jcp.os;
-                id += (1 + jcp.dilate_d);
-                continue;
-            }
+    // For a given od every kd hits a different id plane
+    parallel_nd(jcp.ic, jcp.kd, jcp.ih, [&](int ic, int kd, int ih) {
+        const int id = od * jcp.stride_d - jcp.f_pad + kd * (1 + jcp.dilate_d);
+        if (id < 0 || id >= jcp.id) return;
 
-            float *__restrict im_ = im_ic + id * jcp.ih * jcp.iw;
+        float *__restrict im_ = im + ic * im_step
+            + ((size_t)id * jcp.ih + ih) * jcp.iw;
+        const float *__restrict col_ = col + ic * col_step
+            + (size_t)kd * jcp.kh * jcp.kw * jcp.os;
 
-            for (int oh = 0; oh < jcp.oh; ++oh) {
-            for (int kh = 0; kh < jcp.kh; ++kh) {
-                const int ih = oh * jcp.stride_h - jcp.t_pad
-                    + kh * (1 + jcp.dilate_h);
-                if (ih < 0 || ih >= jcp.ih) continue;
+        for (int kh = 0; kh < jcp.kh; ++kh) {
+            const int ih_off = ih + jcp.t_pad - kh * dh;
+            if (ih_off < 0 || ih_off % jcp.stride_h) continue;
+            const int oh = ih_off / jcp.stride_h;
+            if (oh >= jcp.oh) continue;
 
+            for (int kw = 0; kw < jcp.kw; ++kw) {
+                const float *__restrict col_k
+                        = col_ + ((kh * jcp.kw + kw) * jcp.oh + oh) * jcp.ow;
                 for (int ow = 0; ow < jcp.ow; ++ow) {
-                for (int kw = 0; kw < jcp.kw; ++kw) {
-                    const int iw = ow * jcp.stride_w - jcp.l_pad
-                        + kw * (1 + jcp.dilate_w);
+                    const int iw = ow * jcp.stride_w - jcp.l_pad + kw * dw;
                     if (iw < 0 || iw >= jcp.iw) continue;
-
-                    const size_t col_idx =
-                        ((kh * jcp.kw + kw) * jcp.oh + oh) * jcp.ow + ow;
-                    const size_t im_idx = ih*jcp.iw + iw;
-                    im_[im_idx] += col_[col_idx];
-                }}
-            }}
-
-            col_ += jcp.kh * jcp.kw * jcp.os;
-            id += (1 + jcp.dilate_d);
+                    im_[iw] += col_k[ow];
+                }
+            }
         }
     });
 }
 
 void col2im(const jit_gemm_conv_conf_t &jcp, const float *col, float *im) {
-    const size_t col_step = jcp.ks * jcp.os;
-    const size_t im_step = jcp.ih * jcp.iw;
-    const int iS = jcp.ih * jcp.iw;
+    const size_t col_step = (size_t)jcp.ks * jcp.os;
+    const size_t im_step = (size_t)jcp.ih * jcp.iw;
+    const int dh = 1 + jcp.dilate_h;
+    const int dw = 1 + jcp.dilate_w;
 
-    parallel_nd(jcp.ic, [&](int ic) {
-        float *__restrict im_ = im + ic * im_step;
+    parallel_nd(jcp.ic, jcp.ih, [&](int ic, int ih) {
+        float *__restrict im_ = im + ic * im_step + (size_t)ih * jcp.iw;
         const float *__restrict col_ = col + ic * col_step;
         PRAGMA_OMP_SIMD()
-        for (int is = 0; is < iS; ++is) im_[is] = 0.;
+        for (int iw = 0; iw < jcp.iw; ++iw) im_[iw] = 0.;
 
         for (int kh = 0; kh < jcp.kh; ++kh) {
-        for (int oh = 0; oh < jcp.oh; ++oh) {
-            const int ih =
-                    oh * jcp.stride_h - jcp.t_pad + kh * (1 + jcp.dilate_h);
-            if (ih < 0 || ih >= jcp.ih) continue;
+            const int ih_off = ih + jcp.t_pad - kh * dh;
+            if (ih_off < 0 || ih_off % jcp.stride_h) continue;
+            const int oh = ih_off / jcp.stride_h;
+            if (oh >= jcp.oh) continue;
 
             for (int kw = 0; kw < jcp.kw; ++kw) {
-            for (int ow = 0; ow < jcp.ow; ++ow) {
-                const int iw =
-                        ow * jcp.stride_w - jcp.l_pad + kw * (1 + jcp.dilate_w);
-                if (iw < 0 || iw >= jcp.iw) continue;
-
-                const size_t col_idx = ((kh*jcp.kw + kw)*jcp.oh+oh)*jcp.ow+ow;
-                const size_t im_idx = ih*jcp.iw + iw;
-                im_[im_idx] += col_[col_idx];
-            }
+                const float *__restrict col_k
+                        = col_ + ((kh * jcp.kw + kw) * jcp.oh + oh) * jcp.ow;
+                for (int ow = 0; ow < jcp.ow; ++ow) {
+                    const int iw = ow * jcp.stride_w - jcp.l_pad + kw * dw;
+                    if (iw < 0 || iw >= jcp.iw) continue;
+                    im_[iw] += col_k[ow];
+                }
             }
         }
-        }
     });
 }
 
@@ -600,6 +636,8 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
         ? (ptrdiff_t)jcp.ic * jcp.ks * jcp.os : 0;
 
     jcp.outer_threading = false;
+    jcp.use_implicit_gemm = false;
+    jcp.implicit_a_ws_sz = 0;
 
     bool is_int8_conv = utils::one_of(src_d.data_type(), s32, s8, u8)
         && weights_d.data_type() == s8;
@@ -1056,6 +1094,17 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
             }
             if (jcp.im2col_sz)
                 jcp.im2col_sz = (ptrdiff_t)jcp.ic_block * jcp.ks * jcp.os_block;
+
+            // The panels of A are packed straight from src, no col buffer
+            jcp.use_implicit_gemm = jcp.im2col_sz && !is_3d && !is_bf16_conv
+                && implicit_sgemm_available();
+            if (jcp.use_implicit_gemm) {
+                jcp.im2col_sz = 0;
+                const int m = jcp.os_block;
+                const int n = jcp.oc_block;
+                const int k = jcp.ic_block * jcp.ks;
+                jcp.implicit_a_ws_sz = sgemm_implicit_a_ws_size(&m, &n, &k);
+            }
         } else if (is_bwd_d) {
             const size_t outer_work_amount = jcp.ngroups * jcp.mb;
             const float outer_thr_eff = (float)outer_work_amount
@@ -1079,6 +1128,10 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
             : sizeof(float);
         scratchpad.book(key_conv_gemm_col,
                 gemm_col_datatype_size * jcp.nthr * jcp.im2col_sz);
+        // a slot per thread of the convolution, or of the gemm when the
+        // convolution runs on a single thread
+        scratchpad.book(key_conv_gemm_implicit_a,
+                jcp.implicit_a_ws_sz * max_threads, PAGE_4K);
 
         const int sizeof_cacheline_float = 16;
         if (is_bwd_w) {
@@ -1130,7 +1183,24 @@ void bwd_weights_balance(int ithr, int nthr, int ngroups, int mb, int &ithr_g,
     }
 }
 
-void bwd_weights_reduction_par(int ithr, int nthr,
+void bwd_weights_balance(int ithr, int nthr, int ngroups, int mb, int ic,
+        int &ithr_g, int &nthr_g, int &ithr_mb, int &nthr_mb,
+        int &ithr_ic, int &nthr_ic) {
+    nthr_g = nstl::min(ngroups, nthr);
+    const int nthr_per_g = nthr / nthr_g;
+    nthr_mb = nstl::min(mb, nthr_per_g);
+    nthr_ic = nstl::max(1, nstl::min(ic, nthr_per_g / nthr_mb));
+    const int nthr_per_gi = nthr_mb * nthr_ic;
+    if (ithr / nthr_per_gi >= nthr_g) {
+        ithr_g = ithr_mb = ithr_ic = -1;
+    } else {
+        ithr_g = ithr / nthr_per_gi;
+        ithr_ic = (ithr % nthr_per_gi) / nthr_mb;
+        ithr_mb = ithr % nthr_mb;
+    }
+}
+
+void bwd_weights_reduction_par(int ithr, int nthr, int nbuf,
         const jit_gemm_conv_conf_t &jcp, const float *weights_reduce_ws,
         float *weights) {
     const size_t weights_g_size = jcp.ic * jcp.oc * jcp.ks;
@@ -1138,10 +1208,20 @@ void bwd_weights_reduction_par(int ithr, int nthr,
     size_t weights_start{0}, weights_end{0};
     balance211(weights_g_size, nthr, ithr, weights_start, weights_end);
 
-    for (int i = 0; i < nthr; ++i) {
-        const float *ws_i = weights_reduce_ws + i * weights_g_size;
-        for (size_t s = weights_start; s < weights_end; ++s)
-            weights[s] = (i == 0 ? 0 : weights[s]) + ws_i[s];
+    // Blocks small enough for the partial sum to stay in L1 while all
+    // the buffers are added to it
+    const size_t block = 1024;
+    for (size_t s0 = weights_start; s0 < weights_end; s0 += block) {
+        const size_t s1 = nstl::min(s0 + block, weights_end);
+        PRAGMA_OMP_SIMD()
+        for (size_t s = s0; s < s1; ++s)
+            weights[s] = weights_reduce_ws[s];
+        for (int i = 1; i < nbuf; ++i) {
+            const float *ws_i = weights_reduce_ws + i * weights_g_size;
+            PRAGMA_OMP_SIMD()
+            for (size_t s = s0; s < s1; ++s)
+                weights[s] += ws_i[s];
+        }
     }
 }
 
@@ -38,6 +38,12 @@ template <typename data_type_t>
 void im2col(const jit_gemm_conv_conf_t &jcp, const data_type_t *__restrict im,
        data_type_t *__restrict col, int ss, int sb, int cs, int cb);
 
+/* Writes the rows [ss, ss + sb) of the columns [ks, ks + kb) of the im2col
+ * matrix (spatial points by ic * kh * kw) as a gemm panel: column after
+ * column, sb values each. */
+void im2col_panel(const jit_gemm_conv_conf_t &jcp, const float *__restrict im,
+        float *__restrict panel, int ss, int sb, int ks, int kb);
+
 template <typename T>
 void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
         T* __restrict imtr, uint8_t *__restrict col,
@@ -56,7 +62,13 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
 
 void bwd_weights_balance(int ithr, int nthr, int ngroups, int mb,
         int &ithr_g, int &nthr_g, int &ithr_mb, int &nthr_mb);
-void bwd_weights_reduction_par(int ithr, int nthr,
+/* Also splits ic among the threads of a group that the batch leaves
+ * idle, every ic range owning disjoint rows of the diff weights. */
+void bwd_weights_balance(int ithr, int nthr, int ngroups, int mb, int ic,
+        int &ithr_g, int &nthr_g, int &ithr_mb, int &nthr_mb,
+        int &ithr_ic, int &nthr_ic);
+/* Sums nbuf partial diff weights, the work is split among nthr threads. */
+void bwd_weights_reduction_par(int ithr, int nthr, int nbuf,
         const jit_gemm_conv_conf_t &jcp, const float *weights_reduce_ws,
         float *weights);
 
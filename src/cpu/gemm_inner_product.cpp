@@ -34,7 +34,10 @@ template <impl::data_type_t data_type>
 void gemm_inner_product_fwd_t<data_type>::execute_forward() const {
     auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
     auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
-    auto bias = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto bias = pd()->with_bias()
+        ? reinterpret_cast<const data_t *>(this->input_memory(2)) : nullptr;
+    auto binary_src1 = reinterpret_cast<const float *>(
+            this->input_memory(pd()->binary_po_input_index(0)));
     auto dst = reinterpret_cast<data_t*>(this->memory());
 
     const int MB = pd()->MB();
@@ -55,7 +58,8 @@ void gemm_inner_product_fwd_t<data_type>::execute_forward() const {
         parallel(0, [&](int ithr, int nthr) {
             size_t start = 0, end = 0;
             balance211((size_t)OC * MB, nthr, ithr, start, end);
-            (*pp_kernel_)(dst, dst, (char *)bias, scales, start, end);
+            (*pp_kernel_)(dst, dst, (char *)bias, scales, start, end,
+                    binary_src1);
         });
     }
 }
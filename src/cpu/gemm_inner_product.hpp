@@ -55,22 +55,41 @@ struct gemm_inner_product_fwd_t: public cpu_primitive_t {
                         desc()->dst_desc.data_type)
                 && IMPLICATION(this->with_bias(),
                         data_type == desc()->bias_desc.data_type)
-                && attr()->post_ops_.len_ <= 1
-                && IMPLICATION(attr()->post_ops_.len_ == 1,
-                        attr()->post_ops_.entry_[0].is_eltwise())
                 && dense_gemm_consitency_check(src_pd(), weights_pd(),
-                        dst_pd());
+                        dst_pd())
+                && post_ops_ok();
             return ok ? status::success : status::unimplemented;
         }
+
+    protected:
+        bool post_ops_ok() const {
+            auto const &po = attr()->post_ops_;
+            auto is_eltwise = [&](int idx)
+            { return po.entry_[idx].is_eltwise(); };
+            auto is_binary = [&](int idx) {
+                return po.entry_[idx].is_binary()
+                    && get_binary_po_bcast(po.entry_[idx].binary.src1_desc,
+                            *dst_pd()->desc())
+                        != binary_po_bcast_unsupported;
+            };
+
+            switch (po.len_) {
+            case 0: return true; // no post_ops
+            case 1: return is_eltwise(0) || is_binary(0); // eltwise OR binary
+            case 2: return is_eltwise(0) && is_binary(1); // eltwise -> binary
+            default: return false;
+            }
+            return false;
+        }
     };
 
     gemm_inner_product_fwd_t(const pd_t *apd, const input_vector &inputs,
             const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs) {
         bool has_bias = pd()->with_bias(),
-             has_eltwise = pd()->attr()->post_ops_.len_ == 1,
+             has_post_ops = pd()->attr()->post_ops_.len_ > 0,
              has_scale = !pd()->attr()->output_scales_.has_default_values();
-        postops_in_ip_ = has_bias || has_eltwise || has_scale;
+        postops_in_ip_ = has_bias || has_post_ops || has_scale;
         pp_kernel_ = new inner_product_utils::pp_kernel_t<data_type, data_type>(
                 apd);
     }
@@ -35,6 +35,7 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(
     : ker_(nullptr)
     , eltwise_injector_(nullptr)
     , ref_eltwise_(nullptr)
+    , ref_binary_(nullptr)
     , bf16_emu_(nullptr)
     , OC_(pd->OC())
     , bias_data_type_(data_type::undef)
@@ -44,6 +45,7 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(
     , rmode_(round_mode::nearest)
     , do_bias_(pd->with_bias())
     , do_eltwise_(false)
+    , do_binary_(false)
     , isa_(isa_any)
     , max_OC_loop_unroll_(13)
     , idx_compute_vreg_start_(0)
@@ -67,6 +69,10 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(
     if (do_eltwise_)
         eltwise_ = p.entry_[eltwise_ind].eltwise;
 
+    /* the binary post-op is only applied by the fallback code */
+    const int binary_ind = p.find(primitive_kind::binary);
+    do_binary_ = binary_ind != -1;
+
     if (do_bias_) {
         bias_data_type_ = pd->desc()->bias_desc.data_type;
         assert(bias_data_type_ != data_type::undef);
@@ -75,7 +81,7 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(
     }
 
 #ifdef __ARM_ARCH
-    if ( mayiuse(avx512_core) && !mayiuse(sve)) {
+    if ( mayiuse(avx512_core) && !mayiuse(sve) && !do_binary_) {
         isa_ = mayiuse(avx512_core_bf16) ? avx512_core_bf16 : avx512_core;
         if (dst_type == data_type::bf16 && isa_ != avx512_core_bf16) {
             idx_compute_vreg_max_ = 27;
@@ -104,6 +110,9 @@ pp_kernel_t<acc_type, dst_type>::pp_kernel_t(
         if (do_eltwise_)
             ref_eltwise_ = new ref_eltwise_scalar_fwd_t(
                     eltwise_.alg, eltwise_.alpha, eltwise_.beta);
+        if (do_binary_)
+            ref_binary_ = new ref_binary_po_t(p.entry_[binary_ind].binary,
+                    *pd->dst_pd()->desc());
         return;
     }
 }
@@ -402,7 +411,7 @@ void pp_kernel_t<acc_type, dst_type>::generate()
 template <data_type_t acc_type, data_type_t dst_type>
 void pp_kernel_t<acc_type, dst_type>::operator()(dst_data_t *dst,
         const acc_data_t *acc, const char *bias, const float *scales,
-        size_t start, size_t end) {
+        size_t start, size_t end, const float *binary_src1) {
     using math::get_bias;
 
     if (end <= start)
@@ -430,6 +439,8 @@ void pp_kernel_t<acc_type, dst_type>::operator()(dst_data_t *dst,
                 d *= scales[oc * scale_idx_mult_];
             if (do_eltwise_)
                 d = ref_eltwise_->compute_scalar(d);
+            if (do_binary_)
+                d = ref_binary_->compute_scalar(d, binary_src1, i, oc);
             dst[i] = qz_a1b0<float, dst_data_t>()(d, rmode_);
             oc = (oc == OC_ - 1) ? 0 : oc + 1;
         }
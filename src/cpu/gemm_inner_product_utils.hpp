@@ -24,6 +24,7 @@
 #include "utils.hpp"
 #include "jit_generator.hpp"
 #include "jit_uni_eltwise.hpp"
+#include "ref_binary.hpp"
 #include "ref_eltwise.hpp"
 #include "jit_avx512_core_bf16cvt.hpp"
 
@@ -44,13 +45,15 @@ public:
             delete eltwise_injector_;
             delete ref_eltwise_;
         }
+        delete ref_binary_;
     }
 
     typedef typename prec_traits<acc_type>::type acc_data_t;
     typedef typename prec_traits<dst_type>::type dst_data_t;
 
     void operator()(dst_data_t *dst, const acc_data_t *acc, const char *bias,
-            const float *scales, size_t start, size_t end);
+            const float *scales, size_t start, size_t end,
+            const float *binary_src1 = nullptr);
 
 private:
     void generate();
@@ -72,6 +75,7 @@ private:
     void (*ker_)(const ker_args *args);
     jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
     ref_eltwise_scalar_fwd_t *ref_eltwise_;
+    ref_binary_po_t *ref_binary_;
     bf16_emulation_t *bf16_emu_;
 
     Xbyak::Reg64 reg_param = abi_param1;
@@ -105,6 +109,7 @@ private:
     round_mode_t rmode_;
     bool do_bias_;
     bool do_eltwise_;
+    bool do_binary_;
     cpu_isa_t isa_;
     int max_OC_loop_unroll_;
     int idx_compute_vreg_start_;
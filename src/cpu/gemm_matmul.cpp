@@ -0,0 +1,187 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+#include "gemm_matmul.hpp"
+#include "utils.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::utils;
+
+namespace gemm_matmul_utils {
+bool init_matrix_layout(matrix_layout_t &ml, const memory_desc_wrapper &md) {
+    if (!md.is_plain()) return false;
+
+    const int nd = md.ndims();
+    const int rows = md.dims()[nd - 2], cols = md.dims()[nd - 1];
+    const auto &strides = md.blocking_desc().strides[0];
+    /* the stride of a dimension of size 1 is meaningless */
+    const ptrdiff_t rs = rows == 1 ? cols : strides[nd - 2];
+    const ptrdiff_t cs = cols == 1 ? rows : strides[nd - 1];
+
+    if (cs == 1 && rs >= cols) {
+        ml.trans = false;
+        ml.ld = (int)rs;
+    } else if (rs == 1 && cs >= rows) {
+        ml.trans = true;
+        ml.ld = (int)cs;
+    } else {
+        return false;
+    }
+    if (ml.ld < 1) ml.ld = 1;
+    return true;
+}
+}
+
+namespace {
+/* strides of the dims of md with the broadcast ones (of size 1) zeroed */
+void broadcast_strides(ptrdiff_t *bstrides, const memory_desc_wrapper &md) {
+    for (int d = 0; d < md.ndims(); ++d)
+        bstrides[d] = md.dims()[d] == 1
+            ? 0 : md.blocking_desc().strides[0][d];
+}
+
+/* offset of the batch item b (enumerating the outer dims of dst) */
+ptrdiff_t batch_offset(int b, const ptrdiff_t *bstrides, const dims_t dims,
+        int nd) {
+    ptrdiff_t off = 0;
+    for (int d = nd - 3; d >= 0; --d) {
+        off += (b % dims[d]) * bstrides[d];
+        b /= dims[d];
+    }
+    return off;
+}
+}
+
+void gemm_matmul_t::execute_forward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto bias = pd()->with_bias()
+        ? reinterpret_cast<const data_t *>(this->input_memory(2)) : nullptr;
+    auto binary_src1 = reinterpret_cast<const data_t *>(
+            this->input_memory(pd()->binary_po_input_index(0)));
+    auto dst = reinterpret_cast<data_t*>(this->memory());
+
+    const memory_desc_wrapper src_d(pd()->src_pd());
+    const memory_desc_wrapper weights_d(pd()->weights_pd(0));
+    const memory_desc_wrapper bias_d(pd()->weights_pd(1));
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+
+    src += src_d.blocking_desc().offset_padding;
+    weights += weights_d.blocking_desc().offset_padding;
+    dst += dst_d.blocking_desc().offset_padding;
+    if (bias) bias += bias_d.blocking_desc().offset_padding;
+
+    const int nd = pd()->ndims();
+    const int M = pd()->M(), N = pd()->N(), K = pd()->K();
+    const int batch = pd()->batch();
+    const auto &dst_dims = dst_d.dims();
+
+    ptrdiff_t src_bs[TENSOR_MAX_DIMS], wei_bs[TENSOR_MAX_DIMS],
+              dst_bs[TENSOR_MAX_DIMS], bia_bs[TENSOR_MAX_DIMS] = {0};
+    broadcast_strides(src_bs, src_d);
+    broadcast_strides(wei_bs, weights_d);
+    broadcast_strides(dst_bs, dst_d);
+    if (bias) broadcast_strides(bia_bs, bias_d);
+
+    const auto &src_l = pd()->src_layout_;
+    const auto &wei_l = pd()->wei_layout_;
+    const int ldc = pd()->dst_layout_.ld;
+    /* dst is row major, i.e. dst^T (N x M) = weights^T * src^T in the column
+     * major notation of the gemm */
+    const char *transa = wei_l.trans ? "T" : "N";
+    const char *transb = src_l.trans ? "T" : "N";
+    const ptrdiff_t src_row_stride = src_l.trans ? 1 : src_l.ld;
+
+    const float scale = pd()->attr()->output_scales_.scales_[0];
+    const float beta = beta_;
+
+    /* bias, eltwise and binary on the rows [m0, m1) of the batch item b */
+    auto post_process = [&](int b, int m0, int m1) {
+        if (!bias && !eltwise_ && !binary_) return;
+        data_t *d = dst + batch_offset(b, dst_bs, dst_dims, nd);
+        const data_t *bia = bias
+            ? bias + batch_offset(b, bia_bs, dst_dims, nd) : nullptr;
+        for (int m = m0; m < m1; ++m) {
+            data_t *d_m = d + m * dst_bs[nd - 2];
+            const data_t *b_m = bia ? bia + m * bia_bs[nd - 2] : nullptr;
+            for (int n = 0; n < N; ++n) {
+                float v = d_m[n];
+                if (b_m) v += scale * b_m[n * bia_bs[nd - 1]];
+                if (eltwise_) v = eltwise_->compute_scalar(v);
+                if (binary_) v = binary_->compute_scalar(v, binary_src1,
+                        d_m - dst + n, n);
+                d_m[n] = v;
+            }
+        }
+    };
+
+    auto gemm = [&](int b, int m0, int m1) {
+        const data_t *s = src + batch_offset(b, src_bs, dst_dims, nd)
+            + m0 * src_row_stride;
+        const data_t *w = weights + batch_offset(b, wei_bs, dst_dims, nd);
+        data_t *d = dst + batch_offset(b, dst_bs, dst_dims, nd)
+            + m0 * dst_bs[nd - 2];
+        const int m = m1 - m0;
+        extended_sgemm(transa, transb, &N, &m, &K, &scale, w, &wei_l.ld,
+                s, &src_l.ld, &beta, d, &ldc);
+    };
+
+    if (batch == 1) {
+        /* the gemm threads itself */
+        gemm(0, 0, M);
+        if (bias || eltwise_ || binary_)
+            parallel_nd(M, [&](int m) { post_process(0, m, m + 1); });
+        return;
+    }
+
+    /* a batch item is split into row blocks only when the batch is too small
+     * to keep all the threads busy */
+    const int max_nthr = mkldnn_get_max_threads();
+    const int m_block_min = 32;
+    const int m_chunks = nstl::max(1,
+            nstl::min(div_up(max_nthr, batch), M / m_block_min));
+    const size_t work_amount = (size_t)batch * m_chunks;
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        int b{0}, mc{0};
+        nd_iterator_init(start, b, batch, mc, m_chunks);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            int m0{0}, m1{0};
+            balance211(M, m_chunks, mc, m0, m1);
+            gemm(b, m0, m1);
+            post_process(b, m0, m1);
+            nd_iterator_step(b, batch, mc, m_chunks);
+        }
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
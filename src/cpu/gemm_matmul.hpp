@@ -0,0 +1,153 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_GEMM_MATMUL_HPP
+#define CPU_GEMM_MATMUL_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_matmul_pd.hpp"
+#include "cpu_engine.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+#include "gemm/gemm.hpp"
+#include "ref_binary.hpp"
+#include "ref_eltwise.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace gemm_matmul_utils {
+/* Layout of the matrices of a plain tensor: ld is the distance between the
+ * rows, or between the columns if trans is set (column major matrices). */
+struct matrix_layout_t {
+    bool trans;
+    int ld;
+};
+
+bool init_matrix_layout(matrix_layout_t &ml, const memory_desc_wrapper &md);
+}
+
+/* f32 matmul on the gemm driver. The matrices of a batch are spread over the
+ * threads together with blocks of their rows, each running a sequential
+ * gemm; a single matrix is left to the threading of the gemm itself. */
+struct gemm_matmul_t: public cpu_primitive_t {
+    struct pd_t: public cpu_matmul_pd_t {
+        pd_t(engine_t *engine, const matmul_desc_t *adesc,
+                const primitive_attr_t *attr, const matmul_pd_t *hint_pd)
+            : cpu_matmul_pd_t(engine, adesc, attr, hint_pd) {}
+
+        DECLARE_COMMON_PD_T(GEMM_IMPL_STR, gemm_matmul_t);
+
+        virtual status_t init() override {
+            using namespace data_type;
+            using namespace gemm_matmul_utils;
+            assert(engine()->kind() == engine_kind::cpu);
+
+            bool ok = true
+                && this->set_default_params() == status::success
+                && !has_zero_dim_memory()
+                && utils::everyone_is(f32, desc()->src_desc.data_type,
+                        desc()->weights_desc.data_type,
+                        desc()->dst_desc.data_type)
+                && IMPLICATION(with_bias(),
+                        desc()->bias_desc.data_type == f32)
+                && attr()->output_scales_.mask_ == 0
+                && post_ops_ok()
+                && init_matrix_layout(src_layout_, src_pd())
+                && init_matrix_layout(wei_layout_, weights_pd(0))
+                && init_matrix_layout(dst_layout_, dst_pd())
+                && !dst_layout_.trans
+                && IMPLICATION(with_bias(),
+                        memory_desc_wrapper(weights_pd(1)).is_plain());
+            return ok ? status::success : status::unimplemented;
+        }
+
+        gemm_matmul_utils::matrix_layout_t src_layout_, wei_layout_,
+                dst_layout_;
+
+    protected:
+        bool post_ops_ok() const {
+            auto const &po = this->attr()->post_ops_;
+            auto is_eltwise = [&](int idx)
+            { return po.entry_[idx].is_eltwise(); };
+            auto is_sum = [&](int idx) { return po.entry_[idx].is_sum(false); };
+            /* the binary post-op broadcasts along the columns of dst */
+            auto is_binary = [&](int idx) {
+                return po.entry_[idx].is_binary()
+                    && get_binary_po_bcast(po.entry_[idx].binary.src1_desc,
+                            *this->dst_pd()->desc(), ndims() - 1)
+                        != binary_po_bcast_unsupported;
+            };
+
+            int len = po.len_;
+            if (len > 0 && is_binary(len - 1)) --len; // binary goes last
+
+            switch (len) {
+            case 0: return true; // no post_ops
+            case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
+            case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
+            default: return false;
+            }
+            return false;
+        }
+    };
+
+    gemm_matmul_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs), eltwise_(nullptr)
+        , binary_(nullptr)
+    {
+        const auto &post_ops = pd()->attr()->post_ops_;
+        const int sum_idx = post_ops.find(primitive_kind::sum);
+        beta_ = sum_idx >= 0 ? post_ops.entry_[sum_idx].sum.scale : 0.f;
+
+        const int entry_idx = post_ops.find(primitive_kind::eltwise);
+        if (entry_idx != -1) eltwise_ = new ref_eltwise_scalar_fwd_t(
+                post_ops.entry_[entry_idx].eltwise);
+
+        const int binary_idx = post_ops.find(primitive_kind::binary);
+        if (binary_idx != -1) binary_ = new ref_binary_po_t(
+                post_ops.entry_[binary_idx].binary, *pd()->dst_pd()->desc(),
+                pd()->ndims() - 1);
+    }
+    ~gemm_matmul_t() { delete eltwise_; delete binary_; }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    float beta_;
+    ref_eltwise_scalar_fwd_t *eltwise_;
+    ref_binary_po_t *binary_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,177 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "mkldnn.h"
+
+#include "utils.hpp"
+
+#include "cpu_isa_traits.hpp"
+#include "jit_code_cache.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+namespace jit_code_cache {
+
+namespace {
+const char magic[8] = {'M', 'K', 'L', 'D', 'N', 'N', 'J', 'C'};
+const uint32_t format_version = 2;
+
+/* Version of the generators of the cached kernels. The library hash may be
+ * "N/A", so it has to be bumped whenever the code a cached kernel emits for
+ * a given key changes. */
+const uint32_t key_version = 1;
+
+/* Kernels are a few pages of code, larger files are not ours */
+const size_t max_code_words = 16 * 1024 * 1024;
+
+struct header_t {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t reserved;
+    uint64_t key_size;
+    uint64_t code_words;
+    uint64_t checksum;
+};
+
+uint64_t fnv1a(const void *data, size_t size,
+        uint64_t h = 0xcbf29ce484222325ULL) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+const std::string &cache_dir() {
+    static const std::string dir = []() {
+        const int len = 4096;
+        char val[len] = {0};
+        if (mkldnn_getenv("MKLDNN_JIT_CACHE_DIR", val, len) > 0)
+            return std::string(val);
+        return std::string();
+    }();
+    return dir;
+}
+
+std::string file_name(const std::string &key) {
+    char hash[32];
+    snprintf(hash, sizeof(hash), "%016llx",
+            (unsigned long long)fnv1a(key.data(), key.size()));
+    return cache_dir() + "/mkldnn_jit_" + hash + ".bin";
+}
+}
+
+bool enabled() { return !cache_dir().empty(); }
+
+std::string make_key(const char *kernel_name, const void *conf,
+        size_t conf_size) {
+    const mkldnn_version_t *v = mkldnn_version();
+    const int32_t versions[]
+            = { (int32_t)key_version, v->major, v->minor, v->patch };
+
+    std::string key(kernel_name);
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char *>(versions), sizeof(versions));
+    key.append(v->hash);
+    key.push_back('\0');
+#ifdef __ARM_ARCH
+    const int vlen = get_sve_length();
+#else
+    const int vlen = 0;
+#endif
+    key.append(reinterpret_cast<const char *>(&vlen), sizeof(vlen));
+    key.append(static_cast<const char *>(conf), conf_size);
+    return key;
+}
+
+bool load(const std::string &key, std::vector<uint32_t> &code) {
+    if (!enabled()) return false;
+
+    FILE *fp = mkldnn_fopen(file_name(key).c_str(), "rb");
+    if (!fp) return false;
+
+    bool ok = false;
+    header_t h;
+    std::string file_key;
+    if (fread(&h, sizeof(h), 1, fp) == 1
+            && memcmp(h.magic, magic, sizeof(magic)) == 0
+            && h.format_version == format_version
+            && h.key_size == key.size()
+            && h.code_words > 0 && h.code_words <= max_code_words) {
+        file_key.resize(key.size());
+        code.resize(h.code_words);
+        ok = fread(&file_key[0], key.size(), 1, fp) == 1
+                && file_key == key
+                && fread(code.data(), sizeof(uint32_t) * code.size(), 1, fp)
+                        == 1
+                && fnv1a(code.data(), sizeof(uint32_t) * code.size())
+                        == h.checksum;
+    }
+    fclose(fp);
+
+    if (!ok) code.clear();
+    return ok;
+}
+
+/* The file is written under a temporary name and renamed, so a concurrent
+ * reader sees either no file or a complete one. Failures are not fatal. */
+void store(const std::string &key, const uint32_t *code, size_t n_words) {
+    if (!enabled() || code == nullptr || n_words == 0
+            || n_words > max_code_words)
+        return;
+
+    header_t h;
+    memcpy(h.magic, magic, sizeof(magic));
+    h.format_version = format_version;
+    h.reserved = 0;
+    h.key_size = key.size();
+    h.code_words = n_words;
+    h.checksum = fnv1a(code, sizeof(uint32_t) * n_words);
+
+    const std::string name = file_name(key);
+    static std::atomic<int> counter(0);
+    char suffix[48];
+    snprintf(suffix, sizeof(suffix), ".%d.%d.tmp", (int)getpid(),
+            counter++);
+    const std::string tmp_name = name + suffix;
+
+    FILE *fp = mkldnn_fopen(tmp_name.c_str(), "wb");
+    if (!fp) return;
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1
+            && fwrite(key.data(), key.size(), 1, fp) == 1
+            && fwrite(code, sizeof(uint32_t) * n_words, 1, fp) == 1;
+    ok = fclose(fp) == 0 && ok;
+
+    if (!ok || rename(tmp_name.c_str(), name.c_str()) != 0)
+        remove(tmp_name.c_str());
+}
+
+}
+}
+}
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_CODE_CACHE_HPP
+#define CPU_JIT_CODE_CACHE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Persistent cache of generated AArch64 code, kept across processes.
+ *
+ * It is enabled by setting MKLDNN_JIT_CACHE_DIR to a writable directory.
+ * Each kernel is stored in its own file named after a hash of its key; the
+ * file also holds the full key and a checksum of the code, and any
+ * mismatch makes the kernel be generated again.
+ *
+ * Only kernels whose code is position independent may use the cache: the
+ * code is restored into a new buffer, so absolute addresses of data or of
+ * the code buffer itself would be stale. */
+namespace jit_code_cache {
+
+bool enabled();
+
+/* The key is made of the kernel name, its configuration, the cache key
+ * version, the library version and the vector length of the machine.
+ *
+ * The configuration is hashed bytewise: it must hold only the inputs of the
+ * code generation, with no padding bytes and no run time sizes such as the
+ * minibatch or the number of threads, or the cache would never hit. */
+std::string make_key(const char *kernel_name, const void *conf,
+        size_t conf_size);
+
+bool load(const std::string &key, std::vector<uint32_t> &code);
+void store(const std::string &key, const uint32_t *code, size_t n_words);
+
+}
+
+}
+}
+}
+
+#endif
@@ -38,6 +38,7 @@
 #include <limits.h>
 #include "cpu_isa_traits.hpp"
 
+#include "nstl.hpp"
 #include "utils.hpp"
 #include "mkldnn_thread.hpp"
 
@@ -186,9 +187,13 @@ inline unsigned int get_cache_size(int level, bool per_core = true){
         const int L1_cache_per_core = 65536;
         const int L2_cache_per_CMG = 8388608;
         int num_cores = per_core ? 1 : nthreads;
+        // The team spreads over the CMGs it runs on, each bringing its
+        // own L2, and needs at least one CMG per 12 cores
+        const int num_cmgs = nstl::max(mkldnn_get_team_cmgs(num_cores),
+                utils::div_up(num_cores, 12));
         switch (l) {
         case (0): return L1_cache_per_core * num_cores;
-        case (1): return L2_cache_per_CMG * utils::div_up(num_cores, 12);
+        case (1): return L2_cache_per_CMG * num_cmgs;
         default: return 0;
         }
     }
@@ -38,9 +38,15 @@
 #include "cpu_isa_traits.hpp"
 #include <limits.h>
 
+#include <string>
+#include <vector>
+
 #include "mkldnn_thread.hpp"
+#include "nstl.hpp"
 #include "utils.hpp"
 
+#include "jit_code_cache.hpp"
+
 #ifdef JIT_PROFILING_VTUNE
 #include "jitprofiling.h"
 #endif
@@ -141,13 +147,17 @@ inline unsigned int get_A64FX_cache_size_aarch64(int level, bool per_core = true
         const int L1_cache_per_core = 65536;
         const int L2_cache_per_CMG = 8388608;
         int num_cores = per_core ? 1 : nthreads;
+        // The team spreads over the CMGs it runs on, each bringing its
+        // own L2, and needs at least one CMG per 12 cores
+        const int num_cmgs = nstl::max(mkldnn_get_team_cmgs(nthreads),
+                utils::div_up(nthreads, 12));
         switch (l) {
         case (0): return L1_cache_per_core * num_cores;
         case (1):
 	  if (per_core) {
-	    return (L2_cache_per_CMG * utils::div_up(num_cores, 12)) / nthreads;
+	    return (L2_cache_per_CMG * num_cmgs) / nthreads;
 	  } else {
-	    return L2_cache_per_CMG * utils::div_up(num_cores, 12);
+	    return L2_cache_per_CMG * num_cmgs;
 	  }
         default: return 0;
         }
@@ -1426,6 +1436,11 @@ public:
 #endif
     }
 
+    /* Key of the kernel in the persistent code cache, empty if the kernel
+     * does not use it */
+    std::string code_cache_key_;
+    bool code_from_cache_ = false;
+
 public:
     jit_generator_aarch64(void *code_ptr = nullptr, size_t code_size = 256 * 1024)
         : Xbyak::Xbyak_aarch64::CodeGeneratorAArch64(code_size, code_ptr) {
@@ -1440,10 +1455,28 @@ public:
 
     // XXX: use normal_case name and update all callees (?)
 
+    /* Restores the code of the kernel from the persistent code cache, see
+     * jit_code_cache.hpp. Position independent kernels opt in by calling
+     *     if (!load_cached_code(&conf, sizeof(conf))) generate();
+     * and the code generated on a miss is stored by getCode32(). */
+    bool load_cached_code(const void *conf, size_t conf_size) {
+        if (!jit_code_cache::enabled()) return false;
+        code_cache_key_ = jit_code_cache::make_key(name(), conf, conf_size);
+        std::vector<uint32_t> code;
+        if (!jit_code_cache::load(code_cache_key_, code)) return false;
+        for (size_t i = 0; i < code.size(); i++)
+            dd(code[i]);
+        code_from_cache_ = true;
+        return true;
+    }
+
     const uint32_t *getCode32() {
         const uint32_t *code = CodeGeneratorAArch64::getCode32();
         register_code(code);
 
+        if (!code_cache_key_.empty() && !code_from_cache_)
+            jit_code_cache::store(code_cache_key_, code, getSize());
+
         if (mkldnn_jit_dump())
             dump_code(code);
 
@@ -0,0 +1,65 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_KERNEL_CACHE_HPP
+#define CPU_JIT_KERNEL_CACHE_HPP
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#include "c_types_map.hpp"
+#include "primitive_attr.hpp"
+#include "primitive_cache.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+typedef lru_cache_t<std::shared_ptr<void>> jit_kernel_cache_t;
+
+inline jit_kernel_cache_t &jit_kernel_cache() {
+    static jit_kernel_cache_t cache;
+    return cache;
+}
+
+/* Returns the kernel generated for the configuration @p conf and the
+ * attributes @p attr, creating it as kernel_t(conf, args...) on a miss.
+ *
+ * The kernel is shared by all the primitives created for the same
+ * configuration, so it must not be modified after generation. The
+ * configuration is compared bytewise; it is value-initialized by the
+ * primitive descriptors, so differences in padding may only cause misses. */
+template <typename kernel_t, typename conf_t, typename... args_t>
+std::shared_ptr<kernel_t> get_jit_kernel(const conf_t &conf,
+        const primitive_attr_t *attr, const args_t &... args) {
+    std::string key(typeid(kernel_t).name());
+    key.append(reinterpret_cast<const char *>(&conf), sizeof(conf));
+    append_attr_to_key(key, attr);
+
+    std::shared_ptr<void> kernel;
+    if (!jit_kernel_cache().get(key, kernel)) {
+        kernel = std::make_shared<kernel_t>(conf, args...);
+        jit_kernel_cache().add(key, kernel);
+    }
+    return std::static_pointer_cast<kernel_t>(kernel);
+}
+
+}
+}
+}
+
+#endif
@@ -75,8 +75,11 @@ struct jit_conv_conf_t {
     bool with_bias;
     bool with_sum;
     bool with_eltwise;
+    bool with_binary;
 
     post_ops_t::entry_t::eltwise_t eltwise;
+    alg_kind_t binary_alg;
+    binary_po_bcast_t binary_bcast;
 
     int nthr, nthr_mb, nthr_g, nthr_oc_b, nthr_ic_b;
 
@@ -282,6 +285,8 @@ struct jit_conv_call_s {
     const void *scales;
     const void *acc_s32;
     const void *compensation;
+    const void *binary_src1;
+    const void *binary_src1_prf;
     size_t kd_offset;
     size_t kd_offset_prf;
     size_t kh_offset;
@@ -364,8 +369,11 @@ struct jit_1x1_conv_conf_t {
     bool with_bias;
     bool with_sum;
     bool with_eltwise;
+    bool with_binary;
 
     post_ops_t::entry_t::eltwise_t eltwise;
+    alg_kind_t binary_alg;
+    binary_po_bcast_t binary_bcast;
 
     int is, os;
     int ic_block, oc_block;
@@ -378,6 +386,11 @@ struct jit_1x1_conv_conf_t {
         nb_load_blocking, nb_load_blocking_max, nb_load_chunk;
     int bcast_dim, bcast_block, nb_bcast,
         nb_bcast_blocking, nb_bcast_blocking_max;
+    /* distance (in points) between two channel blocks of the output: either
+     * bcast_dim or the size of the band of rows of a fused depthwise conv */
+    int output_bcast_dim;
+    bool with_dw_conv;
+    int dw_conv_band_h;
 
     int reduce_loop_unroll, reduce_loop_bcast_step, reduce_loop_load_step;
     int load_loop_load_step, load_loop_iter_step;
@@ -434,6 +447,8 @@ struct jit_gemm_conv_conf_t {
     bool outer_threading;
     conv_gemm_loop_order_t loop_order;
     int nthr_oc;
+    bool use_implicit_gemm; /* no col buffer, gemm packs A from src */
+    size_t implicit_a_ws_sz; /* sgemm_implicit_a buffers per thread */
 };
 
 struct jit_1x1_conv_call_s {
@@ -444,6 +459,7 @@ struct jit_1x1_conv_call_s {
     const void *acc_s32;
     const void *scales;
     const void *compensation;
+    const void *binary_src1; // used in forward only
 
     size_t load_dim;
     size_t bcast_dim;
@@ -500,6 +516,78 @@ struct jit_pool_call_s {
     float ker_area_h;
 };
 
+/* softmax */
+struct jit_softmax_conf_t {
+    int is_fwd;
+    int is_log;
+    int is_online; /* max and sum in one pass */
+    int vectorize_inner; /* lanes along the inner dims, else along the axis */
+    int simd_w;
+    int unroll;
+
+    dim_t outer_size, axis_size, inner_size;
+    dim_t axis_blk; /* contiguous elements of the axis in a run */
+    dim_t axis_stride; /* between the runs, or between the axis points */
+    dim_t inner_stride;
+};
+
+struct jit_softmax_call_s {
+    const float *src; /* dst on backward */
+    const float *diff_dst;
+    float *dst; /* diff_src on backward */
+    size_t work; /* valid inner points when vectorize_inner */
+};
+
+/* layer normalization */
+struct jit_lnorm_conf_t {
+    int is_fwd;
+    int use_scaleshift;
+    int calculate_stats; /* else use_global_stats */
+    int save_stats; /* forward training */
+    int calculate_diff_ss; /* backward with scaleshift */
+    int simd_w;
+    int unroll;
+
+    dim_t C; /* normalized axis */
+    dim_t row_stride; /* of the data, the statistics are dense */
+    float eps;
+};
+
+struct jit_lnorm_call_s {
+    const float *src;
+    const float *diff_dst;
+    float *dst; /* diff_src on backward */
+    float *mean;
+    float *var;
+    const float *scale_shift;
+    float *diff_scale_shift; /* accumulated, per thread */
+    size_t rows; /* rows of the call */
+};
+
+/* binary */
+enum jit_binary_bcast_t {
+    binary_bcast_none, /* src1 runs along src0 */
+    binary_bcast_scalar, /* one element of src1 for the call */
+    binary_bcast_vector, /* one vector of src1 repeated over the call */
+};
+
+/* The kernel only depends on the operation, the shapes are handled by the
+ * driver which splits dst in runs of contiguous elements. */
+struct jit_binary_conf_t {
+    alg_kind_t alg;
+    jit_binary_bcast_t bcast;
+    int simd_w;
+    int unroll;
+};
+
+struct jit_binary_call_s {
+    const float *src0;
+    const float *src1;
+    float *dst;
+    size_t len; /* elements of the run */
+    size_t src1_len; /* valid elements of the src1 vector */
+};
+
 
 }
 }
@@ -148,7 +148,7 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
         int ofs = jcp.typesize_out * jcp.oc_block * i_load;
         if((VL_OFS(ofs) <= LDRMAX) &&
            (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-           ((ofs&0x3f)==0)){
+           VL_ALIGNED(ofs)){
 
             CGA64::ldr(vreg_accum(i_load, i_ur),
                        xa::ptr(reg_bias_data, static_cast<int32_t>(VL_OFS(ofs))));
@@ -158,13 +158,36 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
         }
     };
 
+    auto binary_load = [=](int i_load) {
+        int ofs = jcp.typesize_out * jcp.oc_block * i_load;
+        if((VL_OFS(ofs) <= LDRMAX) &&
+           (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
+           VL_ALIGNED(ofs)){
+            CGA64::ldr(vreg_sum(), xa::ptr(reg_binary_data,
+                        static_cast<int32_t>(VL_OFS(ofs))));
+        }else{
+            CGA64::add_imm(reg_tmp_ofs, reg_binary_data, ofs, reg_tmp_imm);
+            CGA64::ldr(vreg_sum(), xa::ptr(reg_tmp_ofs));
+        }
+    };
+
+    auto binary_op = [=](xa::ZRegS z, xa::ZRegS rhs) {
+        switch (jcp.binary_alg) {
+        case alg_kind::binary_add: CGA64::fadd(z, z, rhs); break;
+        case alg_kind::binary_mul: CGA64::fmul(z, z, rhs); break;
+        case alg_kind::binary_max: CGA64::fmax(z, reg_p_all_ones, rhs); break;
+        case alg_kind::binary_min: CGA64::fmin(z, reg_p_all_ones, rhs); break;
+        default: assert(!"unsupported binary post-op");
+        }
+    };
+
     auto prefetch_output = [=](int i_load, int i_ur) {
       int ofs;
       int bwd_iload = (i_load != 0) && one_of(jcp.prop_kind, backward_weights);
       auto r = (bwd_iload) ? reg_tmp_ofs : aux_reg_output_data;
       if (one_of(jcp.prop_kind, forward_training, forward_inference,
                  backward_data)){
-        ofs = (i_load * jcp.bcast_dim + i_ur) * jcp.load_block * jcp.typesize_out;
+        ofs = (i_load * jcp.output_bcast_dim + i_ur) * jcp.load_block * jcp.typesize_out;
       }else{
         ofs = jcp.typesize_out * jcp.load_block * i_ur;
       }
@@ -324,7 +347,7 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
       ofs = u1 * jcp.reduce_loop_load_step + jcp.typesize_in * ofs;
 
       if((VL_OFS(ofs) <= LDRMAX) && (VL_OFS(ofs) >= (-1* LDRMAX)) &&
-         ((ofs&0x3f)==0)){
+         VL_ALIGNED(ofs)){
         ofs = VL_OFS(ofs);
         CGA64::ldr(vreg_load(i_load, i_fma), xa::ptr(aux_reg_load_data, static_cast<int32_t>(ofs)));
       }else{
@@ -339,7 +362,7 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
       auto r = (bwd_iload) ? reg_tmp_ofs : aux_reg_output_data;
       if (one_of(jcp.prop_kind, forward_training, forward_inference,
                  backward_data)){
-        ofs = (i_load * jcp.bcast_dim + i_ur) * jcp.load_block * jcp.typesize_out;
+        ofs = (i_load * jcp.output_bcast_dim + i_ur) * jcp.load_block * jcp.typesize_out;
       }else{
         ofs = jcp.typesize_out * jcp.load_block * i_ur;
       }
@@ -348,7 +371,7 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
       if(bwd_iload) CGA64::mov(r, i_load);
       if((VL_OFS(ofs) <= LDRMAX) &&
          (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-         ((ofs&0x3f)==0)){
+         VL_ALIGNED(ofs)){
         if(bwd_iload) CGA64::madd(r, r, reg_output_stride, aux_reg_output_data);
         CGA64::ldr(vreg_sum(), xa::ptr(r, static_cast<int32_t>(VL_OFS(ofs))));
       }else{
@@ -382,7 +405,7 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
       auto r = (bwd_iload) ? reg_tmp_ofs : aux_reg_output_data;
       if (one_of(jcp.prop_kind, forward_training, forward_inference,
                  backward_data)){
-        ofs = (i_load * jcp.bcast_dim + i_ur) * jcp.load_block * jcp.typesize_out;
+        ofs = (i_load * jcp.output_bcast_dim + i_ur) * jcp.load_block * jcp.typesize_out;
       }else{
         ofs = jcp.typesize_out * jcp.load_block * i_ur;
       }
@@ -391,7 +414,7 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
       if(bwd_iload) CGA64::mov(r, i_load);
       if((VL_OFS(ofs) <= LDRMAX) &&
          (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-         ((ofs&0x3f)==0)){
+         VL_ALIGNED(ofs)){
         if(bwd_iload) CGA64::madd(r, r, reg_output_stride, aux_reg_output_data);
         if (jcp.use_vmovntps)
           CGA64::stnt1w(vreg_accum_s(i_load, i_ur), reg_p_all_ones, xa::ptr(r, static_cast<int32_t>(VL_OFS(ofs))));
@@ -452,6 +475,24 @@ void jit_sve_1x1_conv_kernel::reduce_loop(int load_loop_blk,
 
             CGA64::L_aarch64(store_noeltwise);
         }
+        if (jcp.with_binary) {
+            xa::LabelAArch64 store_nobinary;
+            CGA64::tst(reg_reduce_pos_flag, FLAG_REDUCE_LAST);
+            CGA64::b(xa::EQ, store_nobinary);
+
+            /* vreg_sum is free once the sum is done */
+            const bool per_oc = jcp.binary_bcast == binary_po_bcast_per_oc;
+            if (!per_oc)
+                CGA64::ld1rw(vreg_sum_s(), reg_p_all_ones,
+                        xa::ptr(reg_binary_data));
+            for (int i_load = 0; i_load < load_loop_blk; ++i_load) {
+                if (per_oc) binary_load(i_load);
+                for (int i_ur = 0; i_ur < ur; ++i_ur)
+                    binary_op(vreg_accum_s(i_load, i_ur), vreg_sum_s());
+            }
+
+            CGA64::L_aarch64(store_nobinary);
+        }
 
         prev_ofs = -1;
         for (int i_ur = 0; i_ur < ur; ++i_ur)
@@ -672,6 +713,8 @@ void jit_sve_1x1_conv_kernel::generate() {
     /* Pointer indicates bias data if the layer has bias option */
     if (jcp.with_bias)
         CGA64::ldr(reg_bias_data, xa::ptr(abi_param1_aarch64, GET_OFF(bias_data)));
+    if (jcp.with_binary)
+        CGA64::ldr(reg_binary_data, xa::ptr(abi_param1_aarch64, GET_OFF(binary_src1)));
 
     /* Get workloads of each loop */
     CGA64::ldr(reg_load_loop_work, xa::ptr(abi_param1_aarch64, GET_OFF(load_dim)));
@@ -699,13 +742,15 @@ void jit_sve_1x1_conv_kernel::generate() {
           case forward_inference:
               /* Calculate the address of the bias for the next bcast_loop */
               CGA64::add_imm(reg_bias_data, reg_bias_data, load_loop_blk * jcp.load_block * jcp.typesize_out, reg_tmp_imm);
+              if (jcp.with_binary && jcp.binary_bcast == binary_po_bcast_per_oc)
+                  CGA64::add_imm(reg_binary_data, reg_binary_data, load_loop_blk * jcp.load_block * jcp.typesize_out, reg_tmp_imm);
 
-              CGA64::add_imm(reg_output_data, reg_output_data, load_loop_blk * jcp.bcast_dim * jcp.load_block *jcp.typesize_out, reg_tmp_imm);
+              CGA64::add_imm(reg_output_data, reg_output_data, load_loop_blk * jcp.output_bcast_dim * jcp.load_block *jcp.typesize_out, reg_tmp_imm);
               break;
           case backward_data:
               /* Calculate the address of the weight for the next bcast_loop */
               CGA64::add_imm(reg_output_data, reg_output_data,
-                        load_loop_blk * jcp.bcast_dim * jcp.load_block * jcp.typesize_out, reg_tmp_imm);
+                        load_loop_blk * jcp.output_bcast_dim * jcp.load_block * jcp.typesize_out, reg_tmp_imm);
               break;
           case backward_weights:
               for (int i_load = 0; i_load < load_loop_blk; i_load++){
@@ -718,7 +763,7 @@ void jit_sve_1x1_conv_kernel::generate() {
         CGA64::sub(reg_load_loop_work, reg_load_loop_work, load_loop_blk * jcp.load_loop_iter_step);
     };
 
-    const int simd_w = 16; // The length of a vector instructions (512-bit)
+    const int simd_w = jcp.oc_block; // The length of a vector in floats
 
     xa::LabelAArch64 load_loop_blk[7];
 
@@ -781,7 +826,10 @@ bool jit_sve_1x1_conv_kernel::post_ops_ok(
     auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
     auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
 
-    switch (p.len_) {
+    int len = p.len_;
+    if (len > 0 && p.entry_[len - 1].is_binary()) --len; // binary goes last
+
+    switch (len) {
     case 0: return true; // no post_ops
     case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
     case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
@@ -798,8 +846,11 @@ status_t jit_sve_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
     if (!mayiuse(sve)) return status::unimplemented;
 
     const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
-    const int simd_w = cpu_isa_traits<sve>::vlen / sizeof(float);
+    const int simd_w = get_sve_length() / sizeof(float);
     const int ndims = src_d.ndims();
+    /* Blocked layouts follow the vector length: 16c for 512-bit and 8c for
+     * 256-bit machines */
+    if (!sve_length_supported()) return status::unimplemented;
     /* Forward_[training, inference], backward_[data, weight] */
     jcp.prop_kind = cd.prop_kind;
 
@@ -863,12 +914,32 @@ status_t jit_sve_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
     if (jcp.with_eltwise) {
       jcp.eltwise = p.entry_[eltwise_ind].eltwise;
       if (dst_d.data_type() == data_type::s32) return status::unimplemented;
+      // The eltwise injector works on 512-bit registers only
+      if (simd_w != 16) return status::unimplemented;
+    }
+
+    const int binary_ind = p.find(primitive_kind::binary);
+    jcp.with_binary = binary_ind != -1;
+    if (jcp.with_binary) {
+      /* the kernel reads either one value or one value per channel */
+      const auto &binary = p.entry_[binary_ind].binary;
+      jcp.binary_alg = binary.alg;
+      jcp.binary_bcast = get_binary_po_bcast(binary.src1_desc, *dst_d._md);
+      bool binary_ok = true
+          && dst_d.data_type() == data_type::f32
+          && one_of(jcp.binary_bcast, binary_po_bcast_per_oc,
+                  binary_po_bcast_per_tensor)
+          && IMPLICATION(jcp.binary_bcast == binary_po_bcast_per_oc,
+                  jcp.oc == jcp.oc_without_padding);
+      if (!binary_ok) return status::unimplemented;
     }
 
+    const auto dat_format = simd_w == 16
+        ? pick(ndims - 3, nCw16c, nChw16c)
+        : pick(ndims - 3, nCw8c, nChw8c);
     bool args_ok = true
         && jcp.ngroups == 1
-        && everyone_is(pick(ndims - 3, nCw16c, nChw16c), src_d.format(),
-            dst_d.format())
+        && everyone_is(dat_format, src_d.format(), dst_d.format())
         && one_of(cd.bias_desc.format, memory_format::undef, any, x);
     if (!args_ok) return status::unimplemented;
 
@@ -887,11 +958,17 @@ status_t jit_sve_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
                             weights_d.data_type(), dst_d.data_type()))
     {
         const int is_bwd_d = jcp.prop_kind == backward_data;
-        memory_format_t weights_format = with_groups
-            ? pick(2 * ndims - 6 + is_bwd_d, gOIw16i16o, gIOw16o16i,
-                gOIhw16i16o, gIOhw16o16i)
-            : pick(2 * ndims - 6 + is_bwd_d, OIw16i16o, IOw16o16i,
-                OIhw16i16o, IOhw16o16i);
+        /* There are no IO*8o8i layouts for backward data on 256-bit */
+        if (simd_w == 8 && is_bwd_d) return status::unimplemented;
+        memory_format_t weights_format = simd_w == 16
+            ? (with_groups
+                ? pick(2 * ndims - 6 + is_bwd_d, gOIw16i16o, gIOw16o16i,
+                    gOIhw16i16o, gIOhw16o16i)
+                : pick(2 * ndims - 6 + is_bwd_d, OIw16i16o, IOw16o16i,
+                    OIhw16i16o, IOhw16o16i))
+            : (with_groups
+                ? pick(ndims - 3, gOIw8i8o, gOIhw8i8o)
+                : pick(ndims - 3, OIw8i8o, OIhw8i8o));
 
         if (weights_d.format() != weights_format)
             return status::unimplemented;
@@ -1290,6 +1367,10 @@ status_t jit_sve_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
 
     jcp.ur_tail = jcp.bcast_dim % jcp.ur;
 
+    jcp.output_bcast_dim = jcp.bcast_dim;
+    jcp.with_dw_conv = false;
+    jcp.dw_conv_band_h = 0;
+
     jcp.nb_bcast_blocking = bcast_blocking / jcp.bcast_block;
     jcp.nb_bcast_blocking_max = bcast_blocking_max / jcp.bcast_block;
     jcp.nb_load_blocking = load_blocking / jcp.load_block;
@@ -1311,6 +1392,34 @@ status_t jit_sve_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
     return status::success;
 }
 
+/* The output goes to a band of dw_conv_band_h rows of nb_ch_blocking
+ * channel blocks of the fused depthwise convolution instead of dst */
+status_t jit_sve_1x1_conv_kernel::init_dw_conv_conf(jit_1x1_conv_conf_t &jcp,
+        const jit_conv_conf_t &jcp_dw, int nthreads) {
+    bool ok = true
+        && one_of(jcp.prop_kind, forward_training, forward_inference)
+        && jcp.oc_block == jcp_dw.ch_block
+        && jcp.oc == jcp_dw.oc
+        && jcp.oh == jcp_dw.ih && jcp.ow == jcp_dw.iw;
+    if (!ok) return status::unimplemented;
+
+    /* keep the band in a half of the thread share of L2 */
+    const size_t L2_size = get_A64FX_cache_size(2, false, nthreads) / nthreads;
+    const size_t row_size = (size_t)jcp_dw.nb_ch_blocking * jcp.ow
+        * jcp.oc_block * jcp.typesize_out;
+    const int band_h = (int)(L2_size / 2 / row_size);
+
+    jcp.with_dw_conv = true;
+    jcp.dw_conv_band_h = nstl::min(jcp.oh, nstl::max(jcp_dw.kh, band_h));
+    jcp.output_bcast_dim = jcp.dw_conv_band_h * jcp.ow;
+    /* the driver computes whole rows: several at once if ow % ur == 0 and
+     * one at a time otherwise */
+    jcp.ur_tail = jcp.ow % jcp.ur;
+    jcp.nthr = nthreads;
+
+    return status::success;
+}
+
 void jit_sve_1x1_conv_kernel::init_scratchpad(
         memory_tracking::registrar_t &scratchpad,
         const jit_1x1_conv_conf_t &jcp) {
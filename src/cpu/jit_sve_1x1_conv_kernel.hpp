@@ -56,8 +56,10 @@ namespace cpu {
 
 #define CGA64 CodeGeneratorAArch64
 namespace xa = Xbyak::Xbyak_aarch64;
-/* Get vector offsets, ofs / VL(VL: 512bits = 64Bytes) */
-#define VL_OFS(ofs) ((ofs)>>6)
+/* Get vector offsets, ofs / VL(VL: SVE vector length in bytes) */
+#define VL_OFS(ofs) ((ofs) >> get_sve_length_shift())
+/* True if ofs is a multiple of VL */
+#define VL_ALIGNED(ofs) (((ofs) & (get_sve_length() - 1)) == 0)
 
 struct jit_sve_1x1_conv_kernel : public jit_generator {
     jit_sve_1x1_conv_kernel(jit_1x1_conv_conf_t ajcp,
@@ -90,6 +92,9 @@ struct jit_sve_1x1_conv_kernel : public jit_generator {
             const primitive_attr_t &attr,
             int nthreads, bool reduce_src);
 
+    static status_t init_dw_conv_conf(jit_1x1_conv_conf_t &jcp,
+            const jit_conv_conf_t &jcp_dw, int nthreads);
+
     static void init_scratchpad(memory_tracking::registrar_t &scratchpad,
             const jit_1x1_conv_conf_t &jcp);
 
@@ -128,6 +133,7 @@ struct jit_sve_1x1_conv_kernel : public jit_generator {
     /* Temporay registers */
     reg64_t reg_tmp_imm             = x18; // tmp for add_imm
     reg64_t reg_tmp_ofs             = x19; // tmp reg to calc bwd wei offset in out_load
+    reg64_t reg_binary_data         = x21; // src1 of the binary post-op
 
     void prefetch(const std::string prfop, int level, reg64_t in, long long int ofs) {
         bool for_load;
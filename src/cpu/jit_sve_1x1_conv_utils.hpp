@@ -238,14 +238,8 @@ struct rtus_driver_t: public jit_generator {
         reg_zero = Vreg(0, typesize);
         reg_v = Vreg(1, typesize);
 #endif
-        vlen_ = reg_v.getBit() / 8;
-        vlen_shift_ = 0;
-
-        int tvlen = vlen_;
-        while (tvlen > 1) {
-            tvlen /= 2;
-            vlen_shift_++;
-        }
+        vlen_ = get_sve_length();
+        vlen_shift_ = get_sve_length_shift();
         generate();
     }
 
@@ -266,7 +260,7 @@ struct rtus_driver_t: public jit_generator {
             CGA64::str(reg_v, xa::ptr(reg_cur_src));
             for (int w = 1; w < stride_w_; ++w){
                 int ofs = w * vlen_;
-                ofs = ofs>>6;
+                ofs = ofs >> vlen_shift_;
                 assert( ofs < 256 );
                 CGA64::str(reg_zero, xa::ptr(reg_cur_src, ofs));
             }
@@ -293,7 +287,7 @@ struct rtus_driver_t: public jit_generator {
 
                 for (int w = 0; w < stride_w_; ++w){
                     int ofs = w * vlen_;
-                    ofs = ofs>>6;
+                    ofs = ofs >> vlen_shift_;
                     assert( ofs < 256 );
 
                     CGA64::str(reg_zero, xa::ptr(reg_cur_src, ofs));
@@ -30,6 +30,8 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <string.h>
+
 #include "c_types_map.hpp"
 #include "type_helpers.hpp"
 #include "mkldnn_thread.hpp"
@@ -58,7 +60,10 @@ execute_forward() const {
     auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
     auto weights =
         reinterpret_cast<const wei_data_t *>(this->input_memory(1));
-    auto bias = reinterpret_cast<const dst_data_t *>(this->input_memory(2));
+    auto bias = pd()->with_bias()
+        ? reinterpret_cast<const dst_data_t *>(this->input_memory(2)) : nullptr;
+    auto binary_src1 = reinterpret_cast<const float *>(
+            this->input_memory(pd()->binary_po_input_index(0)));
     auto dst = reinterpret_cast<dst_data_t *>(this->memory());
 
     auto scratchpad = this->scratchpad();
@@ -72,18 +77,46 @@ execute_forward() const {
         bias = padded_bias;
     }
 
-    parallel(0, [&](const int ithr, const int nthr) {
-        execute_forward_thr(ithr, nthr, src, weights, bias, dst, scratchpad);
-    });
+    if (jcp.with_dw_conv) {
+        const int dw_input = 2 + pd()->with_bias();
+        auto dw_weights = reinterpret_cast<const float *>(
+                this->input_memory(dw_input));
+        auto dw_bias = pd()->jcp_dw_.with_bias
+            ? reinterpret_cast<const float *>(
+                    this->input_memory(dw_input + 1))
+            : nullptr;
+        if (pd()->wants_padded_dw_bias()) {
+            const auto &jcp_dw = pd()->jcp_dw_;
+            auto padded_bias = scratchpad.template get<float>(
+                    key_conv_dw_padded_bias);
+            utils::array_copy(padded_bias, dw_bias,
+                    jcp_dw.oc_without_padding);
+            utils::array_set(padded_bias + jcp_dw.oc_without_padding, 0.f,
+                    jcp_dw.oc - jcp_dw.oc_without_padding);
+            dw_bias = padded_bias;
+        }
+        parallel(0, [&](const int ithr, const int nthr) {
+            execute_forward_dw_thr(ithr, nthr, src, weights, bias,
+                    dw_weights, dw_bias, reinterpret_cast<float *>(dst),
+                    scratchpad);
+        });
+    } else {
+        parallel(0, [&](const int ithr, const int nthr) {
+            execute_forward_thr(ithr, nthr, src, weights, bias, binary_src1,
+                    dst, scratchpad);
+        });
+    }
 
-    if (pd()->wants_zero_pad_dst())
+    if (jcp.with_dw_conv ? pd()->wants_zero_pad_dw_dst()
+            : pd()->wants_zero_pad_dst())
         output_memory_primitive(0)->zero_pad();
 }
 
 template <data_type_t src_type, data_type_t wei_type, data_type_t dst_type>
 void jit_sve_1x1_convolution_fwd_t<src_type, wei_type, dst_type>::
 execute_forward_thr(const int ithr, const int nthr, const src_data_t *src,
-        const wei_data_t *weights, const dst_data_t *bias, dst_data_t *dst,
+        const wei_data_t *weights, const dst_data_t *bias,
+        const float *binary_src1, dst_data_t *dst,
         const memory_tracking::grantor_t &scratchpad) const {
     const memory_desc_wrapper src_d(pd()->src_pd());
     const memory_desc_wrapper dst_d(pd()->dst_pd());
@@ -171,6 +204,9 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src,
 
         p.output_data = &dst[dst_off];
         p.bias_data = &bias[_ocb * jcp.oc_block];
+        p.binary_src1 = jcp.with_binary
+                && jcp.binary_bcast == binary_po_bcast_per_oc
+            ? &binary_src1[_ocb * jcp.oc_block] : binary_src1;
         p.load_data = &weights[pd()->with_groups()
             ? weights_d.blk_off(g, ocb, icb)
             : weights_d.blk_off(ocb, icb)];
@@ -267,6 +303,158 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src,
 
 }
 
+/* The fused depthwise convolution: each thread takes a range of the rows of
+ * the depthwise output of one chunk of nb_ch_blocking channel blocks, computes
+ * the rows of the 1x1 output they read into a band of dw_conv_band_h rows
+ * that stays in L2, and slides the band down when the next row needs more
+ * than it holds. The 1x1 output never goes to memory. */
+template <data_type_t src_type, data_type_t wei_type, data_type_t dst_type>
+void jit_sve_1x1_convolution_fwd_t<src_type, wei_type, dst_type>::
+execute_forward_dw_thr(const int ithr, const int nthr, const src_data_t *src,
+        const wei_data_t *weights, const dst_data_t *bias,
+        const float *dw_weights, const float *dw_bias, float *dst,
+        const memory_tracking::grantor_t &scratchpad) const {
+    const memory_desc_wrapper src_d(pd()->src_pd());
+    const memory_desc_wrapper weights_d(pd()->weights_pd(0));
+    const memory_desc_wrapper dw_weights_d(pd()->dw_conv_po_pd(0));
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+    const auto &jcp = kernel_->jcp;
+    const auto &jcp_dw = pd()->jcp_dw_;
+
+    const int band_h = jcp.dw_conv_band_h;
+    const int nb_ch_blocking = jcp_dw.nb_ch_blocking;
+    const size_t row_size = (size_t)jcp.ow * jcp.oc_block;
+    const size_t band_ch_size = band_h * row_size;
+    float *band = scratchpad.get<float>(key_conv_dw_band)
+        + ithr * nb_ch_blocking * band_ch_size;
+
+    const int oc_chunks = div_up(jcp.nb_load, nb_ch_blocking);
+    const int work_amount = jcp.mb * oc_chunks * jcp_dw.oh;
+    int start{0}, end{0};
+    balance211(work_amount, nthr, ithr, start, end);
+
+    auto p = jit_1x1_conv_call_s();
+
+    /* computes the rows [ih_start, ih_end) of the 1x1 output to out */
+    auto compute_1x1 = [&](int n, int ocb, int load_step, int ih_start,
+            int ih_end, float *out) {
+        const int rows_step = jcp.ur_tail == 0 ? ih_end - ih_start : 1;
+        p.load_dim = load_step * jcp.oc_block;
+        p.bias_data = &bias[ocb * jcp.oc_block];
+        p.binary_src1 = nullptr;
+        for (int ih = ih_start; ih < ih_end; ih += rows_step) {
+            p.bcast_dim = nstl::min(rows_step, ih_end - ih) * jcp.ow;
+            p.output_data = out + (ih - ih_start) * row_size;
+            for (int icb = 0; icb < jcp.nb_reduce;
+                    icb += jcp.nb_reduce_blocking) {
+                const int nb_ic_blocking_step = nstl::min(
+                        icb + jcp.nb_reduce_blocking, jcp.nb_reduce) - icb;
+                p.first_last_flag = 0
+                    | (icb == 0 ? FLAG_REDUCE_FIRST : 0)
+                    | (icb + nb_ic_blocking_step >= jcp.nb_reduce
+                            ? FLAG_REDUCE_LAST : 0);
+                p.reduce_dim = this_block_size(icb * jcp.ic_block, jcp.ic,
+                        nb_ic_blocking_step * jcp.ic_block);
+                p.load_data = &weights[pd()->with_groups()
+                    ? weights_d.blk_off(0, ocb, icb)
+                    : weights_d.blk_off(ocb, icb)];
+                p.bcast_data = &src[src_d.blk_off(n, icb, ih, 0)];
+                kernel_->jit_ker(&p);
+            }
+        }
+    };
+
+    /* computes the row oh of the depthwise output from the band that holds
+     * the rows of the 1x1 output starting from band_ih */
+    auto compute_dw = [&](int n, int ocb, int load_step, int oh,
+            int band_ih) {
+        const int str_h = jcp_dw.stride_h;
+        const int str_w = jcp_dw.stride_w;
+        const int i_t_overflow = nstl::max(0, jcp_dw.t_pad - oh * str_h);
+        const int i_b_overflow = nstl::max(jcp_dw.ih,
+                oh * str_h + jcp_dw.kh - jcp_dw.t_pad) - jcp_dw.ih;
+        const int ih = nstl::max(oh * str_h - jcp_dw.t_pad, 0);
+        const int kh_padding = jcp_dw.kh - i_t_overflow - i_b_overflow;
+
+        auto ker = [&](int ow, int ur_w) {
+            const int i_l_overflow = nstl::max(0, jcp_dw.l_pad - ow * str_w);
+            const int i_r_overflow = nstl::max(jcp_dw.iw,
+                    ow * str_w + jcp_dw.kw - jcp_dw.l_pad) - jcp_dw.iw;
+            const int iw = nstl::max(ow * str_w - jcp_dw.l_pad, 0);
+            const int kw_padding = jcp_dw.kw - i_l_overflow - i_r_overflow;
+
+            auto par_conv = jit_conv_call_s();
+            par_conv.src = band
+                + ((ih - band_ih) * jcp_dw.iw + iw) * jcp_dw.ch_block;
+            par_conv.dst = &dst[dst_d.blk_off(n, ocb, oh, ow)];
+            par_conv.filt = &dw_weights[dw_weights_d.blk_off(ocb, 0, 0,
+                    i_t_overflow, i_l_overflow)];
+            if (dw_bias) par_conv.bias = &dw_bias[ocb * jcp_dw.ch_block];
+            par_conv.kh_padding = (size_t)nstl::max(0, kh_padding);
+            par_conv.kw_padding = (size_t)nstl::max(0, kw_padding);
+            par_conv.ur_w = (size_t)ur_w;
+            par_conv.ch_blocks = load_step;
+            dw_kernel_->jit_ker(&par_conv);
+        };
+
+        int ow = 0;
+        const int l_border = nstl::min(div_up(jcp_dw.l_pad, str_w), jcp_dw.ow);
+        for (; ow < l_border; ow++)
+            ker(ow, 1);
+        const int ur_w_step
+            = (jcp_dw.iw - jcp_dw.kw + jcp_dw.l_pad) / str_w - ow + 1;
+        if (ur_w_step > 0) {
+            ker(ow, ur_w_step);
+            ow += ur_w_step;
+        }
+        for (; ow < jcp_dw.ow; ow++)
+            ker(ow, 1);
+    };
+
+    int n{0}, occ{0}, oh{0};
+    nd_iterator_init(start, n, jcp.mb, occ, oc_chunks, oh, jcp_dw.oh);
+
+    /* the band holds the rows [band_ih, band_end) of the 1x1 output */
+    int band_ih = 0, band_end = 0;
+    for (int iwork = start; iwork < end; ++iwork) {
+        const int ocb = occ * nb_ch_blocking;
+        const int load_step = nstl::min(nb_ch_blocking, jcp.nb_load - ocb);
+
+        /* the rows of the 1x1 output the row oh reads */
+        const int ih_start = nstl::max(0, oh * jcp_dw.stride_h - jcp_dw.t_pad);
+        const int ih_end = nstl::min(jcp.oh,
+                oh * jcp_dw.stride_h - jcp_dw.t_pad + jcp_dw.kh);
+
+        if (iwork == start || oh == 0)
+            band_ih = band_end = ih_start;
+
+        if (ih_end > band_ih + band_h) {
+            const int keep = nstl::max(0, band_end - ih_start);
+            for (int ch = 0; ch < load_step; ch++) {
+                float *band_ch = band + ch * band_ch_size;
+                memmove(band_ch, band_ch + (ih_start - band_ih) * row_size,
+                        keep * row_size * sizeof(float));
+            }
+            band_ih = ih_start;
+            band_end = ih_start + keep;
+        }
+
+        if (band_end < ih_end) {
+            /* fill the band up to the last row this thread needs */
+            const int oh_last = nstl::min(jcp_dw.oh, oh + end - iwork) - 1;
+            const int ih_last = nstl::min(jcp.oh,
+                    oh_last * jcp_dw.stride_h - jcp_dw.t_pad + jcp_dw.kh);
+            const int fill_end = nstl::min(ih_last, band_ih + band_h);
+            compute_1x1(n, ocb, load_step, band_end, fill_end,
+                    band + (band_end - band_ih) * row_size);
+            band_end = fill_end;
+        }
+
+        compute_dw(n, ocb, load_step, oh, band_ih);
+
+        nd_iterator_step(n, jcp.mb, occ, oc_chunks, oh, jcp_dw.oh);
+    }
+}
 
 template struct jit_sve_1x1_convolution_fwd_t<data_type::f32>;
 template struct jit_sve_1x1_convolution_fwd_t<data_type::s16,
@@ -775,14 +963,14 @@ void jit_sve_1x1_convolution_bwd_weights_t::execute_backward_weights() const
                     + b_job_loc * rb->balancer().job_size_;
 
                 if (img == img_start)
-                    for (int o = 0; o < 16; ++o)
+                    for (int o = 0; o < jcp.oc_block; ++o)
                         d_bias[o] = 0.;
 
                 for (int hw = 0; hw < jcp.oh * jcp.ow; ++hw) {
                     PRAGMA_OMP_SIMD()
-                    for (int o = 0; o < 16; ++o)
+                    for (int o = 0; o < jcp.oc_block; ++o)
                         d_bias[o] += d_dst[o];
-                    d_dst += 16;
+                    d_dst += jcp.oc_block;
                 }
 
                 nd_iterator_step(g, jcp.ngroups, ocb, jcp.nb_load);
@@ -42,9 +42,11 @@
 #include "cpu_engine.hpp"
 #include "cpu_reducer.hpp"
 
+#include "jit_kernel_cache.hpp"
 #include "jit_sve_1x1_conv_kernel.hpp"
 #include "jit_sve_1x1_conv_utils.hpp"
 #include "jit_transpose_src_utils.hpp"
+#include "jit_uni_dw_conv_kernel_utils.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -61,7 +63,8 @@ struct jit_sve_1x1_convolution_fwd_t : public cpu_primitive_t {
                 const primitive_attr_t *attr,
                 const typename pd_t::base_class *hint_fwd_pd)
             : cpu_convolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
-            , jcp_(), rtus_() {}
+            , jcp_(), rtus_(), jcp_dw_(), dw_weights_pd_(engine)
+            , dw_bias_pd_(engine), dw_dst_pd_(engine) {}
 
 #ifdef __ARM_ARCH
 //        assert(src_type == data_type::f32);
@@ -95,39 +98,178 @@ struct jit_sve_1x1_convolution_fwd_t : public cpu_primitive_t {
             const memory_desc_t *src_d = this->src_pd_.desc();
             rtus_prepare(this, conv_d, src_d, this->dst_pd_.desc());
 
+            /* the kernel applies the post-ops that precede the depthwise
+             * convolution, the depthwise kernel applies the rest */
+            const int dw_idx
+                = this->attr()->post_ops_.find(primitive_kind::convolution);
+            primitive_attr_t attr_1x1(*this->attr());
+            if (dw_idx != -1) attr_1x1.post_ops_.len_ = dw_idx;
+
             status_t status = jit_sve_1x1_conv_kernel::init_conf(
                     jcp_, *conv_d, *src_d, *this->weights_pd_.desc(),
-                    *this->dst_pd_.desc(), *this->attr(),
+                    *this->dst_pd_.desc(), attr_1x1,
                     mkldnn_get_max_threads(), rtus_.reduce_src_);
             if (status != status::success) return status;
 
+            if (dw_idx != -1) {
+                status = init_dw_conv(dw_idx);
+                if (status != status::success) return status;
+            }
+
             auto scratchpad = scratchpad_registry().registrar();
             jit_sve_1x1_conv_kernel::init_scratchpad(scratchpad,
                     jcp_);
+            if (jcp_.with_dw_conv) {
+                scratchpad.book(memory_tracking::names::key_conv_dw_band,
+                        (size_t)jcp_.typesize_out * jcp_.nthr
+                        * jcp_dw_.nb_ch_blocking * jcp_.output_bcast_dim
+                        * jcp_.oc_block);
+                if (wants_padded_dw_bias())
+                    scratchpad.book(
+                            memory_tracking::names::key_conv_dw_padded_bias,
+                            sizeof(float) * jcp_dw_.oc);
+            }
 
             rtus_prepare_space_info(this, scratchpad);
 
             return status::success;
         }
 
+        /* with a depthwise post-op dst is the one of the depthwise conv */
+        virtual const cpu_memory_pd_t *dst_pd(int index = 0) const override {
+            if (index != 0) return nullptr;
+            return jcp_.with_dw_conv ? &dw_dst_pd_ : &this->dst_pd_;
+        }
+        virtual const cpu_memory_pd_t *dw_conv_po_pd(int index = 0) const
+            override {
+            if (!jcp_.with_dw_conv) return nullptr;
+            if (index == 0) return &dw_weights_pd_;
+            if (index == 1 && jcp_dw_.with_bias) return &dw_bias_pd_;
+            return nullptr;
+        }
+
+        /* the depthwise kernel reads whole channel blocks of the bias */
+        bool wants_padded_dw_bias() const {
+            return jcp_.with_dw_conv && jcp_dw_.with_bias
+                && jcp_dw_.oc != jcp_dw_.oc_without_padding;
+        }
+
+        /* the padded channels of the depthwise dst get f(0) from the
+         * eltwise post-ops that follow the depthwise one */
+        bool wants_zero_pad_dw_dst() const {
+            if (!jcp_.with_dw_conv
+                    || jcp_dw_.oc == jcp_dw_.oc_without_padding)
+                return false;
+            const auto &po = this->attr()->post_ops_;
+            for (int idx = po.find(primitive_kind::convolution) + 1;
+                    idx < po.len_; ++idx)
+                if (po.entry_[idx].is_eltwise(false)
+                        && !math::eltwise_fwd_preserves_zero(
+                                po.entry_[idx].eltwise.alg, true))
+                    return true;
+            return false;
+        }
+
         jit_1x1_conv_conf_t jcp_;
         reduce_to_unit_stride_t rtus_;
+        jit_conv_conf_t jcp_dw_;
 
     protected:
+        cpu_memory_pd_t dw_weights_pd_, dw_bias_pd_, dw_dst_pd_;
+
+        /* The depthwise post-op is a 3x3 convolution with the padding of 1
+         * over the output of the 1x1 one: f32 only, and no sum or binary
+         * post-ops around it */
+        status_t init_dw_conv(int dw_idx) {
+            using namespace memory_format;
+            const auto &po = this->attr()->post_ops_;
+            const auto &dw = po.entry_[dw_idx].depthwise_conv;
+            const memory_desc_t &src_md = *this->dst_pd_.desc();
+            bool ok = true
+                && this->ndims() == 4
+                && !rtus_.reduce_src_
+                && po.count(primitive_kind::convolution) == 1
+                && po.count(primitive_kind::sum) == 0
+                && po.count(primitive_kind::binary) == 0
+                && utils::everyone_is(data_type::f32, src_md.data_type,
+                        dw.wei_dt, dw.dst_dt)
+                && utils::one_of(dw.bias_dt, data_type::f32,
+                        data_type::undef);
+            if (!ok) return status::unimplemented;
+
+            const int kh = 3, kw = 3, pad = 1, stride = dw.stride;
+            const int oc = src_md.dims[1];
+            const int ih = src_md.dims[2], iw = src_md.dims[3];
+            const int oh = (ih + 2 * pad - kh) / stride + 1;
+            const int ow = (iw + 2 * pad - kw) / stride + 1;
+
+            dims_t wei_dims = { oc, 1, 1, kh, kw };
+            dims_t bias_dims = { oc };
+            dims_t dst_dims = { src_md.dims[0], oc, oh, ow };
+            memory_desc_t wei_md, bias_md, dst_md;
+            /* the channel blocks follow the 1x1 dst */
+            const bool blk8 = get_sve_length() == 32; // 256-bit vectors
+            CHECK(mkldnn_memory_desc_init(&wei_md, 5, wei_dims, dw.wei_dt,
+                        blk8 ? Goihw8g : Goihw16g));
+            CHECK(mkldnn_memory_desc_init(&dst_md, 4, dst_dims, dw.dst_dt,
+                        blk8 ? nChw8c : nChw16c));
+            const bool with_bias = dw.bias_dt != data_type::undef;
+            if (with_bias)
+                CHECK(mkldnn_memory_desc_init(&bias_md, 1, bias_dims,
+                            dw.bias_dt, x));
+
+            dims_t strides = { stride, stride };
+            dims_t padding_l = { pad, pad };
+            dims_t padding_r = { (oh - 1) * stride + kh - 1 - (ih + pad - 1),
+                (ow - 1) * stride + kw - 1 - (iw + pad - 1) };
+            convolution_desc_t dw_d;
+            CHECK(conv_desc_init(&dw_d, prop_kind::forward_inference,
+                        alg_kind::convolution_direct, &src_md, &wei_md,
+                        with_bias ? &bias_md : nullptr, &dst_md, strides,
+                        nullptr, padding_l, padding_r,
+                        padding_kind::padding_zero));
+
+            primitive_attr_t attr_dw;
+            for (int idx = dw_idx + 1; idx < po.len_; ++idx)
+                attr_dw.post_ops_.entry_[attr_dw.post_ops_.len_++]
+                    = po.entry_[idx];
+
+            CHECK(jit_uni_dw_conv_fwd_kernel<sve, data_type::f32>::init_conf(
+                        jcp_dw_, dw_d, &dw_d.src_desc, &dw_d.weights_desc,
+                        &dw_d.dst_desc, attr_dw));
+            CHECK(jit_sve_1x1_conv_kernel::init_dw_conv_conf(jcp_, jcp_dw_,
+                        mkldnn_get_max_threads()));
+
+            dw_weights_pd_ = cpu_memory_pd_t(this->engine_, &dw_d.weights_desc);
+            if (with_bias)
+                dw_bias_pd_ = cpu_memory_pd_t(this->engine_, &dw_d.bias_desc);
+            dw_dst_pd_ = cpu_memory_pd_t(this->engine_, &dw_d.dst_desc);
+
+            return status::success;
+        }
+
         virtual status_t set_default_params() override {
             using namespace memory_format;
+            const bool blk8 = get_sve_length() == 32; // 256-bit vectors
+            const auto dat_fmt = blk8
+                ? pick(this->ndims() - 3, nCw8c, nChw8c)
+                : pick(this->ndims() - 3, nCw16c, nChw16c);
             if (this->src_pd_.desc()->format == any)
-                CHECK(this->src_pd_.set_format(pick(this->ndims() - 3,
-                    nCw16c, nChw16c)));
+                CHECK(this->src_pd_.set_format(dat_fmt));
             if (this->dst_pd_.desc()->format == any)
-                CHECK(this->dst_pd_.set_format(pick(this->ndims() - 3,
-                    nCw16c, nChw16c)));
+                CHECK(this->dst_pd_.set_format(dat_fmt));
             if (this->weights_pd_.desc()->format == any) {
                 if (dst_type == data_type::f32 && src_type == data_type::f32
                     && wei_type == data_type::f32)
                         CHECK(this->weights_pd_.set_format(this->with_groups()
-                            ? pick(this->ndims() - 3, gOIw16i16o, gOIhw16i16o)
-                            : pick(this->ndims() - 3, OIw16i16o, OIhw16i16o)));
+                            ? (blk8
+                                ? pick(this->ndims() - 3, gOIw8i8o, gOIhw8i8o)
+                                : pick(this->ndims() - 3, gOIw16i16o,
+                                    gOIhw16i16o))
+                            : (blk8
+                                ? pick(this->ndims() - 3, OIw8i8o, OIhw8i8o)
+                                : pick(this->ndims() - 3, OIw16i16o,
+                                    OIhw16i16o))));
                 else if (dst_type == data_type::s32
                     && src_type == data_type::s16
                     && wei_type == data_type::s16)
@@ -149,16 +291,22 @@ struct jit_sve_1x1_convolution_fwd_t : public cpu_primitive_t {
     jit_sve_1x1_convolution_fwd_t(const pd_t *apd,
             const input_vector &inputs, const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs)
-        , kernel_(nullptr), rtus_driver_(nullptr)
+        , kernel_(nullptr), rtus_driver_(nullptr), dw_kernel_(nullptr)
     {
-        kernel_ =
-            new jit_sve_1x1_conv_kernel(pd()->jcp_, *pd()->attr());
+        kernel_ = get_jit_kernel<jit_sve_1x1_conv_kernel>(pd()->jcp_,
+                pd()->attr(), *pd()->attr());
         init_rtus_driver<sve>(this);
+        if (pd()->jcp_.with_dw_conv) {
+            /* the depthwise kernel reads the band, not the whole image */
+            jit_conv_conf_t jcp_dw = pd()->jcp_dw_;
+            jcp_dw.ih = pd()->jcp_.dw_conv_band_h;
+            dw_kernel_ = new dw_kernel_t(jcp_dw);
+        }
     }
 
     ~jit_sve_1x1_convolution_fwd_t() {
-        delete kernel_;
         delete rtus_driver_;
+        delete dw_kernel_;
     }
 
     typedef typename prec_traits<src_type>::type src_data_t;
@@ -174,12 +322,20 @@ struct jit_sve_1x1_convolution_fwd_t : public cpu_primitive_t {
     void execute_forward() const;
     void execute_forward_thr(const int ithr, const int nthr,
             const src_data_t *src, const wei_data_t *weights,
-            const dst_data_t *bias, dst_data_t *dst,
+            const dst_data_t *bias, const float *binary_src1, dst_data_t *dst,
+            const memory_tracking::grantor_t &scratchpad) const;
+    void execute_forward_dw_thr(const int ithr, const int nthr,
+            const src_data_t *src, const wei_data_t *weights,
+            const dst_data_t *bias, const float *dw_weights,
+            const float *dw_bias, float *dst,
             const memory_tracking::grantor_t &scratchpad) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_1x1_conv_kernel *kernel_;
+    typedef jit_uni_dw_conv_fwd_kernel<sve, data_type::f32> dw_kernel_t;
+
+    std::shared_ptr<jit_sve_1x1_conv_kernel> kernel_;
     rtus_driver_t<sve> *rtus_driver_;
+    dw_kernel_t *dw_kernel_;
 };
 
 using jit_sve_1x1_convolution_fwd_f32_t
@@ -238,6 +394,22 @@ struct jit_sve_1x1_convolution_bwd_data_t : public cpu_primitive_t {
         }
 
         // TODO (Roma): structs conf header cleanup
+        /* the padded channels of the depthwise dst get f(0) from the
+         * eltwise post-ops that follow the depthwise one */
+        bool wants_zero_pad_dw_dst() const {
+            if (!jcp_.with_dw_conv
+                    || jcp_dw_.oc == jcp_dw_.oc_without_padding)
+                return false;
+            const auto &po = this->attr()->post_ops_;
+            for (int idx = po.find(primitive_kind::convolution) + 1;
+                    idx < po.len_; ++idx)
+                if (po.entry_[idx].is_eltwise(false)
+                        && !math::eltwise_fwd_preserves_zero(
+                                po.entry_[idx].eltwise.alg, true))
+                    return true;
+            return false;
+        }
+
         jit_1x1_conv_conf_t jcp_;
         reduce_to_unit_stride_t rtus_;
 
@@ -385,17 +557,23 @@ struct jit_sve_1x1_convolution_bwd_weights_t : public cpu_primitive_t
     protected:
         virtual status_t set_default_params() override {
             using namespace memory_format;
+            const bool blk8 = get_sve_length() == 32; // 256-bit vectors
+            const auto dat_fmt = blk8
+                ? pick(this->ndims() - 3, nCw8c, nChw8c)
+                : pick(this->ndims() - 3, nCw16c, nChw16c);
 
             if (this->src_pd_.desc()->format == any)
-                CHECK(this->src_pd_.set_format(pick(this->ndims() - 3,
-                    nCw16c, nChw16c)));
+                CHECK(this->src_pd_.set_format(dat_fmt));
             if (this->diff_dst_pd_.desc()->format == any)
-                CHECK(this->diff_dst_pd_.set_format(pick(this->ndims() - 3,
-                    nCw16c, nChw16c)));
+                CHECK(this->diff_dst_pd_.set_format(dat_fmt));
             if (this->diff_weights_pd_.desc()->format == any)
                 CHECK(this->diff_weights_pd_.set_format(this->with_groups()
-                    ? pick(this->ndims() - 3, gOIw16i16o, gOIhw16i16o)
-                    : pick(this->ndims() - 3, OIw16i16o, OIhw16i16o)));
+                    ? (blk8
+                        ? pick(this->ndims() - 3, gOIw8i8o, gOIhw8i8o)
+                        : pick(this->ndims() - 3, gOIw16i16o, gOIhw16i16o))
+                    : (blk8
+                        ? pick(this->ndims() - 3, OIw8i8o, OIhw8i8o)
+                        : pick(this->ndims() - 3, OIw16i16o, OIhw16i16o))));
             if (this->diff_bias_pd_.desc()->format == any)
                 CHECK(this->diff_bias_pd_.set_format(x));
             if (this->desc()->alg_kind == alg_kind::convolution_auto)
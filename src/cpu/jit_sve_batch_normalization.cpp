@@ -0,0 +1,1038 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_barrier.hpp"
+#include "cpu_batch_normalization_utils.hpp"
+#include "jit_generator.hpp"
+#include "jit_generator_aarch64.hpp"
+
+#include "jit_sve_batch_normalization.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>(offsetof(call_params_t, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+using namespace memory_tracking::names;
+
+using namespace Xbyak::Xbyak_aarch64;
+namespace barrier = simple_barrier;
+
+typedef float acc_data_t;
+
+/* Same algorithm and call parameters as jit_bnorm_t of
+ * jit_uni_batch_normalization.cpp, written with SVE instructions. One vector
+ * holds one block of channels; the padded channels of the last block are
+ * handled with a predicate instead of a branch to a masked copy. */
+struct jit_sve_bnorm_t: public jit_generator_aarch64 {
+    struct call_params_t {
+        // keep all sizes at 8 bytes -- jit code expects this
+        size_t N_ithr, N_nthr;
+        size_t coff_max, soff_max;
+        size_t mb_stride_Bc, spat_size, spat_size_loc;
+        size_t S_s, S_tail;
+        size_t chan_work; // channels of the thread which are not padding
+        acc_data_t chan_size, eps, one;
+        const acc_data_t *scale_shift;
+        const acc_data_t *mean, *var;
+        const acc_data_t *diff_scale_shift;
+        const void *src, *dst;
+        const void *diff_src, *diff_dst;
+        const acc_data_t *rbuf1, *rbuf2;
+        const uint8_t *ws;
+        barrier::ctx_t *barrier;
+    };
+
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_bnorm_t)
+
+    using xreg_t = const XReg;
+    using preg_t = const PReg;
+    using zreg_t = const ZRegS;
+
+    void (*ker)(const call_params_t *);
+    void operator()(const call_params_t *p) { (*ker)(p); }
+
+    const batch_normalization_pd_t *bdesc_;
+    bool is_spatial_thr_;
+    int vlen;
+
+    size_t unroll_blocks;
+    size_t unroll_regs;
+    bool with_relu, with_relu_inf_only;
+
+    size_t spat_size;
+    size_t chan_data_offt;
+
+    xreg_t reg_param = x0;
+
+    xreg_t reg_src = x1;
+    xreg_t reg_dst = x2; // diff_src for backward
+    xreg_t reg_diff_dst = x3;
+    xreg_t reg_ws = x4;
+    xreg_t reg_mean = x5;
+    xreg_t reg_var = x6;
+    xreg_t reg_scale_shift = x7;
+    xreg_t reg_diff_scale_shift = x8;
+    xreg_t reg_rbuf1 = x9;
+    xreg_t reg_rbuf2 = x10;
+
+    xreg_t reg_coff = x11;
+    xreg_t reg_coff_max = x12;
+    xreg_t reg_soff = x13;
+    xreg_t reg_soff_max = x14;
+    xreg_t reg_mb_stride_Bc = x15;
+    xreg_t reg_ctr = x16;
+    xreg_t reg_roff = x17;
+    xreg_t reg_nnthr = x19;
+    xreg_t reg_bar = x20;
+
+    /* addresses of the spatial data of the current iteration */
+    xreg_t reg_src_a = x21;
+    xreg_t reg_dst_a = x22;
+    xreg_t reg_diff_dst_a = x23;
+    xreg_t reg_ws_a = x24;
+
+    xreg_t reg_chan_work = x25;
+    xreg_t reg_tmp = x26;
+    xreg_t reg_tmp1 = x27;
+    xreg_t reg_tmp2 = x28;
+
+    preg_t reg_p_all = p0;
+    preg_t reg_p_c = p1; // valid channels of the current block
+    preg_t reg_p_relu = p2;
+
+    /* z0 - z20 : spatial data and partial sums */
+    zreg_t vbits = zreg_t(21); // 1 << lane, bits of the relu workspace
+    zreg_t vzero = zreg_t(22);
+    zreg_t vdiff_beta = zreg_t(23);
+    zreg_t vdiff_gamma = zreg_t(24);
+    zreg_t vbeta = zreg_t(25);
+    zreg_t vgamma = zreg_t(26);
+    zreg_t vsqrtvar = zreg_t(27);
+    zreg_t vmean = zreg_t(28);
+    zreg_t vchan_size = zreg_t(29);
+    zreg_t veps = zreg_t(30);
+    zreg_t vone = zreg_t(31);
+
+    bool is_c_padded() const {
+        const memory_desc_wrapper data_d(bdesc_->src_pd());
+        return bdesc_->C() != data_d.blocking_desc().padding_dims[1];
+    }
+
+    void compute_static_strides() {
+        spat_size = bdesc_->D() * bdesc_->W() * bdesc_->H();
+        chan_data_offt = bdesc_->C() * sizeof(acc_data_t);
+    }
+
+    void load_common_params() {
+        ldr(reg_rbuf1, ptr(reg_param, GET_OFF(rbuf1)));
+        if (bdesc_->is_bwd())
+            ldr(reg_rbuf2, ptr(reg_param, GET_OFF(rbuf2)));
+        ldr(reg_coff_max, ptr(reg_param, GET_OFF(coff_max)));
+        ldr(reg_soff_max, ptr(reg_param, GET_OFF(soff_max)));
+        ldr(reg_mb_stride_Bc, ptr(reg_param, GET_OFF(mb_stride_Bc)));
+        lsl(reg_coff_max, reg_coff_max, 2);
+
+        ldr(reg_mean, ptr(reg_param, GET_OFF(mean)));
+        ldr(reg_var, ptr(reg_param, GET_OFF(var)));
+        ldr(reg_scale_shift, ptr(reg_param, GET_OFF(scale_shift)));
+        if (bdesc_->is_bwd())
+            ldr(reg_diff_scale_shift,
+                    ptr(reg_param, GET_OFF(diff_scale_shift)));
+        if (is_c_padded())
+            ldr(reg_chan_work, ptr(reg_param, GET_OFF(chan_work)));
+
+        ld1rw(vchan_size, reg_p_all, ptr(reg_param, GET_OFF(chan_size)));
+        ld1rw(vone, reg_p_all, ptr(reg_param, GET_OFF(one)));
+        ld1rw(veps, reg_p_all, ptr(reg_param, GET_OFF(eps)));
+    }
+
+    void prepare_relu() {
+        with_relu = bdesc_->is_fwd()
+            ? bdesc_->with_relu_post_op() || bdesc_->fuse_bn_relu()
+            : bdesc_->fuse_bn_relu();
+        with_relu_inf_only = with_relu && bdesc_->is_fwd()
+            && !(bdesc_->fuse_bn_relu() && bdesc_->is_training());
+
+        if (with_relu) {
+            uni_clear(vzero);
+            if (!with_relu_inf_only) {
+                index(ZRegS(0), 0, 1);
+                dup(vbits, 1);
+                lsl(vbits, reg_p_all, ZRegS(0));
+            }
+        }
+    }
+
+    void uni_clear(const ZRegS &z) {
+        eor(ZRegD(z.getIdx()), ZRegD(z.getIdx()), ZRegD(z.getIdx()));
+    }
+
+    /* The workspace holds one bit per element as for the avx512 kernel: a
+     * byte for 8 lanes, a half-word for 16 lanes, at soff / 32. */
+    void ws_access(bool is_store, size_t i) {
+        const int32_t offt = static_cast<int32_t>(i * vlen / 32);
+        const WReg w_bits(reg_tmp.getIdx());
+        if (vlen == 64) {
+            if (is_store) strh(w_bits, ptr(reg_ws_a, offt));
+            else ldrh(w_bits, ptr(reg_ws_a, offt));
+        } else {
+            if (is_store) strb(w_bits, ptr(reg_ws_a, offt));
+            else ldrb(w_bits, ptr(reg_ws_a, offt));
+        }
+    }
+
+    void fwd_process_relu(const ZRegS &vdst, const ZRegS &vtmp, size_t i) {
+        fcmgt(reg_p_relu.s, reg_p_all / T_z, vdst, vzero);
+        sel(vdst, reg_p_relu, vdst, vzero);
+        sel(vtmp, reg_p_relu, vbits, vzero);
+        orv(SReg(vtmp.getIdx()), reg_p_all, vtmp);
+        fmov(WReg(reg_tmp.getIdx()), SReg(vtmp.getIdx()));
+        ws_access(true, i);
+    }
+
+    void bwd_process_relu(const ZRegS &vdiff_dst, const ZRegS &vtmp,
+            size_t i) {
+        ws_access(false, i);
+        dup(vtmp, WReg(reg_tmp.getIdx()));
+        and_(ZRegD(vtmp.getIdx()), ZRegD(vtmp.getIdx()),
+                ZRegD(vbits.getIdx()));
+        cmpne(reg_p_relu.s, reg_p_all / T_z, vtmp, 0);
+        sel(vdiff_dst, reg_p_relu, vdiff_dst, vzero);
+    }
+
+    void barrier() {
+        ldr(reg_nnthr, ptr(reg_param, GET_OFF(N_nthr)));
+        ldr(reg_bar, ptr(reg_param, GET_OFF(barrier)));
+        simple_barrier::generate(*this, reg_bar, reg_nnthr, reg_tmp,
+                reg_tmp1, reg_tmp2);
+    }
+
+    /* Channel data (statistics and scale-shift) may be shorter than the
+     * padded channels, it is accessed under reg_p_c. */
+    void prepare_chan_pred() {
+        if (!is_c_padded()) return;
+        lsr(reg_tmp, reg_coff, 2);
+        whilelt(reg_p_c.s, reg_tmp, reg_chan_work);
+    }
+
+    void chan_addr(const XReg &base, size_t offt) {
+        add(reg_tmp, base, reg_coff);
+        if (offt)
+            add_imm(reg_tmp, reg_tmp, offt, reg_tmp1);
+    }
+
+    void load_chan(const ZRegS &z, const XReg &base, size_t offt = 0) {
+        chan_addr(base, offt);
+        ld1w(z, reg_p_c / T_z, ptr(reg_tmp));
+    }
+
+    void store_chan(const XReg &base, const ZRegS &z, size_t offt = 0) {
+        chan_addr(base, offt);
+        st1w(z, reg_p_c, ptr(reg_tmp));
+    }
+
+    void load_rbuf(const ZRegS &z, const XReg &base, const XReg &off) {
+        add(reg_tmp, base, off);
+        ld1w(z, reg_p_all / T_z, ptr(reg_tmp));
+    }
+
+    void store_rbuf(const XReg &base, const XReg &off, const ZRegS &z) {
+        add(reg_tmp, base, off);
+        st1w(z, reg_p_all, ptr(reg_tmp));
+    }
+
+    void load_spat(const ZRegS &z, const XReg &addr, size_t i) {
+        ldr(ZReg(z.getIdx()), ptr(addr, static_cast<int32_t>(i), MUL_VL));
+    }
+
+    void store_spat(const XReg &addr, const ZRegS &z, size_t i) {
+        str(ZReg(z.getIdx()), ptr(addr, static_cast<int32_t>(i), MUL_VL));
+    }
+
+    void spat_addr() {
+        add(reg_src_a, reg_src, reg_soff);
+        add(reg_dst_a, reg_dst, reg_soff);
+        add(reg_diff_dst_a, reg_diff_dst, reg_soff);
+        if (with_relu && !with_relu_inf_only) {
+            lsr(reg_ws_a, reg_soff, 5);
+            add(reg_ws_a, reg_ws_a, reg_ws);
+        }
+    }
+
+    template <typename init_t, typename body_t, typename fini_t>
+    void spat_loop(size_t len, size_t blocks, size_t regs,
+            init_t init, body_t body, fini_t fini) {
+        size_t factor = regs * blocks;
+        size_t loop_unroll = len / factor * factor;
+        size_t loop_tail = len - loop_unroll;
+        size_t num_active_regs = (len < regs) ? len : regs;
+        for (size_t i = 0; i < num_active_regs; i++)
+            init(i);
+        if (loop_unroll) {
+            if (is_spatial_thr_) {
+                ldr(reg_ctr, ptr(reg_param, GET_OFF(spat_size_loc)));
+                ldr(reg_tmp, ptr(reg_param, GET_OFF(S_s)));
+                add(reg_soff, reg_soff, reg_tmp);
+            } else {
+                mov_imm(reg_ctr, loop_unroll);
+            }
+            LabelAArch64 label;
+            L_aarch64(label); {
+                spat_addr();
+                for (size_t i = 0; i < factor; i++) {
+                    size_t base_reg = i % regs;
+                    body(base_reg, i);
+                }
+                add_imm(reg_soff, reg_soff, factor * vlen, reg_tmp);
+                subs(reg_ctr, reg_ctr, factor);
+                b(NE, label);
+            }
+            if (is_spatial_thr_) {
+                ldr(reg_tmp, ptr(reg_param, GET_OFF(S_tail)));
+                add(reg_soff, reg_soff, reg_tmp);
+            }
+        }
+
+        if (loop_tail) {
+            spat_addr();
+            for (size_t i = 0; i < loop_tail; i++) {
+                size_t base_reg = i % regs;
+                body(base_reg, i);
+            }
+            add_imm(reg_soff, reg_soff, loop_tail * vlen, reg_tmp);
+        }
+
+        for (size_t i = 0; i < num_active_regs; i++)
+            fini(i);
+    }
+
+    void next_channel(LabelAArch64 &ch_label) {
+        add(reg_coff, reg_coff, vlen);
+        cmp(reg_coff, reg_coff_max);
+        b(LT, ch_label);
+    }
+
+    void mean_channels() {
+        LabelAArch64 ch_label;
+        L_aarch64(ch_label); {
+            load_rbuf(ZRegS(0), reg_rbuf1, reg_coff);
+            spat_loop(spat_size, unroll_blocks, unroll_regs,
+                    [=](size_t base_reg) {
+                        if (base_reg)
+                            uni_clear(ZRegS(base_reg * 2));
+                    },
+                    [=](size_t base_reg, size_t i) {
+                        ZRegS v0(base_reg * 2 + 0);
+                        ZRegS v1(base_reg * 2 + 1);
+                        load_spat(v1, reg_src_a, i);
+                        fadd(v0, v0, v1);
+                    },
+                    [=](size_t base_reg) {
+                        if (base_reg)
+                            fadd(ZRegS(0), ZRegS(0), ZRegS(base_reg * 2));
+                    });
+            store_rbuf(reg_rbuf1, reg_coff, ZRegS(0));
+            next_channel(ch_label);
+        }
+    }
+
+    void var_channels() {
+        LabelAArch64 ch_label;
+        L_aarch64(ch_label); {
+            prepare_chan_pred();
+            load_chan(vmean, reg_mean);
+            load_rbuf(ZRegS(0), reg_rbuf1, reg_coff);
+            spat_loop(spat_size, unroll_blocks, unroll_regs,
+                    [=](size_t base_reg) {
+                        if (base_reg)
+                            uni_clear(ZRegS(base_reg * 2));
+                    },
+                    [=](size_t base_reg, size_t i) {
+                        ZRegS v(base_reg * 2 + 0);
+                        ZRegS vtmp(base_reg * 2 + 1);
+                        load_spat(vtmp, reg_src_a, i);
+                        fsub(vtmp, vtmp, vmean);
+                        fmla(v, reg_p_all, vtmp, vtmp);
+                    },
+                    [=](size_t base_reg) {
+                        if (base_reg)
+                            fadd(ZRegS(0), ZRegS(0), ZRegS(base_reg * 2));
+                    });
+            store_rbuf(reg_rbuf1, reg_coff, ZRegS(0));
+            next_channel(ch_label);
+        }
+    }
+
+    void zero_rbuf() {
+        LabelAArch64 zero_label;
+        uni_clear(ZRegS(0));
+        mov(reg_coff, 0);
+        L_aarch64(zero_label); {
+            store_rbuf(reg_rbuf1, reg_coff, ZRegS(0));
+            if (bdesc_->is_bwd())
+                store_rbuf(reg_rbuf2, reg_coff, ZRegS(0));
+            add(reg_coff, reg_coff, vlen);
+            cmp(reg_coff, reg_coff_max);
+            b(NE, zero_label);
+        }
+    }
+
+    template <typename channels_t>
+    void spatial_loop(channels_t channels) {
+        LabelAArch64 spatial_label;
+        mov(reg_soff, 0);
+        L_aarch64(spatial_label); {
+            mov(reg_coff, 0);
+            channels();
+            add(reg_soff, reg_soff, reg_mb_stride_Bc);
+            cmp(reg_soff, reg_soff_max);
+            b(NE, spatial_label);
+        }
+    }
+
+    /* The thread with N_ithr == 0 sums the partial results of the threads
+     * sharing its channels; the caller surrounds it with barriers. */
+    template <typename fini_t>
+    void reduction(bool zero_partials, bool both_bufs, fini_t fini) {
+        LabelAArch64 no_reduction, reduction_channels, reduction_thrs;
+        ldr(reg_tmp, ptr(reg_param, GET_OFF(N_ithr)));
+        cbnz(reg_tmp, no_reduction);
+
+        ldr(reg_nnthr, ptr(reg_param, GET_OFF(N_nthr)));
+        if (zero_partials)
+            uni_clear(ZRegS(2));
+        mov(reg_coff, 0);
+        L_aarch64(reduction_channels); {
+            mov(reg_roff, reg_coff);
+            uni_clear(ZRegS(0));
+            uni_clear(ZRegS(1));
+            mov(reg_ctr, reg_nnthr);
+            L_aarch64(reduction_thrs); {
+                load_rbuf(ZRegS(3), reg_rbuf1, reg_roff);
+                fadd(ZRegS(0), ZRegS(0), ZRegS(3));
+                if (zero_partials)
+                    store_rbuf(reg_rbuf1, reg_roff, ZRegS(2));
+                if (both_bufs) {
+                    load_rbuf(ZRegS(3), reg_rbuf2, reg_roff);
+                    fadd(ZRegS(1), ZRegS(1), ZRegS(3));
+                }
+                add(reg_roff, reg_roff, reg_coff_max);
+                subs(reg_ctr, reg_ctr, 1);
+                b(NE, reduction_thrs);
+            }
+            prepare_chan_pred();
+            fini();
+            add(reg_coff, reg_coff, vlen);
+            cmp(reg_coff, reg_coff_max);
+            b(NE, reduction_channels);
+        }
+        L_aarch64(no_reduction);
+    }
+
+    void compute_mean_variance() {
+        zero_rbuf();
+
+        ldr(reg_src, ptr(reg_param, GET_OFF(src)));
+
+        spatial_loop([=]() { mean_channels(); });
+
+        barrier();
+        // rbuf1 is reused for the variance
+        reduction(true, false, [=]() {
+            fdiv(ZRegS(0), reg_p_all, vchan_size);
+            store_chan(reg_mean, ZRegS(0));
+        });
+        barrier();
+
+        spatial_loop([=]() { var_channels(); });
+
+        barrier();
+        reduction(false, false, [=]() {
+            fdiv(ZRegS(0), reg_p_all, vchan_size);
+            store_chan(reg_var, ZRegS(0));
+        });
+        barrier();
+    }
+
+    // vsqrtvar = sqrt(var + eps)
+    void load_sqrtvar() {
+        load_chan(vsqrtvar, reg_var);
+        fadd(vsqrtvar, vsqrtvar, veps);
+        fsqrt(vsqrtvar, reg_p_all / T_m, vsqrtvar);
+    }
+
+    void forward_channels() {
+        LabelAArch64 ch_label;
+        L_aarch64(ch_label); {
+            prepare_chan_pred();
+            load_chan(vmean, reg_mean);
+            load_sqrtvar();
+
+            if (bdesc_->use_scaleshift()) {
+                load_chan(vgamma, reg_scale_shift);
+                load_chan(vbeta, reg_scale_shift, chan_data_offt);
+                fdiv(vgamma, reg_p_all, vsqrtvar);
+            } else {
+                fdivr(vsqrtvar, reg_p_all, vone);
+            }
+
+            spat_loop(spat_size, unroll_blocks, unroll_regs,
+                    [](size_t base_reg) {UNUSED(base_reg);},
+                    [=](size_t base_reg, size_t i) {
+                        ZRegS v(base_reg);
+                        ZRegS vtmp(base_reg + unroll_regs);
+                        load_spat(v, reg_src_a, i);
+                        fsub(v, v, vmean);
+                        if (bdesc_->use_scaleshift())
+                            fmad(v, reg_p_all, vgamma, vbeta);
+                        else
+                            fmul(v, v, vsqrtvar);
+                        if (with_relu_inf_only)
+                            fmax(v, reg_p_all, vzero);
+                        else if (with_relu)
+                            fwd_process_relu(v, vtmp, i);
+                        store_spat(reg_dst_a, v, i);
+                    },
+                    [](size_t base_reg) {UNUSED(base_reg);});
+
+            next_channel(ch_label);
+        }
+    }
+
+    void forward() {
+        ldr(reg_src, ptr(reg_param, GET_OFF(src)));
+        ldr(reg_dst, ptr(reg_param, GET_OFF(dst)));
+        ldr(reg_ws, ptr(reg_param, GET_OFF(ws)));
+
+        spatial_loop([=]() { forward_channels(); });
+    }
+
+    void backward_sh_channels() {
+        const size_t sh_regs = nstl::min(unroll_regs, (size_t)3);
+        LabelAArch64 sh_channels;
+        L_aarch64(sh_channels); {
+            prepare_chan_pred();
+            load_chan(vmean, reg_mean);
+            load_rbuf(ZRegS(0), reg_rbuf1, reg_coff);
+            load_rbuf(ZRegS(1), reg_rbuf2, reg_coff);
+            spat_loop(spat_size, unroll_blocks, sh_regs,
+                    [=](size_t base_reg) {
+                        if (base_reg > 0) {
+                            uni_clear(ZRegS(base_reg * 5 + 0));
+                            uni_clear(ZRegS(base_reg * 5 + 1));
+                        }
+                    },
+                    [=](size_t base_reg, size_t i) {
+                        ZRegS o0(base_reg * 5 + 0);
+                        ZRegS o1(base_reg * 5 + 1);
+                        ZRegS t1(base_reg * 5 + 2);
+                        ZRegS t2(base_reg * 5 + 3);
+                        ZRegS t3(base_reg * 5 + 4);
+                        load_spat(t1, reg_src_a, i);
+                        load_spat(t2, reg_diff_dst_a, i);
+                        if (with_relu)
+                            bwd_process_relu(t2, t3, i);
+                        fsub(t3, t1, vmean);
+                        fmla(o0, reg_p_all, t3, t2);
+                        fadd(o1, o1, t2);
+                    },
+                    [=](size_t base_reg) {
+                        if (base_reg) {
+                            fadd(ZRegS(0), ZRegS(0), ZRegS(base_reg * 5 + 0));
+                            fadd(ZRegS(1), ZRegS(1), ZRegS(base_reg * 5 + 1));
+                        }
+                    });
+            store_rbuf(reg_rbuf1, reg_coff, ZRegS(0));
+            store_rbuf(reg_rbuf2, reg_coff, ZRegS(1));
+            next_channel(sh_channels);
+        }
+    }
+
+    void backward_diff_channels() {
+        LabelAArch64 diff_channels;
+        L_aarch64(diff_channels); {
+            prepare_chan_pred();
+            load_chan(vmean, reg_mean);
+            load_sqrtvar();
+            fdivr(vsqrtvar, reg_p_all, vone);
+            if (bdesc_->use_scaleshift())
+                load_chan(vgamma, reg_scale_shift);
+            load_chan(vdiff_gamma, reg_diff_scale_shift);
+            load_chan(vdiff_beta, reg_diff_scale_shift, chan_data_offt);
+            fmul(vdiff_gamma, vdiff_gamma, vsqrtvar);
+            fdiv(vdiff_beta, reg_p_all, vchan_size);
+            fdiv(vdiff_gamma, reg_p_all, vchan_size);
+
+            spat_loop(spat_size, unroll_blocks, unroll_regs,
+                    [](size_t base_reg) {UNUSED(base_reg);},
+                    [=](size_t base_reg, size_t i) {
+                        ZRegS v(base_reg * 2 + 0);
+                        ZRegS t(base_reg * 2 + 1);
+                        load_spat(v, reg_diff_dst_a, i);
+                        if (with_relu)
+                            bwd_process_relu(v, t, i);
+                        if (!bdesc_->use_global_stats()) {
+                            fsub(v, v, vdiff_beta);
+                            load_spat(t, reg_src_a, i);
+                            fsub(t, t, vmean);
+                            fmls(v, reg_p_all, t, vdiff_gamma);
+                        }
+                        fmul(v, v, vsqrtvar);
+                        if (bdesc_->use_scaleshift())
+                            fmul(v, v, vgamma);
+                        store_spat(reg_dst_a, v, i);
+                    },
+                    [](size_t base_reg) {UNUSED(base_reg);});
+
+            next_channel(diff_channels);
+        }
+    }
+
+    void backward() {
+        zero_rbuf();
+
+        ldr(reg_src, ptr(reg_param, GET_OFF(src)));
+        ldr(reg_diff_dst, ptr(reg_param, GET_OFF(diff_dst)));
+        ldr(reg_ws, ptr(reg_param, GET_OFF(ws)));
+
+        spatial_loop([=]() { backward_sh_channels(); });
+
+        barrier();
+        reduction(false, true, [=]() {
+            load_sqrtvar();
+            fdivr(vsqrtvar, reg_p_all, vone);
+            fmul(ZRegS(0), ZRegS(0), vsqrtvar);
+            store_chan(reg_diff_scale_shift, ZRegS(0));
+            store_chan(reg_diff_scale_shift, ZRegS(1), chan_data_offt);
+        });
+        barrier();
+
+        ldr(reg_dst, ptr(reg_param, GET_OFF(diff_src)));
+
+        spatial_loop([=]() { backward_diff_channels(); });
+    }
+
+    void generate() {
+        preamble();
+
+        ptrue(reg_p_all.s);
+        ptrue(reg_p_c.s);
+
+        compute_static_strides();
+        load_common_params();
+        prepare_relu();
+
+        if (bdesc_->is_fwd()) {
+            if (!bdesc_->stats_is_src())
+                compute_mean_variance();
+            forward();
+        } else {
+            backward();
+        }
+
+        postamble();
+    }
+
+    jit_sve_bnorm_t(const batch_normalization_pd_t *bdesc)
+        : jit_generator_aarch64(nullptr, 64 * 1024), bdesc_(bdesc) {
+        vlen = get_sve_length();
+        const int simd_w = vlen / sizeof(acc_data_t);
+        is_spatial_thr_ = bnorm_utils::is_spatial_thr(bdesc_, simd_w,
+                sizeof(acc_data_t));
+
+        /* ldr and str of a vector take offsets of up to 255 vectors, so the
+         * unrolled loop addresses the data from a single base */
+        unroll_blocks = is_spatial_thr_ ? 1 : 4;
+        unroll_regs = is_spatial_thr_ ? 1 : 4;
+
+        generate();
+        ready();
+        ker = getCode<void (*)(const call_params_t *)>();
+    }
+};
+
+struct sve_bnorm_driver_t: public c_compatible {
+    sve_bnorm_driver_t(const batch_normalization_pd_t *bdesc)
+        : bdesc_(bdesc), ker_(bdesc_) {
+        const int nthrs = mkldnn_get_max_threads();
+        const dim_t C_PADDED = get_c_padded(bdesc_);
+
+        size_t data_size = sizeof(acc_data_t) * bdesc_->MB() * C_PADDED
+            * bdesc_->D() * bdesc_->H() * bdesc_->W();
+        l3_size_ = get_cache_size(3, true) * nthrs / 2;
+        do_blocking_ = (data_size >= l3_size_ / 2 && l3_size_ > 0);
+    }
+
+    ~sve_bnorm_driver_t() {}
+
+    static int simd_w() { return get_sve_length() / sizeof(acc_data_t); }
+
+    static void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+            const batch_normalization_pd_t *bdesc) {
+        int nthrs = mkldnn_get_max_threads();
+        dim_t C_PADDED = get_c_padded(bdesc);
+
+        int sbuf_sz = use_tmp_stats(bdesc) * 2 * C_PADDED;
+        int pbuf_sz = use_tmp_diff_scale_shift(bdesc) * 2 * C_PADDED;
+        int rbuf_sz = (bdesc->is_fwd() ? 1 : 2) * C_PADDED * nthrs;
+
+        scratchpad.book(key_bnorm_tmp_stats, sizeof(acc_data_t) * sbuf_sz);
+        scratchpad.book(key_bnorm_tmp_diff_ss, sizeof(acc_data_t) * pbuf_sz);
+        scratchpad.book(key_bnorm_reduction, sizeof(acc_data_t) * rbuf_sz);
+
+        if (mkldnn_thr_syncable()) {
+            int n_barriers = C_PADDED / simd_w();
+            scratchpad.book(key_barrier, sizeof(barrier::ctx_t) * n_barriers);
+        }
+    }
+
+    void exec(int ithr, int nthr, const void *src, void *diff_src, void *dst,
+            const void *diff_dst, const acc_data_t *scale_shift,
+            acc_data_t *diff_scale_shift, const acc_data_t *mean,
+            const acc_data_t *var, const uint8_t *ws,
+            const memory_tracking::grantor_t &scratchpad) {
+        auto sbuf = scratchpad.get<acc_data_t>(key_bnorm_tmp_stats);
+        auto pbuf = scratchpad.get<acc_data_t>(key_bnorm_tmp_diff_ss);
+        auto rbuf = scratchpad.get<acc_data_t>(key_bnorm_reduction);
+        auto barriers = scratchpad.get<barrier::ctx_t>(key_barrier);
+
+        const int simd_w = this->simd_w();
+        size_t N = bdesc_->MB();
+        size_t C = bdesc_->C();
+        size_t C_PADDED = get_c_padded(bdesc_);
+        size_t D = bdesc_->D();
+        size_t H = bdesc_->H();
+        size_t W = bdesc_->W();
+        int SP = D * H * W;
+        size_t img_size = C_PADDED * D * H * W;
+        const int vlen_spat_data = ker_.vlen;
+
+        jit_sve_bnorm_t::call_params_t p;
+
+        p.eps = bdesc_->desc()->batch_norm_epsilon;
+        p.one = 1.0f;
+        p.spat_size = D * H * W;
+        p.chan_size = 1.0f * N * p.spat_size;
+
+        int C_blks = C_PADDED / simd_w;
+
+        int C_ithr{0}, C_nthr{0}, N_ithr{0}, N_nthr{0}, S_ithr{0}, S_nthr{0};
+        int C_blk_s{0}, C_blk_e{0}, N_s{0}, N_e{0}, S_s{0}, S_e{0};
+
+        int C_blks_per_iter{ 1 }, iters{ 1 };
+        if (do_blocking_) {
+            int num_tensors = bdesc_->is_fwd() ? 1 : 2;
+            size_t working_set_size = sizeof(acc_data_t)
+                    * (N * D * H * W * simd_w) * num_tensors;
+            bnorm_utils::cache_balance(working_set_size, C_blks,
+                C_blks_per_iter, iters);
+        }
+
+        // thread_balance() leaves the last threads idle when the C x N x SP
+        // decomposition doesn't fill the team, which would idle whole CMGs:
+        // renumber the threads so that the working ones spread over the CMGs
+        auto thread_balance = [&](bool sp_allowed, int blks) {
+            int C_i, C_n, N_i, N_n, S_i, S_n, C_s, C_e, N_s_, N_e_, S_s_, S_e_;
+            bnorm_utils::thread_balance(do_blocking_, sp_allowed, 0, nthr,
+                    N, blks, SP, C_i, C_n, C_s, C_e, N_i, N_n, N_s_, N_e_,
+                    S_i, S_n, S_s_, S_e_);
+            const int ithr_cmg = cmg_spread_ithr(nthr, ithr, C_n * N_n * S_n);
+            return bnorm_utils::thread_balance(do_blocking_, sp_allowed,
+                    ithr_cmg, nthr, N, blks, SP, C_ithr, C_nthr, C_blk_s,
+                    C_blk_e, N_ithr, N_nthr, N_s, N_e, S_ithr, S_nthr, S_s,
+                    S_e);
+        };
+
+        bool spatial_thr_allowed = thread_balance(true,
+                do_blocking_ ? C_blks_per_iter : C_blks);
+
+        int SP_N_ithr = N_ithr * S_nthr + S_ithr;
+        int SP_N_nthr = N_nthr * S_nthr;
+        assert(IMPLICATION(!mkldnn_thr_syncable(), SP_N_nthr == 1));
+
+        p.N_ithr = SP_N_ithr;
+        p.N_nthr = SP_N_nthr;
+
+        int last_iter_blks = C_blks - (iters - 1) * C_blks_per_iter;
+        int global_C_blk_s;
+        int global_barriers_per_iter = C_nthr;
+
+        for (int it = 0; it < iters; it++) {
+            if (it == iters - 1 && iters > 1) {
+                C_blk_s = C_blk_e = N_s = N_e = 0;
+                spatial_thr_allowed = thread_balance(spatial_thr_allowed,
+                        last_iter_blks);
+
+                // Update call parameters for JIT, last iteration
+                p.N_ithr = N_ithr * S_nthr + S_ithr;
+                p.N_nthr = N_nthr * S_nthr;
+            }
+
+            global_C_blk_s = do_blocking_ ?
+                    (C_blk_s == -1) ? -1 : it * C_blks_per_iter + C_blk_s :
+                    C_blk_s;
+
+            int C_blks_thr = C_blk_e - C_blk_s;
+            int N_thr = N_e - N_s;
+
+            size_t coff_base = global_C_blk_s * simd_w;
+            size_t soff_base
+                    = global_C_blk_s * p.spat_size * simd_w + N_s * img_size;
+
+            p.spat_size_loc = S_e - S_s;
+            p.S_s = S_s * vlen_spat_data;
+            p.S_tail = (p.spat_size - S_e) * vlen_spat_data;
+            p.coff_max = C_blks_thr * simd_w;
+            p.chan_work = coff_base < C
+                    ? nstl::min(p.coff_max, C - coff_base) : 0;
+            p.mean = (use_tmp_stats(bdesc_) ? sbuf : mean) + coff_base;
+            p.var = (use_tmp_stats(bdesc_) ? sbuf + C_PADDED : var) + coff_base;
+            p.scale_shift = scale_shift + coff_base;
+            p.diff_scale_shift = (use_tmp_diff_scale_shift(bdesc_)
+                    ? pbuf : diff_scale_shift) + coff_base;
+
+            p.soff_max = sizeof(acc_data_t) * N_thr * img_size;
+            p.src = (void *)((char *)src + soff_base * sizeof(acc_data_t));
+            p.dst = (void *)((char *)dst + soff_base * sizeof(acc_data_t));
+            p.diff_src = (void *)((char *)diff_src
+                    + soff_base * sizeof(acc_data_t));
+            p.diff_dst = (void *)((char *)diff_dst
+                    + soff_base * sizeof(acc_data_t));
+            p.ws = ws + soff_base / 8;
+
+            p.mb_stride_Bc = sizeof(acc_data_t)
+                    * (img_size - p.coff_max * p.spat_size);
+
+            // use SP_N_nthr which is the same as p.N_nthr except maybe for
+            // the last iteration.
+            p.rbuf1 = rbuf + ((it * C_blks_per_iter) * SP_N_nthr
+                    + C_blk_s * p.N_nthr + p.N_ithr * C_blks_thr) * simd_w;
+            // rbuf1 and rbuf2 have to be disjoint
+            p.rbuf2 = p.rbuf1 + C_PADDED * nthr;
+
+            size_t iter_bariers
+                    = do_blocking_ ? it * global_barriers_per_iter : 0;
+            p.barrier = barriers + C_ithr + iter_bariers;
+            if (p.soff_max != 0 && p.coff_max != 0)
+                ker_(&p);
+        }
+    }
+
+    void init_barriers(const memory_tracking::grantor_t &scratchpad) {
+        auto barriers = scratchpad.get<barrier::ctx_t>(key_barrier);
+        if (barriers) {
+            const int n_barriers = get_c_padded(bdesc_) / simd_w();
+            for (int i = 0; i < n_barriers; ++i)
+                barrier::ctx_init(&barriers[i]);
+        }
+    }
+
+private:
+    static bool use_tmp_stats(const batch_normalization_pd_t *bdesc) {
+        return true
+            && !bdesc->stats_is_src()
+            && bdesc->desc()->prop_kind == prop_kind::forward_inference;
+    }
+
+    static bool use_tmp_diff_scale_shift(const batch_normalization_pd_t *bdesc)
+    {
+        return false
+            || (bdesc->is_bwd() && !bdesc->use_scaleshift())
+            || bdesc->desc()->prop_kind == prop_kind::backward_data;
+    }
+
+    static dim_t get_c_padded(const batch_normalization_pd_t *bdesc)
+    { return bdesc->src_pd()->desc()->layout_desc.blocking.padding_dims[1]; }
+
+    const batch_normalization_pd_t *bdesc_;
+    jit_sve_bnorm_t ker_;
+    bool do_blocking_;
+    size_t l3_size_;
+};
+
+/* The channel block of the data has to be one SVE vector */
+memory_format_t desired_fmt(int ndims) {
+    using namespace memory_format;
+    const bool is_512 = get_sve_length() == 64;
+    if (ndims == 4) return is_512 ? nChw16c : nChw8c;
+    return is_512 ? nCdhw16c : nCdhw8c;
+}
+
+}
+
+using namespace data_type;
+using namespace utils;
+
+/* fwd */
+status_t jit_sve_batch_normalization_fwd_t::pd_t::init() {
+    assert(engine()->kind() == engine_kind::cpu);
+
+    bool ok = true
+        && mayiuse(sve)
+        && one_of(get_sve_length(), 32, 64)
+        && is_fwd()
+        && !has_zero_dim_memory()
+        && one_of(ndims(), 4, 5)
+        && desc()->data_desc.data_type == f32
+        && IMPLICATION(use_scaleshift(),
+                desc()->data_scaleshift_desc.data_type == f32)
+        && desc()->data_desc.format == desired_fmt(ndims())
+        && (attr()->has_default_values() || this->with_relu_post_op());
+    if (!ok) return status::unimplemented;
+
+    if (is_training() && fuse_bn_relu())
+        bn_init_default_ws(this, this->workspace_pd_, 1);
+
+    if (stats_is_src() || is_training()) {
+        memory_desc_t stats_d;
+        dims_t stats_dims = { C() };
+        mkldnn_memory_desc_init(&stats_d, 1, stats_dims, f32, memory_format::x);
+        mean_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+        variance_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+    }
+
+    auto scratchpad = scratchpad_registry().registrar();
+    sve_bnorm_driver_t::init_scratchpad(scratchpad, this);
+
+    return status::success;
+}
+
+jit_sve_batch_normalization_fwd_t::jit_sve_batch_normalization_fwd_t(
+        const pd_t *apd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    bnorm_driver_ = new sve_bnorm_driver_t(pd());
+}
+
+void jit_sve_batch_normalization_fwd_t::execute(event_t *e) const {
+    auto src = reinterpret_cast<const void *>(this->input_memory(0));
+    auto dst = reinterpret_cast<void *>(this->memory(0));
+    auto mean = reinterpret_cast<acc_data_t *>(pd()->stats_is_src()
+                    ? const_cast<char *>(this->input_memory(1))
+                    : this->memory(1));
+    auto var = reinterpret_cast<acc_data_t *>(pd()->stats_is_src()
+                    ? const_cast<char *>(this->input_memory(2))
+                    : this->memory(2));
+
+    auto idx_scale_shift = 1 + 2*pd()->stats_is_src();
+    auto ws = reinterpret_cast<uint8_t *>(this->memory(pd()->ws_idx()));
+
+    auto scratchpad = this->scratchpad();
+
+    bnorm_driver_->init_barriers(scratchpad);
+    auto scale_shift = reinterpret_cast<const acc_data_t *>(
+            this->input_memory(idx_scale_shift));
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        bnorm_driver_->exec(ithr, nthr, src, nullptr, dst, nullptr,
+                scale_shift, nullptr, mean, var, ws, scratchpad);
+    });
+    e->set_state(event_t::ready);
+}
+
+jit_sve_batch_normalization_fwd_t::~jit_sve_batch_normalization_fwd_t() {
+    delete bnorm_driver_;
+}
+
+/* bwd */
+status_t jit_sve_batch_normalization_bwd_t::pd_t::init() {
+    assert(engine()->kind() == engine_kind::cpu);
+
+    bool ok = true
+        && mayiuse(sve)
+        && one_of(get_sve_length(), 32, 64)
+        && is_bwd()
+        && !has_zero_dim_memory()
+        && one_of(ndims(), 4, 5)
+        && everyone_is(f32, desc()->data_desc.data_type,
+                desc()->diff_data_desc.data_type)
+        && IMPLICATION(use_scaleshift(), utils::everyone_is(f32,
+                desc()->data_scaleshift_desc.data_type,
+                desc()->diff_data_scaleshift_desc.data_type))
+        && everyone_is(desired_fmt(ndims()), desc()->diff_data_desc.format,
+                desc()->data_desc.format)
+        && attr()->has_default_values();
+    if (!ok) return status::unimplemented;
+
+    if (fuse_bn_relu()) {
+        bn_init_default_ws(this, this->workspace_pd_, 1);
+        size_t this_ws_sz = memory_desc_wrapper(this->workspace_pd()).size();
+
+        bool ws_ok = true
+            && hint_fwd_pd_->workspace_pd()
+            && memory_desc_wrapper(hint_fwd_pd_->workspace_pd()).size()
+            == this_ws_sz;
+        if (!ws_ok) return status::unimplemented;
+    }
+
+    auto scratchpad = scratchpad_registry().registrar();
+    sve_bnorm_driver_t::init_scratchpad(scratchpad, this);
+
+    return status::success;
+}
+
+jit_sve_batch_normalization_bwd_t::jit_sve_batch_normalization_bwd_t(
+        const pd_t *apd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    bnorm_driver_ = new sve_bnorm_driver_t(pd());
+}
+
+void jit_sve_batch_normalization_bwd_t::execute(event_t *e) const {
+    auto src = reinterpret_cast<const void *>(this->input_memory(0));
+    auto mean = reinterpret_cast<const acc_data_t *>(this->input_memory(1));
+    auto var = reinterpret_cast<const acc_data_t *>(this->input_memory(2));
+    auto diff_dst = reinterpret_cast<const void *>(this->input_memory(3));
+    auto scale_shift
+            = reinterpret_cast<const acc_data_t *>(this->input_memory(4));
+    auto diff_src = reinterpret_cast<void *>(this->memory(0));
+    auto diff_scale_shift = reinterpret_cast<acc_data_t *>(this->memory(1));
+    auto ws = reinterpret_cast<const uint8_t *>(
+            this->input_memory(pd()->ws_idx()));
+
+    auto scratchpad = this->scratchpad();
+
+    bnorm_driver_->init_barriers(scratchpad);
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        bnorm_driver_->exec(ithr, nthr, src, diff_src, nullptr, diff_dst,
+                scale_shift, diff_scale_shift, mean, var, ws, scratchpad);
+    });
+    e->set_state(event_t::ready);
+}
+
+jit_sve_batch_normalization_bwd_t::~jit_sve_batch_normalization_bwd_t() {
+    delete bnorm_driver_;
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
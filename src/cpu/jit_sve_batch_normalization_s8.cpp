@@ -0,0 +1,366 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_generator_aarch64.hpp"
+
+#include "jit_sve_batch_normalization_s8.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>(offsetof(call_params_t, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+using namespace Xbyak::Xbyak_aarch64;
+
+typedef int8_t data_t;
+
+/* One call normalizes coff_max channels of spat_size points; a point is
+ * C channels apart in n(d)hwc and 16 channels apart in a block of
+ * nC(d)hw16c. The channels are processed one vector at a time, the last
+ * vector under a whilelt predicate, so there is no scalar tail. */
+struct jit_sve_bnorm_s8_t: public jit_generator_aarch64 {
+    struct call_params_t {
+        // keep int sizes at 8 bytes -- jit code expects this
+        size_t coff_max, spat_size;
+        float eps, one;
+        const float *scale_shift, *mean, *var;
+        const data_t *src, *dst;
+    };
+
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_bnorm_s8_t)
+
+    using xreg_t = const XReg;
+    using preg_t = const PReg;
+    using zreg_t = const ZRegS;
+
+    const batch_normalization_pd_t *bdesc_;
+
+    void (*ker)(const call_params_t *);
+    void operator()(const call_params_t *p) { (*ker)(p); }
+
+    xreg_t reg_param = x0;
+
+    xreg_t reg_src = x1;
+    xreg_t reg_dst = x2;
+    xreg_t reg_mean = x3;
+    xreg_t reg_var = x4;
+    xreg_t reg_scale = x5;
+    xreg_t reg_shift = x6;
+    xreg_t reg_coff = x7;
+    xreg_t reg_coff_max = x8;
+    xreg_t reg_soff = x9;
+    xreg_t reg_stride = x10;
+    xreg_t reg_ctr = x11;
+    xreg_t reg_spat_size = x12;
+    xreg_t reg_tmp = x13;
+
+    preg_t reg_p_all = p0;
+    preg_t reg_p_c = p1;
+
+    enum { unroll = 4 };
+
+    /* z0 - z3 : data */
+    zreg_t vscale = zreg_t(4);
+    zreg_t vshift = zreg_t(5);
+    zreg_t vmean = zreg_t(6);
+    zreg_t vsqrtvar = zreg_t(7);
+    zreg_t vone = zreg_t(30);
+    zreg_t veps = zreg_t(31);
+
+    bool with_relu_;
+    int simd_w_;
+    size_t point_stride_;
+    size_t chan_data_offt_;
+
+    void compute_predefined_variables() {
+        const memory_desc_wrapper data_d(bdesc_->src_pd());
+        const bool is_blocked = utils::one_of(data_d.format(),
+                memory_format::nChw16c, memory_format::nCdhw16c);
+
+        simd_w_ = get_sve_length() / sizeof(float);
+        point_stride_ = is_blocked ? 16 : bdesc_->C();
+        chan_data_offt_ = bdesc_->C() * sizeof(float);
+        with_relu_ = (bdesc_->with_relu_post_op() || bdesc_->fuse_bn_relu())
+                && bdesc_->is_fwd();
+    }
+
+    void load_common_params() {
+        ld1rw(vone, reg_p_all, ptr(reg_param, GET_OFF(one)));
+        ld1rw(veps, reg_p_all, ptr(reg_param, GET_OFF(eps)));
+
+        ldr(reg_coff_max, ptr(reg_param, GET_OFF(coff_max)));
+        ldr(reg_spat_size, ptr(reg_param, GET_OFF(spat_size)));
+        ldr(reg_src, ptr(reg_param, GET_OFF(src)));
+        ldr(reg_dst, ptr(reg_param, GET_OFF(dst)));
+        ldr(reg_mean, ptr(reg_param, GET_OFF(mean)));
+        ldr(reg_var, ptr(reg_param, GET_OFF(var)));
+        ldr(reg_scale, ptr(reg_param, GET_OFF(scale_shift)));
+        add_imm(reg_shift, reg_scale, chan_data_offt_, reg_tmp);
+        mov_imm(reg_stride, point_stride_);
+    }
+
+    // Precomputes vscale and vshift for following
+    // `vdst = vscale * vsrc + vshift`
+    void compute_vscaleshift() {
+        ld1w(vmean, reg_p_c / T_z, ptr(reg_mean, reg_coff, LSL, 2));
+        ld1w(vsqrtvar, reg_p_c / T_z, ptr(reg_var, reg_coff, LSL, 2));
+        fadd(vsqrtvar, vsqrtvar, veps);
+        fsqrt(vsqrtvar, reg_p_all / T_m, vsqrtvar);
+
+        if (bdesc_->use_scaleshift()) {
+            ld1w(vscale, reg_p_c / T_z, ptr(reg_scale, reg_coff, LSL, 2));
+            ld1w(vshift, reg_p_c / T_z, ptr(reg_shift, reg_coff, LSL, 2));
+            fdiv(vscale, reg_p_all, vsqrtvar);
+            fmls(vshift, reg_p_all, vmean, vscale);
+        } else {
+            mov(ZRegD(vscale.getIdx()), ZRegD(vone.getIdx()));
+            fdiv(vscale, reg_p_all, vsqrtvar);
+            fmul(vshift, vmean, vscale);
+            fneg(vshift, reg_p_all / T_m, vshift);
+        }
+    }
+
+    /* Rounds to nearest even as vcvtps2dq does and saturates to s8, the
+     * ReLU is folded into the lower bound of the saturation. */
+    void compute_point(const ZRegS &v) {
+        ld1sb(v, reg_p_c / T_z, ptr(reg_src, reg_soff));
+        scvtf(v, reg_p_all / T_m, v);
+        fmad(v, reg_p_all, vscale, vshift);
+        frintn(v, reg_p_all / T_m, v);
+        fcvtzs(v, reg_p_all / T_m, v);
+        smin(v, 127);
+        smax(v, with_relu_ ? 0 : -128);
+        st1b(v, reg_p_c, ptr(reg_dst, reg_soff));
+        add(reg_soff, reg_soff, reg_stride);
+    }
+
+    void forward() {
+        LabelAArch64 c_loop;
+        mov(reg_coff, 0);
+        L_aarch64(c_loop);
+        {
+            whilelt(reg_p_c.s, reg_coff, reg_coff_max);
+            compute_vscaleshift();
+
+            LabelAArch64 sp_unroll_loop, sp_loop, sp_end;
+            mov(reg_soff, reg_coff);
+
+            lsr(reg_ctr, reg_spat_size, 2);
+            cbz(reg_ctr, sp_loop);
+            L_aarch64(sp_unroll_loop);
+            {
+                for (int i = 0; i < unroll; i++)
+                    compute_point(ZRegS(i));
+                subs(reg_ctr, reg_ctr, 1);
+                b(NE, sp_unroll_loop);
+            }
+
+            L_aarch64(sp_loop);
+            and_(reg_ctr, reg_spat_size, unroll - 1);
+            cbz(reg_ctr, sp_end);
+            LabelAArch64 sp_tail_loop;
+            L_aarch64(sp_tail_loop);
+            {
+                compute_point(ZRegS(0));
+                subs(reg_ctr, reg_ctr, 1);
+                b(NE, sp_tail_loop);
+            }
+            L_aarch64(sp_end);
+
+            add(reg_coff, reg_coff, simd_w_);
+            cmp(reg_coff, reg_coff_max);
+            b(LT, c_loop);
+        }
+    }
+
+    jit_sve_bnorm_s8_t(const batch_normalization_pd_t *bdesc)
+        : jit_generator_aarch64(nullptr, 16 * 1024), bdesc_(bdesc) {
+        compute_predefined_variables();
+
+        preamble();
+        ptrue(reg_p_all.s);
+        load_common_params();
+        forward();
+        postamble();
+
+        ready();
+        ker = getCode<void (*)(const call_params_t *)>();
+    }
+};
+
+struct sve_bnorm_s8_driver_t: public c_compatible {
+    sve_bnorm_s8_driver_t(const batch_normalization_pd_t *bdesc)
+        : bdesc_(bdesc), ker_(bdesc_) {
+        const memory_desc_wrapper data_d(bdesc_->src_pd());
+        is_blocked_ = utils::one_of(data_d.format(),
+                memory_format::nChw16c, memory_format::nCdhw16c);
+    }
+    ~sve_bnorm_s8_driver_t() {}
+
+    void exec(int ithr, int nthr, const data_t *src, data_t *dst,
+            const float *scale_shift, const float *mean, const float *var) {
+        dim_t N = bdesc_->MB();
+        dim_t C = bdesc_->C();
+        dim_t D = bdesc_->D();
+        dim_t H = bdesc_->H();
+        dim_t W = bdesc_->W();
+        dim_t SP = D * H * W;
+
+        jit_sve_bnorm_s8_t::call_params_t p;
+
+        p.eps = bdesc_->desc()->batch_norm_epsilon;
+        p.one = 1.0f;
+
+        if (is_blocked_) {
+            // one block of 16 channels of one image per call
+            const dim_t blksize = 16;
+            const dim_t C_blks = utils::div_up(C, blksize);
+
+            dim_t start{ 0 }, end{ 0 };
+            balance211(N * C_blks, nthr, ithr, start, end);
+
+            dim_t n{ 0 }, cb{ 0 };
+            utils::nd_iterator_init(start, n, N, cb, C_blks);
+            for (dim_t iwork = start; iwork < end; ++iwork) {
+                const dim_t coff = cb * blksize;
+                const size_t soff = (n * C_blks + cb) * SP * blksize;
+
+                p.coff_max = nstl::min(blksize, C - coff);
+                p.spat_size = SP;
+                p.scale_shift = scale_shift + coff;
+                p.mean = mean + coff;
+                p.var = var + coff;
+                p.src = src + soff;
+                p.dst = dst + soff;
+                ker_(&p);
+
+                utils::nd_iterator_step(n, N, cb, C_blks);
+            }
+            return;
+        }
+
+        p.scale_shift = scale_shift;
+        p.mean = mean;
+        p.var = var;
+
+        dim_t work_amount{ N * SP }, start{ 0 }, end{ 0 };
+        balance211(work_amount, nthr, ithr, start, end);
+
+        p.coff_max = C;
+        p.spat_size = end - start;
+        p.src = src + start * C;
+        p.dst = dst + start * C;
+
+        if (p.spat_size != 0)
+            ker_(&p);
+    }
+
+private:
+    const batch_normalization_pd_t *bdesc_;
+    bool is_blocked_;
+
+    jit_sve_bnorm_s8_t ker_;
+};
+
+}
+
+using namespace data_type;
+using namespace memory_format;
+using namespace utils;
+
+/* fwd */
+
+status_t jit_sve_batch_normalization_s8_fwd_t::pd_t::init() {
+    using namespace prop_kind;
+    assert(engine()->kind() == engine_kind::cpu);
+    auto desired_fmts = (ndims() == 4)
+        ? one_of(desc()->data_desc.format, nhwc, nChw16c)
+        : one_of(desc()->data_desc.format, ndhwc, nCdhw16c);
+
+    bool ok = true
+        && mayiuse(sve)
+        && is_fwd()
+        && !has_zero_dim_memory()
+        && one_of(ndims(), 4, 5)
+        && stats_is_src()
+        && desc()->prop_kind == forward_inference
+        && desc()->data_desc.data_type == s8
+        && IMPLICATION(use_scaleshift(),
+                desc()->data_scaleshift_desc.data_type == f32)
+        && desired_fmts
+        && (attr()->has_default_values() || this->with_relu_post_op());
+    if (!ok) return status::unimplemented;
+
+    memory_desc_t stats_d;
+    dims_t stats_dims = {C()};
+    mkldnn_memory_desc_init(&stats_d, 1, stats_dims, data_type::f32,
+            memory_format::x);
+    mean_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+    variance_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+
+    return status::success;
+}
+
+jit_sve_batch_normalization_s8_fwd_t::jit_sve_batch_normalization_s8_fwd_t(
+        const pd_t *apd, const input_vector &inputs,
+        const output_vector &outputs) : cpu_primitive_t(apd, inputs, outputs) {
+    bnorm_driver_ = new sve_bnorm_s8_driver_t(pd());
+}
+
+void jit_sve_batch_normalization_s8_fwd_t::execute(event_t *e) const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+    auto mean = reinterpret_cast<float *>(const_cast<char*>(
+                this->input_memory(1)));
+    auto var = reinterpret_cast<float *>(const_cast<char*>(
+                this->input_memory(2)));
+
+    auto idx_scale_shift = 1 + 2*pd()->stats_is_src();
+    auto scale_shift =
+        reinterpret_cast<const float *>(this->input_memory(idx_scale_shift));
+
+    // do sequential if the problem is less than one 4K memory page
+    const bool force_sequential = pd()->MB() * pd()->C() * pd()->D() * pd()->H()
+        * pd()->W() <= 4096;
+
+    parallel(force_sequential ? 1 : 0, [&](const int ithr, const int nthr) {
+        bnorm_driver_->exec(ithr, nthr, src, dst, scale_shift, mean, var);
+    });
+
+    e->set_state(event_t::ready);
+}
+
+jit_sve_batch_normalization_s8_fwd_t::~jit_sve_batch_normalization_s8_fwd_t() {
+    delete bnorm_driver_;
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
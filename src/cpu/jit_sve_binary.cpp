@@ -0,0 +1,375 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_generator_aarch64.hpp"
+
+#include "jit_sve_binary.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>(offsetof(call_params_t, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+typedef float data_t;
+
+using namespace Xbyak::Xbyak_aarch64;
+
+/* One call computes a run of len contiguous elements of dst, unroll vectors
+ * at a time and then vector by vector, the last one under a whilelt
+ * predicate. A broadcast src1 is loaded once per call. */
+struct jit_sve_binary_kernel_t: public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_binary_kernel_t)
+
+    typedef jit_binary_call_s call_params_t;
+
+    using xreg_t = const XReg;
+    using preg_t = const PReg;
+    using zreg_t = const ZRegS;
+
+    void (*ker)(const call_params_t *);
+    void operator()(const call_params_t *p) const { (*ker)(p); }
+
+    jit_binary_conf_t jbp_;
+
+    xreg_t reg_param = x0;
+
+    xreg_t reg_src0 = x1;
+    xreg_t reg_src1 = x2;
+    xreg_t reg_dst = x3;
+    xreg_t reg_len = x4;
+    xreg_t reg_tmp = x5;
+
+    preg_t reg_p_all = p0;
+    preg_t reg_p_tail = p1;
+    preg_t reg_p_src1 = p2;
+
+    /* z0 - z3 : src0 and dst, z4 - z7 : src1 */
+    int data_idx(int i) const { return i; }
+    int src1_idx(int i) const { return 4 + i; }
+
+    zreg_t z_src1 = zreg_t(8); // broadcast src1
+
+    PReg pred(bool tail) const { return tail ? reg_p_tail : reg_p_all; }
+
+    void compute(const ZRegS &z, const ZRegS &rhs) {
+        using namespace alg_kind;
+        switch (jbp_.alg) {
+        case binary_add: fadd(z, z, rhs); break;
+        case binary_mul: fmul(z, z, rhs); break;
+        case binary_max: fmax(z, reg_p_all, rhs); break;
+        case binary_min: fmin(z, reg_p_all, rhs); break;
+        default: assert(!"unknown binary alg_kind");
+        }
+    }
+
+    void body(int unroll, bool tail) {
+        const bool bcast = jbp_.bcast != binary_bcast_none;
+        for (int i = 0; i < unroll; i++) {
+            ld1w(ZRegS(data_idx(i)), pred(tail) / T_z,
+                    ptr(reg_src0, static_cast<int32_t>(i), MUL_VL));
+            if (!bcast)
+                ld1w(ZRegS(src1_idx(i)), pred(tail) / T_z,
+                        ptr(reg_src1, static_cast<int32_t>(i), MUL_VL));
+        }
+        for (int i = 0; i < unroll; i++)
+            compute(ZRegS(data_idx(i)), bcast ? z_src1 : ZRegS(src1_idx(i)));
+        for (int i = 0; i < unroll; i++)
+            st1w(ZRegS(data_idx(i)), pred(tail),
+                    ptr(reg_dst, static_cast<int32_t>(i), MUL_VL));
+    }
+
+    void advance(int n_vecs) {
+        const dim_t bytes = n_vecs * jbp_.simd_w * sizeof(data_t);
+        add_imm(reg_src0, reg_src0, bytes, reg_tmp);
+        add_imm(reg_dst, reg_dst, bytes, reg_tmp);
+        if (jbp_.bcast == binary_bcast_none)
+            add_imm(reg_src1, reg_src1, bytes, reg_tmp);
+    }
+
+    void generate() {
+        preamble();
+
+        ptrue(reg_p_all.s);
+
+        ldr(reg_src0, ptr(reg_param, GET_OFF(src0)));
+        ldr(reg_src1, ptr(reg_param, GET_OFF(src1)));
+        ldr(reg_dst, ptr(reg_param, GET_OFF(dst)));
+        ldr(reg_len, ptr(reg_param, GET_OFF(len)));
+
+        if (jbp_.bcast == binary_bcast_scalar) {
+            ld1rw(z_src1, reg_p_all / T_z, ptr(reg_src1));
+        } else if (jbp_.bcast == binary_bcast_vector) {
+            /* the lanes past src1_len are zero, so are those of src0 */
+            ldr(reg_tmp, ptr(reg_param, GET_OFF(src1_len)));
+            whilelt(reg_p_src1.s, xzr, reg_tmp);
+            ld1w(z_src1, reg_p_src1 / T_z, ptr(reg_src1));
+        }
+
+        const int step = jbp_.unroll * jbp_.simd_w;
+        LabelAArch64 unroll_loop, tail_loop, end;
+
+        L_aarch64(unroll_loop); {
+            cmp(reg_len, step);
+            b(LT, tail_loop);
+            body(jbp_.unroll, false);
+            advance(jbp_.unroll);
+            sub(reg_len, reg_len, step);
+            b(unroll_loop);
+        }
+
+        L_aarch64(tail_loop); {
+            cmp(reg_len, 0);
+            b(LE, end);
+            whilelt(reg_p_tail.s, xzr, reg_len);
+            body(1, true);
+            advance(1);
+            sub(reg_len, reg_len, jbp_.simd_w);
+            b(tail_loop);
+        }
+
+        L_aarch64(end);
+        postamble();
+    }
+
+    jit_sve_binary_kernel_t(const jit_binary_conf_t &jbp)
+        : jit_generator_aarch64(nullptr, 16 * 1024), jbp_(jbp) {
+        assert(jbp_.unroll >= 1 && jbp_.unroll <= 4);
+
+        if (!load_cached_code(&jbp_, sizeof(jbp_)))
+            generate();
+        ready();
+        ker = getCode<void (*)(const call_params_t *)>();
+    }
+};
+
+}
+
+namespace sve_binary_utils {
+
+namespace {
+status_t init_plain(jit_binary_conf_t &jbp, binary_plan_t &bp,
+        const memory_desc_wrapper &src1_d, const memory_desc_wrapper &dst_d) {
+    if (!(dst_d.is_dense() && src1_d.is_plain() && src1_d.is_dense()))
+        return status::unimplemented;
+
+    const int ndims = dst_d.ndims();
+    const dims_t &dims = dst_d.dims();
+    const dims_t &src1_dims = src1_d.dims();
+    const auto &dst_strides = dst_d.blocking_desc().strides[0];
+    const auto &src1_strides = src1_d.blocking_desc().strides[0];
+
+    /* the dims of dst that matter, from the outermost in memory */
+    int perm[TENSOR_MAX_DIMS];
+    int n = 0;
+    for (int d = 0; d < ndims; d++) {
+        if (dims[d] == 1) continue;
+        int i = n++;
+        for (; i > 0 && dst_strides[perm[i - 1]] < dst_strides[d]; i--)
+            perm[i] = perm[i - 1];
+        perm[i] = d;
+    }
+
+    auto is_bcast = [&](int d) { return src1_dims[d] == 1; };
+
+    /* src1 has to be dense along the same dims in the same order */
+    dim_t src1_stride = 1;
+    for (int i = n - 1; i >= 0; i--) {
+        const int d = perm[i];
+        if (is_bcast(d)) continue;
+        if (src1_strides[d] != src1_stride) return status::unimplemented;
+        src1_stride *= dims[d];
+    }
+
+    const bool inner_bcast = n > 0 && is_bcast(perm[n - 1]);
+    int first = n > 0 ? n - 1 : 0;
+    while (first > 0 && is_bcast(perm[first - 1]) == inner_bcast)
+        first--;
+
+    jbp.bcast = inner_bcast ? binary_bcast_scalar : binary_bcast_none;
+    bp.run_len = 1;
+    for (int i = first; i < n; i++)
+        bp.run_len *= dims[perm[i]];
+    bp.n_outer = first;
+    for (int i = 0; i < first; i++) {
+        const int d = perm[i];
+        bp.outer_dims[i] = dims[d];
+        bp.dst_strides[i] = dst_strides[d];
+        bp.src1_strides[i] = is_bcast(d) ? 0 : src1_strides[d];
+    }
+
+    return status::success;
+}
+
+status_t init_blocked(jit_binary_conf_t &jbp, binary_plan_t &bp,
+        const memory_desc_wrapper &src1_d, const memory_desc_wrapper &dst_d) {
+    const int ndims = dst_d.ndims();
+    const dims_t &dims = dst_d.dims();
+    const dims_t &src1_dims = src1_d.dims();
+    const auto &bd = dst_d.blocking_desc();
+    const int blk = bd.block_dims[1];
+
+    bool ok = true
+        && ndims >= 3
+        && blk == jbp.simd_w
+        && utils::array_product(bd.block_dims, ndims) == blk
+        && bd.strides[1][1] == 1
+        && src1_d.is_plain()
+        && src1_d.blocking_desc().strides[0][1] == 1
+        && src1_dims[1] == dims[1];
+    for (int d = 2; d < ndims; d++)
+        ok = ok && src1_dims[d] == 1;
+    if (!ok) return status::unimplemented;
+
+    /* the spatial points of a block of channels are contiguous */
+    dim_t sp_stride = blk;
+    for (int d = ndims - 1; d >= 2; d--) {
+        if (bd.strides[0][d] != sp_stride) return status::unimplemented;
+        sp_stride *= dims[d];
+    }
+
+    jbp.bcast = binary_bcast_vector;
+    bp.run_len = sp_stride;
+    bp.n_outer = 2;
+    bp.outer_dims[0] = dims[0];
+    bp.outer_dims[1] = utils::div_up(dims[1], blk);
+    bp.dst_strides[0] = bd.strides[0][0];
+    bp.dst_strides[1] = bd.strides[0][1];
+    bp.src1_strides[0] = src1_dims[0] == 1
+        ? 0 : src1_d.blocking_desc().strides[0][0];
+    bp.src1_strides[1] = blk;
+    bp.blk_dim = 1;
+    bp.C = dims[1];
+
+    return status::success;
+}
+}
+
+status_t init_conf(jit_binary_conf_t &jbp, binary_plan_t &bp,
+        const binary_pd_t *pd) {
+    const memory_desc_wrapper src0_d(pd->src_pd(0));
+    const memory_desc_wrapper src1_d(pd->src_pd(1));
+    const memory_desc_wrapper dst_d(pd->dst_pd());
+
+    jbp.alg = pd->desc()->alg_kind;
+    jbp.simd_w = get_sve_length() / sizeof(data_t);
+    jbp.unroll = 4;
+
+    bp.n_outer = 0;
+    bp.blk_dim = -1;
+    bp.C = 0;
+
+    bool ok = true
+        && src0_d == dst_d
+        && dst_d.is_blocking_desc()
+        && src1_d.is_blocking_desc();
+    if (!ok) return status::unimplemented;
+
+    /* the padding of src0 and src1 is zero, so is the one of dst */
+    if (src1_d == dst_d && dst_d.is_dense(true)) {
+        jbp.bcast = binary_bcast_none;
+        bp.run_len = dst_d.nelems(true);
+        return status::success;
+    }
+
+    return dst_d.is_plain()
+        ? init_plain(jbp, bp, src1_d, dst_d)
+        : init_blocked(jbp, bp, src1_d, dst_d);
+}
+
+}
+
+jit_sve_binary_t::jit_sve_binary_t(const pd_t *apd,
+        const input_vector &inputs, const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    kernel_ = new jit_sve_binary_kernel_t(pd()->jbp_);
+}
+
+jit_sve_binary_t::~jit_sve_binary_t() {
+    delete kernel_;
+}
+
+void jit_sve_binary_t::execute_forward() const {
+    const memory_desc_wrapper src0_d(pd()->src_pd(0));
+    const memory_desc_wrapper src1_d(pd()->src_pd(1));
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+
+    auto src0 = reinterpret_cast<const data_t *>(this->input_memory(0))
+        + src0_d.off_l(0);
+    auto src1 = reinterpret_cast<const data_t *>(this->input_memory(1))
+        + src1_d.off_l(0);
+    auto dst = reinterpret_cast<data_t *>(this->memory(0)) + dst_d.off_l(0);
+
+    const auto &jbp = pd()->jbp_;
+    const auto &bp = pd()->bp_;
+    const dim_t simd_w = jbp.simd_w;
+
+    dim_t n_runs = 1;
+    for (int i = 0; i < bp.n_outer; i++)
+        n_runs *= bp.outer_dims[i];
+
+    /* too few runs for the threads: split them in chunks, still big
+     * enough to amortize the call */
+    const dim_t min_chunk = 16 * jbp.unroll * simd_w;
+    const int nthr = mkldnn_get_max_threads();
+    dim_t nb_chunks = 1;
+    if (n_runs < nthr)
+        nb_chunks = nstl::min(utils::div_up((dim_t)nthr, n_runs),
+                utils::div_up(bp.run_len, min_chunk));
+    const dim_t chunk = utils::rnd_up(utils::div_up(bp.run_len, nb_chunks),
+            simd_w);
+    nb_chunks = utils::div_up(bp.run_len, chunk);
+
+    parallel_nd(n_runs, nb_chunks, [&](dim_t run, dim_t ic) {
+        dim_t dst_off = 0, src1_off = 0, src1_len = simd_w;
+        for (int i = bp.n_outer - 1; i >= 0; i--) {
+            const dim_t pos = run % bp.outer_dims[i];
+            run /= bp.outer_dims[i];
+            dst_off += pos * bp.dst_strides[i];
+            src1_off += pos * bp.src1_strides[i];
+            if (i == bp.blk_dim)
+                src1_len = nstl::min(simd_w, bp.C - pos * simd_w);
+        }
+
+        const dim_t start = ic * chunk;
+        if (jbp.bcast == binary_bcast_none) src1_off += start;
+
+        jit_binary_call_s p;
+        p.src0 = src0 + dst_off + start;
+        p.src1 = src1 + src1_off;
+        p.dst = dst + dst_off + start;
+        p.len = nstl::min(chunk, bp.run_len - start);
+        p.src1_len = src1_len;
+        (*kernel_)(&p);
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
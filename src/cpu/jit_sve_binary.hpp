@@ -0,0 +1,115 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_BINARY_HPP
+#define JIT_SVE_BINARY_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_binary_pd.hpp"
+#include "cpu_isa_traits.hpp"
+#include "cpu_primitive.hpp"
+#include "jit_primitive_conf.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace { struct jit_sve_binary_kernel_t; }
+
+namespace sve_binary_utils {
+/* dst (and src0, which has the same layout) is made of runs of run_len
+ * contiguous elements addressed by n_outer outer dims; src1 follows the
+ * runs as jit_binary_conf_t::bcast says, its outer strides being 0 along
+ * the broadcast dims */
+struct binary_plan_t {
+    int n_outer;
+    dim_t outer_dims[TENSOR_MAX_DIMS];
+    dim_t dst_strides[TENSOR_MAX_DIMS];
+    dim_t src1_strides[TENSOR_MAX_DIMS];
+    dim_t run_len;
+    int blk_dim; /* outer dim of the channel blocks for binary_bcast_vector */
+    dim_t C;
+};
+
+/* Handles src0 and dst of the same layout, either
+ * - src1 of the same layout as well (one run over the padded elements),
+ * - dense plain layouts, src1 dense plain in the order of dst: the runs are
+ *   the innermost dims along which src1 is either broadcast or not,
+ * - nC[d]hw16c with src1 of dims (N or 1) x C x 1 ... and C contiguous:
+ *   the runs are the blocks of 16 channels (one vector of src1). */
+status_t init_conf(jit_binary_conf_t &jbp, binary_plan_t &bp,
+        const binary_pd_t *pd);
+}
+
+struct jit_sve_binary_t: public cpu_primitive_t {
+    struct pd_t: public cpu_binary_pd_t {
+        pd_t(engine_t *engine, const binary_desc_t *adesc,
+                const primitive_attr_t *attr, const binary_pd_t *hint_pd)
+            : cpu_binary_pd_t(engine, adesc, attr, hint_pd)
+            , jbp_(), bp_() {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_binary_t);
+
+        virtual status_t init() override {
+            using namespace data_type;
+            bool ok = true
+                && mayiuse(sve)
+                && !has_zero_dim_memory()
+                && set_default_params() == status::success
+                && utils::everyone_is(f32, desc()->src_desc[0].data_type,
+                        desc()->src_desc[1].data_type,
+                        desc()->dst_desc.data_type)
+                && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            return sve_binary_utils::init_conf(jbp_, bp_, this);
+        }
+
+        jit_binary_conf_t jbp_;
+        sve_binary_utils::binary_plan_t bp_;
+    };
+
+    jit_sve_binary_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs);
+    ~jit_sve_binary_t();
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_sve_binary_kernel_t *kernel_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
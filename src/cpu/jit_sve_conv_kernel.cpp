@@ -92,6 +92,17 @@ inline bool is_1stconv(const jit_conv_conf_t &jcp) {
         return one_of(jcp.ic, 1, 3);
 }
 
+/* Blocked layouts follow the SVE vector length: 16 floats on 512-bit
+ * machines, 8 floats on 256-bit ones. */
+inline bool sve_simd_w_ok(int simd_w) {
+    return sve_length_supported() && one_of(simd_w, 8, 16);
+}
+
+inline memory_format_t pick_by_simd_w(int simd_w, memory_format_t fmt4,
+        memory_format_t fmt8, memory_format_t fmt16) {
+    return simd_w == 4 ? fmt4 : (simd_w == 8 ? fmt8 : fmt16);
+}
+
 inline bool is_ow_threading_on(const jit_conv_conf_t &jcp) {
     return (jcp.nb_ow > 1);
 }
@@ -147,6 +158,16 @@ void _jit_sve_conv_fwd_kernel<Vmm>::store_output(int ur_w)
         return xa::ZRegS(idx);
     };
 
+    auto binary_op = [=](xa::ZRegS z, xa::ZRegS rhs) {
+        switch (jcp.binary_alg) {
+        case alg_kind::binary_add: CGA64::fadd(z, z, rhs); break;
+        case alg_kind::binary_mul: CGA64::fmul(z, z, rhs); break;
+        case alg_kind::binary_max: CGA64::fmax(z, reg_p_all_ones, rhs); break;
+        case alg_kind::binary_min: CGA64::fmin(z, reg_p_all_ones, rhs); break;
+        default: assert(!"unsupported binary post-op");
+        }
+    };
+
     xa::LabelAArch64 no_update_label, store_label, eltwise_label;
 
     CGA64::ldr(reg_channel, xa::ptr(abi_param1_aarch64, GET_OFF(channel)));
@@ -183,7 +204,7 @@ void _jit_sve_conv_fwd_kernel<Vmm>::store_output(int ur_w)
 
         if( (VL_OFS(ofs) < LDRMAX) &&
             (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-            ((ofs&0x3f) == 0)){
+            VL_ALIGNED(ofs)){
             CGA64::ldr(zreg_tmp(idx), xa::ptr(reg_bias, static_cast<int32_t>(VL_OFS(ofs))));
         }else{
             CGA64::add_imm(reg_tmp_addr, reg_bias, ofs, reg_tmp_imm);
@@ -224,12 +245,31 @@ void _jit_sve_conv_fwd_kernel<Vmm>::store_output(int ur_w)
         }
     }
 
+    if (jcp.with_binary) {
+        CGA64::cmp(reg_channel, jcp.nb_ic - 1);
+        CGA64::b(xa::LT, store_label);
+
+        /* reg_bias is free once the bias is added */
+        CGA64::ldr(reg_bias,
+                xa::ptr(abi_param1_aarch64, GET_OFF(binary_src1)));
+        const bool per_oc = jcp.binary_bcast == binary_po_bcast_per_oc;
+        if (!per_oc)
+            CGA64::ld1rw(zreg_tmp_s(reg_ofs), reg_p_all_ones,
+                    xa::ptr(reg_bias));
+        for (int k = 0; k < jcp.nb_oc_blocking; k++) {
+            if (per_oc)
+                bias_load(jcp.typesize_out * k * jcp.oc_block, reg_ofs);
+            for (int j = 0; j < ur_w; j++)
+                binary_op(zreg_out_s(j, k), zreg_tmp_s(reg_ofs));
+        }
+    }
+
     auto out_str = [=](int j, int k, int aux_output_offset){
         int ofs = aux_output_offset;
 
         if( (VL_OFS(ofs) < LDRMAX) &&
             (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-            ((ofs&0x3f) == 0)){
+            VL_ALIGNED(ofs)){
             CGA64::str(zreg_out(j, k), xa::ptr(reg_out, static_cast<int32_t>(VL_OFS(ofs))));
         }else{
             CGA64::add_imm(reg_tmp_addr, reg_out, ofs, reg_tmp_imm);
@@ -743,7 +783,10 @@ bool jit_sve_conv_fwd_kernel::post_ops_ok(
     auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
     auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
 
-    switch (p.len_) {
+    int len = p.len_;
+    if (len > 0 && p.entry_[len - 1].is_binary()) --len; // binary goes last
+
+    switch (len) {
     case 0: return true; // no post_ops
     case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
     case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
@@ -815,8 +858,10 @@ status_t jit_sve_conv_fwd_kernel::init_conf(
         && jcp.ngroups == 1
         && src_d.data_type() == data_type::f32;
 
-    const int full_simd_w = cpu_isa_traits<sve>::vlen / sizeof(float);
-    jcp.simd_w = full_simd_w; // 512-bit simd
+    const int full_simd_w = get_sve_length() / sizeof(float);
+    jcp.simd_w = full_simd_w; // full vector length simd
+    if (!sve_simd_w_ok(jcp.simd_w))
+        return status::unimplemented;
 
     // Check whethear simd_w should be changed to 128-bit or not.
     bool ok_to_try_128bit = true
@@ -857,28 +902,46 @@ status_t jit_sve_conv_fwd_kernel::init_conf(
 #if 0
         return status::unimplemented;
 #else
+        // The eltwise injector works on 512-bit registers only
+        if (jcp.simd_w != 16) return status::unimplemented;
         jcp.eltwise = p.entry_[eltwise_ind].eltwise;
         if (dst_d.data_type() == data_type::s32) return status::unimplemented;
 #endif
     }
+    const int binary_ind = p.find(primitive_kind::binary);
+    jcp.with_binary = binary_ind != -1;
+    if (jcp.with_binary) {
+        /* the kernel reads either one value or one value per channel */
+        const auto &binary = p.entry_[binary_ind].binary;
+        jcp.binary_alg = binary.alg;
+        jcp.binary_bcast = get_binary_po_bcast(binary.src1_desc, *dst_pd.desc());
+        bool binary_ok = true
+            && dst_d.data_type() == data_type::f32
+            && utils::one_of(jcp.binary_bcast, binary_po_bcast_per_oc,
+                    binary_po_bcast_per_tensor)
+            && IMPLICATION(jcp.binary_bcast == binary_po_bcast_per_oc,
+                    jcp.oc == jcp.oc_without_padding);
+        if (!binary_ok) return status::unimplemented;
+    }
+
+    auto dst_format = pick_by_simd_w(jcp.simd_w,
+            pick(ndims - 3, nCw4c, nChw4c, nCdhw4c),        // for 128-bit
+            pick(ndims - 3, nCw8c, nChw8c, nCdhw8c),        // for 256-bit
+            pick(ndims - 3, nCw16c, nChw16c, nCdhw16c));    // for 512-bit
 
     auto src_format = jcp.is_1stconv
         ? pick(ndims - 3, ncw, nchw, ncdhw)                 // first convolution
-        : ((jcp.simd_w == 4)
-            ? pick(ndims - 3, nCw4c, nChw4c, nCdhw4c)       // for 128-bit simd
-            : pick(ndims - 3, nCw16c, nChw16c, nCdhw16c));  // for 512-bit
-
-    auto dst_format = (jcp.simd_w == 4)
-        ? pick(ndims - 3, nCw4c, nChw4c, nCdhw4c)           // for 128-bit
-        : pick(ndims - 3, nCw16c, nChw16c, nCdhw16c);       // for 512-bit
+        : dst_format;
 
     auto wei_format = with_groups
-        ? ((jcp.simd_w == 4)    // with_groups
-            ? pick(ndims - 3, gOIw4i4o, gOIhw4i4o, gOIdhw4i4o)          // for 128-bit
-            : pick(ndims - 3, gOIw16i16o, gOIhw16i16o, gOIdhw16i16o))   // for 512-bit
-        : ((jcp.simd_w == 4)    // not with_groups
-            ? pick(ndims - 3, OIw4i4o, OIhw4i4o, OIdhw4i4o)             // for 128-bit
-            : pick(ndims - 3, OIw16i16o, OIhw16i16o, OIdhw16i16o));     // for 512-bit
+        ? pick_by_simd_w(jcp.simd_w,
+            pick(ndims - 3, gOIw4i4o, gOIhw4i4o, gOIdhw4i4o),
+            pick(ndims - 3, gOIw8i8o, gOIhw8i8o, gOIdhw8i8o),
+            pick(ndims - 3, gOIw16i16o, gOIhw16i16o, gOIdhw16i16o))
+        : pick_by_simd_w(jcp.simd_w,
+            pick(ndims - 3, OIw4i4o, OIhw4i4o, OIdhw4i4o),
+            pick(ndims - 3, OIw8i8o, OIhw8i8o, OIdhw8i8o),
+            pick(ndims - 3, OIw16i16o, OIhw16i16o, OIdhw16i16o));
 
     if (src_d.format() == any)
         CHECK(src_pd.set_format(src_format));
@@ -910,12 +973,14 @@ status_t jit_sve_conv_fwd_kernel::init_conf(
         if (jcp.is_1stconv) {
 
             const auto w_format = with_groups
-                ? ((jcp.simd_w == 4)    // with_groups
-                    ? pick(ndims - 3, gOwi4o, gOhwi4o, gOdhwi4o)    // 128-bit
-                    : pick(ndims - 3, gOwi16o, gOhwi16o, gOdhwi16o))// 512-bit
-                : ((jcp.simd_w == 4)    // not with_groups
-                    ? pick(ndims - 3, Owi4o, Ohwi4o, Odhwi4o)       // 128-bit
-                    : pick(ndims - 3, Owi16o, Ohwi16o, Odhwi16o));  // 512-bit
+                ? pick_by_simd_w(jcp.simd_w,
+                    pick(ndims - 3, gOwi4o, gOhwi4o, gOdhwi4o),
+                    pick(ndims - 3, gOwi8o, gOhwi8o, gOdhwi8o),
+                    pick(ndims - 3, gOwi16o, gOhwi16o, gOdhwi16o))
+                : pick_by_simd_w(jcp.simd_w,
+                    pick(ndims - 3, Owi4o, Ohwi4o, Odhwi4o),
+                    pick(ndims - 3, Owi8o, Ohwi8o, Odhwi8o),
+                    pick(ndims - 3, Owi16o, Ohwi16o, Odhwi16o));
 
             if (weights_d.format() == any)
                 CHECK(weights_pd.set_format(w_format));
@@ -1203,7 +1268,7 @@ void jit_sve_conv_bwd_data_kernel_f32::store_output(int ur_w)
         int ofs = aux_output_offset;
         if( (VL_OFS(ofs) < LDRMAX) &&
             (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-            ((ofs&0x3f) == 0)){
+            VL_ALIGNED(ofs)){
             CGA64::ldr(zreg_tmp(), xa::ptr(reg_src, static_cast<int32_t>(VL_OFS(ofs))));
         }else{
             CGA64::add_imm(reg_tmp_addr, reg_src, ofs, reg_tmp_imm);
@@ -1216,7 +1281,7 @@ void jit_sve_conv_bwd_data_kernel_f32::store_output(int ur_w)
 
         if( (VL_OFS(ofs) < LDRMAX) &&
             (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-            ((ofs&0x3f) == 0)){
+            VL_ALIGNED(ofs)){
             CGA64::str(zreg_out(j, k), xa::ptr(reg_src, static_cast<int32_t>(VL_OFS(ofs))));
         }else{
             CGA64::add_imm(reg_tmp_addr, reg_src, ofs, reg_tmp_imm);
@@ -1323,7 +1388,7 @@ void jit_sve_conv_bwd_data_kernel_f32::compute_loop_fma(
 
         if( (VL_OFS(ofs) < LDRMAX) &&
             (VL_OFS(ofs) >= (-1 * LDRMAX)) &&
-            ((ofs&0x3f) == 0)){
+            VL_ALIGNED(ofs)){
             CGA64::ldr(zreg_ker(i), xa::ptr(aux_reg_ker, static_cast<int32_t>(VL_OFS(ofs))));
         }else{
             CGA64::add_imm(reg_tmp_addr, aux_reg_ker, ofs, reg_tmp_imm);
@@ -1780,7 +1845,9 @@ status_t jit_sve_conv_bwd_data_kernel_f32::init_conf(
 
     jcp = zero<decltype(jcp)>();
 
-    jcp.simd_w = cpu_isa_traits<sve>::vlen / sizeof(float);
+    jcp.simd_w = get_sve_length() / sizeof(float);
+    if (!sve_simd_w_ok(jcp.simd_w))
+        return status::unimplemented;
     const bool with_groups = weights_d.ndims() == diff_src_d.ndims() + 1;
     int ndims = diff_src_d.ndims();
 
@@ -1851,10 +1918,16 @@ status_t jit_sve_conv_bwd_data_kernel_f32::init_conf(
         jcp.ic = rnd_up(jcp.ic, jcp.ic_block);
     }
 
-    auto src_format = pick(ndims - 3, nCw16c, nChw16c, nCdhw16c);
+    auto src_format = pick_by_simd_w(jcp.simd_w, undef,
+            pick(ndims - 3, nCw8c, nChw8c, nCdhw8c),
+            pick(ndims - 3, nCw16c, nChw16c, nCdhw16c));
     auto wei_format = with_groups
-        ? pick(ndims - 3, gOIw16o16i, gOIhw16o16i, gOIdhw16o16i)
-        : pick(ndims - 3, OIw16o16i, OIhw16o16i, OIdhw16o16i);
+        ? pick_by_simd_w(jcp.simd_w, undef,
+            pick(ndims - 3, gOIw8o8i, gOIhw8o8i, gOIdhw8o8i),
+            pick(ndims - 3, gOIw16o16i, gOIhw16o16i, gOIdhw16o16i))
+        : pick_by_simd_w(jcp.simd_w, undef,
+            pick(ndims - 3, OIw8o8i, OIhw8o8i, OIdhw8o8i),
+            pick(ndims - 3, OIw16o16i, OIhw16o16i, OIdhw16o16i));
     bool args_ok = true
         && jcp.oc % jcp.oc_block == 0
         && jcp.ic % jcp.ic_block == 0
@@ -2443,8 +2516,7 @@ void jit_sve_conv_bwd_weights_kernel_f32::maybe_zero_kernel()
     CGA64::eor(zero, reg_p_all_ones, zero); //vpxord(zero, zero, zero);
     CGA64::mov(reg_tmp, 0);
     CGA64::L_aarch64(zeroing_loop); {
-        assert(jcp.oc_block * jcp.typesize_out
-            == cpu_isa_traits<sve>::vlen);
+        assert(jcp.oc_block * jcp.typesize_out == get_sve_length());
         for (int ic1 = 0; ic1 < jcp.ic_block; ic1++) {
             CGA64::add(reg_add_tmp, reg_kernel, reg_tmp);
             CGA64::add_imm(reg_add_tmp, reg_add_tmp, ic1 * jcp.oc_block * jcp.typesize_out, reg_tmp_imm);
@@ -3007,7 +3079,9 @@ status_t jit_sve_conv_bwd_weights_kernel_f32::init_conf(
 
     jcp = zero<decltype(jcp)>();
 
-    jcp.simd_w = cpu_isa_traits<sve>::vlen / sizeof(float);
+    jcp.simd_w = get_sve_length() / sizeof(float);
+    if (!sve_simd_w_ok(jcp.simd_w))
+        return status::unimplemented;
     jcp.ndims = ndims;
     jcp.prop_kind = cd.prop_kind;
 
@@ -3085,10 +3159,16 @@ status_t jit_sve_conv_bwd_weights_kernel_f32::init_conf(
     if (jcp.oc % jcp.oc_block)
         return status::unimplemented;
 
-    auto src_format = pick(ndims - 3, nCw16c, nChw16c, nCdhw16c);
+    auto src_format = pick_by_simd_w(jcp.simd_w, undef,
+            pick(ndims - 3, nCw8c, nChw8c, nCdhw8c),
+            pick(ndims - 3, nCw16c, nChw16c, nCdhw16c));
     auto wei_format = with_groups
-        ? pick(ndims - 3, gOIw16i16o, gOIhw16i16o, gOIdhw16i16o)
-        : pick(ndims - 3, OIw16i16o, OIhw16i16o, OIdhw16i16o);
+        ? pick_by_simd_w(jcp.simd_w, undef,
+            pick(ndims - 3, gOIw8i8o, gOIhw8i8o, gOIdhw8i8o),
+            pick(ndims - 3, gOIw16i16o, gOIhw16i16o, gOIdhw16i16o))
+        : pick_by_simd_w(jcp.simd_w, undef,
+            pick(ndims - 3, OIw8i8o, OIhw8i8o, OIdhw8i8o),
+            pick(ndims - 3, OIw16i16o, OIhw16i16o, OIdhw16i16o));
     /* conditions on bias memory */
     jcp.with_bias = cd.diff_bias_desc.format != memory_format::undef;
     if (jcp.with_bias) {
@@ -3148,8 +3228,12 @@ status_t jit_sve_conv_bwd_weights_kernel_f32::init_conf(
             jcp.ic_block = jcp.ic;
 
             const auto want_wfmt = with_groups
-                ? pick(ndims - 3, gOwi16o, gOhwi16o, gOdhwi16o)
-                : pick(ndims - 3, Owi16o, Ohwi16o, Odhwi16o);
+                ? pick_by_simd_w(jcp.simd_w, undef,
+                    pick(ndims - 3, gOwi8o, gOhwi8o, gOdhwi8o),
+                    pick(ndims - 3, gOwi16o, gOhwi16o, gOdhwi16o))
+                : pick_by_simd_w(jcp.simd_w, undef,
+                    pick(ndims - 3, Owi8o, Ohwi8o, Odhwi8o),
+                    pick(ndims - 3, Owi16o, Ohwi16o, Odhwi16o));
             if (diff_weights_d.format() == any)
                 CHECK(diff_weights_pd.set_format(want_wfmt));
             if (diff_weights_d.format() != want_wfmt)
@@ -3356,6 +3440,7 @@ void jit_sve_conv_bwd_weights_kernel_f32::balance(
 }
 
 template struct  _jit_sve_conv_fwd_kernel<Zmm>;
+template struct  _jit_sve_conv_fwd_kernel<Ymm>;
 template struct  _jit_sve_conv_fwd_kernel<Xmm>;
 
 }
@@ -55,8 +55,10 @@ namespace cpu {
 
 #define CGA64 CodeGeneratorAArch64
 namespace xa = Xbyak::Xbyak_aarch64;
-/* Get vector offsets, ofs / VL(VL: 512bits = 64Bytes) */
-#define VL_OFS(ofs) ((ofs)>>6)
+/* Get vector offsets, ofs / VL(VL: SVE vector length in bytes) */
+#define VL_OFS(ofs) ((ofs) >> get_sve_length_shift())
+/* True if ofs is a multiple of VL */
+#define VL_ALIGNED(ofs) (((ofs) & (get_sve_length() - 1)) == 0)
 
 template<typename Vmm>
 struct _jit_sve_conv_fwd_kernel : public jit_generator {
@@ -231,6 +233,7 @@ struct jit_sve_conv_fwd_kernel {
         const primitive_attr_t &attr) :
         jit_ker(nullptr),
         zmm_kernel_(nullptr),
+        ymm_kernel_(nullptr),
         xmm_kernel_(nullptr) {
         int ch_block = ajcp.is_depthwise ? ajcp.ch_block : ajcp.oc_block;
         switch (ch_block) {
@@ -240,6 +243,12 @@ struct jit_sve_conv_fwd_kernel {
                     ajcp, attr);
             jit_ker = zmm_kernel_->jit_ker_;
             return;
+        case 8:
+            ymm_kernel_ =
+                new _jit_sve_conv_fwd_kernel<Xbyak::Ymm>(
+                    ajcp, attr);
+            jit_ker = ymm_kernel_->jit_ker_;
+            return;
         case 4:
             xmm_kernel_ =
                 new _jit_sve_conv_fwd_kernel<Xbyak::Xmm>(
@@ -253,6 +262,7 @@ struct jit_sve_conv_fwd_kernel {
 
     ~jit_sve_conv_fwd_kernel() {
         delete xmm_kernel_;
+        delete ymm_kernel_;
         delete zmm_kernel_;
     }
 
@@ -275,6 +285,7 @@ struct jit_sve_conv_fwd_kernel {
 
     void(*jit_ker)(jit_conv_call_s *);
     _jit_sve_conv_fwd_kernel<Xbyak::Zmm> *zmm_kernel_;
+    _jit_sve_conv_fwd_kernel<Xbyak::Ymm> *ymm_kernel_;
     _jit_sve_conv_fwd_kernel<Xbyak::Xmm> *xmm_kernel_;
 };
 
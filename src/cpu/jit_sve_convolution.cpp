@@ -76,7 +76,8 @@ inline void jit_conv_ker_pipeline(jit_conv_ker_t ker, jit_conv_call_s &p,
 // TODO: implement it for BWD_D and BWD_W too
 inline void jit_conv_ker_pipeline_ow_thr(jit_conv_ker_t ker, jit_conv_call_s &p,
         const void *src, const void *dst, const void *filt, const void *bias,
-        int channel, int kh_padding, int owb)
+        int channel, int kh_padding, int owb,
+        const void *binary_src1 = nullptr)
 {
     PIPELINE(src);
     PIPELINE(dst);
@@ -87,6 +88,7 @@ inline void jit_conv_ker_pipeline_ow_thr(jit_conv_ker_t ker, jit_conv_call_s &p,
     // skip computation part and initialize output by zeroes
     PIPELINE(kh_padding);
     PIPELINE(owb);
+    PIPELINE(binary_src1);
 
     if (p.src)
         ker(&p);
@@ -94,7 +96,8 @@ inline void jit_conv_ker_pipeline_ow_thr(jit_conv_ker_t ker, jit_conv_call_s &p,
 
 inline void jit_conv_3d_ker_pipeline(jit_conv_ker_t ker, jit_conv_call_s &p,
         const void *src, const void *dst, const void *filt, const void *bias,
-        int channel, int kh_padding, int kd_padding)
+        int channel, int kh_padding, int kd_padding,
+        const void *binary_src1 = nullptr)
 {
     PIPELINE(src);
     PIPELINE(dst);
@@ -105,6 +108,7 @@ inline void jit_conv_3d_ker_pipeline(jit_conv_ker_t ker, jit_conv_call_s &p,
     // case kernel must skip computation part and initialize output by zeroes
     PIPELINE(kh_padding);
     PIPELINE(kd_padding);
+    PIPELINE(binary_src1);
 
     if (p.src)
         ker(&p);
@@ -113,7 +117,8 @@ inline void jit_conv_3d_ker_pipeline(jit_conv_ker_t ker, jit_conv_call_s &p,
 // TODO: implement it for BWD_D and BWD_W too
 inline void jit_conv_3d_ker_pipeline_ow_thr(jit_conv_ker_t ker,
         jit_conv_call_s &p, const void *src, const void *dst, const void *filt,
-        const void *bias, int channel, int kh_padding, int kd_padding, int owb)
+        const void *bias, int channel, int kh_padding, int kd_padding, int owb,
+        const void *binary_src1 = nullptr)
 {
     PIPELINE(src);
     PIPELINE(dst);
@@ -125,6 +130,7 @@ inline void jit_conv_3d_ker_pipeline_ow_thr(jit_conv_ker_t ker,
     PIPELINE(kh_padding);
     PIPELINE(kd_padding);
     PIPELINE(owb);
+    PIPELINE(binary_src1);
 
     if (p.src)
         ker(&p);
@@ -194,7 +200,10 @@ void jit_sve_convolution_fwd_t
 {
     auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
     auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
-    auto bias = reinterpret_cast<const dst_data_t *>(this->input_memory(2));
+    auto bias = pd()->with_bias()
+        ? reinterpret_cast<const dst_data_t *>(this->input_memory(2)) : nullptr;
+    auto binary_src1 = reinterpret_cast<const float *>(
+            this->input_memory(pd()->binary_po_input_index(0)));
     auto dst = reinterpret_cast<dst_data_t *>(this->memory());
 
     prepare_padded_bias(bias);
@@ -205,6 +214,7 @@ void jit_sve_convolution_fwd_t
 
     const auto &jcp = pd()->jcp_;
     assert(jcp.nb_oc % jcp.nb_oc_blocking == 0);
+    const bool binary_per_oc = jcp.binary_bcast == binary_po_bcast_per_oc;
 
     int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
     int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.nb_ow;
@@ -217,7 +227,7 @@ void jit_sve_convolution_fwd_t
 
     parallel(nthr, [&](const int ithr, const int nthr) {
         int start{0}, end{0}, start_copy;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance_cmg(work_amount, nthr, ithr, start, end);
         start_copy = start;
 
         auto par_conv = jit_conv_call_s();
@@ -249,6 +259,8 @@ void jit_sve_convolution_fwd_t
                 int ow_s =  owb * jcp.ow_block;
                 int iw_s =  ow_s * jcp.stride_w;
                 auto bias_w = bias ? bias + g_oc : nullptr;
+                auto binary_w = binary_src1 && binary_per_oc
+                    ? binary_src1 + g_oc : binary_src1;
                 auto dst_w = dst + dst_d.blk_off(n, g_ocb, ow_s);
                 auto src_w = src + src_d.blk_off(n, g_icb + icb_l2, iw_s);
                 auto wht_w = weights + wht_blk_off(weights_d, g, ocb, icb_l2);
@@ -256,7 +268,7 @@ void jit_sve_convolution_fwd_t
                 for (int icb = icb_l2;
                      icb < min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2); ++icb) {
                      jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv,
-                        src_w, dst_w, wht_w, bias_w, icb, 1, owb);
+                        src_w, dst_w, wht_w, bias_w, icb, 1, owb, binary_w);
 
                     src_w += src_c_stride;
                     wht_w += wht_ic_stride;
@@ -280,7 +292,7 @@ void jit_sve_convolution_fwd_t
         // here as call parameters to avoid execution of prefetch instructions
         // with nullptr, other parameters are not used in real jit call here
         jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv,
-                src, dst, weights, bias, 0, 0, 0);
+                src, dst, weights, bias, 0, 0, 0, binary_src1);
     });
 }
 
@@ -291,7 +303,10 @@ void jit_sve_convolution_fwd_t
 {
     auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
     auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
-    auto bias = reinterpret_cast<const dst_data_t *>(this->input_memory(2));
+    auto bias = pd()->with_bias()
+        ? reinterpret_cast<const dst_data_t *>(this->input_memory(2)) : nullptr;
+    auto binary_src1 = reinterpret_cast<const float *>(
+            this->input_memory(pd()->binary_po_input_index(0)));
     auto dst = reinterpret_cast<dst_data_t *>(this->memory());
 
     prepare_padded_bias(bias);
@@ -302,6 +317,7 @@ void jit_sve_convolution_fwd_t
 
     const auto &jcp = pd()->jcp_;
     assert(jcp.nb_oc % jcp.nb_oc_blocking == 0);
+    const bool binary_per_oc = jcp.binary_bcast == binary_po_bcast_per_oc;
 
     int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
     int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.oh * jcp.nb_ow;
@@ -314,7 +330,7 @@ void jit_sve_convolution_fwd_t
 
     parallel(nthr, [&](const int ithr, const int nthr) {
         int start{0}, end{0}, start_copy;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance_cmg(work_amount, nthr, ithr, start, end);
         start_copy = start;
 
         auto par_conv = jit_conv_call_s();
@@ -349,6 +365,8 @@ void jit_sve_convolution_fwd_t
                 int iw_s =  ow_s * jcp.stride_w;
                 int oh_e = oh_s + work_rem > jcp.oh ? jcp.oh : oh_s + work_rem;
                 auto bias_w = bias ? bias + g_oc : nullptr;
+                auto binary_w = binary_src1 && binary_per_oc
+                    ? binary_src1 + g_oc : binary_src1;
 
                 for (int oh_b = oh_s; oh_b < oh_e; oh_b += jcp.h_blocking) {
                     int ih_b = -jcp.t_pad + oh_b * jcp.stride_h;
@@ -380,7 +398,7 @@ void jit_sve_convolution_fwd_t
 
                             jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker,
                                 par_conv, aux_src, dst_c, aux_wht, bias_w, icb,
-                                kh_padding, owb);
+                                kh_padding, owb, binary_w);
 
                             src_c += src_h_stride * jcp.stride_h;
                             dst_c += dst_h_stride;
@@ -406,7 +424,7 @@ void jit_sve_convolution_fwd_t
         // here as call parameters to avoid execution of prefetch instructions
         // with nullptr, other parameters are not used in real jit call here
         jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv,
-                src, dst, weights, bias, 0, 0, 0);
+                src, dst, weights, bias, 0, 0, 0, binary_src1);
     });
 }
 
@@ -417,7 +435,10 @@ void jit_sve_convolution_fwd_t
 {
     auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
     auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
-    auto bias = reinterpret_cast<const dst_data_t *>(this->input_memory(2));
+    auto bias = pd()->with_bias()
+        ? reinterpret_cast<const dst_data_t *>(this->input_memory(2)) : nullptr;
+    auto binary_src1 = reinterpret_cast<const float *>(
+            this->input_memory(pd()->binary_po_input_index(0)));
     auto dst = reinterpret_cast<dst_data_t *>(this->memory());
 
     prepare_padded_bias(bias);
@@ -429,13 +450,14 @@ void jit_sve_convolution_fwd_t
 
     const auto &jcp = pd()->jcp_;
     assert(jcp.nb_oc % jcp.nb_oc_blocking == 0);
+    const bool binary_per_oc = jcp.binary_bcast == binary_po_bcast_per_oc;
 
     parallel(0, [&](const int ithr, const int nthr) {
         int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
         int start{0}, end{0}, start_copy;
         int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.od * jcp.oh
             * jcp.nb_ow;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance_cmg(work_amount, nthr, ithr, start, end);
         start_copy = start;
 
         auto par_conv = jit_conv_call_s();
@@ -485,6 +507,8 @@ void jit_sve_convolution_fwd_t
                     jcp.kd - d_t_overflow - d_b_overflow);
 
                 auto bias_w = bias ? bias + bias_d.blk_off(g_oc) : 0;
+                auto binary_w = binary_src1 && binary_per_oc
+                    ? binary_src1 + g_oc : binary_src1;
                 auto dst_w = dst + dst_d.blk_off(n, g_ocb, od_s, oh_s, ow_s);
                 auto src_w = src + src_d.blk_off(n, g_icb + icb_l2, id_s, ih_s,
                     iw_s) + d_t_overflow * dilate_d * src_d_stride;
@@ -510,7 +534,8 @@ void jit_sve_convolution_fwd_t
                             par_conv,
                             src_c + i_t_overflow * dilate_h * src_h_stride,
                             dst_c, wht_w + i_t_overflow * wht_h_stride,
-                            bias_w, icb, kh_padding, kd_padding, owb);
+                            bias_w, icb, kh_padding, kd_padding, owb,
+                            binary_w);
 
                         src_c += src_h_stride * jcp.stride_h;
                         dst_c += dst_h_stride;
@@ -537,7 +562,7 @@ void jit_sve_convolution_fwd_t
         // here as call parameters to avoid execution of prefetch instructions
         // with nullptr, other parameters are not used in real jit call here
         jit_conv_3d_ker_pipeline(kernel_->jit_ker, par_conv,
-                src, dst, weights, bias, 0, 0, 0);
+                src, dst, weights, bias, 0, 0, 0, binary_src1);
     });
 }
 
@@ -564,7 +589,7 @@ void jit_sve_convolution_bwd_data_t<diff_dst_type, wei_type,
         int start{0}, end{0}, start_copy;
         int ic_chunks = jcp.nb_ic / jcp.nb_ic_blocking;
         int work_amount = jcp.ngroups * jcp.mb * ic_chunks * jcp.ih;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance_cmg(work_amount, nthr, ithr, start, end);
         start_copy = start;
 
         auto par_conv = jit_conv_call_s();
@@ -646,7 +671,7 @@ void jit_sve_convolution_bwd_data_t<diff_dst_type, wei_type,
         int start{0}, end{0}, start_copy;
         int ic_chunks = jcp.nb_ic / jcp.nb_ic_blocking;
         int work_amount = jcp.ngroups * jcp.mb * ic_chunks * jcp.ih;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance_cmg(work_amount, nthr, ithr, start, end);
         start_copy = start;
 
         auto par_conv = jit_conv_call_s();
@@ -774,7 +799,7 @@ void jit_sve_convolution_bwd_data_t<diff_dst_type, wei_type,
         int start{0}, end{0}, start_copy;
         int ic_chunks = jcp.nb_ic / jcp.nb_ic_blocking;
         int work_amount = jcp.ngroups * jcp.mb * ic_chunks * jcp.id * jcp.ih;
-        balance211(work_amount, nthr, ithr, start, end);
+        balance_cmg(work_amount, nthr, ithr, start, end);
         start_copy = start;
 
         auto par_conv = jit_conv_call_s();
@@ -1250,10 +1275,9 @@ void jit_sve_convolution_bwd_weights_t<src_type, diff_dst_type,
 
         /* zero diff_bias if applicable */
         if (jcp.with_bias && ti->ithr_ic_b == 0) {
-            assert(jcp.oc_block == 16);
             for (int oc_b = ti->ic_b_start; oc_b < ti->oc_b_end; ++oc_b) {
-                diff_weights_data_t *db = &diff_bia[oc_b * 16];
-                for (int o = 0; o < 16; ++o)
+                diff_weights_data_t *db = &diff_bia[oc_b * jcp.oc_block];
+                for (int o = 0; o < jcp.oc_block; ++o)
                     db[o] = 0;
             }
         }
@@ -1480,7 +1504,7 @@ void jit_sve_convolution_bwd_weights_t<src_type, diff_dst_type,
 
             jit_sve_conv_3d_ker_bwd_w_pipeline(kernel_->jit_ker, p, src, dst,
                     diff_wei + wht_blk_off(diff_weights_d, g, oc_b, ic_b),
-                    diff_bia + _oc * 16, (img == img_first), od_s, od_e,
+                    diff_bia + _oc * jcp.oc_block, (img == img_first), od_s, od_e,
                     jcp.kd - kd_front_pad - kd_back_pad, kd_pad_off);
 
             p.flags = ic_b == 0 ? 0 : 1;
@@ -1654,13 +1678,13 @@ void jit_sve_convolution_bwd_weights_t<src_type, diff_dst_type,
                 + b_job_loc * rb->balancer().job_size_;
 
             if (img == img_start)
-                for (int o = 0; o < 16; ++o)
+                for (int o = 0; o < jcp.oc_block; ++o)
                     d_bias[o] = 0;
             for (int hw = 0; hw < jcp.oh * jcp.ow * jcp.od; ++hw) {
                 PRAGMA_OMP_SIMD()
-                for (int o = 0; o < 16; ++o)
+                for (int o = 0; o < jcp.oc_block; ++o)
                     d_bias[o] += d_dst[o];
-                d_dst += 16;
+                d_dst += jcp.oc_block;
             }
 
             nd_iterator_step(g, jcp.ngroups, ocb, jcp.nb_oc);
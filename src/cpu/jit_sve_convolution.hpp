@@ -43,6 +43,7 @@
 #include "cpu_reducer.hpp"
 
 #include "jit_transpose_src_utils.hpp"
+#include "jit_kernel_cache.hpp"
 #include "jit_sve_conv_kernel.hpp"
 
 namespace mkldnn {
@@ -108,10 +109,9 @@ struct jit_sve_convolution_fwd_t : public cpu_primitive_t {
             const input_vector &inputs, const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs)
     {
-        kernel_ = new jit_sve_conv_fwd_kernel(pd()->jcp_,
-                    *pd()->attr());
+        kernel_ = get_jit_kernel<jit_sve_conv_fwd_kernel>(pd()->jcp_,
+                pd()->attr(), *pd()->attr());
     }
-    ~jit_sve_convolution_fwd_t() { delete kernel_; }
 
     typedef typename prec_traits<src_type>::type src_data_t;
     typedef typename prec_traits<wei_type>::type wei_data_t;
@@ -141,7 +141,7 @@ private:
     void execute_forward_3d() const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_conv_fwd_kernel *kernel_;
+    std::shared_ptr<jit_sve_conv_fwd_kernel> kernel_;
 };
 
 template <impl::data_type_t diff_dst_type,
@@ -192,6 +192,8 @@ struct jit_sve_convolution_bwd_data_t: public cpu_primitive_t {
         inline memory_format_t src_format()
         {
             using namespace memory_format;
+            if (get_sve_length() == 32) // 256-bit vectors
+                return utils::pick(ndims() - 3, nCw8c, nChw8c, nCdhw8c);
             return utils::pick(ndims() - 3, nCw16c, nChw16c, nCdhw16c);
         }
         inline memory_format_t wei_format()
@@ -201,6 +203,11 @@ struct jit_sve_convolution_bwd_data_t: public cpu_primitive_t {
                 && diff_src_type == data_type::s32
                 && wei_type == data_type::s16) {
                 return  this->with_groups() ? gOIhw8o16i2o : OIhw8o16i2o;
+            } else if (get_sve_length() == 32) {
+                return this->with_groups()
+                    ? utils::pick(ndims() - 3, gOIw8o8i, gOIhw8o8i,
+                          gOIdhw8o8i)
+                    : utils::pick(ndims() - 3, OIw8o8i, OIhw8o8i, OIdhw8o8i);
             } else {
                 return this->with_groups()
                     ? utils::pick(ndims() - 3, gOIw16o16i, gOIhw16o16i,
@@ -319,11 +326,18 @@ struct jit_sve_convolution_bwd_weights_t: public cpu_primitive_t {
         inline memory_format_t src_format()
         {
             using namespace memory_format;
+            if (get_sve_length() == 32) // 256-bit vectors
+                return utils::pick(ndims() - 3, nCw8c, nChw8c, nCdhw8c);
             return utils::pick(ndims() - 3, nCw16c, nChw16c, nCdhw16c);
         }
         inline memory_format_t wei_format()
         {
             using namespace memory_format;
+            if (get_sve_length() == 32) // 256-bit vectors
+                return this->with_groups()
+                    ? utils::pick(ndims() - 3, gOIw8o8i, gOIhw8o8i,
+                          gOIdhw8o8i)
+                    : utils::pick(ndims() - 3, OIw8o8i, OIhw8o8i, OIdhw8o8i);
             return this->with_groups()
                 ? utils::pick(ndims() - 3, gOIw16o16i, gOIhw16o16i,
                       gOIdhw16o16i)
@@ -0,0 +1,954 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_sve_dw_conv_kernel_f32.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>(offsetof(jit_conv_call_s, field))
+#define GET_OFF_DW(field) \
+    static_cast<int32_t>(offsetof(jit_dw_conv_call_s, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_format;
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+
+namespace {
+
+inline xa::ZRegS zs(const xa::ZReg &z) { return xa::ZRegS(z.getIdx()); }
+
+inline bool vl_ofs_ok(int ofs) {
+    return VL_OFS(ofs) < LDRMAX && VL_OFS(ofs) >= -LDRMAX && VL_ALIGNED(ofs);
+}
+
+}
+
+/* Vector loads and stores: use the "MUL VL" immediate form of ldr/str when
+ * the offset can be encoded, otherwise materialize the address. */
+#define DEFINE_VREG_LDST(kernel_t) \
+inline void kernel_t::load_vreg( \
+        const xa::ZReg &z, reg64_t &base, int ofs) { \
+    if (vl_ofs_ok(ofs)) { \
+        CGA64::ldr(z, xa::ptr(base, static_cast<int32_t>(VL_OFS(ofs)))); \
+    } else { \
+        CGA64::add_imm(reg_tmp_addr, base, ofs, reg_tmp_imm); \
+        CGA64::ldr(z, xa::ptr(reg_tmp_addr)); \
+    } \
+} \
+inline void kernel_t::store_vreg( \
+        const xa::ZReg &z, reg64_t &base, int ofs) { \
+    if (vl_ofs_ok(ofs)) { \
+        CGA64::str(z, xa::ptr(base, static_cast<int32_t>(VL_OFS(ofs)))); \
+    } else { \
+        CGA64::add_imm(reg_tmp_addr, base, ofs, reg_tmp_imm); \
+        CGA64::str(z, xa::ptr(reg_tmp_addr)); \
+    } \
+}
+
+DEFINE_VREG_LDST(jit_sve_dw_conv_fwd_kernel_f32)
+DEFINE_VREG_LDST(jit_sve_dw_conv_bwd_data_kernel_f32)
+DEFINE_VREG_LDST(jit_sve_dw_conv_bwd_weights_kernel_f32)
+
+#undef DEFINE_VREG_LDST
+
+inline void jit_sve_dw_conv_fwd_kernel_f32::load_src(
+        int ur_ch_blocks, int ur_w) {
+    for (int ch = 0; ch < ur_ch_blocks; ch++) {
+        for (int ow = 0; ow < ur_w; ow++) {
+            xa::ZReg zreg_acc = get_acc_reg(ch * ur_w + ow);
+
+            int b_off = ch * jcp.ch_block;
+            if (this->jcp.with_bias)
+                load_vreg(zreg_acc, reg_bias, b_off * sizeof(float));
+            else
+                CGA64::fmov(zs(zreg_acc));
+
+            int o_off = ch * jcp.oh * jcp.ow * jcp.ch_block
+                + ow * jcp.ch_block;
+            if (this->jcp.with_sum) {
+                xa::ZReg zreg_tmp = get_tmp_reg(0);
+                load_vreg(zreg_tmp, reg_output, o_off * sizeof(float));
+                CGA64::fadd(zs(zreg_acc), zs(zreg_acc), zs(zreg_tmp));
+            }
+        }
+    }
+}
+
+inline void jit_sve_dw_conv_fwd_kernel_f32::apply_filter(
+        int ur_ch_blocks, int ur_w) {
+    int ch_blk = jcp.ch_block;
+    int dilate_h = jcp.dilate_h + 1;
+    int dilate_w = jcp.dilate_w + 1;
+    int stride_w = jcp.stride_w;
+
+    xa::LabelAArch64 iter_exit_label;
+
+    CGA64::cmp(reg_kh, 0);
+    CGA64::b(xa::EQ, iter_exit_label);
+    CGA64::cmp(reg_kw, 0);
+    CGA64::b(xa::EQ, iter_exit_label);
+
+    CGA64::mov(iter_kh, reg_kh);
+    xa::LabelAArch64 kh_label;
+    CGA64::L_aarch64(kh_label); {
+        CGA64::mov(iter_kw, reg_kw);
+        CGA64::mov(aux1_reg_input, aux_reg_input);
+        CGA64::mov(aux1_reg_kernel, aux_reg_kernel);
+
+        xa::LabelAArch64 kw_label;
+        CGA64::L_aarch64(kw_label); {
+            for (int ch = 0; ch < ur_ch_blocks; ch++) {
+                int ker_off = ch * jcp.kh * jcp.kw * ch_blk;
+                xa::ZReg zreg_ker = get_ker_reg(0);
+                load_vreg(zreg_ker, aux1_reg_kernel, ker_off * sizeof(float));
+
+                for (int ow = 0; ow < ur_w; ow++) {
+                    int inp_off = ch * jcp.ih * jcp.iw * ch_blk
+                        + ow * stride_w * ch_blk;
+                    xa::ZReg zreg_src = get_src_reg(0);
+                    load_vreg(zreg_src, aux1_reg_input,
+                            inp_off * sizeof(float));
+
+                    xa::ZReg zreg_acc = get_acc_reg(ch * ur_w + ow);
+                    CGA64::fmla(zs(zreg_acc), reg_p_all_ones, zs(zreg_src),
+                            zs(zreg_ker));
+                }
+            }
+            CGA64::add_imm(aux1_reg_kernel, aux1_reg_kernel,
+                    ch_blk * sizeof(float), reg_tmp_imm);
+            CGA64::add_imm(aux1_reg_input, aux1_reg_input,
+                    ch_blk * dilate_w * sizeof(float), reg_tmp_imm);
+
+            CGA64::subs(iter_kw, iter_kw, 1);
+            CGA64::b(xa::GT, kw_label);
+        }
+        CGA64::add_imm(aux_reg_kernel, aux_reg_kernel,
+                jcp.kw * ch_blk * sizeof(float), reg_tmp_imm);
+        CGA64::add_imm(aux_reg_input, aux_reg_input,
+                jcp.iw * ch_blk * dilate_h * sizeof(float), reg_tmp_imm);
+
+        CGA64::subs(iter_kh, iter_kh, 1);
+        CGA64::b(xa::GT, kh_label);
+    }
+
+    CGA64::L_aarch64(iter_exit_label);
+}
+
+inline void jit_sve_dw_conv_fwd_kernel_f32::apply_filter_unrolled(
+        int ur_ch_blocks, int ur_w) {
+    int ch_blk = jcp.ch_block;
+    int dilate_h = jcp.dilate_h + 1;
+    int dilate_w = jcp.dilate_w + 1;
+    int stride_w = jcp.stride_w;
+
+    xa::LabelAArch64 iter_exit_label;
+
+    CGA64::cmp(reg_kh, 0);
+    CGA64::b(xa::EQ, iter_exit_label);
+
+    CGA64::mov(iter_kh, reg_kh);
+    xa::LabelAArch64 kh_label;
+    CGA64::L_aarch64(kh_label); {
+        for (int ch = 0; ch < ur_ch_blocks; ch++) {
+            for (int kw = 0; kw < jcp.kw; kw++) {
+                int ker_off = ch * jcp.kh * jcp.kw * ch_blk + kw * ch_blk;
+
+                xa::ZReg zreg_ker = get_ker_reg(0);
+                load_vreg(zreg_ker, aux_reg_kernel, ker_off * sizeof(float));
+
+                for (int ow = 0; ow < ur_w; ow++) {
+                    int inp_off = ch * jcp.ih * jcp.iw * ch_blk
+                        + ow * stride_w * ch_blk + kw * ch_blk * dilate_w;
+
+                    xa::ZReg zreg_src = get_src_reg(0);
+                    load_vreg(zreg_src, aux_reg_input,
+                            inp_off * sizeof(float));
+
+                    xa::ZReg zreg_acc = get_acc_reg(ch * ur_w + ow);
+                    CGA64::fmla(zs(zreg_acc), reg_p_all_ones, zs(zreg_src),
+                            zs(zreg_ker));
+                }
+            }
+        }
+
+        CGA64::add_imm(aux_reg_kernel, aux_reg_kernel,
+                jcp.kw * ch_blk * sizeof(float), reg_tmp_imm);
+        CGA64::add_imm(aux_reg_input, aux_reg_input,
+                jcp.iw * ch_blk * dilate_h * sizeof(float), reg_tmp_imm);
+
+        CGA64::subs(iter_kh, iter_kh, 1);
+        CGA64::b(xa::GT, kh_label);
+    }
+
+    CGA64::L_aarch64(iter_exit_label);
+}
+
+inline void jit_sve_dw_conv_fwd_kernel_f32::apply_activation(
+        int ur_ch_blocks, int ur_w) {
+    if (this->jcp.with_eltwise)
+        eltwise_injector_->compute_vector_range(4, ur_w * ur_ch_blocks + 4);
+}
+
+inline void jit_sve_dw_conv_fwd_kernel_f32::store_dst(
+        int ur_ch_blocks, int ur_w) {
+    int ch_blk = jcp.ch_block;
+
+    for (int ch = 0; ch < ur_ch_blocks; ch++) {
+        for (int ow = 0; ow < ur_w; ow++) {
+            int o_off = ch * jcp.oh * jcp.ow * ch_blk + ow * ch_blk;
+            xa::ZReg zreg_dst = get_acc_reg(ch * ur_w + ow);
+
+            store_vreg(zreg_dst, reg_output, o_off * sizeof(float));
+        }
+    }
+}
+
+inline void jit_sve_dw_conv_fwd_kernel_f32::loop_body(int ur_ch_blocks) {
+    xa::LabelAArch64 unrolled_w_label;
+    xa::LabelAArch64 tail_w_label;
+    xa::LabelAArch64 exit_label;
+
+    CGA64::L_aarch64(unrolled_w_label); {
+        int ur_w = jcp.ur_w;
+
+        CGA64::cmp(reg_ur_w, ur_w);
+        CGA64::b(xa::LT, tail_w_label);
+
+        CGA64::mov(aux_reg_input, reg_input);
+        CGA64::mov(aux_reg_kernel, reg_kernel);
+
+        load_src(ur_ch_blocks, ur_w);
+        apply_filter_unrolled(ur_ch_blocks, ur_w);
+        apply_activation(ur_ch_blocks, ur_w);
+        store_dst(ur_ch_blocks, ur_w);
+
+        CGA64::add_imm(reg_input, reg_input,
+                sizeof(float) * ur_w * jcp.ch_block * jcp.stride_w,
+                reg_tmp_imm);
+        CGA64::add_imm(reg_output, reg_output,
+                sizeof(float) * ur_w * jcp.ch_block, reg_tmp_imm);
+
+        CGA64::sub(reg_ur_w, reg_ur_w, ur_w);
+        CGA64::b(unrolled_w_label);
+    }
+
+    CGA64::L_aarch64(tail_w_label); {
+        int ur_w = 1;
+
+        CGA64::cmp(reg_ur_w, ur_w);
+        CGA64::b(xa::LT, exit_label);
+
+        CGA64::mov(aux_reg_input, reg_input);
+        CGA64::mov(aux_reg_kernel, reg_kernel);
+
+        load_src(ur_ch_blocks, ur_w);
+        apply_filter(ur_ch_blocks, ur_w);
+        apply_activation(ur_ch_blocks, ur_w);
+        store_dst(ur_ch_blocks, ur_w);
+
+        CGA64::add_imm(reg_input, reg_input,
+                sizeof(float) * ur_w * jcp.ch_block * jcp.stride_w,
+                reg_tmp_imm);
+        CGA64::add_imm(reg_output, reg_output,
+                sizeof(float) * ur_w * jcp.ch_block, reg_tmp_imm);
+
+        CGA64::sub(reg_ur_w, reg_ur_w, ur_w);
+        CGA64::b(tail_w_label);
+    }
+
+    CGA64::L_aarch64(exit_label);
+}
+
+void jit_sve_dw_conv_fwd_kernel_f32::generate() {
+    this->preamble();
+
+    CGA64::ptrue(reg_p_all_ones.b);
+
+    CGA64::ldr(reg_input, xa::ptr(abi_param1_aarch64, GET_OFF(src)));
+    CGA64::ldr(reg_output, xa::ptr(abi_param1_aarch64, GET_OFF(dst)));
+    CGA64::ldr(reg_kernel, xa::ptr(abi_param1_aarch64, GET_OFF(filt)));
+    if (jcp.with_bias)
+        CGA64::ldr(reg_bias, xa::ptr(abi_param1_aarch64, GET_OFF(bias)));
+    CGA64::ldr(reg_kh, xa::ptr(abi_param1_aarch64, GET_OFF(kh_padding)));
+    CGA64::ldr(reg_kw, xa::ptr(abi_param1_aarch64, GET_OFF(kw_padding)));
+    CGA64::ldr(reg_ch_blocks, xa::ptr(abi_param1_aarch64, GET_OFF(ch_blocks)));
+    CGA64::ldr(reg_ur_w, xa::ptr(abi_param1_aarch64, GET_OFF(ur_w)));
+
+    xa::LabelAArch64 ch_blocks_tail_label;
+    xa::LabelAArch64 exit_label;
+
+    int ch_blocks_tail = jcp.nb_ch % jcp.nb_ch_blocking;
+
+    CGA64::cmp(reg_ch_blocks, jcp.nb_ch_blocking);
+    CGA64::b(xa::NE, ch_blocks_tail ? ch_blocks_tail_label : exit_label);
+
+    loop_body(jcp.nb_ch_blocking); // channel main loop
+
+    if (ch_blocks_tail) {
+        CGA64::b(exit_label);
+        CGA64::L_aarch64(ch_blocks_tail_label);
+
+        CGA64::cmp(reg_ch_blocks, ch_blocks_tail);
+        CGA64::b(xa::NE, exit_label);
+
+        loop_body(ch_blocks_tail); // channel tail loop
+    }
+
+    CGA64::L_aarch64(exit_label);
+
+    this->postamble();
+
+    if (jcp.with_eltwise)
+        eltwise_injector_->prepare_table();
+}
+
+inline void jit_sve_dw_conv_bwd_data_kernel_f32::load_ddst(
+        int ur_ch_blocks, int ur_str_w) {
+    for (int ch = 0; ch < ur_ch_blocks; ch++) {
+        for (int w = 0; w < ur_str_w; w++) {
+            xa::ZReg zreg_acc = get_acc_reg(ch * ur_str_w + w);
+            CGA64::fmov(zs(zreg_acc));
+        }
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_data_kernel_f32::apply_filter(
+        int ur_ch_blocks, int ur_str_w) {
+    int kw = jcp.kw;
+    int kh = jcp.kh;
+    int ow = jcp.ow;
+    int oh = jcp.oh;
+
+    int ch_blk = jcp.ch_block;
+    int stride_h = jcp.stride_h;
+    int stride_w = jcp.stride_w;
+
+    xa::LabelAArch64 iter_exit_label;
+
+    CGA64::cmp(reg_kh, 0);
+    CGA64::b(xa::EQ, iter_exit_label);
+
+    CGA64::cmp(reg_kw, 0);
+    CGA64::b(xa::EQ, iter_exit_label);
+
+    CGA64::mov(iter_kh, reg_kh);
+    xa::LabelAArch64 kh_label;
+    CGA64::L_aarch64(kh_label); {
+        CGA64::mov(aux1_reg_ddst, aux_reg_ddst);
+        CGA64::mov(aux1_reg_kernel, aux_reg_kernel);
+
+        CGA64::mov(iter_kw, reg_kw);
+        xa::LabelAArch64 kw_label;
+        CGA64::L_aarch64(kw_label); {
+            for (int ch = 0; ch < ur_ch_blocks; ch++) {
+                int ker_off = ch * kh * kw * ch_blk;
+                xa::ZReg zreg_ker = get_ker_reg(0);
+                load_vreg(zreg_ker, aux1_reg_kernel, ker_off * sizeof(float));
+
+                for (int w = 0; w < ur_str_w; w++) {
+                    int ddst_off = (ch * oh * ow + w) * ch_blk;
+
+                    xa::ZReg zreg_src = get_src_reg(0);
+                    load_vreg(zreg_src, aux1_reg_ddst,
+                            ddst_off * sizeof(float));
+
+                    xa::ZReg zreg_acc = get_acc_reg(ch * ur_str_w + w);
+                    CGA64::fmla(zs(zreg_acc), reg_p_all_ones, zs(zreg_src),
+                            zs(zreg_ker));
+                }
+            }
+
+            CGA64::add_imm(aux1_reg_kernel, aux1_reg_kernel,
+                    ch_blk * stride_w * sizeof(float), reg_tmp_imm);
+            CGA64::sub_imm(aux1_reg_ddst, aux1_reg_ddst,
+                    ch_blk * sizeof(float), reg_tmp_imm);
+
+            CGA64::subs(iter_kw, iter_kw, stride_w);
+            CGA64::b(xa::GT, kw_label);
+        }
+
+        CGA64::add_imm(aux_reg_kernel, aux_reg_kernel,
+                kw * ch_blk * stride_h * sizeof(float), reg_tmp_imm);
+        CGA64::sub_imm(aux_reg_ddst, aux_reg_ddst,
+                ow * ch_blk * sizeof(float), reg_tmp_imm);
+
+        CGA64::subs(iter_kh, iter_kh, stride_h);
+        CGA64::b(xa::GT, kh_label);
+    }
+
+    CGA64::L_aarch64(iter_exit_label);
+}
+
+inline void jit_sve_dw_conv_bwd_data_kernel_f32::store_dsrc(
+        int ur_ch_blocks, int ur_str_w) {
+    int ch_blk = jcp.ch_block;
+    int iw = jcp.iw;
+    int ih = jcp.ih;
+    int stride_w = jcp.stride_w;
+
+    for (int ch = 0; ch < ur_ch_blocks; ch++) {
+        for (int w = 0; w < ur_str_w; w++) {
+            int dsrc_off = (ch * ih * iw + w * stride_w) * ch_blk;
+            xa::ZReg zreg_acc = get_acc_reg(ch * ur_str_w + w);
+
+            store_vreg(zreg_acc, reg_dsrc, dsrc_off * sizeof(float));
+        }
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_data_kernel_f32::loop_body(
+        int ur_ch_blocks) {
+    xa::LabelAArch64 unrolled_w_label;
+    xa::LabelAArch64 tail_w_label;
+    xa::LabelAArch64 exit_label;
+
+    CGA64::L_aarch64(unrolled_w_label); {
+        int ur_w = jcp.ur_w;
+
+        CGA64::cmp(reg_ur_str_w, ur_w);
+        CGA64::b(xa::LT, tail_w_label);
+
+        CGA64::mov(aux_reg_ddst, reg_ddst);
+        CGA64::mov(aux_reg_kernel, reg_kernel);
+
+        load_ddst(ur_ch_blocks, ur_w);
+        apply_filter(ur_ch_blocks, ur_w);
+        store_dsrc(ur_ch_blocks, ur_w);
+
+        CGA64::add_imm(reg_dsrc, reg_dsrc,
+                sizeof(float) * ur_w * jcp.ch_block * jcp.stride_w,
+                reg_tmp_imm);
+        CGA64::add_imm(reg_ddst, reg_ddst,
+                sizeof(float) * ur_w * jcp.ch_block, reg_tmp_imm);
+
+        CGA64::sub(reg_ur_str_w, reg_ur_str_w, ur_w);
+        CGA64::b(unrolled_w_label);
+    }
+
+    CGA64::L_aarch64(tail_w_label); {
+        int ur_w = 1;
+
+        CGA64::cmp(reg_ur_str_w, ur_w);
+        CGA64::b(xa::LT, exit_label);
+
+        CGA64::mov(aux_reg_ddst, reg_ddst);
+        CGA64::mov(aux_reg_kernel, reg_kernel);
+
+        load_ddst(ur_ch_blocks, ur_w);
+        apply_filter(ur_ch_blocks, ur_w);
+        store_dsrc(ur_ch_blocks, ur_w);
+
+        CGA64::add_imm(reg_dsrc, reg_dsrc,
+                sizeof(float) * ur_w * jcp.ch_block * jcp.stride_w,
+                reg_tmp_imm);
+        CGA64::add_imm(reg_ddst, reg_ddst,
+                sizeof(float) * ur_w * jcp.ch_block, reg_tmp_imm);
+
+        CGA64::sub(reg_ur_str_w, reg_ur_str_w, ur_w);
+        CGA64::b(tail_w_label);
+    }
+
+    CGA64::L_aarch64(exit_label);
+}
+
+void jit_sve_dw_conv_bwd_data_kernel_f32::generate() {
+    this->preamble();
+
+    CGA64::ptrue(reg_p_all_ones.b);
+
+    CGA64::ldr(reg_dsrc, xa::ptr(abi_param1_aarch64, GET_OFF(src)));
+    CGA64::ldr(reg_ddst, xa::ptr(abi_param1_aarch64, GET_OFF(dst)));
+    CGA64::ldr(reg_kernel, xa::ptr(abi_param1_aarch64, GET_OFF(filt)));
+    CGA64::ldr(reg_kh, xa::ptr(abi_param1_aarch64, GET_OFF(kh_padding)));
+    CGA64::ldr(reg_kw, xa::ptr(abi_param1_aarch64, GET_OFF(kw_padding)));
+    CGA64::ldr(reg_ch_blocks, xa::ptr(abi_param1_aarch64, GET_OFF(ch_blocks)));
+    CGA64::ldr(reg_ur_str_w, xa::ptr(abi_param1_aarch64, GET_OFF(ur_str_w)));
+
+    xa::LabelAArch64 ch_blocks_tail_label;
+    xa::LabelAArch64 exit_label;
+
+    int ch_blocks_tail = jcp.nb_ch % jcp.nb_ch_blocking;
+
+    CGA64::cmp(reg_ch_blocks, jcp.nb_ch_blocking);
+    CGA64::b(xa::NE, ch_blocks_tail ? ch_blocks_tail_label : exit_label);
+
+    loop_body(jcp.nb_ch_blocking); // channel main loop
+
+    if (ch_blocks_tail) {
+        CGA64::b(exit_label);
+        CGA64::L_aarch64(ch_blocks_tail_label);
+
+        CGA64::cmp(reg_ch_blocks, ch_blocks_tail);
+        CGA64::b(xa::NE, exit_label);
+
+        loop_body(ch_blocks_tail); // channel tail loop
+    }
+
+    CGA64::L_aarch64(exit_label);
+
+    this->postamble();
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::zero_filter() {
+    for (int i = 0; i < jcp.kw; ++i) {
+        xa::ZReg zreg_acc = get_acc_reg(i);
+        CGA64::fmov(zs(zreg_acc));
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::load_filter() {
+    for (int i = 0; i < jcp.kw; ++i) {
+        int off_filter = i * jcp.ch_block;
+        xa::ZReg zreg_acc = get_acc_reg(i);
+        load_vreg(zreg_acc, reg_tmp_filter, off_filter * sizeof(float));
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::zero_bias() {
+    CGA64::fmov(zs(get_bias_reg(0)));
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::load_bias() {
+    load_vreg(get_bias_reg(0), reg_bias_baddr, 0);
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::compute_ow_step_unroll(
+        int unroll_w, int l_pad, int pad_offset, int ow_block) {
+
+    const int simd_w = jcp.ch_block;
+    const int iw_block = ow_block * jcp.stride_w;
+    const int right_border = jcp.iw - iw_block;
+    const int r_pad = jcp.r_pad;
+
+    const int cascade_input = nstl::min(jcp.stride_w, jcp.kw);
+
+    /* preamble count for number of cascaded LOAD + FMA operation */
+    const int input_overlap = nstl::max(jcp.kw - l_pad, 0);
+    const bool is_last_block = (unroll_w + ow_block == jcp.ow);
+
+    /* LOAD initial input registers, then cascade LOADs and FMAs*/
+    for (int i_ur = 0; i_ur < unroll_w; ++i_ur) {
+        int off_output = i_ur * simd_w;
+        xa::ZReg zreg_output = get_output_reg(0);
+        load_vreg(zreg_output, reg_tmp_output, off_output * sizeof(float));
+        if (i_ur == 0) {
+            for (int c = 0; c < input_overlap; ++c) {
+                int off_input = (c - pad_offset) * simd_w;
+                if (off_input < 0 && unroll_w == jcp.ow)
+                    continue;
+
+                const bool over_steps_bdry = true
+                    && is_last_block
+                    && (c - pad_offset + r_pad > right_border);
+                if (over_steps_bdry)
+                    continue;
+
+                xa::ZReg zreg_input = get_input_reg(c % jcp.kw);
+                load_vreg(zreg_input, reg_tmp_input,
+                        off_input * sizeof(float));
+            }
+        } else {
+            for (int c = 0; c < cascade_input; ++c) {
+                int overlap = (i_ur - 1) * jcp.stride_w + input_overlap;
+                int off_input = (overlap + c - pad_offset) * simd_w;
+                if (off_input < 0 || overlap + c + l_pad > right_border)
+                    continue;
+
+                const bool over_steps_bdry = true
+                    && is_last_block
+                    && (overlap + c - pad_offset + r_pad > right_border);
+                if (over_steps_bdry)
+                    continue;
+
+                xa::ZReg zreg_input = get_input_reg((overlap + c) % jcp.kw);
+                load_vreg(zreg_input, reg_tmp_input,
+                        off_input * sizeof(float));
+            }
+        }
+
+        for (int i_kw = 0; i_kw < jcp.kw; ++i_kw) {
+            int io_overlap = i_kw + (i_ur * jcp.stride_w);
+
+            /* Don't apply FMAs that fall into the padded region */
+            if (io_overlap - l_pad < 0
+                    || io_overlap - jcp.l_pad >= right_border)
+                continue;
+
+            const bool over_steps_bdry = true
+                && is_last_block
+                && (io_overlap - jcp.l_pad + jcp.r_pad > right_border);
+            if (over_steps_bdry)
+                continue;
+
+            xa::ZReg zreg_input
+                    = get_input_reg((io_overlap - l_pad) % jcp.kw);
+            xa::ZReg zreg_acc = get_acc_reg(i_kw);
+            CGA64::fmla(zs(zreg_acc), reg_p_all_ones, zs(zreg_input),
+                    zs(zreg_output));
+        }
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::compute_bias_step_unroll(
+        const int unroll_w) {
+    xa::ZReg zreg_bias = get_bias_reg(0);
+    for (int i = 0; i < unroll_w; ++i) {
+        int off_output = i * jcp.ch_block;
+        xa::ZReg zreg_output = get_output_reg(0);
+        load_vreg(zreg_output, reg_tmp_output, off_output * sizeof(float));
+        CGA64::fadd(zs(zreg_bias), zs(zreg_bias), zs(zreg_output));
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::store_filter() {
+    for (int i = 0; i < jcp.kw; ++i) {
+        int off_filter = i * jcp.ch_block;
+        xa::ZReg zreg_acc = get_acc_reg(i);
+        store_vreg(zreg_acc, reg_tmp_filter, off_filter * sizeof(float));
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::store_bias() {
+    store_vreg(get_bias_reg(0), reg_bias_baddr, 0);
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::compute_bias_loop(
+        const int block_size) {
+    xa::LabelAArch64 oh_label;
+    xa::LabelAArch64 ow_blk_label;
+
+    const int unroll_w = nstl::min(block_size, jcp.ow);
+    const int unroll_w_trips = jcp.ow / unroll_w;
+    const int tail_w = jcp.ow > block_size ? jcp.ow % block_size : 0;
+
+    const int ch_offset = jcp.ch_block;
+
+    CGA64::ldr(reg_oh, xa::ptr(abi_param1_aarch64, GET_OFF_DW(oh_index)));
+    CGA64::ldr(reg_oh_worksize,
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(oh_count)));
+
+    CGA64::mov(reg_tmp_output, reg_output_baddr);
+    CGA64::L_aarch64(oh_label);
+    {
+
+        CGA64::mov_imm(iter_ow_blk, unroll_w_trips);
+        CGA64::L_aarch64(ow_blk_label);
+        {
+
+            compute_bias_step_unroll(unroll_w);
+            CGA64::add_imm(reg_tmp_output, reg_tmp_output,
+                    unroll_w * ch_offset * sizeof(float), reg_tmp_imm);
+
+            CGA64::subs(iter_ow_blk, iter_ow_blk, 1);
+            CGA64::b(xa::GT, ow_blk_label);
+        }
+
+        if (tail_w > 0) {
+            compute_bias_step_unroll(tail_w);
+            CGA64::add_imm(reg_tmp_output, reg_tmp_output,
+                    tail_w * ch_offset * sizeof(float), reg_tmp_imm);
+        }
+
+        CGA64::add(reg_oh, reg_oh, 1);
+        CGA64::cmp(reg_oh, reg_oh_worksize);
+        CGA64::b(xa::LT, oh_label);
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::compute_zero_filter() {
+
+    const int ch_offset = jcp.ch_block;
+
+    xa::LabelAArch64 kh_loop_label, skip_zeroing_label;
+
+    CGA64::ldrb(xa::WReg(reg_exec_flags.getIdx()),
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(exec_flags)));
+    CGA64::tst(xa::WReg(reg_exec_flags.getIdx()),
+            static_cast<uint64_t>(FLAG_ZERO_FILTER));
+    CGA64::b(xa::EQ, skip_zeroing_label);
+
+    zero_filter();
+
+    CGA64::mov(reg_tmp_filter, reg_filter_baddr);
+    CGA64::mov_imm(reg_kh, jcp.kh);
+    CGA64::L_aarch64(kh_loop_label);
+    {
+        store_filter();
+
+        CGA64::add_imm(reg_tmp_filter, reg_tmp_filter,
+                jcp.kw * ch_offset * sizeof(float), reg_tmp_imm);
+        CGA64::subs(reg_kh, reg_kh, 1);
+        CGA64::b(xa::GT, kh_loop_label);
+    }
+
+    /* Comeback pointers */
+    CGA64::sub_imm(reg_tmp_filter, reg_tmp_filter,
+            jcp.kh * jcp.kw * ch_offset * sizeof(float), reg_tmp_imm);
+
+    CGA64::L_aarch64(skip_zeroing_label);
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::compute_h_step(
+        int unroll_w, int l_pad, int pad_offset, int ow_block) {
+
+    const int ch_offset = jcp.ch_block;
+
+    xa::LabelAArch64 kh_loop_label, skip_loop_label;
+
+    CGA64::cmp(reg_kh_count, 0);
+    CGA64::b(xa::EQ, skip_loop_label);
+
+    CGA64::mov(reg_kh, reg_kh_count);
+    CGA64::L_aarch64(kh_loop_label);
+    {
+        load_filter();
+        compute_ow_step_unroll(unroll_w, l_pad, pad_offset, ow_block);
+        store_filter();
+
+        CGA64::add_imm(reg_tmp_filter, reg_tmp_filter,
+                jcp.kw * ch_offset * sizeof(float), reg_tmp_imm);
+        CGA64::add_imm(reg_tmp_input, reg_tmp_input,
+                jcp.iw * ch_offset * sizeof(float), reg_tmp_imm);
+        CGA64::subs(reg_kh, reg_kh, 1);
+        CGA64::b(xa::GT, kh_loop_label);
+    }
+
+    /* Comeback pointers */
+    xa::LabelAArch64 kh_comeback_label;
+    CGA64::mov(reg_kh, reg_kh_count);
+    CGA64::L_aarch64(kh_comeback_label);
+    {
+        CGA64::sub_imm(reg_tmp_input, reg_tmp_input,
+                jcp.iw * ch_offset * sizeof(float), reg_tmp_imm);
+        CGA64::sub_imm(reg_tmp_filter, reg_tmp_filter,
+                jcp.kw * ch_offset * sizeof(float), reg_tmp_imm);
+        CGA64::subs(reg_kh, reg_kh, 1);
+        CGA64::b(xa::GT, kh_comeback_label);
+    }
+
+    CGA64::L_aarch64(skip_loop_label);
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::compute_h_loop(
+        int unroll_w, int l_pad, int pad_offset, int ow_block) {
+
+    // last index of output that is not influenced by right padding
+    const size_t io_overlap
+            = jcp.oh - 1 - utils::div_up(jcp.b_pad, jcp.stride_h);
+
+    const int ch_offset = jcp.ch_block;
+    const int t_overlap_off = jcp.t_pad % jcp.stride_h == 0 ? jcp.stride_h : 1;
+    const int b_overlap_off = jcp.b_pad % jcp.stride_h == 0 ? jcp.stride_h : 1;
+
+    xa::LabelAArch64 tpad_loop_label, h_loop_label, skip_tpad_label,
+            skip_bpad_label;
+
+    CGA64::ldr(reg_oh, xa::ptr(abi_param1_aarch64, GET_OFF_DW(oh_index)));
+    CGA64::ldr(reg_oh_worksize,
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(oh_count)));
+    CGA64::ldr(reg_kh_count,
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(kh_count)));
+
+    CGA64::mov(reg_tmp_output, reg_output_baddr);
+    CGA64::mov(reg_tmp_input, reg_input_baddr);
+    CGA64::mov(reg_tmp_filter, reg_filter_baddr);
+
+    CGA64::L_aarch64(h_loop_label);
+    {
+
+        compute_h_step(unroll_w, l_pad, pad_offset, ow_block);
+
+        CGA64::add_imm(reg_tmp_output, reg_tmp_output,
+                jcp.ow * ch_offset * sizeof(float), reg_tmp_imm);
+
+        /* If within the top_pad region */
+        if (jcp.t_pad > 0) {
+            /* Skip t_pad area if no longer in initial h_block */
+            CGA64::cmp(reg_oh, jcp.t_pad);
+            CGA64::b(xa::GT, skip_tpad_label);
+
+            CGA64::cmp(reg_kh_count, jcp.kh);
+            CGA64::b(xa::GE, skip_tpad_label);
+
+            CGA64::add(reg_kh_count, reg_kh_count, t_overlap_off);
+            CGA64::sub_imm(reg_tmp_filter, reg_tmp_filter,
+                    t_overlap_off * jcp.kw * ch_offset * sizeof(float),
+                    reg_tmp_imm);
+
+            /* kernel has moved beyond padding (adjust for stride effects) */
+            if (jcp.t_pad % jcp.stride_h != 0) {
+                int inp_corr = jcp.stride_h - jcp.t_pad % jcp.stride_h;
+                CGA64::add_imm(reg_tmp_input, reg_tmp_input,
+                        inp_corr * jcp.iw * ch_offset * sizeof(float),
+                        reg_tmp_imm);
+            }
+            CGA64::b(tpad_loop_label);
+        }
+
+        CGA64::L_aarch64(skip_tpad_label);
+
+        CGA64::mov_imm(reg_tmp_imm, io_overlap);
+        CGA64::cmp(reg_oh, reg_tmp_imm);
+        CGA64::b(xa::LT, skip_bpad_label);
+        CGA64::sub(reg_kh_count, reg_kh_count, b_overlap_off);
+
+        CGA64::L_aarch64(skip_bpad_label);
+        CGA64::add_imm(reg_tmp_input, reg_tmp_input,
+                jcp.stride_h * jcp.iw * ch_offset * sizeof(float),
+                reg_tmp_imm);
+
+        CGA64::L_aarch64(tpad_loop_label);
+
+        CGA64::add(reg_oh, reg_oh, 1);
+
+        CGA64::cmp(reg_oh, reg_oh_worksize);
+        CGA64::b(xa::LT, h_loop_label);
+    }
+}
+
+inline void jit_sve_dw_conv_bwd_weights_kernel_f32::compute_ow_block_unroll() {
+
+    const int ch_offset = jcp.ch_block;
+    int ow = jcp.ow;
+    int pad_offset = 0;
+    int l_pad = jcp.l_pad;
+    int r_pad = jcp.r_pad;
+
+    const int max_unroll_w = 30;
+    const int block_size = 15;
+
+    int unroll_w_tail = 0;
+    int unroll_w = 0;
+    int unroll_w_trips = 0;
+    const bool do_unroll_w = jcp.ow > max_unroll_w;
+
+    if (do_unroll_w) {
+        unroll_w = nstl::min(block_size, jcp.ow);
+        unroll_w_trips = ow / unroll_w;
+        /* calculate tail */
+        unroll_w_tail = ow % unroll_w;
+        /* Perform some rebalancing if tail too small*/
+        if ((unroll_w_tail == 0 && r_pad != 0)
+                || (r_pad > 0 && r_pad >= unroll_w_tail)) {
+            if (unroll_w_trips > 1) {
+                unroll_w_tail += unroll_w;
+                unroll_w_trips--;
+            } else {
+                /* Idealy, this case shouldn't happen */
+                unroll_w_tail += (unroll_w - unroll_w / 2);
+                unroll_w = unroll_w / 2;
+            }
+        }
+    } else {
+        unroll_w_tail = jcp.ow;
+    }
+    if (jcp.with_bias) {
+        xa::LabelAArch64 skip_load_bias;
+        CGA64::ldr(reg_bias_baddr,
+                xa::ptr(abi_param1_aarch64, GET_OFF_DW(bias)));
+
+        zero_bias();
+
+        CGA64::ldrb(xa::WReg(reg_exec_flags.getIdx()),
+                xa::ptr(abi_param1_aarch64, GET_OFF_DW(exec_flags)));
+        CGA64::tst(xa::WReg(reg_exec_flags.getIdx()),
+                static_cast<uint64_t>(FLAG_ZERO_BIAS));
+        CGA64::b(xa::NE, skip_load_bias);
+
+        load_bias();
+
+        CGA64::L_aarch64(skip_load_bias);
+        compute_bias_loop(block_size);
+
+        store_bias();
+    }
+
+    /* Pass filter address, then offset for h_padding. */
+    compute_zero_filter();
+    CGA64::ldr(reg_kh_offset,
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(filter_pad_off)));
+    CGA64::add(reg_filter_baddr, reg_filter_baddr, reg_kh_offset);
+
+    /* compute left padded block */
+    if (l_pad && do_unroll_w) {
+        compute_h_loop(unroll_w, l_pad, 0, 0);
+        CGA64::add_imm(reg_output_baddr, reg_output_baddr,
+                unroll_w * ch_offset * sizeof(float), reg_tmp_imm);
+        CGA64::add_imm(reg_input_baddr, reg_input_baddr,
+                unroll_w * jcp.stride_w * ch_offset * sizeof(float),
+                reg_tmp_imm);
+        unroll_w_trips--;
+        pad_offset = l_pad;
+        l_pad = 0;
+    }
+
+    /* compute middle block */
+    xa::LabelAArch64 ow_blk_label;
+
+    /* Insert loop for 'ow' block when middle block needs to execute more
+     * than once */
+    bool do_ow_blk_loop = unroll_w_trips > 1;
+    if (do_ow_blk_loop) {
+        CGA64::mov_imm(iter_ow_blk, unroll_w_trips);
+        CGA64::L_aarch64(ow_blk_label);
+    }
+    if (unroll_w_trips > 0) {
+        compute_h_loop(unroll_w, l_pad, pad_offset, 0);
+        CGA64::add_imm(reg_output_baddr, reg_output_baddr,
+                unroll_w * ch_offset * sizeof(float), reg_tmp_imm);
+        CGA64::add_imm(reg_input_baddr, reg_input_baddr,
+                unroll_w * jcp.stride_w * ch_offset * sizeof(float),
+                reg_tmp_imm);
+    }
+    if (do_ow_blk_loop) {
+        CGA64::subs(iter_ow_blk, iter_ow_blk, 1);
+        CGA64::b(xa::GT, ow_blk_label);
+    }
+
+    /* compute right padded block */
+    if (unroll_w_tail) {
+        compute_h_loop(unroll_w_tail, l_pad, pad_offset,
+            jcp.ow - unroll_w_tail);
+    }
+}
+
+void jit_sve_dw_conv_bwd_weights_kernel_f32::generate() {
+    this->preamble();
+
+    CGA64::ptrue(reg_p_all_ones.b);
+
+    CGA64::ldr(reg_input_baddr,
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(input)));
+    CGA64::ldr(reg_output_baddr,
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(output)));
+    CGA64::ldr(reg_filter_baddr,
+            xa::ptr(abi_param1_aarch64, GET_OFF_DW(filter)));
+
+    compute_ow_block_unroll();
+
+    this->postamble();
+}
+
+}
+}
+}
@@ -0,0 +1,248 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_DW_CONV_KERNEL_F32_HPP
+#define JIT_SVE_DW_CONV_KERNEL_F32_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_primitive_conf.hpp"
+#include "jit_uni_eltwise.hpp"
+
+#define LDRMAX    255
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+#define CGA64 CodeGeneratorAArch64
+namespace xa = Xbyak::Xbyak_aarch64;
+/* Get vector offsets, ofs / VL(VL: SVE vector length in bytes) */
+#define VL_OFS(ofs) ((ofs) >> get_sve_length_shift())
+/* True if ofs is a multiple of VL */
+#define VL_ALIGNED(ofs) (((ofs) & (get_sve_length() - 1)) == 0)
+
+/* Depthwise convolution kernels written with native SVE instructions.
+ * One channel block (jcp.ch_block) occupies exactly one SVE vector, so the
+ * kernels follow the vector length of the machine (8 or 16 floats).
+ * The register blocking and loop structure mirror
+ * jit_uni_dw_conv_*_kernel_f32<avx512_common>. */
+struct jit_sve_dw_conv_fwd_kernel_f32 : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_dw_conv_fwd_kernel_f32)
+
+    jit_sve_dw_conv_fwd_kernel_f32(jit_conv_conf_t ajcp)
+        : jcp(ajcp), eltwise_injector_(nullptr) {
+        if (jcp.with_eltwise)
+            eltwise_injector_ = new jit_uni_eltwise_injector_f32<avx512_common>(
+                    this, jcp.eltwise);
+
+        this->generate();
+        jit_ker = (void (*)(jit_conv_call_s *))this->getCode32();
+    }
+
+    ~jit_sve_dw_conv_fwd_kernel_f32() { delete eltwise_injector_; }
+
+    jit_conv_conf_t jcp;
+    void (*jit_ker)(jit_conv_call_s *);
+
+private:
+    using reg64_t = const xa::XReg;
+
+    const xa::PReg reg_p_all_ones = p2;
+
+    reg64_t reg_input = x1;
+    reg64_t aux_reg_input = x2;
+    reg64_t aux1_reg_input = x3;
+    reg64_t reg_kernel = x4;
+    reg64_t aux_reg_kernel = x5;
+    reg64_t aux1_reg_kernel = x6;
+    reg64_t reg_output = x7;
+    reg64_t reg_bias = x8;
+    reg64_t reg_kh = x9;
+    reg64_t reg_kw = x10;
+    reg64_t iter_kh = x11;
+    reg64_t iter_kw = x12;
+    reg64_t reg_ur_w = x13;
+    reg64_t reg_ch_blocks = x14;
+
+    /* Temporary registers for ARM insts */
+    reg64_t reg_tmp_addr = x15;
+    reg64_t reg_tmp_imm = x16;
+
+    inline xa::ZReg get_ker_reg(int idx) { return xa::ZReg(idx + 0); }
+    inline xa::ZReg get_src_reg(int idx) { return xa::ZReg(idx + 1); }
+    inline xa::ZReg get_tmp_reg(int idx) { return xa::ZReg(idx + 2); }
+    inline xa::ZReg get_acc_reg(int idx) { return xa::ZReg(idx + 4); }
+
+    inline void load_vreg(const xa::ZReg &z, reg64_t &base, int ofs);
+    inline void store_vreg(const xa::ZReg &z, reg64_t &base, int ofs);
+
+    inline void load_src(int ur_ch_blocks, int ur_w);
+    inline void apply_filter(int ur_ch_blocks, int ur_w);
+    inline void apply_filter_unrolled(int ur_ch_blocks, int ur_w);
+    inline void apply_activation(int ur_ch_blocks, int ur_w);
+    inline void store_dst(int ur_ch_blocks, int ur_w);
+    inline void loop_body(int ur_ch_blocks);
+
+    jit_uni_eltwise_injector_f32<avx512_common> *eltwise_injector_;
+
+    void generate();
+};
+
+struct jit_sve_dw_conv_bwd_data_kernel_f32 : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_dw_conv_bwd_data_kernel_f32)
+
+    jit_sve_dw_conv_bwd_data_kernel_f32(jit_conv_conf_t ajcp) : jcp(ajcp) {
+        this->generate();
+        jit_ker = (void (*)(jit_conv_call_s *))this->getCode32();
+    }
+
+    jit_conv_conf_t jcp;
+    void (*jit_ker)(jit_conv_call_s *);
+
+private:
+    using reg64_t = const xa::XReg;
+
+    const xa::PReg reg_p_all_ones = p2;
+
+    inline xa::ZReg get_ker_reg(int idx) { return xa::ZReg(idx + 0); }
+    inline xa::ZReg get_src_reg(int idx) { return xa::ZReg(idx + 1); }
+    inline xa::ZReg get_acc_reg(int idx) { return xa::ZReg(idx + 4); }
+
+    reg64_t reg_ddst = x1;
+    reg64_t aux_reg_ddst = x2;
+    reg64_t aux1_reg_ddst = x3;
+    reg64_t reg_kernel = x4;
+    reg64_t aux_reg_kernel = x5;
+    reg64_t aux1_reg_kernel = x6;
+    reg64_t reg_dsrc = x7;
+
+    reg64_t reg_ur_str_w = x8;
+    reg64_t reg_ch_blocks = x9;
+
+    reg64_t iter_kh = x10;
+    reg64_t iter_kw = x11;
+    reg64_t reg_kh = x12;
+    reg64_t reg_kw = x13;
+
+    /* Temporary registers for ARM insts */
+    reg64_t reg_tmp_addr = x15;
+    reg64_t reg_tmp_imm = x16;
+
+    inline void load_vreg(const xa::ZReg &z, reg64_t &base, int ofs);
+    inline void store_vreg(const xa::ZReg &z, reg64_t &base, int ofs);
+
+    inline void loop_body(int ur_ch_blocks);
+    inline void load_ddst(int ur_ch_blocks, int ur_str_w);
+    inline void apply_filter(int ur_ch_blocks, int ur_str_w);
+    inline void store_dsrc(int ur_ch_blocks, int ur_str_w);
+
+    void generate();
+};
+
+struct jit_sve_dw_conv_bwd_weights_kernel_f32 : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_dw_conv_bwd_weights_kernel_f32)
+
+    jit_sve_dw_conv_bwd_weights_kernel_f32(jit_conv_conf_t ajcp) : jcp(ajcp) {
+        assert(jcp.kw <= max_kw);
+        this->generate();
+        jit_ker = (void (*)(jit_dw_conv_call_s *))this->getCode32();
+    }
+
+    jit_conv_conf_t jcp;
+    void (*jit_ker)(jit_dw_conv_call_s *);
+
+private:
+    using reg64_t = const xa::XReg;
+
+    const xa::PReg reg_p_all_ones = p2;
+
+    /* z0: bias, z1: output, z2-z4: filter accumulators, z5-z7: input; the
+     * accumulators and the input take one register per kw, so kw > max_kw
+     * is rejected by init_conf() */
+    enum { max_kw = 3 };
+    inline xa::ZReg get_bias_reg(int idx = 0) { return xa::ZReg(idx); }
+    inline xa::ZReg get_output_reg(int idx) { return xa::ZReg(idx + 1); }
+    inline xa::ZReg get_input_reg(int idx) {
+        return xa::ZReg(idx + 2 + max_kw);
+    }
+    inline xa::ZReg get_acc_reg(int idx) { return xa::ZReg(idx + 2); }
+
+    reg64_t reg_tmp_input = x1;
+    reg64_t reg_tmp_output = x2;
+    reg64_t reg_tmp_filter = x3;
+    reg64_t reg_kh_offset = x4;
+
+    /* parameter passed by driver into kernel */
+    reg64_t reg_exec_flags = x5;
+
+    reg64_t reg_oh_worksize = x6;
+    reg64_t reg_oh = x7;
+
+    reg64_t iter_ow_blk = x8;
+
+    reg64_t reg_kh = x9;
+    reg64_t reg_kh_count = x10;
+
+    /* Base addresses for convolution parameters. */
+    reg64_t reg_input_baddr = x11;
+    reg64_t reg_output_baddr = x12;
+    reg64_t reg_filter_baddr = x13;
+    reg64_t reg_bias_baddr = x14;
+
+    /* Temporary registers for ARM insts */
+    reg64_t reg_tmp_addr = x15;
+    reg64_t reg_tmp_imm = x16;
+
+    inline void load_vreg(const xa::ZReg &z, reg64_t &base, int ofs);
+    inline void store_vreg(const xa::ZReg &z, reg64_t &base, int ofs);
+
+    /* Micro-kernel JIT'ing, fusing 'kw' and 'ow_block' loops into unrolled FMAs
+     */
+    inline void compute_ow_step_unroll(
+            int unroll_w, int l_pad, int pad_offset, int ow_block);
+
+    /* JIT'ing the outer loops for the micro-kernel -> {kh, oh_block} */
+    inline void compute_h_step(
+            int unroll_w, int l_pad, int pad_offset, int ow_block);
+    inline void compute_h_loop(
+            int unroll_w, int l_pad, int pad_offset, int ow_block);
+
+    /* Write 'width' micro-kernel JITs; depending on the padding and convolution
+     * size, write a micro-kernel for the left ow-block, middle ow-block(s), and
+     * right ow-block.*/
+    inline void compute_ow_block_unroll();
+
+    inline void compute_zero_filter();
+    inline void load_filter();
+    inline void zero_filter();
+    inline void load_bias();
+    inline void zero_bias();
+    inline void compute_bias_step_unroll(const int unroll_w);
+    inline void compute_bias_loop(const int block_size);
+    inline void store_filter();
+    inline void store_bias();
+
+    void generate();
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,346 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_sve_fp32_wino_conv_4x3.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+using namespace winograd_sve;
+
+namespace {
+constexpr int max_simd_w = cpu_isa_traits<sve>::max_vlen / sizeof(float);
+
+/* One-dimensional transforms of F(4, 3), applied lane-wise to vectors of
+ * simd_w floats. The vectors of in and out are in_s and out_s floats
+ * apart. The coefficients match the weights transform of wino_reorder_t. */
+inline void trans_I_4x3(float *out, int out_s, const float *in, int in_s,
+        int simd_w) {
+    PRAGMA_OMP_SIMD()
+    for (int v = 0; v < simd_w; v++) {
+        const float I0 = in[0 * in_s + v], I1 = in[1 * in_s + v],
+                    I2 = in[2 * in_s + v], I3 = in[3 * in_s + v],
+                    I4 = in[4 * in_s + v], I5 = in[5 * in_s + v];
+
+        const float t0 = I2 * -2.25f + I4;
+        const float t1 = I1 * -2.25f + I3;
+        const float t2 = I2 * -0.390625f + I4;
+        const float t3 = I1 * -0.390625f + I3;
+        const float t4 = I0 * 0.87890625f + I4;
+        const float t5 = I1 * 0.87890625f + I5;
+
+        out[0 * out_s + v] = I2 * -2.640625f + t4;
+        out[1 * out_s + v] = t1 * 0.625f + t0;
+        out[2 * out_s + v] = t1 * -0.625f + t0;
+        out[3 * out_s + v] = t3 * 1.5f + t2;
+        out[4 * out_s + v] = t3 * -1.5f + t2;
+        out[5 * out_s + v] = I3 * -2.640625f + t5;
+    }
+}
+
+inline void trans_O_4x3(float *out, int out_s, const float *in, int in_s,
+        int simd_w) {
+    PRAGMA_OMP_SIMD()
+    for (int v = 0; v < simd_w; v++) {
+        const float M0 = in[0 * in_s + v], M1 = in[1 * in_s + v],
+                    M2 = in[2 * in_s + v], M3 = in[3 * in_s + v],
+                    M4 = in[4 * in_s + v], M5 = in[5 * in_s + v];
+
+        const float t0 = M1 + M2;
+        const float t1 = M3 + M4;
+        const float t2 = M1 - M2;
+        const float t3 = M3 - M4;
+
+        out[0 * out_s + v] = t0 + t1 + M0;
+        out[1 * out_s + v] = t2 * 0.625f + t3 * 1.5f;
+        out[2 * out_s + v] = t0 * 0.390625f + t1 * 2.25f;
+        out[3 * out_s + v] = t2 * 0.244140625f + t3 * 3.375f + M5;
+    }
+}
+
+inline void trans_W_4x3(float *out, int out_s, const float *in, int in_s,
+        int simd_w) {
+    PRAGMA_OMP_SIMD()
+    for (int v = 0; v < simd_w; v++) {
+        const float F0 = in[0 * in_s + v], F1 = in[1 * in_s + v],
+                    F2 = in[2 * in_s + v];
+
+        const float t0 = 0.26890756302521f * F2;
+        const float t1 = -t0 - 0.688403361344538f * F0;
+        const float t2 = t0 + 0.119514472455649f * F0;
+
+        out[0 * out_s + v] = 1.13777777777778f * F0;
+        out[1 * out_s + v] = t1 - 0.430252100840336f * F1;
+        out[2 * out_s + v] = t1 + 0.430252100840336f * F1;
+        out[3 * out_s + v] = t2 + 0.179271708683473f * F1;
+        out[4 * out_s + v] = t2 - 0.179271708683473f * F1;
+        out[5 * out_s + v] = F2;
+    }
+}
+}
+
+/* Training only: OIhw{8,16}i{8,16}o weights -> U in the layout of the
+ * gemm kernel (see jit_sve_fp32_wino_conv_4x3_kernel.hpp) */
+void jit_sve_fp32_wino_conv_4x3_fwd_t::weight_transform(
+        const float *wei, float *U) const {
+    const auto &jcp = kernel_->jcp;
+    const int simd_w = jcp.oc_simd_block;
+    const int ocrb = jcp.oc_reg_block;
+    const int nb_ic = jcp.ic / simd_w;
+    const int nb_oc = jcp.oc / simd_w;
+    const size_t ab_stride = (size_t)jcp.ic * ocrb * simd_w;
+
+    parallel_nd(nb_oc, jcp.ic, [&](int ob, int c) {
+        float F[3][3][max_simd_w];
+        float T[3][alpha][max_simd_w];
+        float W[alpha][alpha][max_simd_w];
+
+        const int ib = c / simd_w, i = c % simd_w;
+        const float *wei_c = wei
+                + (size_t)(ob * nb_ic + ib) * jcp.kh * jcp.kw * simd_w
+                        * simd_w
+                + i * simd_w;
+        for (int h = 0; h < jcp.kh; h++)
+        for (int k = 0; k < jcp.kw; k++) {
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                F[h][k][v] = wei_c[(h * jcp.kw + k) * simd_w * simd_w + v];
+        }
+
+        for (int h = 0; h < 3; h++)
+            trans_W_4x3(&T[h][0][0], max_simd_w, &F[h][0][0], max_simd_w,
+                    simd_w);
+        for (int b = 0; b < alpha; b++)
+            trans_W_4x3(&W[0][b][0], alpha * max_simd_w, &T[0][b][0],
+                    alpha * max_simd_w, simd_w);
+
+        const int occ = ob / ocrb, obr = ob % ocrb;
+        float *U_c = U
+                + ((size_t)occ * alpha * alpha * jcp.ic + c) * ocrb * simd_w
+                + obr * simd_w;
+        for (int a = 0; a < alpha; a++)
+        for (int b = 0; b < alpha; b++) {
+            float *U_ab = U_c + (a * alpha + b) * ab_stride;
+            PRAGMA_OMP_SIMD()
+            for (int v = 0; v < simd_w; v++)
+                U_ab[v] = W[a][b][v];
+        }
+    });
+}
+
+void jit_sve_fp32_wino_conv_4x3_fwd_t::input_transform(
+        int tile_block, const float *src, float *V) const {
+    const auto &jcp = kernel_->jcp;
+    const int simd_w = jcp.ic_simd_block;
+    const int tur = jcp.tile_block_ur;
+    const int nb = jcp.nb_tile_block_ur;
+    const int nb_ic = jcp.ic / simd_w;
+    const size_t ab_stride = (size_t)nb * jcp.ic * tur;
+
+    float I[alpha][alpha][max_simd_w];
+    float T[alpha][alpha][max_simd_w];
+    float W[alpha][alpha][max_simd_w];
+
+    for (int gi = 0; gi < nb; gi++)
+    for (int t = 0; t < tur; t++) {
+        const int tile = (tile_block * nb + gi) * tur + t;
+        float *V_t = V + (size_t)gi * jcp.ic * tur + t;
+
+        if (tile >= jcp.ntiles) {
+            /* keep the tail of the last block finite */
+            for (int ab = 0; ab < alpha * alpha; ab++)
+            for (int c = 0; c < jcp.ic; c++)
+                V_t[ab * ab_stride + c * tur] = 0.f;
+            continue;
+        }
+
+        const int img = tile / (jcp.jtiles * jcp.itiles);
+        const int tj = (tile / jcp.itiles) % jcp.jtiles;
+        const int ti = tile % jcp.itiles;
+        const int y0 = tj * tile_size - jcp.t_pad;
+        const int x0 = ti * tile_size - jcp.l_pad;
+
+        for (int cb = 0; cb < nb_ic; cb++) {
+            const float *src_b = src
+                    + (size_t)(img * nb_ic + cb) * jcp.ih * jcp.iw * simd_w;
+            for (int j = 0; j < alpha; j++)
+            for (int i = 0; i < alpha; i++) {
+                const int y = y0 + j, x = x0 + i;
+                const bool inside = y >= 0 && y < jcp.ih && x >= 0
+                        && x < jcp.iw;
+                const float *s = src_b + ((size_t)y * jcp.iw + x) * simd_w;
+                PRAGMA_OMP_SIMD()
+                for (int v = 0; v < simd_w; v++)
+                    I[j][i][v] = inside ? s[v] : 0.f;
+            }
+
+            for (int j = 0; j < alpha; j++)
+                trans_I_4x3(&T[j][0][0], max_simd_w, &I[j][0][0],
+                        max_simd_w, simd_w);
+            for (int b = 0; b < alpha; b++)
+                trans_I_4x3(&W[0][b][0], alpha * max_simd_w, &T[0][b][0],
+                        alpha * max_simd_w, simd_w);
+
+            for (int a = 0; a < alpha; a++)
+            for (int b = 0; b < alpha; b++) {
+                float *V_ab = V_t + (a * alpha + b) * ab_stride
+                        + cb * simd_w * tur;
+                for (int v = 0; v < simd_w; v++)
+                    V_ab[v * tur] = W[a][b][v];
+            }
+        }
+    }
+}
+
+void jit_sve_fp32_wino_conv_4x3_fwd_t::output_transform(int tile_block,
+        const float *M, float *dst, const float *bias) const {
+    const auto &jcp = kernel_->jcp;
+    const int simd_w = jcp.oc_simd_block;
+    const int tur = jcp.tile_block_ur;
+    const int nb = jcp.nb_tile_block_ur;
+    const int nb_oc = jcp.oc / simd_w;
+    const size_t ab_stride = (size_t)nb * tur * jcp.oc;
+
+    float W[alpha][alpha][max_simd_w];
+    float T[alpha][alpha][max_simd_w];
+    float O[tile_size][tile_size][max_simd_w];
+    float B[max_simd_w];
+
+    for (int gi = 0; gi < nb; gi++)
+    for (int t = 0; t < tur; t++) {
+        const int tile = (tile_block * nb + gi) * tur + t;
+        if (tile >= jcp.ntiles)
+            return;
+
+        const int img = tile / (jcp.jtiles * jcp.itiles);
+        const int tj = (tile / jcp.itiles) % jcp.jtiles;
+        const int ti = tile % jcp.itiles;
+
+        for (int ob = 0; ob < nb_oc; ob++) {
+            const float *M_t = M + (size_t)(gi * tur + t) * jcp.oc
+                    + ob * simd_w;
+            for (int a = 0; a < alpha; a++)
+            for (int b = 0; b < alpha; b++) {
+                const float *M_ab = M_t + (a * alpha + b) * ab_stride;
+                PRAGMA_OMP_SIMD()
+                for (int v = 0; v < simd_w; v++)
+                    W[a][b][v] = M_ab[v];
+            }
+
+            for (int a = 0; a < alpha; a++)
+                trans_O_4x3(&T[a][0][0], max_simd_w, &W[a][0][0],
+                        max_simd_w, simd_w);
+            for (int i = 0; i < tile_size; i++)
+                trans_O_4x3(&O[0][i][0], tile_size * max_simd_w, &T[0][i][0],
+                        alpha * max_simd_w, simd_w);
+
+            for (int v = 0; v < simd_w; v++) {
+                const int c = ob * simd_w + v;
+                B[v] = jcp.with_bias && c < jcp.oc_without_padding
+                        ? bias[c] : 0.f;
+            }
+
+            float *dst_b = dst
+                    + (size_t)(img * nb_oc + ob) * jcp.oh * jcp.ow * simd_w;
+            for (int j = 0; j < tile_size; j++) {
+                const int y = tj * tile_size + j;
+                if (y >= jcp.oh) break;
+                for (int i = 0; i < tile_size; i++) {
+                    const int x = ti * tile_size + i;
+                    if (x >= jcp.ow) break;
+                    float *d = dst_b + ((size_t)y * jcp.ow + x) * simd_w;
+                    PRAGMA_OMP_SIMD()
+                    for (int v = 0; v < simd_w; v++) {
+                        float o = O[j][i][v] + B[v];
+                        if (jcp.with_eltwise)
+                            o = o > 0.f ? o : 0.f;
+                        if (jcp.with_sum)
+                            o += d[v];
+                        if (jcp.with_relu_postsum)
+                            o = o > 0.f ? o : 0.f;
+                        d[v] = o;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void jit_sve_fp32_wino_conv_4x3_fwd_t::execute_forward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto bias = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto dst = reinterpret_cast<data_t *>(this->memory());
+
+    const auto &jcp = kernel_->jcp;
+    auto scratchpad = this->scratchpad();
+
+    const float *U = weights;
+    if (jcp.prop_kind != prop_kind::forward_inference) {
+        float *wino_U = scratchpad.template get<float>(key_wino_U);
+        weight_transform(weights, wino_U);
+        U = wino_U;
+    }
+
+    float *V_base = scratchpad.template get<float>(key_wino_V);
+    float *M_base = scratchpad.template get<float>(key_wino_M);
+
+    const int tur = jcp.tile_block_ur;
+    const int nb = jcp.nb_tile_block_ur;
+    const int oc_chunk = jcp.oc_reg_block * jcp.oc_simd_block;
+    const size_t tiles_per_thr = (size_t)nb * tur;
+    const size_t V_thr = alpha * alpha * tiles_per_thr * jcp.ic;
+    const size_t M_thr = alpha * alpha * tiles_per_thr * jcp.oc;
+    const size_t U_ab = (size_t)jcp.ic * oc_chunk;
+    const size_t U_occ = alpha * alpha * U_ab;
+
+    parallel(jcp.nthr, [&](const int ithr, const int nthr) {
+        int start{0}, end{0};
+        balance211(jcp.tile_block, nthr, ithr, start, end);
+
+        float *V = V_base + ithr * V_thr;
+        float *M = M_base + ithr * M_thr;
+
+        for (int tb = start; tb < end; tb++) {
+            input_transform(tb, src, V);
+
+            /* U of one (a, a) point and oc chunk is reused across the
+             * groups of tiles */
+            for (int ab = 0; ab < alpha * alpha; ab++)
+            for (int occ = 0; occ < jcp.nb_oc; occ++)
+            for (int gi = 0; gi < nb; gi++) {
+                const size_t grp = (size_t)ab * nb + gi;
+                kernel_->ker_(M + grp * tur * jcp.oc + occ * oc_chunk,
+                        U + occ * U_occ + ab * U_ab,
+                        V + grp * jcp.ic * tur);
+            }
+
+            output_transform(tb, M, dst, bias);
+        }
+    });
+}
+
+}
+}
+}
@@ -0,0 +1,156 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_SVE_FP32_WINO_CONV_4x3_HPP
+#define CPU_JIT_SVE_FP32_WINO_CONV_4x3_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "cpu_convolution_pd.hpp"
+#include "cpu_engine.hpp"
+
+#include "jit_kernel_cache.hpp"
+#include "jit_sve_fp32_wino_conv_4x3_kernel.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace winograd_sve {
+inline void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+        const jit_conv_winograd_conf_t &jcp) {
+    using namespace memory_tracking::names;
+
+    const size_t tiles_per_thr
+            = (size_t)jcp.nb_tile_block_ur * jcp.tile_block_ur;
+    size_t V_sz = (size_t)jcp.nthr * alpha * alpha * tiles_per_thr * jcp.ic;
+    size_t M_sz = (size_t)jcp.nthr * alpha * alpha * tiles_per_thr * jcp.oc;
+
+    scratchpad.book(key_wino_V, sizeof(float) * V_sz, PAGE_2M);
+    scratchpad.book(key_wino_M, sizeof(float) * M_sz, PAGE_2M);
+
+    /* Inference weights come pre-transformed by wino_reorder_t */
+    if (jcp.prop_kind != prop_kind::forward_inference) {
+        size_t U_sz = (size_t)alpha * alpha * jcp.ic * jcp.oc;
+        scratchpad.book(key_wino_U, sizeof(float) * U_sz, PAGE_2M);
+    }
+}
+}
+
+/* Winograd F(4x4, 3x3) forward convolution for SVE.
+ *
+ * The input and output transforms run per thread on blocks of tiles that
+ * fit in L2, the batched gemm in between is done by
+ * jit_sve_fp32_wino_conv_4x3_fwd_kernel. */
+struct jit_sve_fp32_wino_conv_4x3_fwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_convolution_fwd_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const typename pd_t::base_class *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_wino_4x3:", sve, ""),
+                jit_sve_fp32_wino_conv_4x3_fwd_t);
+
+        virtual status_t init() override
+        {
+            using namespace prop_kind;
+            assert(this->engine()->kind() == engine_kind::cpu);
+            bool ok = true && this->set_default_params() == status::success
+                    && utils::one_of(this->desc()->prop_kind, forward_training,
+                               forward_inference)
+                    && utils::one_of(this->desc()->alg_kind,
+                               alg_kind::convolution_auto,
+                               alg_kind::convolution_winograd)
+                    && utils::everyone_is(data_type::f32,
+                               this->desc()->src_desc.data_type,
+                               this->desc()->weights_desc.data_type,
+                               this->desc()->dst_desc.data_type)
+                    && IMPLICATION(this->with_bias(), data_type::f32
+                                       == this->desc()->bias_desc.data_type);
+            if (!ok)
+                return status::unimplemented;
+
+            status_t status =
+                jit_sve_fp32_wino_conv_4x3_fwd_kernel::init_conf(jcp_,
+                        *this->desc(), this->src_pd_, this->weights_pd_,
+                        this->dst_pd_, *this->attr());
+            if (status != status::success) return status;
+
+            auto scratchpad = this->scratchpad_registry().registrar();
+            winograd_sve::init_scratchpad(scratchpad, jcp_);
+            if (this->desc()->alg_kind == alg_kind::convolution_auto)
+                CHECK(this->set_alg_kind(alg_kind::convolution_winograd));
+
+            return status::success;
+        }
+
+        jit_conv_winograd_conf_t jcp_;
+
+    protected:
+        virtual status_t set_default_params() override
+        {
+            using namespace memory_format;
+            const bool blk8 = get_sve_length() == 32; // 256-bit vectors
+            const auto act_fmt = blk8 ? nChw8c : nChw16c;
+            if (this->src_pd_.desc()->format == any)
+                CHECK(this->src_pd_.set_format(act_fmt));
+            if (this->dst_pd_.desc()->format == any)
+                CHECK(this->dst_pd_.set_format(act_fmt));
+            if (this->weights_pd_.desc()->format == any
+                    && (this->desc()->prop_kind != mkldnn_forward_inference))
+                CHECK(this->weights_pd_.set_format(
+                        blk8 ? OIhw8i8o : OIhw16i16o));
+            if (this->bias_pd_.desc()->format == any)
+                CHECK(this->bias_pd_.set_format(x));
+            return status::success;
+        }
+    };
+
+    jit_sve_fp32_wino_conv_4x3_fwd_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs, true) {
+        kernel_ = get_jit_kernel<jit_sve_fp32_wino_conv_4x3_fwd_kernel>(
+                pd()->jcp_, pd()->attr());
+    }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const
+    {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    void weight_transform(const float *wei, float *U) const;
+    void input_transform(int tile_block, const float *src, float *V) const;
+    void output_transform(int tile_block, const float *M, float *dst,
+            const float *bias) const;
+
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    std::shared_ptr<jit_sve_fp32_wino_conv_4x3_fwd_kernel> kernel_;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,272 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_sve_fp32_wino_conv_4x3_kernel.hpp"
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_format;
+using namespace mkldnn::impl::utils;
+using namespace winograd_sve;
+
+void jit_sve_fp32_wino_conv_4x3_fwd_kernel::generate() {
+    const int ocrb = jcp.oc_reg_block;
+    const int tur = jcp.tile_block_ur;
+    LabelAArch64 k_loop;
+
+    preamble();
+
+    ptrue(reg_p_all.s);
+
+    for (int t = 0; t < tur; t++)
+        for (int ob = 0; ob < ocrb; ob++)
+            eor(ZRegD(acc_idx(t, ob)), ZRegD(acc_idx(t, ob)),
+                    ZRegD(acc_idx(t, ob)));
+
+    mov_imm(reg_k, jcp.ic);
+    L_aarch64(k_loop);
+    {
+        for (int ob = 0; ob < ocrb; ob++)
+            ldr(ZReg(u_idx(ob)), ptr(reg_U, ob, MUL_VL));
+        for (int t = 0; t < tur; t++) {
+            ld1rw(ZRegS(v_idx(t)), reg_p_all,
+                    ptr(reg_V, static_cast<int32_t>(t * sizeof(float))));
+            for (int ob = 0; ob < ocrb; ob++)
+                fmla(ZRegS(acc_idx(t, ob)), reg_p_all, ZRegS(u_idx(ob)),
+                        ZRegS(v_idx(t)));
+        }
+        addvl(reg_U, reg_U, ocrb);
+        add_imm(reg_V, reg_V, tur * 4, reg_tmp);
+        subs(reg_k, reg_k, 1);
+        b(NE, k_loop);
+    }
+
+    mov_imm(reg_ldm, jcp.oc * sizeof(float));
+    for (int t = 0; t < tur; t++) {
+        for (int ob = 0; ob < ocrb; ob++)
+            str(ZReg(acc_idx(t, ob)), ptr(reg_M, ob, MUL_VL));
+        if (t < tur - 1)
+            add(reg_M, reg_M, reg_ldm);
+    }
+
+    postamble();
+}
+
+bool jit_sve_fp32_wino_conv_4x3_fwd_kernel::post_ops_ok(
+        jit_conv_conf_t &jcp, const primitive_attr_t &attr) {
+    const auto &p = attr.post_ops_;
+
+    auto is_relu = [&](int idx) { return p.entry_[idx].is_relu(); };
+    auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(); };
+
+    switch (p.len_) {
+    case 0: return true; // no post_ops
+    case 1: return is_relu(0) || is_sum(0); // relu or sum
+    case 2: return (is_sum(0) && is_relu(1))
+                      || (is_relu(0) && is_sum(1)); // sum->relu or relu->sum
+    case 3: return is_relu(0) && is_sum(1) && is_relu(2); // relu->sum->relu
+    default: return false;
+    }
+
+    return false;
+}
+
+namespace {
+bool is_winograd_faster_than_direct(const jit_conv_winograd_conf_t &jcp) {
+    /* The input and output transforms are memory bound, so the Winograd
+     * path only pays off once the gemm part is large enough. The
+     * conditions are empirical. */
+    if (jcp.prop_kind == prop_kind::forward_inference)
+        return jcp.mb >= 4;
+    return jcp.mb >= 4 && jcp.ic >= 64 && jcp.oc >= 64;
+}
+}
+
+status_t jit_sve_fp32_wino_conv_4x3_fwd_kernel::init_conf(
+        jit_conv_winograd_conf_t &jcp, const convolution_desc_t &cd,
+        const cpu_memory_t::pd_t &src_pd, cpu_memory_t::pd_t &weights_pd,
+        const cpu_memory_t::pd_t &dst_pd, const primitive_attr_t &attr) {
+    const memory_desc_wrapper src_d(src_pd.desc());
+    const memory_desc_wrapper weights_d(weights_pd.desc());
+    const memory_desc_wrapper dst_d(dst_pd.desc());
+
+    if (!mayiuse(sve))
+        return status::unimplemented;
+
+    if (!sve_length_supported())
+        return status::unimplemented;
+    const int simd_w = get_sve_length() / sizeof(float);
+
+    jcp.nthr = mkldnn_get_max_threads();
+    jcp.ver = ver_sve;
+    jcp.prop_kind = cd.prop_kind;
+
+    const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
+
+    jcp.ngroups = with_groups ? weights_d.dims()[0] : 1;
+    jcp.mb = src_d.dims()[0];
+    jcp.oc = dst_d.dims()[1] / jcp.ngroups;
+    jcp.oc_without_padding = jcp.oc;
+    jcp.ic = src_d.dims()[1] / jcp.ngroups;
+    jcp.ih = src_d.dims()[2];
+    jcp.iw = src_d.dims()[3];
+    jcp.oh = dst_d.dims()[2];
+    jcp.ow = dst_d.dims()[3];
+    jcp.kh = weights_d.dims()[with_groups + 2];
+    jcp.kw = weights_d.dims()[with_groups + 3];
+    jcp.t_pad = cd.padding[0][0];
+    jcp.l_pad = cd.padding[0][1];
+    jcp.stride_h = cd.strides[0];
+    jcp.stride_w = cd.strides[1];
+    jcp.dilate_h = cd.dilates[0];
+    jcp.dilate_w = cd.dilates[1];
+
+    bool ok_to_pad_channels = jcp.ngroups == 1;
+    if (ok_to_pad_channels) {
+        jcp.oc = rnd_up(jcp.oc, simd_w);
+        jcp.ic = rnd_up(jcp.ic, simd_w);
+    }
+
+    jcp.itiles = div_up(jcp.ow, tile_size);
+    jcp.jtiles = div_up(jcp.oh, tile_size);
+    jcp.ntiles = jcp.mb * jcp.itiles * jcp.jtiles;
+
+    // Checking conditions not supported by this implementation
+    if (!IMPLICATION(cd.alg_kind == alg_kind::convolution_auto,
+               is_winograd_faster_than_direct(jcp)))
+        return status::unimplemented;
+
+    if (jcp.ngroups != 1)
+        return status::unimplemented;
+    if ((jcp.kh != 3) || (jcp.kw != 3))
+        return status::unimplemented;
+    if ((jcp.dilate_h != 0) || (jcp.dilate_w != 0))
+        return status::unimplemented;
+    if ((jcp.stride_h != 1) || (jcp.stride_w != 1))
+        return status::unimplemented;
+    if ((jcp.ic % simd_w) != 0 || (jcp.oc % simd_w) != 0)
+        return status::unimplemented;
+
+    const auto act_fmt = simd_w == 16 ? nChw16c : nChw8c;
+    const auto wei_fmt = simd_w == 16 ? OIhw16i16o : OIhw8i8o;
+    if (src_d.format() != act_fmt || dst_d.format() != act_fmt)
+        return status::unimplemented;
+    if (!one_of(weights_d.format(), any, wei_fmt, wino_fmt))
+        return status::unimplemented;
+    /* The plain blocked weights are transformed inside the primitive only
+     * for training, inference expects them pre-transformed by a reorder. */
+    const bool is_inference = cd.prop_kind == prop_kind::forward_inference;
+    if (weights_d.format() == (is_inference ? wei_fmt : wino_fmt))
+        return status::unimplemented;
+
+    bool layout_consistency = true
+            && jcp.ic <= src_d.blocking_desc().padding_dims[1]
+            && jcp.oc <= dst_d.blocking_desc().padding_dims[1]
+            && (weights_d.format() == any || weights_d.format() == wino_fmt
+                    || (jcp.ic <= weights_d.blocking_desc().padding_dims[1]
+                            && jcp.oc <= weights_d.blocking_desc()
+                                            .padding_dims[0]));
+    if (!layout_consistency)
+        return status::unimplemented;
+
+    jcp.with_bias = cd.bias_desc.format != memory_format::undef;
+
+    if (!post_ops_ok(jcp, attr))
+        return status::unimplemented;
+
+    const auto &p = attr.post_ops_;
+    const int eltwise_ind = p.find(primitive_kind::eltwise, 0, 1);
+    jcp.with_eltwise = eltwise_ind != -1;
+    if (jcp.with_eltwise)
+        jcp.eltwise = p.entry_[eltwise_ind].eltwise;
+    jcp.with_sum = p.find(primitive_kind::sum, 0) != -1;
+    jcp.with_relu_postsum = p.find(primitive_kind::eltwise, 1) != -1;
+
+    /* Register blocking of the gemm kernel: oc_reg_block vectors of U are
+     * kept in registers against tile_block_ur broadcasts of V. Two
+     * registers are reserved for the broadcasts. */
+    jcp.ic_simd_block = simd_w;
+    jcp.oc_simd_block = simd_w;
+    const int nb_oc_simd = jcp.oc / simd_w;
+    jcp.oc_reg_block = 1;
+    for (int ocrb = 4; ocrb > 1; ocrb--)
+        if (nb_oc_simd % ocrb == 0) {
+            jcp.oc_reg_block = ocrb;
+            break;
+        }
+    jcp.ic_reg_block = 1;
+    jcp.nb_oc = nb_oc_simd / jcp.oc_reg_block;
+    jcp.nb_reg = 32 - 2 - jcp.oc_reg_block;
+    jcp.tile_block_ur = nstl::min(8, jcp.nb_reg / jcp.oc_reg_block);
+
+    /* A work item of a thread is nb_tile_block_ur groups of tile_block_ur
+     * tiles; its transformed input and output should stay in L2. */
+    const size_t L2_per_thr
+            = get_A64FX_cache_size(2, false, jcp.nthr) / jcp.nthr;
+    const size_t group_sz = sizeof(float) * alpha * alpha
+            * jcp.tile_block_ur * (jcp.ic + jcp.oc);
+    const int nb_groups = div_up(jcp.ntiles, jcp.tile_block_ur);
+    jcp.nb_tile_block_ur = nstl::max(1,
+            nstl::min(nb_groups, (int)(L2_per_thr / 2 / group_sz)));
+    while (jcp.nb_tile_block_ur > 1
+            && div_up(nb_groups, jcp.nb_tile_block_ur) < jcp.nthr)
+        jcp.nb_tile_block_ur--;
+    jcp.tile_block = div_up(nb_groups, jcp.nb_tile_block_ur);
+
+    /* re-create weights primitive descriptor
+    and set weights wino_blocking */
+    if (is_inference) {
+        memory_desc_t expect_wei_md = *weights_pd.desc();
+
+        expect_wei_md.format = mkldnn_wino_fmt;
+        expect_wei_md.data_type = data_type::f32;
+        mkldnn_wino_desc_t &wd = expect_wei_md.layout_desc.wino_desc;
+        wd.wino_format = mkldnn_wino_wei_OBaaIBOIio;
+        wd.r = 3;
+        wd.alpha = alpha;
+
+        wd.ic = jcp.ic;
+        wd.oc = jcp.oc;
+        wd.ic_block = 1;
+        wd.oc_block = simd_w;
+        wd.ic2_block = 1;
+        wd.oc2_block = jcp.oc_reg_block;
+        wd.size = sizeof(float) * wd.alpha * wd.alpha * jcp.ic * jcp.oc;
+        wd.adj_scale = 1.f;
+
+        cpu_memory_t::pd_t new_weights_pd(
+            weights_pd.engine(), &expect_wei_md);
+        if (weights_pd.desc()->format == memory_format::any)
+            weights_pd = new_weights_pd;
+        if (!weights_pd.is_equal(&new_weights_pd))
+            return status::unimplemented;
+    }
+
+    return status::success;
+}
+
+}
+}
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_FP32_WINO_CONV_4x3_KERNEL_HPP
+#define JIT_SVE_FP32_WINO_CONV_4x3_KERNEL_HPP
+
+#include "c_types_map.hpp"
+#include "cpu_memory.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_generator_aarch64.hpp"
+#include "jit_primitive_conf.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace winograd_sve {
+/* F(4x4, 3x3): 6x6 input tiles produce 4x4 output tiles */
+constexpr int alpha = 6;
+constexpr int tile_size = 4;
+}
+
+/* Batched gemm of the Winograd domain for one of the alpha * alpha points.
+ *
+ * U (weights) is stored as [occ][ic][oc_reg_block][simd_w], i.e. the
+ * mkldnn_wino_wei_OBaaIBOIio layout with ic_block == ic2_block == 1 and
+ * oc2_block == oc_reg_block, restricted to a single (a, a) point.
+ * V (input) is stored as [ic][tile_block_ur].
+ * M (output) is stored as [tile_block_ur][oc] and is overwritten.
+ *
+ * One call computes tile_block_ur tiles for one oc_reg_block * simd_w chunk
+ * of output channels; simd_w follows the vector length of the machine. */
+struct jit_sve_fp32_wino_conv_4x3_fwd_kernel : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_fp32_wino_conv_4x3_fwd_kernel)
+
+    jit_sve_fp32_wino_conv_4x3_fwd_kernel(
+            const jit_conv_winograd_conf_t &ajcp)
+        : jit_generator_aarch64(nullptr, 64 * 1024), jcp(ajcp) {
+        const code_key_t key = code_key();
+        if (!load_cached_code(&key, sizeof(key)))
+            generate();
+        ready();
+        ker_ = getCode<void (*)(float *, const float *, const float *)>();
+    }
+
+    static bool post_ops_ok(jit_conv_conf_t &jcp,
+            const primitive_attr_t &attr);
+
+    static status_t init_conf(jit_conv_winograd_conf_t &jcp,
+            const convolution_desc_t &cd, const cpu_memory_t::pd_t &src_pd,
+            cpu_memory_t::pd_t &weights_pd, const cpu_memory_t::pd_t &dst_pd,
+            const primitive_attr_t &attr);
+
+    jit_conv_winograd_conf_t jcp;
+    void (*ker_)(float *M, const float *U, const float *V);
+
+private:
+    using xreg_t = const Xbyak::Xbyak_aarch64::XReg;
+    using preg_t = const Xbyak::Xbyak_aarch64::PReg;
+
+    xreg_t reg_M = x0;
+    xreg_t reg_U = x1;
+    xreg_t reg_V = x2;
+    xreg_t reg_k = x3;
+    xreg_t reg_ldm = x4;
+    xreg_t reg_tmp = x5;
+
+    preg_t reg_p_all = p0;
+
+    /* z0 - z(n_acc - 1) : accumulators, then oc_reg_block vectors of U,
+     * z30 - z31 : broadcasts of V */
+    int acc_idx(int t, int ob) const { return t * jcp.oc_reg_block + ob; }
+    int u_idx(int ob) const { return 30 - jcp.oc_reg_block + ob; }
+    int v_idx(int t) const { return 30 + t % 2; }
+
+    /* the inputs of generate(), the key of the persistent code cache */
+    struct code_key_t {
+        int ic, oc, oc_reg_block, tile_block_ur;
+    };
+
+    code_key_t code_key() const {
+        code_key_t key = code_key_t();
+        key.ic = jcp.ic;
+        key.oc = jcp.oc;
+        key.oc_reg_block = jcp.oc_reg_block;
+        key.tile_block_ur = jcp.tile_block_ur;
+        return key;
+    }
+
+    void generate();
+};
+
+}
+}
+}
+
+#endif
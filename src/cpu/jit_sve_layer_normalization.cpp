@@ -0,0 +1,614 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_generator_aarch64.hpp"
+
+#include "jit_sve_layer_normalization.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>(offsetof(call_params_t, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+typedef float data_t;
+
+using namespace Xbyak::Xbyak_aarch64;
+
+/* One call normalizes, or back propagates through, rows consecutive rows of
+ * C elements. Forward computes the statistics of a row in a single pass over
+ * it: the sums of x - K and (x - K)^2 are accumulated with K = x[0], which
+ * keeps var = E[(x - K)^2] - E[x - K]^2 accurate when the mean is large
+ * compared to the deviation. A second pass writes dst. With the global
+ * statistics only the second pass remains. Backward makes one pass for the
+ * two reductions of the full derivative (and the gradients of gamma and
+ * beta) and one for diff_src. */
+struct jit_sve_lnorm_kernel_t: public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_lnorm_kernel_t)
+
+    typedef jit_lnorm_call_s call_params_t;
+
+    using xreg_t = const XReg;
+    using preg_t = const PReg;
+    using zreg_t = const ZRegS;
+
+    void (*ker)(const call_params_t *);
+    void operator()(const call_params_t *p) const { (*ker)(p); }
+
+    jit_lnorm_conf_t jln_;
+
+    xreg_t reg_param = x0;
+
+    xreg_t reg_src = x1;
+    xreg_t reg_diff_dst = x2;
+    xreg_t reg_dst = x3; // diff_src for backward
+    xreg_t reg_mean = x4;
+    xreg_t reg_var = x5;
+    xreg_t reg_gamma = x6;
+    xreg_t reg_diff_gamma = x7;
+    xreg_t reg_rows = x8;
+
+    /* addresses of the current vectors of the row */
+    xreg_t reg_src_a = x9;
+    xreg_t reg_diff_dst_a = x10;
+    xreg_t reg_dst_a = x11;
+    xreg_t reg_gamma_a = x12;
+    xreg_t reg_diff_gamma_a = x13;
+    xreg_t reg_ctr = x14;
+    xreg_t reg_tmp = x15;
+    xreg_t reg_beta_a = x19;
+    xreg_t reg_diff_beta_a = x20;
+
+    preg_t reg_p_all = p0;
+    preg_t reg_p_tail = p1;
+    preg_t reg_p_first = p2;
+
+    /* z0 - z3 : src or x_hat, z4 - z7 : diff_dst,
+     * z8 - z11 and z12 - z15 : accumulators of the two reductions,
+     * z16 - z23 : gamma and beta or their gradients */
+    int data_idx(int i) const { return i; }
+    int diff_idx(int i) const { return 4 + i; }
+    int acc1_idx(int i) const { return 8 + i; }
+    int acc2_idx(int i) const { return 12 + i; }
+    int gamma_idx(int i) const { return 16 + i; }
+    int beta_idx(int i) const { return 20 + i; }
+
+    zreg_t z_mean = zreg_t(24);
+    zreg_t z_inv = zreg_t(25); // 1 / sqrt(var + eps)
+    zreg_t z_1_c = zreg_t(26);
+    zreg_t z_eps = zreg_t(27);
+    zreg_t z_one = zreg_t(28);
+    zreg_t z_zero = zreg_t(29);
+    zreg_t z_tmp = zreg_t(31);
+
+    PReg pred(bool tail) const { return tail ? reg_p_tail : reg_p_all; }
+
+    void load(int idx, const XReg &addr, int i, bool tail) {
+        ld1w(ZRegS(idx), pred(tail) / T_z,
+                ptr(addr, static_cast<int32_t>(i), MUL_VL));
+    }
+
+    void store(int idx, const XReg &addr, int i, bool tail) {
+        st1w(ZRegS(idx), pred(tail),
+                ptr(addr, static_cast<int32_t>(i), MUL_VL));
+    }
+
+    void bcast(const ZRegS &z, float f) {
+        mov_imm(reg_tmp, float2int(f));
+        dup(z, WReg(reg_tmp.getIdx()));
+    }
+
+    void advance(dim_t bytes) {
+        add_imm(reg_src_a, reg_src_a, bytes, reg_tmp);
+        add_imm(reg_dst_a, reg_dst_a, bytes, reg_tmp);
+        if (!jln_.is_fwd)
+            add_imm(reg_diff_dst_a, reg_diff_dst_a, bytes, reg_tmp);
+        if (jln_.use_scaleshift) {
+            add_imm(reg_gamma_a, reg_gamma_a, bytes, reg_tmp);
+            add_imm(reg_beta_a, reg_beta_a, bytes, reg_tmp);
+        }
+        if (jln_.calculate_diff_ss) {
+            add_imm(reg_diff_gamma_a, reg_diff_gamma_a, bytes, reg_tmp);
+            add_imm(reg_diff_beta_a, reg_diff_beta_a, bytes, reg_tmp);
+        }
+    }
+
+    /* Calls body for the vectors of the current row. */
+    template <typename body_t>
+    void row_loop(body_t body) {
+        const int simd_w = jln_.simd_w;
+        const int unroll = jln_.unroll;
+        const dim_t C_bytes = jln_.C * sizeof(data_t);
+        const dim_t n_vecs = jln_.C / simd_w;
+        const dim_t n_loops = n_vecs / unroll;
+        const int loop_tail = n_vecs % unroll;
+        const int c_tail = jln_.C % simd_w;
+
+        mov(reg_src_a, reg_src);
+        mov(reg_dst_a, reg_dst);
+        if (!jln_.is_fwd) mov(reg_diff_dst_a, reg_diff_dst);
+        if (jln_.use_scaleshift) {
+            mov(reg_gamma_a, reg_gamma);
+            add_imm(reg_beta_a, reg_gamma, C_bytes, reg_tmp);
+        }
+        if (jln_.calculate_diff_ss) {
+            mov(reg_diff_gamma_a, reg_diff_gamma);
+            add_imm(reg_diff_beta_a, reg_diff_gamma, C_bytes, reg_tmp);
+        }
+
+        if (n_loops > 1) {
+            LabelAArch64 c_loop;
+            mov_imm(reg_ctr, n_loops);
+            L_aarch64(c_loop); {
+                body(unroll, false);
+                advance(unroll * simd_w * sizeof(data_t));
+                subs(reg_ctr, reg_ctr, 1);
+                b(NE, c_loop);
+            }
+        } else if (n_loops == 1) {
+            body(unroll, false);
+            advance(unroll * simd_w * sizeof(data_t));
+        }
+
+        if (loop_tail) {
+            body(loop_tail, false);
+            advance(loop_tail * simd_w * sizeof(data_t));
+        }
+
+        if (c_tail) {
+            mov_imm(reg_tmp, c_tail);
+            whilelt(reg_p_tail.s, xzr, reg_tmp);
+            body(1, true);
+        }
+    }
+
+    void zero_accumulators() {
+        for (int i = 0; i < jln_.unroll; i++) {
+            dup(ZRegS(acc1_idx(i)), 0);
+            dup(ZRegS(acc2_idx(i)), 0);
+        }
+    }
+
+    /* Folds the unrolled accumulators into the first one, broadcasts the
+     * sum of its lanes and scales it by 1 / C. */
+    void reduce_mean(int idx) {
+        const ZRegS acc(idx);
+        for (int i = 1; i < jln_.unroll; i++)
+            fadd(acc, acc, ZRegS(idx + i));
+        faddv(SReg(z_tmp.getIdx()), reg_p_all, acc);
+        dup(acc, ZRegS(z_tmp.getIdx())[0]);
+        fmul(acc, acc, z_1_c);
+    }
+
+    // z_inv = 1 / sqrt(z_inv + eps)
+    void compute_inv() {
+        fadd(z_inv, z_inv, z_eps);
+        fsqrt(z_inv, reg_p_all / T_m, z_inv);
+        fdivr(z_inv, reg_p_all, z_one);
+    }
+
+    void forward_row() {
+        auto accumulate_stats = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                const ZRegS v(data_idx(i));
+                load(data_idx(i), reg_src_a, i, tail);
+                fsub(v, pred(tail), z_mean);
+                fadd(ZRegS(acc1_idx(i)), pred(tail), v);
+                fmla(ZRegS(acc2_idx(i)), pred(tail), v, v);
+            }
+        };
+
+        auto compute_dst = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                const ZRegS v(data_idx(i));
+                load(data_idx(i), reg_src_a, i, tail);
+                fsub(v, v, z_mean);
+                fmul(v, v, z_inv);
+                if (jln_.use_scaleshift) {
+                    load(gamma_idx(i), reg_gamma_a, i, tail);
+                    load(beta_idx(i), reg_beta_a, i, tail);
+                    fmad(v, reg_p_all, ZRegS(gamma_idx(i)),
+                            ZRegS(beta_idx(i)));
+                }
+                store(data_idx(i), reg_dst_a, i, tail);
+            }
+        };
+
+        if (jln_.calculate_stats) {
+            const ZRegS vmean(acc1_idx(0)), vvar(acc2_idx(0));
+
+            ld1rw(z_mean, reg_p_all, ptr(reg_src)); // the shift K
+            zero_accumulators();
+            row_loop(accumulate_stats);
+            reduce_mean(acc1_idx(0));
+            reduce_mean(acc2_idx(0));
+
+            fmls(vvar, reg_p_all, vmean, vmean);
+            fmax(vvar, reg_p_all, z_zero);
+            fadd(z_mean, z_mean, vmean);
+            mov(ZRegD(z_inv.getIdx()), ZRegD(vvar.getIdx()));
+
+            if (jln_.save_stats) {
+                st1w(z_mean, reg_p_first, ptr(reg_mean));
+                st1w(z_inv, reg_p_first, ptr(reg_var));
+            }
+        } else {
+            ld1rw(z_mean, reg_p_all, ptr(reg_mean));
+            ld1rw(z_inv, reg_p_all, ptr(reg_var));
+        }
+        compute_inv();
+
+        row_loop(compute_dst);
+    }
+
+    /* diff_src = inv * (dy * gamma - mean(dy * gamma)
+     *                   - x_hat * mean(dy * gamma * x_hat)),
+     * the means are dropped with the global statistics */
+    void backward_row() {
+        const bool full_derivative = jln_.calculate_stats;
+        const bool need_x_hat = full_derivative || jln_.calculate_diff_ss;
+
+        /* x_hat to data(i), dy * gamma to diff(i) */
+        auto load_x_hat_dy = [&](int i, bool tail, bool acc_diff_ss) {
+            const ZRegS vx(data_idx(i)), vdy(diff_idx(i));
+            if (need_x_hat) {
+                load(data_idx(i), reg_src_a, i, tail);
+                fsub(vx, vx, z_mean);
+                fmul(vx, vx, z_inv);
+            }
+            load(diff_idx(i), reg_diff_dst_a, i, tail);
+            if (acc_diff_ss) {
+                const ZRegS vdg(gamma_idx(i)), vdb(beta_idx(i));
+                load(gamma_idx(i), reg_diff_gamma_a, i, tail);
+                load(beta_idx(i), reg_diff_beta_a, i, tail);
+                fmla(vdg, reg_p_all, vdy, vx);
+                fadd(vdb, vdb, vdy);
+                store(gamma_idx(i), reg_diff_gamma_a, i, tail);
+                store(beta_idx(i), reg_diff_beta_a, i, tail);
+            }
+            if (jln_.use_scaleshift) {
+                load(gamma_idx(i), reg_gamma_a, i, tail);
+                fmul(vdy, vdy, ZRegS(gamma_idx(i)));
+            }
+        };
+
+        auto accumulate_sums = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                load_x_hat_dy(i, tail, jln_.calculate_diff_ss);
+                fadd(ZRegS(acc1_idx(i)), pred(tail), ZRegS(diff_idx(i)));
+                fmla(ZRegS(acc2_idx(i)), pred(tail), ZRegS(diff_idx(i)),
+                        ZRegS(data_idx(i)));
+            }
+        };
+
+        auto compute_diff_src = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                const ZRegS vdy(diff_idx(i));
+                load_x_hat_dy(i, tail,
+                        !full_derivative && jln_.calculate_diff_ss);
+                if (full_derivative) {
+                    fsub(vdy, vdy, ZRegS(acc1_idx(0)));
+                    fmls(vdy, reg_p_all, ZRegS(data_idx(i)),
+                            ZRegS(acc2_idx(0)));
+                }
+                fmul(vdy, vdy, z_inv);
+                store(diff_idx(i), reg_dst_a, i, tail);
+            }
+        };
+
+        ld1rw(z_mean, reg_p_all, ptr(reg_mean));
+        ld1rw(z_inv, reg_p_all, ptr(reg_var));
+        compute_inv();
+
+        if (full_derivative) {
+            zero_accumulators();
+            row_loop(accumulate_sums);
+            reduce_mean(acc1_idx(0));
+            reduce_mean(acc2_idx(0));
+        }
+
+        row_loop(compute_diff_src);
+    }
+
+    void generate() {
+        preamble();
+
+        ptrue(reg_p_all.s);
+        mov_imm(reg_tmp, 1);
+        whilelt(reg_p_first.s, xzr, reg_tmp);
+
+        ldr(reg_src, ptr(reg_param, GET_OFF(src)));
+        ldr(reg_dst, ptr(reg_param, GET_OFF(dst)));
+        ldr(reg_mean, ptr(reg_param, GET_OFF(mean)));
+        ldr(reg_var, ptr(reg_param, GET_OFF(var)));
+        ldr(reg_rows, ptr(reg_param, GET_OFF(rows)));
+        if (!jln_.is_fwd)
+            ldr(reg_diff_dst, ptr(reg_param, GET_OFF(diff_dst)));
+        if (jln_.use_scaleshift)
+            ldr(reg_gamma, ptr(reg_param, GET_OFF(scale_shift)));
+        if (jln_.calculate_diff_ss)
+            ldr(reg_diff_gamma, ptr(reg_param, GET_OFF(diff_scale_shift)));
+
+        bcast(z_1_c, 1.f / jln_.C);
+        bcast(z_eps, jln_.eps);
+        bcast(z_one, 1.f);
+        dup(z_zero, 0);
+
+        const dim_t row_bytes = jln_.row_stride * sizeof(data_t);
+        LabelAArch64 rows_loop;
+        L_aarch64(rows_loop); {
+            if (jln_.is_fwd)
+                forward_row();
+            else
+                backward_row();
+
+            add_imm(reg_src, reg_src, row_bytes, reg_tmp);
+            add_imm(reg_dst, reg_dst, row_bytes, reg_tmp);
+            if (!jln_.is_fwd)
+                add_imm(reg_diff_dst, reg_diff_dst, row_bytes, reg_tmp);
+            add_imm(reg_mean, reg_mean, sizeof(float), reg_tmp);
+            add_imm(reg_var, reg_var, sizeof(float), reg_tmp);
+            subs(reg_rows, reg_rows, 1);
+            b(NE, rows_loop);
+        }
+
+        postamble();
+    }
+
+    jit_sve_lnorm_kernel_t(const jit_lnorm_conf_t &jln)
+        : jit_generator_aarch64(nullptr, 64 * 1024), jln_(jln) {
+        assert(jln_.unroll >= 1 && jln_.unroll <= 4);
+
+        if (!load_cached_code(&jln_, sizeof(jln_)))
+            generate();
+        ready();
+        ker = getCode<void (*)(const call_params_t *)>();
+    }
+};
+
+/* Checks that the dims [0, last) of a plain md fold into one dim, the
+ * elements of which are stride apart (0 for a single element). Dims of
+ * size 1 don't matter. */
+bool fold_dims(dim_t &stride, const memory_desc_wrapper &md, int last) {
+    if (!md.is_plain()) return false;
+
+    const dims_t &dims = md.dims();
+    const auto &strides = md.blocking_desc().strides[0];
+    dim_t folded = 1;
+    stride = 0;
+    for (int d = last - 1; d >= 0; d--) {
+        if (dims[d] == 1) continue;
+        if (folded == 1)
+            stride = strides[d];
+        else if (strides[d] != stride * folded)
+            return false;
+        folded *= dims[d];
+    }
+    return true;
+}
+
+}
+
+namespace sve_lnorm_utils {
+
+status_t init_conf(jit_lnorm_conf_t &jln, const layer_normalization_pd_t *pd) {
+    const memory_desc_wrapper data_d(pd->src_pd());
+    const memory_desc_wrapper stat_d(pd->stat_pd());
+
+    const int ndims = data_d.ndims();
+    const int C = pd->norm_axis();
+    dim_t c_stride = 0, stat_stride = 0;
+    bool ok = true
+        && fold_dims(c_stride, data_d, ndims)
+        && utils::one_of(c_stride, 0, 1)
+        && fold_dims(jln.row_stride, data_d, ndims - 1)
+        && IMPLICATION(pd->across_axis() > 1, jln.row_stride >= C)
+        && fold_dims(stat_stride, stat_d, stat_d.ndims())
+        && utils::one_of(stat_stride, 0, 1);
+    if (!ok) return status::unimplemented;
+
+    jln.is_fwd = pd->is_fwd();
+    jln.use_scaleshift = pd->use_scaleshift();
+    jln.calculate_stats = !pd->use_global_stats();
+    jln.save_stats = jln.is_fwd && jln.calculate_stats && pd->is_training();
+    jln.calculate_diff_ss = pd->use_scaleshift()
+        && pd->desc()->prop_kind == prop_kind::backward;
+    jln.simd_w = get_sve_length() / sizeof(data_t);
+    jln.unroll = 4;
+    jln.C = C;
+    jln.eps = pd->desc()->layer_norm_epsilon;
+
+    return status::success;
+}
+
+}
+
+jit_sve_layer_normalization_fwd_t::jit_sve_layer_normalization_fwd_t(
+        const pd_t *apd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    kernel_ = new jit_sve_lnorm_kernel_t(pd()->jln_);
+}
+
+jit_sve_layer_normalization_fwd_t::~jit_sve_layer_normalization_fwd_t() {
+    delete kernel_;
+}
+
+void jit_sve_layer_normalization_fwd_t::execute_forward() const {
+    const bool stats_is_src = pd()->stats_is_src();
+    const bool save_stats = pd()->jln_.save_stats;
+
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+    auto mean = reinterpret_cast<float *>(stats_is_src
+            ? const_cast<char *>(this->input_memory(1))
+            : save_stats ? this->memory(1) : nullptr);
+    auto var = reinterpret_cast<float *>(stats_is_src
+            ? const_cast<char *>(this->input_memory(2))
+            : save_stats ? this->memory(2) : nullptr);
+    auto scale_shift = pd()->use_scaleshift()
+        ? reinterpret_cast<const float *>(
+                this->input_memory(1 + 2 * stats_is_src))
+        : nullptr;
+
+    const memory_desc_wrapper data_d(pd()->src_pd());
+    const memory_desc_wrapper stat_d(pd()->stat_pd());
+    src += data_d.blocking_desc().offset_padding;
+    dst += data_d.blocking_desc().offset_padding;
+    if (mean) mean += stat_d.blocking_desc().offset_padding;
+    if (var) var += stat_d.blocking_desc().offset_padding;
+
+    const auto &jln = pd()->jln_;
+    const int rows = pd()->across_axis();
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        int start{0}, end{0};
+        balance211(rows, nthr, ithr, start, end);
+        if (start == end) return;
+
+        jit_lnorm_call_s p;
+        p.src = src + start * jln.row_stride;
+        p.diff_dst = nullptr;
+        p.dst = dst + start * jln.row_stride;
+        p.mean = mean ? mean + start : nullptr;
+        p.var = var ? var + start : nullptr;
+        p.scale_shift = scale_shift;
+        p.diff_scale_shift = nullptr;
+        p.rows = end - start;
+        (*kernel_)(&p);
+    });
+}
+
+status_t jit_sve_layer_normalization_bwd_t::pd_t::init() {
+    using namespace data_type;
+    assert(engine()->kind() == engine_kind::cpu);
+
+    bool ok = true
+        && mayiuse(sve)
+        && is_bwd()
+        && !has_zero_dim_memory()
+        && set_default_params() == status::success
+        && utils::everyone_is(f32, desc()->data_desc.data_type,
+                desc()->diff_data_desc.data_type,
+                desc()->stat_desc.data_type)
+        && IMPLICATION(use_scaleshift(), utils::everyone_is(f32,
+                desc()->data_scaleshift_desc.data_type,
+                desc()->diff_data_scaleshift_desc.data_type))
+        && memory_desc_wrapper(diff_dst_pd())
+                == memory_desc_wrapper(src_pd())
+        && attr()->has_default_values();
+    if (!ok) return status::unimplemented;
+
+    CHECK(sve_lnorm_utils::init_conf(jln_, this));
+
+    /* every thread accumulates the gradients of gamma and beta of its
+     * rows, they are summed up at the end */
+    nthr_ = mkldnn_get_max_threads();
+    if (jln_.calculate_diff_ss) {
+        auto scratchpad = scratchpad_registry().registrar();
+        scratchpad.book(memory_tracking::names::key_lnorm_tmp_diff_ss,
+                sizeof(float) * nthr_ * 2 * jln_.C);
+    }
+
+    return status::success;
+}
+
+jit_sve_layer_normalization_bwd_t::jit_sve_layer_normalization_bwd_t(
+        const pd_t *apd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    kernel_ = new jit_sve_lnorm_kernel_t(pd()->jln_);
+}
+
+jit_sve_layer_normalization_bwd_t::~jit_sve_layer_normalization_bwd_t() {
+    delete kernel_;
+}
+
+void jit_sve_layer_normalization_bwd_t::execute_backward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto mean = reinterpret_cast<const float *>(this->input_memory(1));
+    auto var = reinterpret_cast<const float *>(this->input_memory(2));
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(3));
+    auto scale_shift = pd()->use_scaleshift()
+        ? reinterpret_cast<const float *>(this->input_memory(4)) : nullptr;
+    auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+    auto diff_scale_shift = pd()->use_diff_scaleshift()
+        ? reinterpret_cast<float *>(this->memory(1)) : nullptr;
+
+    const memory_desc_wrapper data_d(pd()->src_pd());
+    const memory_desc_wrapper stat_d(pd()->stat_pd());
+    src += data_d.blocking_desc().offset_padding;
+    diff_dst += data_d.blocking_desc().offset_padding;
+    diff_src += data_d.blocking_desc().offset_padding;
+    mean += stat_d.blocking_desc().offset_padding;
+    var += stat_d.blocking_desc().offset_padding;
+
+    const auto &jln = pd()->jln_;
+    const int rows = pd()->across_axis();
+    const dim_t C = jln.C;
+    const int nthr_ws = nstl::min(mkldnn_get_max_threads(), pd()->nthr_);
+
+    float *ws_diff_ss = nullptr;
+    if (jln.calculate_diff_ss) {
+        ws_diff_ss = this->scratchpad().template get<float>(
+                memory_tracking::names::key_lnorm_tmp_diff_ss);
+        utils::array_set(ws_diff_ss, 0.f, nthr_ws * 2 * C);
+    }
+
+    parallel(nthr_ws, [&](const int ithr, const int nthr) {
+        int start{0}, end{0};
+        balance211(rows, nthr, ithr, start, end);
+        if (start == end) return;
+
+        jit_lnorm_call_s p;
+        p.src = src + start * jln.row_stride;
+        p.diff_dst = diff_dst + start * jln.row_stride;
+        p.dst = diff_src + start * jln.row_stride;
+        p.mean = const_cast<float *>(mean + start);
+        p.var = const_cast<float *>(var + start);
+        p.scale_shift = scale_shift;
+        p.diff_scale_shift
+            = ws_diff_ss ? ws_diff_ss + ithr * 2 * C : nullptr;
+        p.rows = end - start;
+        (*kernel_)(&p);
+    });
+
+    if (ws_diff_ss) {
+        parallel_nd(2 * C, [&](dim_t c) {
+            float s = 0.f;
+            for (int ithr = 0; ithr < nthr_ws; ithr++)
+                s += ws_diff_ss[ithr * 2 * C + c];
+            diff_scale_shift[c] = s;
+        });
+    }
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
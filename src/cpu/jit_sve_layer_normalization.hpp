@@ -0,0 +1,137 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_LAYER_NORMALIZATION_HPP
+#define JIT_SVE_LAYER_NORMALIZATION_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_layer_normalization_pd.hpp"
+#include "cpu_isa_traits.hpp"
+#include "cpu_primitive.hpp"
+#include "jit_primitive_conf.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace { struct jit_sve_lnorm_kernel_t; }
+
+namespace sve_lnorm_utils {
+/* The normalized axis must be contiguous, the other dims of the data must
+ * fold into rows of a single stride and the statistics must be dense. */
+status_t init_conf(jit_lnorm_conf_t &jln, const layer_normalization_pd_t *pd);
+}
+
+struct jit_sve_layer_normalization_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_layer_normalization_fwd_pd_t {
+        pd_t(engine_t *engine, const layer_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const layer_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_layer_normalization_fwd_pd_t(engine, adesc, attr,
+                    hint_fwd_pd)
+            , jln_() {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_layer_normalization_fwd_t);
+
+        virtual status_t init() override {
+            using namespace data_type;
+            assert(engine()->kind() == engine_kind::cpu);
+
+            bool ok = true
+                && mayiuse(sve)
+                && is_fwd()
+                && !has_zero_dim_memory()
+                && set_default_params() == status::success
+                && desc()->data_desc.data_type == f32
+                && desc()->stat_desc.data_type == f32
+                && IMPLICATION(use_scaleshift(),
+                        desc()->data_scaleshift_desc.data_type == f32)
+                && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            return sve_lnorm_utils::init_conf(jln_, this);
+        }
+
+        jit_lnorm_conf_t jln_;
+    };
+
+    jit_sve_layer_normalization_fwd_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs);
+    ~jit_sve_layer_normalization_fwd_t();
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_sve_lnorm_kernel_t *kernel_;
+};
+
+struct jit_sve_layer_normalization_bwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_layer_normalization_bwd_pd_t {
+        pd_t(engine_t *engine, const layer_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const layer_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_layer_normalization_bwd_pd_t(engine, adesc, attr,
+                    hint_fwd_pd)
+            , jln_() {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_layer_normalization_bwd_t);
+
+        virtual status_t init() override;
+
+        jit_lnorm_conf_t jln_;
+        int nthr_; /* the threads that own a diff_scale_shift buffer */
+    };
+
+    jit_sve_layer_normalization_bwd_t(const pd_t *apd,
+            const input_vector &inputs, const output_vector &outputs);
+    ~jit_sve_layer_normalization_bwd_t();
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_backward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_sve_lnorm_kernel_t *kernel_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
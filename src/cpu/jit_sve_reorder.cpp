@@ -331,7 +331,7 @@ struct jit_uni_reorder_kernel_f32 : public kernel_t,
     bool process_direct_copy_sve(int len) {
         using namespace data_type;
 
-        const int simd_w = cpu_isa_traits<sve>::vlen / itype_sz;
+        const int simd_w = get_sve_length() / itype_sz;
         bool isSameType = prb_.itype == prb_.otype ? true : false;
 
         bool can_do = true && mayiuse(sve)
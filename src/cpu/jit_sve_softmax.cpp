@@ -0,0 +1,666 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_generator_aarch64.hpp"
+
+#include "jit_sve_softmax.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>(offsetof(call_params_t, field))
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+typedef float data_t;
+
+using namespace Xbyak::Xbyak_aarch64;
+
+/* One call computes the softmax, or its backward, of one vector along the
+ * axis (lanes along the axis) or of up to unroll vectors of inner points at
+ * once (lanes along the inner dims). In the first case the axis is made of
+ * runs of axis_blk contiguous elements, axis_stride apart, and the partial
+ * results of the lanes are reduced at the end of each pass; the tail of a
+ * run is a whilelt predicate. In the second case every lane is a softmax of
+ * its own, the axis points are axis_stride apart and the predicates of the
+ * vectors follow from the number of valid inner points of the call. */
+struct jit_sve_softmax_kernel_t: public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_softmax_kernel_t)
+
+    typedef jit_softmax_call_s call_params_t;
+
+    using xreg_t = const XReg;
+    using preg_t = const PReg;
+    using zreg_t = const ZRegS;
+
+    void (*ker)(const call_params_t *);
+    void operator()(const call_params_t *p) const { (*ker)(p); }
+
+    jit_softmax_conf_t jsp_;
+
+    xreg_t reg_param = x0;
+
+    xreg_t reg_src = x1; // dst for backward
+    xreg_t reg_diff_dst = x2;
+    xreg_t reg_dst = x3; // diff_src for backward
+
+    /* addresses of the current run and of the current vectors */
+    xreg_t reg_src_r = x4;
+    xreg_t reg_diff_dst_r = x5;
+    xreg_t reg_dst_r = x6;
+    xreg_t reg_src_a = x7;
+    xreg_t reg_diff_dst_a = x8;
+    xreg_t reg_dst_a = x9;
+
+    xreg_t reg_ctr = x10;
+    xreg_t reg_run_ctr = x11;
+    xreg_t reg_work = x12;
+    xreg_t reg_tmp = x13;
+
+    preg_t reg_p_all = p0;
+    /* p1 - p4 : valid inner points of the vectors when vectorize_inner */
+    preg_t reg_p_tail = p5;
+
+    /* z0 - z3 : src or dst, z4 - z7 : diff_dst,
+     * z8 - z11 : max accumulators, z12 - z15 : sum accumulators */
+    int data_idx(int i) const { return i; }
+    int diff_idx(int i) const { return 4 + i; }
+    int max_idx(int i) const { return 8 + i; }
+    int sum_idx(int i) const { return 12 + i; }
+    /* accumulator holding the result of the reduction for vector i */
+    int red_idx(int i) const { return jsp_.vectorize_inner ? i : 0; }
+
+    zreg_t z_log2 = zreg_t(16);
+    zreg_t z_log2_e = zreg_t(17);
+    zreg_t z_one = zreg_t(18); // exp coefficients are z18 - z22
+    zreg_t z_t1 = zreg_t(23);
+    zreg_t z_t2 = zreg_t(24);
+    zreg_t z_tmp = zreg_t(25);
+    zreg_t z_t3 = zreg_t(26);
+    zreg_t z_exp_min = zreg_t(27);
+
+    PReg pred(int i, bool tail) const {
+        if (jsp_.vectorize_inner) return PReg(1 + i);
+        return tail ? reg_p_tail : reg_p_all;
+    }
+
+    void load(int idx, const XReg &addr, int i, bool tail) {
+        ld1w(ZRegS(idx), pred(i, tail) / T_z,
+                ptr(addr, static_cast<int32_t>(i), MUL_VL));
+    }
+
+    void store(int idx, const XReg &addr, int i, bool tail) {
+        st1w(ZRegS(idx), pred(i, tail),
+                ptr(addr, static_cast<int32_t>(i), MUL_VL));
+    }
+
+    void advance(const XReg &src, const XReg &diff_dst, const XReg &dst,
+            dim_t bytes) {
+        add_imm(src, src, bytes, reg_tmp);
+        add_imm(dst, dst, bytes, reg_tmp);
+        if (!jsp_.is_fwd) add_imm(diff_dst, diff_dst, bytes, reg_tmp);
+    }
+
+    void load_exp_table() {
+        /* Same constants as the exp of the SVE eltwise injector */
+        const unsigned int cvals[] = {
+                0x3f317218, // log2 = std::log(2.0f)
+                0x3fb8aa3b, // log2_e = 1.0f / log2
+                0x3f800000, // exp coefficients
+                0x3effff12,
+                0x3e2aaa56,
+                0x3d2b89cc,
+                0x3c091331,
+        };
+        for (int i = 0; i < 7; i++) {
+            mov_imm(reg_tmp, cvals[i]);
+            dup(ZRegS(z_log2.getIdx() + i), WReg(reg_tmp.getIdx()));
+        }
+        mov_imm(reg_tmp, 0xc2aeac50); // log(FLT_MIN)
+        dup(z_exp_min, WReg(reg_tmp.getIdx()));
+    }
+
+    /* z = exp(z), destroys z_t1 and z_t2. z is clamped to log(FLT_MIN), so
+     * exp(-FLT_MAX - x) of the online sums does not overflow to nan */
+    void exp(const ZRegS &z) {
+        auto coeff = [&](int i) { return ZRegS(z_one.getIdx() + i); };
+
+        fmax(z, reg_p_all, z_exp_min);
+        fmul(z, z, z_log2_e);
+        frintn(z_t2, reg_p_all / T_m, z);
+        fcvtzs(z_t1, reg_p_all / T_m, z_t2);
+        fsub(z_t2, z, z_t2);
+        fmul(z_t2, z_t2, z_log2);
+        mov(ZRegD(z.getIdx()), ZRegD(coeff(4).getIdx()));
+        fmad(z, reg_p_all, z_t2, coeff(3));
+        fmad(z, reg_p_all, z_t2, coeff(2));
+        fmad(z, reg_p_all, z_t2, coeff(1));
+        fmad(z, reg_p_all, z_t2, coeff(0));
+        fmad(z, reg_p_all, z_t2, coeff(0));
+        fscale(z, reg_p_all, z_t1);
+    }
+
+    // z = log(z) for a normal z > 0, destroys z_t1, z_t2, z_t3 and z_tmp
+    void log(const ZRegS &z) {
+        auto bcast = [&](const ZRegS &dst, unsigned int bits) {
+            mov_imm(reg_tmp, bits);
+            dup(dst, WReg(reg_tmp.getIdx()));
+        };
+
+        // z = 2^e * m, m in [1, 2)
+        lsr(z_t1, z, 23);
+        scvtf(z_t1, reg_p_all / T_m, z_t1);
+        bcast(z_tmp, 0x42fe0000); // 127.f
+        fsub(z_t1, z_t1, z_tmp);
+        bcast(z_tmp, 0x007fffff);
+        and_(ZRegD(z.getIdx()), ZRegD(z.getIdx()), ZRegD(z_tmp.getIdx()));
+        orr(ZRegD(z.getIdx()), ZRegD(z.getIdx()), ZRegD(z_one.getIdx()));
+
+        // log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1) in [0, 1/3)
+        fadd(z_t2, z, z_one);
+        fsub(z, z, z_one);
+        fdiv(z, reg_p_all, z_t2);
+        fmul(z_t2, z, z);
+        const unsigned int cvals[] = {
+                0x3e638e39, // 2 / 9
+                0x3e924925, // 2 / 7
+                0x3ecccccd, // 2 / 5
+                0x3f2aaaab, // 2 / 3
+                0x40000000, // 2
+        };
+        bcast(z_t3, 0x3e3a2e8c); // 2 / 11
+        for (int i = 0; i < 5; i++) {
+            bcast(z_tmp, cvals[i]);
+            fmad(z_t3, reg_p_all, z_t2, z_tmp);
+        }
+        fmul(z, z, z_t3);
+
+        // log(z) = log(m) + e * log2
+        fmla(z, reg_p_all, z_t1, z_log2);
+    }
+
+    /* Folds the unrolled accumulators into the first one and broadcasts
+     * the reduction of its lanes. */
+    void reduce(int idx, bool is_max) {
+        const ZRegS acc(idx);
+        for (int i = 1; i < jsp_.unroll; i++) {
+            if (is_max)
+                fmax(acc, reg_p_all, ZRegS(idx + i));
+            else
+                fadd(acc, acc, ZRegS(idx + i));
+        }
+        if (is_max)
+            fmaxv(SReg(z_tmp.getIdx()), reg_p_all, acc);
+        else
+            faddv(SReg(z_tmp.getIdx()), reg_p_all, acc);
+        dup(acc, ZRegS(z_tmp.getIdx())[0]);
+    }
+
+    /* Brings the running sums of the lanes to the max of all lanes before
+     * reducing them, the common max is left in the first max accumulator. */
+    void reduce_online() {
+        const ZRegS vmax(z_t3);
+        mov(ZRegD(vmax.getIdx()), ZRegD(max_idx(0)));
+        for (int i = 1; i < jsp_.unroll; i++)
+            fmax(vmax, reg_p_all, ZRegS(max_idx(i)));
+        fmaxv(SReg(z_tmp.getIdx()), reg_p_all, vmax);
+        dup(vmax, ZRegS(z_tmp.getIdx())[0]);
+
+        for (int i = 0; i < jsp_.unroll; i++) {
+            const ZRegS vscale(max_idx(i));
+            fsub(vscale, vscale, vmax);
+            exp(vscale);
+            fmul(ZRegS(sum_idx(i)), ZRegS(sum_idx(i)), vscale);
+        }
+        mov(ZRegD(max_idx(0)), ZRegD(vmax.getIdx()));
+        reduce(sum_idx(0), false);
+    }
+
+    /* Calls body for the vectors of axis_len contiguous elements starting
+     * at the current run. */
+    template <typename body_t>
+    void run(body_t body, dim_t axis_len) {
+        const int simd_w = jsp_.simd_w;
+        const int unroll = jsp_.unroll;
+        const dim_t n_vecs = axis_len / simd_w;
+        const dim_t n_loops = n_vecs / unroll;
+        const int loop_tail = n_vecs % unroll;
+        const int axis_tail = axis_len % simd_w;
+
+        mov(reg_src_a, reg_src_r);
+        mov(reg_dst_a, reg_dst_r);
+        if (!jsp_.is_fwd) mov(reg_diff_dst_a, reg_diff_dst_r);
+
+        if (n_loops > 1) {
+            LabelAArch64 main_loop;
+            mov_imm(reg_ctr, n_loops);
+            L_aarch64(main_loop); {
+                body(unroll, false);
+                advance(reg_src_a, reg_diff_dst_a, reg_dst_a,
+                        unroll * simd_w * sizeof(data_t));
+                subs(reg_ctr, reg_ctr, 1);
+                b(NE, main_loop);
+            }
+        } else if (n_loops == 1) {
+            body(unroll, false);
+            advance(reg_src_a, reg_diff_dst_a, reg_dst_a,
+                    unroll * simd_w * sizeof(data_t));
+        }
+
+        if (loop_tail) {
+            body(loop_tail, false);
+            advance(reg_src_a, reg_diff_dst_a, reg_dst_a,
+                    loop_tail * simd_w * sizeof(data_t));
+        }
+
+        if (axis_tail) {
+            mov_imm(reg_tmp, axis_tail);
+            whilelt(reg_p_tail.s, xzr, reg_tmp);
+            body(1, true);
+        }
+    }
+
+    template <typename body_t>
+    void axis_loop(body_t body) {
+        const dim_t n_runs = utils::div_up(jsp_.axis_size, jsp_.axis_blk);
+        const dim_t last_run = jsp_.axis_size - (n_runs - 1) * jsp_.axis_blk;
+
+        mov(reg_src_r, reg_src);
+        mov(reg_dst_r, reg_dst);
+        if (!jsp_.is_fwd) mov(reg_diff_dst_r, reg_diff_dst);
+
+        if (n_runs > 1) {
+            LabelAArch64 run_loop;
+            mov_imm(reg_run_ctr, n_runs - 1);
+            L_aarch64(run_loop); {
+                run(body, jsp_.axis_blk);
+                advance(reg_src_r, reg_diff_dst_r, reg_dst_r,
+                        jsp_.axis_stride * sizeof(data_t));
+                subs(reg_run_ctr, reg_run_ctr, 1);
+                b(NE, run_loop);
+            }
+        }
+        run(body, last_run);
+    }
+
+    template <typename body_t>
+    void inner_loop(body_t body) {
+        LabelAArch64 axis_loop;
+
+        mov(reg_src_a, reg_src);
+        mov(reg_dst_a, reg_dst);
+        if (!jsp_.is_fwd) mov(reg_diff_dst_a, reg_diff_dst);
+
+        mov_imm(reg_ctr, jsp_.axis_size);
+        L_aarch64(axis_loop); {
+            body(jsp_.unroll, false);
+            advance(reg_src_a, reg_diff_dst_a, reg_dst_a,
+                    jsp_.axis_stride * sizeof(data_t));
+            subs(reg_ctr, reg_ctr, 1);
+            b(NE, axis_loop);
+        }
+    }
+
+    template <typename body_t>
+    void loop(body_t body) {
+        if (jsp_.vectorize_inner)
+            inner_loop(body);
+        else
+            axis_loop(body);
+    }
+
+    void forward() {
+        auto accumulate_max = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                load(data_idx(i), reg_src_a, i, tail);
+                fmax(ZRegS(max_idx(i)), pred(i, tail), ZRegS(data_idx(i)));
+            }
+        };
+
+        /* logsoftmax stores src - max and keeps the exponent in a
+         * temporary, softmax stores the exponent */
+        auto accumulate_sum = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                const ZRegS v(data_idx(i));
+                const ZRegS vexp = jsp_.is_log ? ZRegS(diff_idx(i)) : v;
+                load(data_idx(i), reg_src_a, i, tail);
+                fsub(v, v, ZRegS(max_idx(red_idx(i))));
+                if (jsp_.is_log) {
+                    store(data_idx(i), reg_dst_a, i, tail);
+                    mov(ZRegD(vexp.getIdx()), ZRegD(v.getIdx()));
+                }
+                exp(vexp);
+                fadd(ZRegS(sum_idx(i)), pred(i, tail), vexp);
+                if (!jsp_.is_log) store(data_idx(i), reg_dst_a, i, tail);
+            }
+        };
+
+        /* One pass for max and sum: the running sum of each lane is
+         * rescaled by exp(max - new_max) whenever its max grows. */
+        auto accumulate_online = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                const ZRegS v(data_idx(i));
+                const ZRegS vmax(max_idx(i));
+                const ZRegS vsum(sum_idx(i));
+                const ZRegS vmax_new(diff_idx(i));
+                load(data_idx(i), reg_src_a, i, tail);
+                mov(ZRegD(vmax_new.getIdx()), ZRegD(vmax.getIdx()));
+                fmax(vmax_new, pred(i, tail), v);
+
+                fsub(vmax, vmax, vmax_new);
+                exp(vmax);
+                fmul(vsum, vsum, vmax);
+
+                fsub(v, v, vmax_new);
+                exp(v);
+                fadd(vsum, pred(i, tail), v);
+                mov(ZRegD(vmax.getIdx()), ZRegD(vmax_new.getIdx()));
+            }
+        };
+
+        /* The online mode recomputes dst from src, logsoftmax subtracts
+         * max + log(sum) there. */
+        auto compute_dst = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                const ZRegS v(data_idx(i));
+                const ZRegS vsum(sum_idx(red_idx(i)));
+                if (!jsp_.is_online) {
+                    load(data_idx(i), reg_dst_a, i, tail);
+                    if (jsp_.is_log)
+                        fsub(v, v, vsum);
+                    else
+                        fmul(v, v, vsum);
+                } else {
+                    load(data_idx(i), reg_src_a, i, tail);
+                    if (jsp_.is_log) {
+                        fsub(v, v, vsum);
+                    } else {
+                        fsub(v, v, ZRegS(max_idx(red_idx(i))));
+                        exp(v);
+                        fmul(v, v, vsum);
+                    }
+                }
+                store(data_idx(i), reg_dst_a, i, tail);
+            }
+        };
+
+        mov_imm(reg_tmp, 0xff7fffff); // -FLT_MAX
+        for (int i = 0; i < jsp_.unroll; i++) {
+            dup(ZRegS(max_idx(i)), WReg(reg_tmp.getIdx()));
+            dup(ZRegS(sum_idx(i)), 0);
+        }
+        load_exp_table();
+
+        if (jsp_.is_online) {
+            loop(accumulate_online);
+            if (!jsp_.vectorize_inner) reduce_online();
+        } else {
+            loop(accumulate_max);
+            if (!jsp_.vectorize_inner) reduce(max_idx(0), true);
+
+            loop(accumulate_sum);
+            if (!jsp_.vectorize_inner) reduce(sum_idx(0), false);
+        }
+
+        const int n_sums = jsp_.vectorize_inner ? jsp_.unroll : 1;
+        for (int i = 0; i < n_sums; i++) {
+            const ZRegS vsum(sum_idx(i));
+            if (jsp_.is_log) {
+                log(vsum);
+                if (jsp_.is_online) fadd(vsum, vsum, ZRegS(max_idx(i)));
+            } else {
+                fdivr(vsum, reg_p_all, z_one);
+            }
+        }
+
+        loop(compute_dst);
+    }
+
+    /* softmax: diff_src = dst * (diff_dst - sum(diff_dst * dst)),
+     * logsoftmax: diff_src = diff_dst - exp(dst) * sum(diff_dst) */
+    void backward() {
+        auto accumulate_sum = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                load(diff_idx(i), reg_diff_dst_a, i, tail);
+                if (jsp_.is_log) {
+                    fadd(ZRegS(sum_idx(i)), pred(i, tail),
+                            ZRegS(diff_idx(i)));
+                } else {
+                    load(data_idx(i), reg_src_a, i, tail);
+                    fmla(ZRegS(sum_idx(i)), pred(i, tail),
+                            ZRegS(data_idx(i)), ZRegS(diff_idx(i)));
+                }
+            }
+        };
+
+        auto compute_diff_src = [&](int unroll, bool tail) {
+            for (int i = 0; i < unroll; i++) {
+                const ZRegS vdata(data_idx(i));
+                const ZRegS vdiff(diff_idx(i));
+                const ZRegS vsum(sum_idx(red_idx(i)));
+                load(data_idx(i), reg_src_a, i, tail);
+                load(diff_idx(i), reg_diff_dst_a, i, tail);
+                if (jsp_.is_log) {
+                    exp(vdata);
+                    fmls(vdiff, reg_p_all, vdata, vsum);
+                } else {
+                    fsub(vdiff, vdiff, vsum);
+                    fmul(vdiff, vdiff, vdata);
+                }
+                store(diff_idx(i), reg_dst_a, i, tail);
+            }
+        };
+
+        for (int i = 0; i < jsp_.unroll; i++)
+            dup(ZRegS(sum_idx(i)), 0);
+        if (jsp_.is_log) load_exp_table();
+
+        loop(accumulate_sum);
+        if (!jsp_.vectorize_inner) reduce(sum_idx(0), false);
+
+        loop(compute_diff_src);
+    }
+
+    void generate() {
+        preamble();
+
+        ptrue(reg_p_all.s);
+
+        ldr(reg_src, ptr(reg_param, GET_OFF(src)));
+        ldr(reg_dst, ptr(reg_param, GET_OFF(dst)));
+        if (!jsp_.is_fwd)
+            ldr(reg_diff_dst, ptr(reg_param, GET_OFF(diff_dst)));
+
+        if (jsp_.vectorize_inner) {
+            ldr(reg_work, ptr(reg_param, GET_OFF(work)));
+            for (int i = 0; i < jsp_.unroll; i++) {
+                mov_imm(reg_tmp, i * jsp_.simd_w);
+                whilelt(PReg(1 + i).s, reg_tmp, reg_work);
+            }
+        }
+
+        if (jsp_.is_fwd)
+            forward();
+        else
+            backward();
+
+        postamble();
+    }
+
+    jit_sve_softmax_kernel_t(const jit_softmax_conf_t &jsp)
+        : jit_generator_aarch64(nullptr, 64 * 1024), jsp_(jsp) {
+        assert(jsp_.unroll >= 1 && jsp_.unroll <= 4);
+
+        if (!load_cached_code(&jsp_, sizeof(jsp_)))
+            generate();
+        ready();
+        ker = getCode<void (*)(const call_params_t *)>();
+    }
+};
+
+/* Splits the softmaxes of the problem between the threads. src and dst are
+ * dst and diff_src for backward. */
+void exec_softmax(const jit_sve_softmax_kernel_t *kernel,
+        const jit_softmax_conf_t &jsp, const memory_desc_wrapper &data_d,
+        const data_t *src, const data_t *diff_dst, data_t *dst) {
+    const dim_t ou_size = jsp.axis_size * jsp.inner_size;
+
+    auto ker = [&](dim_t ou, dim_t in, size_t work) {
+        const size_t off = data_d.off_l(ou * ou_size) + in * jsp.inner_stride;
+
+        jit_softmax_call_s p;
+        p.src = src + off;
+        p.diff_dst = diff_dst ? diff_dst + off : nullptr;
+        p.dst = dst + off;
+        p.work = work;
+        (*kernel)(&p);
+    };
+
+    if (!jsp.vectorize_inner) {
+        parallel_nd(jsp.outer_size, jsp.inner_size,
+                [&](dim_t ou, dim_t in) { ker(ou, in, 0); });
+    } else {
+        const dim_t inner_blk = jsp.unroll * jsp.simd_w;
+        const dim_t nb_inner = utils::div_up(jsp.inner_size, inner_blk);
+        parallel_nd(jsp.outer_size, nb_inner, [&](dim_t ou, dim_t ib) {
+            const dim_t in = ib * inner_blk;
+            ker(ou, in, nstl::min(inner_blk, jsp.inner_size - in));
+        });
+    }
+}
+
+}
+
+namespace sve_softmax_utils {
+
+status_t init_conf(jit_softmax_conf_t &jsp, const softmax_desc_t &sd,
+        const memory_desc_wrapper &data_d, bool is_fwd) {
+    if (!data_d.is_blocking_desc()) return status::unimplemented;
+
+    const int ndims = data_d.ndims();
+    const int axis = sd.softmax_axis;
+    const dims_t &dims = data_d.dims();
+    const auto &bd = data_d.blocking_desc();
+
+    jsp.is_fwd = is_fwd;
+    jsp.is_log = sd.alg_kind == alg_kind::softmax_log;
+    jsp.simd_w = get_sve_length() / sizeof(data_t);
+    jsp.outer_size = utils::array_product(dims, axis);
+    jsp.axis_size = dims[axis];
+    jsp.inner_size = utils::array_product(dims + axis + 1, ndims - 1 - axis);
+
+    /* the inner dims are addressed as one dim of stride inner_stride */
+    bool inner_is_1d = true;
+    for (int d = axis + 1; d < ndims - 1; d++)
+        inner_is_1d = inner_is_1d
+            && bd.strides[0][d] == bd.strides[0][d + 1] * dims[d + 1];
+    jsp.inner_stride = axis < ndims - 1 ? bd.strides[0][ndims - 1] : 1;
+
+    const bool axis_is_blocked = true
+        && bd.block_dims[axis] > 1
+        && bd.strides[1][axis] == 1
+        && utils::array_product(bd.block_dims, ndims) == bd.block_dims[axis];
+
+    bool ok = true
+        && inner_is_1d
+        && data_d.only_padded_dim(axis)
+        && (axis_is_blocked || data_d.is_plain());
+    if (!ok) return status::unimplemented;
+
+    if (axis_is_blocked) {
+        jsp.vectorize_inner = false;
+        jsp.axis_blk = bd.block_dims[axis];
+        jsp.axis_stride = bd.strides[0][axis];
+    } else if (bd.strides[0][axis] == 1) {
+        jsp.vectorize_inner = false;
+        jsp.axis_blk = jsp.axis_size;
+        jsp.axis_stride = 0;
+    } else if (jsp.inner_size > 1 && jsp.inner_stride == 1) {
+        jsp.vectorize_inner = true;
+        jsp.axis_blk = 1;
+        jsp.axis_stride = bd.strides[0][axis];
+    } else {
+        return status::unimplemented;
+    }
+
+    jsp.unroll = jsp.vectorize_inner
+        ? (int)nstl::min(dim_t(4), utils::div_up(jsp.inner_size, jsp.simd_w))
+        : 4;
+
+    /* Once src and dst of a call no longer fit in L2 the three passes
+     * stream from memory, the online mode reads src twice and writes dst
+     * once at the cost of more exponents. */
+    const dim_t call_lanes = jsp.vectorize_inner ? jsp.unroll * jsp.simd_w : 1;
+    const dim_t footprint = 2 * sizeof(data_t) * jsp.axis_size * call_lanes;
+    jsp.is_online = is_fwd && footprint > (dim_t)get_cache_size(2, true);
+
+    return status::success;
+}
+
+}
+
+jit_sve_softmax_fwd_t::jit_sve_softmax_fwd_t(const pd_t *apd,
+        const input_vector &inputs, const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    kernel_ = new jit_sve_softmax_kernel_t(pd()->jsp_);
+}
+
+jit_sve_softmax_fwd_t::~jit_sve_softmax_fwd_t() {
+    delete kernel_;
+}
+
+void jit_sve_softmax_fwd_t::execute_forward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+
+    exec_softmax(kernel_, pd()->jsp_, memory_desc_wrapper(pd()->src_pd()),
+            src, nullptr, dst);
+}
+
+jit_sve_softmax_bwd_t::jit_sve_softmax_bwd_t(const pd_t *apd,
+        const input_vector &inputs, const output_vector &outputs)
+    : cpu_primitive_t(apd, inputs, outputs) {
+    kernel_ = new jit_sve_softmax_kernel_t(pd()->jsp_);
+}
+
+jit_sve_softmax_bwd_t::~jit_sve_softmax_bwd_t() {
+    delete kernel_;
+}
+
+void jit_sve_softmax_bwd_t::execute_backward() const {
+    auto dst = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+
+    exec_softmax(kernel_, pd()->jsp_, memory_desc_wrapper(pd()->dst_pd()),
+            dst, diff_dst, diff_src);
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
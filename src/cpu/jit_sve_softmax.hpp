@@ -0,0 +1,146 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_SOFTMAX_HPP
+#define JIT_SVE_SOFTMAX_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_softmax_pd.hpp"
+#include "cpu_isa_traits.hpp"
+#include "cpu_primitive.hpp"
+#include "jit_primitive_conf.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace { struct jit_sve_softmax_kernel_t; }
+
+namespace sve_softmax_utils {
+/* The axis is vectorized when it is contiguous, or blocked with the block
+ * innermost (nC[d]hw16c over channels); otherwise the lanes run along the
+ * inner dims, which must then be dense and plain. */
+status_t init_conf(jit_softmax_conf_t &jsp, const softmax_desc_t &sd,
+        const memory_desc_wrapper &data_d, bool is_fwd);
+}
+
+struct jit_sve_softmax_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_softmax_fwd_pd_t {
+        pd_t(engine_t *engine, const softmax_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const softmax_fwd_pd_t *hint_fwd_pd)
+            : cpu_softmax_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jsp_() {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_softmax_fwd_t);
+
+        virtual status_t init() override {
+            bool ok = true
+                && mayiuse(sve)
+                && is_fwd()
+                && !has_zero_dim_memory()
+                && data_pd_.desc()->data_type == data_type::f32
+                && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            return sve_softmax_utils::init_conf(jsp_, *desc(),
+                    memory_desc_wrapper(src_pd()), true);
+        }
+
+        jit_softmax_conf_t jsp_;
+    };
+
+    jit_sve_softmax_fwd_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs);
+    ~jit_sve_softmax_fwd_t();
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_sve_softmax_kernel_t *kernel_;
+};
+
+struct jit_sve_softmax_bwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_softmax_bwd_pd_t {
+        pd_t(engine_t *engine, const softmax_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const softmax_fwd_pd_t *hint_fwd_pd)
+            : cpu_softmax_bwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jsp_() {}
+
+        DECLARE_COMMON_PD_T(JIT_IMPL_NAME_HELPER("jit:", sve, ""),
+                jit_sve_softmax_bwd_t);
+
+        virtual status_t init() override {
+            const memory_desc_wrapper data_d(dst_pd());
+
+            bool ok = true
+                && mayiuse(sve)
+                && desc()->prop_kind == prop_kind::backward_data
+                && !memory_desc_wrapper(diff_dst_pd()).has_zero_dim()
+                && data_pd_.desc()->data_type == data_type::f32
+                && diff_src_pd_.desc()->data_type == data_type::f32
+                && diff_dst_pd_.desc()->data_type == data_type::f32
+                && memory_desc_wrapper(diff_dst_pd()) == data_d
+                && attr()->has_default_values();
+            if (!ok) return status::unimplemented;
+
+            return sve_softmax_utils::init_conf(jsp_, *desc(), data_d,
+                    false);
+        }
+
+        jit_softmax_conf_t jsp_;
+    };
+
+    jit_sve_softmax_bwd_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs);
+    ~jit_sve_softmax_bwd_t();
+
+    typedef float data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_backward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_sve_softmax_kernel_t *kernel_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
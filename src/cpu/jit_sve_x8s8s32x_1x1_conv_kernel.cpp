@@ -664,6 +664,9 @@ status_t jit_sve_x8s8s32x_1x1_conv_kernel::init_conf(
         const memory_desc_wrapper &dst_d, const memory_desc_wrapper &bias_d,
         const primitive_attr_t &attr, int nthreads, bool reduce_src) {
     if (!mayiuse(sve)) return status::unimplemented;
+    /* Only generated for 512-bit SVE, see jit_sve_x8s8s32x_fwd_kernel */
+    if (get_sve_length() != cpu_isa_traits<sve>::vlen)
+        return status::unimplemented;
 
     const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
     if (!one_of(src_d.data_type(), data_type::u8, data_type::s8)
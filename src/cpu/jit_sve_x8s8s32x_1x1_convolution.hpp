@@ -42,6 +42,7 @@
 #include "cpu_convolution_pd.hpp"
 #include "cpu_engine.hpp"
 
+#include "jit_kernel_cache.hpp"
 #include "jit_sve_x8s8s32x_1x1_conv_kernel.hpp"
 #include "jit_sve_1x1_conv_utils.hpp"
 
@@ -139,13 +140,12 @@ struct jit_sve_x8s8s32x_1x1_convolution_fwd_t : public cpu_primitive_t {
         : cpu_primitive_t(apd, inputs, outputs)
         , kernel_(nullptr), rtus_driver_(nullptr)
     {
-        kernel_ = new jit_sve_x8s8s32x_1x1_conv_kernel(pd()->jcp_,
-                    *pd()->attr());
+        kernel_ = get_jit_kernel<jit_sve_x8s8s32x_1x1_conv_kernel>(
+                pd()->jcp_, pd()->attr(), *pd()->attr());
         init_rtus_driver<sve>(this);
     }
 
     ~jit_sve_x8s8s32x_1x1_convolution_fwd_t() {
-        delete kernel_;
         delete rtus_driver_;
     }
 
@@ -167,7 +167,7 @@ struct jit_sve_x8s8s32x_1x1_convolution_fwd_t : public cpu_primitive_t {
             const memory_tracking::grantor_t &scratchpad) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_x8s8s32x_1x1_conv_kernel *kernel_;
+    std::shared_ptr<jit_sve_x8s8s32x_1x1_conv_kernel> kernel_;
     rtus_driver_t<sve> *rtus_driver_;
 };
 
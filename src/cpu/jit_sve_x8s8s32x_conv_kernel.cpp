@@ -1210,7 +1210,10 @@ status_t jit_sve_x8s8s32x_fwd_kernel::init_conf(jit_conv_conf_t &jcp,
     int ndims = src_d.ndims();
     bool is_1d = ndims == 3;
 
+    /* The int8 kernels keep 64 channels of int8 data in one vector register
+     * and are only generated for 512-bit SVE. */
     if (!(mayiuse(sve)
+         && get_sve_length() == cpu_isa_traits<sve>::vlen
          && one_of(src_d.data_type(), data_type::u8, data_type::s8)
          && weights_d.data_type() == data_type::s8
          && one_of(dst_d.data_type(), data_type::f32, data_type::s32,
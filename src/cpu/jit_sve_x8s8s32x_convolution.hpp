@@ -40,6 +40,7 @@
 
 #include "cpu_convolution_pd.hpp"
 
+#include "jit_kernel_cache.hpp"
 #include "jit_sve_x8s8s32x_conv_kernel.hpp"
 
 namespace mkldnn {
@@ -102,12 +103,10 @@ struct jit_sve_x8s8s32x_convolution_fwd_t : public cpu_primitive_t {
             const input_vector &inputs, const output_vector &outputs)
         : cpu_primitive_t(apd, inputs, outputs)
     {
-        kernel_ = new jit_sve_x8s8s32x_fwd_kernel(pd()->jcp_,
-                    *pd()->attr());
+        kernel_ = get_jit_kernel<jit_sve_x8s8s32x_fwd_kernel>(pd()->jcp_,
+                pd()->attr(), *pd()->attr());
     }
 
-    ~jit_sve_x8s8s32x_convolution_fwd_t() { delete kernel_; }
-
     typedef typename prec_traits<src_type>::type src_data_t;
     typedef typename prec_traits<data_type::s8>::type wei_data_t;
     typedef typename prec_traits<dst_type>::type dst_data_t;
@@ -130,7 +129,7 @@ private:
     void execute_forward_2d_dw() const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
-    jit_sve_x8s8s32x_fwd_kernel *kernel_;
+    std::shared_ptr<jit_sve_x8s8s32x_fwd_kernel> kernel_;
 };
 
 }
@@ -31,6 +31,9 @@
 
 #include "jit_avx512_core_bf16_dw_conv_kernel.hpp"
 #include "jit_uni_dw_conv_kernel_f32.hpp"
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "jit_sve_dw_conv_kernel_f32.hpp"
+#endif
 
 namespace mkldnn {
 namespace impl {
@@ -40,6 +43,35 @@ using namespace mkldnn::impl::memory_format;
 using namespace mkldnn::impl::memory_tracking::names;
 using namespace mkldnn::impl::utils;
 
+/* f32 kernels generated for the isa. On native AArch64 builds sve maps to
+ * the kernels written with SVE instructions. */
+template <cpu_isa_t isa>
+struct jit_uni_dw_conv_f32_kernels {
+    using fwd_t = jit_uni_dw_conv_fwd_kernel_f32<isa>;
+    using bwd_data_t = jit_uni_dw_conv_bwd_data_kernel_f32<isa>;
+    using bwd_weights_t = jit_uni_dw_conv_bwd_weights_kernel_f32<isa>;
+};
+
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template <>
+struct jit_uni_dw_conv_f32_kernels<sve> {
+    using fwd_t = jit_sve_dw_conv_fwd_kernel_f32;
+    using bwd_data_t = jit_sve_dw_conv_bwd_data_kernel_f32;
+    using bwd_weights_t = jit_sve_dw_conv_bwd_weights_kernel_f32;
+};
+#endif
+
+/* Channel block of the kernels: one vector register of floats. For sve it
+ * follows the vector length of the machine (8 or 16 floats). */
+template <cpu_isa_t isa>
+inline int jit_uni_dw_conv_simd_w() {
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    if (isa == sve)
+        return get_sve_length() / sizeof(float);
+#endif
+    return one_of(isa, avx512_common, avx512_core) ? 16 : 8;
+}
+
 template <cpu_isa_t isa, data_type_t kernel_dt>
 struct jit_uni_dw_conv_fwd_kernel {
 
@@ -66,7 +98,7 @@ private:
     using jit_kernel_t = typename utils::conditional<isa == avx512_core
                     && kernel_dt == data_type::bf16,
             jit_avx512_dw_conv_fwd_kernel_bf16,
-            jit_uni_dw_conv_fwd_kernel_f32<isa>>::type;
+            typename jit_uni_dw_conv_f32_kernels<isa>::fwd_t>::type;
     jit_kernel_t *ker_;
 };
 
@@ -102,7 +134,9 @@ status_t jit_uni_dw_conv_fwd_kernel<isa, kernel_dt>::init_conf(
     if (!mayiuse(isa) || (is_bf16 && !mayiuse(avx512_core)))
         return status::unimplemented;
 
-    const int simd_w = one_of(isa, avx512_common, avx512_core) ? 16 : 8;
+    const int simd_w = jit_uni_dw_conv_simd_w<isa>();
+    if (!one_of(simd_w, 8, 16))
+        return status::unimplemented;
 
     jcp.prop_kind = cd.prop_kind;
 
@@ -148,20 +182,22 @@ status_t jit_uni_dw_conv_fwd_kernel<isa, kernel_dt>::init_conf(
     if (jcp.with_eltwise)
         jcp.eltwise = p.entry_[eltwise_ind].eltwise;
 
+    /* The eltwise injector works on 512-bit registers only */
+    if (isa == sve && jcp.with_eltwise && simd_w != 16)
+        return status::unimplemented;
+
     bool ok_to_pad_channels = true
         && jcp.oc == jcp.ngroups
         && jcp.ic == jcp.ngroups
-        && one_of(isa, avx512_common, avx512_core, avx2);
+        && one_of(isa, avx512_common, avx512_core, avx2, sve);
     if (ok_to_pad_channels) {
         jcp.oc = rnd_up(jcp.oc, simd_w);
         jcp.ic = rnd_up(jcp.oc, simd_w);
         jcp.ngroups = rnd_up(jcp.ngroups, simd_w);
     }
 
-    auto desired_act_fmt
-            = one_of(isa, avx512_common, avx512_core) ? nChw16c : nChw8c;
-    auto desired_wei_fmt
-            = one_of(isa, avx512_common, avx512_core) ? Goihw16g : Goihw8g;
+    auto desired_act_fmt = simd_w == 16 ? nChw16c : nChw8c;
+    auto desired_wei_fmt = simd_w == 16 ? Goihw16g : Goihw8g;
 
     bool args_ok = true
         && jcp.oc == jcp.ngroups
@@ -183,12 +219,14 @@ status_t jit_uni_dw_conv_fwd_kernel<isa, kernel_dt>::init_conf(
             : sizeof(float);
 
     jcp.ur_w = is_bf16 ? (isa_has_bf16(jcp.isa) ? 6 : 4)
-                       : isa == avx512_common ? 6 : isa == avx2 ? 4 : 3;
+                       : one_of(isa, avx512_common, sve) ? 6
+                       : isa == avx2 ? 4 : 3;
 
     jcp.ch_block = simd_w;
     jcp.nb_ch = jcp.oc / jcp.ch_block;
     jcp.nb_ch_blocking
-            = one_of(isa, avx512_common, avx512_core) ? 4 : isa == avx2 ? 3 : 2;
+            = one_of(isa, avx512_common, avx512_core, sve) ? 4
+            : isa == avx2 ? 3 : 2;
     if (jcp.nb_ch < jcp.nb_ch_blocking)
         jcp.nb_ch_blocking = jcp.nb_ch;
 
@@ -210,6 +248,9 @@ template struct jit_uni_dw_conv_fwd_kernel<avx512_core, data_type::bf16>;
 template struct jit_uni_dw_conv_fwd_kernel<avx512_common, data_type::f32>;
 template struct jit_uni_dw_conv_fwd_kernel<avx2, data_type::f32>;
 template struct jit_uni_dw_conv_fwd_kernel<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template struct jit_uni_dw_conv_fwd_kernel<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t kernel_dt>
 struct jit_uni_dw_conv_bwd_data_kernel {
@@ -237,7 +278,7 @@ private:
     using jit_kernel_t = typename utils::conditional<isa == avx512_core
                     && kernel_dt == data_type::bf16,
             jit_avx512_dw_conv_bwd_data_kernel_bf16,
-            jit_uni_dw_conv_bwd_data_kernel_f32<isa>>::type;
+            typename jit_uni_dw_conv_f32_kernels<isa>::bwd_data_t>::type;
     jit_kernel_t *ker_;
 };
 
@@ -256,7 +297,9 @@ status_t jit_uni_dw_conv_bwd_data_kernel<isa, kernel_dt>::init_conf(
     if (!mayiuse(isa) || (is_bf16 && !mayiuse(avx512_core)))
         return status::unimplemented;
 
-    const int simd_w = one_of(isa, avx512_common, avx512_core) ? 16 : 8;
+    const int simd_w = jit_uni_dw_conv_simd_w<isa>();
+    if (!one_of(simd_w, 8, 16))
+        return status::unimplemented;
 
     const bool with_groups = weights_d.ndims() == diff_src_d.ndims() + 1;
     if (!with_groups) return status::unimplemented;
@@ -295,17 +338,15 @@ status_t jit_uni_dw_conv_bwd_data_kernel<isa, kernel_dt>::init_conf(
     bool ok_to_pad_channels = true
         && jcp.oc == jcp.ngroups
         && jcp.ic == jcp.ngroups
-        && one_of(isa, avx512_common, avx512_core, avx2);
+        && one_of(isa, avx512_common, avx512_core, avx2, sve);
     if (ok_to_pad_channels) {
         jcp.oc = rnd_up(jcp.oc, simd_w);
         jcp.ic = rnd_up(jcp.oc, simd_w);
         jcp.ngroups = rnd_up(jcp.ngroups, simd_w);
     }
 
-    auto desired_act_fmt
-            = one_of(isa, avx512_common, avx512_core) ? nChw16c : nChw8c;
-    auto desired_wei_fmt
-            = one_of(isa, avx512_common, avx512_core) ? Goihw16g : Goihw8g;
+    auto desired_act_fmt = simd_w == 16 ? nChw16c : nChw8c;
+    auto desired_wei_fmt = simd_w == 16 ? Goihw16g : Goihw8g;
 
     bool args_ok = true
         && jcp.oc == jcp.ngroups
@@ -331,12 +372,14 @@ status_t jit_uni_dw_conv_bwd_data_kernel<isa, kernel_dt>::init_conf(
             : sizeof(float);
 
     jcp.ur_w = is_bf16 ? (isa_has_bf16(jcp.isa) ? 6 : 4)
-                       : isa == avx512_common ? 6 : isa == avx2 ? 4 : 3;
+                       : one_of(isa, avx512_common, sve) ? 6
+                       : isa == avx2 ? 4 : 3;
 
     jcp.ch_block = simd_w;
     jcp.nb_ch = jcp.ic / jcp.ch_block;
     jcp.nb_ch_blocking
-            = one_of(isa, avx512_common, avx512_core) ? 4 : isa == avx2 ? 3 : 2;
+            = one_of(isa, avx512_common, avx512_core, sve) ? 4
+            : isa == avx2 ? 3 : 2;
     if (jcp.nb_ch < jcp.nb_ch_blocking)
         jcp.nb_ch_blocking = jcp.nb_ch;
 
@@ -354,6 +397,9 @@ template struct jit_uni_dw_conv_bwd_data_kernel<avx512_core, data_type::bf16>;
 template struct jit_uni_dw_conv_bwd_data_kernel<avx512_common, data_type::f32>;
 template struct jit_uni_dw_conv_bwd_data_kernel<avx2, data_type::f32>;
 template struct jit_uni_dw_conv_bwd_data_kernel<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template struct jit_uni_dw_conv_bwd_data_kernel<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t kernel_dt>
 struct jit_uni_dw_conv_bwd_weights_kernel {
@@ -382,7 +428,7 @@ private:
     using jit_kernel_t = typename utils::conditional<isa == avx512_core
                     && kernel_dt == data_type::bf16,
             jit_avx512_dw_conv_bwd_weights_kernel_bf16,
-            jit_uni_dw_conv_bwd_weights_kernel_f32<isa>>::type;
+            typename jit_uni_dw_conv_f32_kernels<isa>::bwd_weights_t>::type;
     jit_kernel_t *ker_;
 };
 
@@ -412,7 +458,9 @@ status_t jit_uni_dw_conv_bwd_weights_kernel<isa, kernel_dt>::init_conf(
     if (!jcp.is_depthwise)
         return status::unimplemented;
 
-    jcp.ch_block = one_of(isa, avx512_common, avx512_core) ? 16 : 8;
+    jcp.ch_block = jit_uni_dw_conv_simd_w<isa>();
+    if (!one_of(jcp.ch_block, 8, 16))
+        return status::unimplemented;
 
     jcp.mb = src_d.dims()[0];
 
@@ -443,10 +491,8 @@ status_t jit_uni_dw_conv_bwd_weights_kernel<isa, kernel_dt>::init_conf(
 
     jcp.with_bias = cd.diff_bias_desc.format != memory_format::undef;
 
-    auto desired_act_fmt
-            = one_of(isa, avx512_common, avx512_core) ? nChw16c : nChw8c;
-    auto desired_wei_fmt
-            = one_of(isa, avx512_common, avx512_core) ? Goihw16g : Goihw8g;
+    auto desired_act_fmt = jcp.ch_block == 16 ? nChw16c : nChw8c;
+    auto desired_wei_fmt = jcp.ch_block == 16 ? Goihw16g : Goihw8g;
 
     bool args_ok = true && src_d.format() == desired_act_fmt
             && diff_weights_d.format() == desired_wei_fmt
@@ -547,6 +593,9 @@ template struct jit_uni_dw_conv_bwd_weights_kernel<avx512_common,
         data_type::f32>;
 template struct jit_uni_dw_conv_bwd_weights_kernel<avx2, data_type::f32>;
 template struct jit_uni_dw_conv_bwd_weights_kernel<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template struct jit_uni_dw_conv_bwd_weights_kernel<sve, data_type::f32>;
+#endif
 }
 }
 }
@@ -158,6 +158,9 @@ template struct _jit_uni_dw_convolution_fwd_t<avx512_core, data_type::bf16>;
 template struct _jit_uni_dw_convolution_fwd_t<avx512_common, data_type::f32>;
 template struct _jit_uni_dw_convolution_fwd_t<avx2, data_type::f32>;
 template struct _jit_uni_dw_convolution_fwd_t<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template struct _jit_uni_dw_convolution_fwd_t<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t diff_dst_type, data_type_t diff_src_type>
 void _jit_uni_dw_convolution_bwd_data_t<isa, diff_dst_type,
@@ -267,6 +270,9 @@ template struct _jit_uni_dw_convolution_bwd_data_t<avx512_common,
         data_type::f32>;
 template struct _jit_uni_dw_convolution_bwd_data_t<avx2, data_type::f32>;
 template struct _jit_uni_dw_convolution_bwd_data_t<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template struct _jit_uni_dw_convolution_bwd_data_t<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t src_type, data_type_t diff_weights_type>
 void _jit_uni_dw_convolution_bwd_weights_t<isa, src_type,
@@ -573,6 +579,9 @@ template struct _jit_uni_dw_convolution_bwd_weights_t<avx512_common,
         data_type::f32>;
 template struct _jit_uni_dw_convolution_bwd_weights_t<avx2, data_type::f32>;
 template struct _jit_uni_dw_convolution_bwd_weights_t<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template struct _jit_uni_dw_convolution_bwd_weights_t<sve, data_type::f32>;
+#endif
 }
 }
 }
@@ -83,12 +83,9 @@ struct _jit_uni_dw_convolution_fwd_t : public cpu_primitive_t {
     protected:
         virtual status_t set_default_params() override {
             using namespace memory_format;
-            auto desired_act_fmt
-                    = utils::one_of(isa, avx512_common, avx512_core) ? nChw16c
-                                                                     : nChw8c;
-            auto desired_wei_fmt
-                    = utils::one_of(isa, avx512_common, avx512_core) ? Goihw16g
-                                                                     : Goihw8g;
+            const int simd_w = jit_uni_dw_conv_simd_w<isa>();
+            auto desired_act_fmt = simd_w == 16 ? nChw16c : nChw8c;
+            auto desired_wei_fmt = simd_w == 16 ? Goihw16g : Goihw8g;
 
             if (this->src_pd_.desc()->format == any)
                 CHECK(this->src_pd_.set_format(desired_act_fmt));
@@ -135,6 +132,10 @@ using jit_avx2_dw_convolution_fwd_t
         = _jit_uni_dw_convolution_fwd_t<avx2, data_type::f32>;
 using jit_sse42_dw_convolution_fwd_t
         = _jit_uni_dw_convolution_fwd_t<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+using jit_sve_dw_convolution_fwd_t
+        = _jit_uni_dw_convolution_fwd_t<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t diff_dst_type,
         data_type_t diff_src_type = diff_dst_type>
@@ -188,12 +189,9 @@ struct _jit_uni_dw_convolution_bwd_data_t : public cpu_primitive_t {
     protected:
         virtual status_t set_default_params() override {
             using namespace memory_format;
-            auto desired_act_fmt
-                    = utils::one_of(isa, avx512_common, avx512_core) ? nChw16c
-                                                                     : nChw8c;
-            auto desired_wei_fmt
-                    = utils::one_of(isa, avx512_common, avx512_core) ? Goihw16g
-                                                                     : Goihw8g;
+            const int simd_w = jit_uni_dw_conv_simd_w<isa>();
+            auto desired_act_fmt = simd_w == 16 ? nChw16c : nChw8c;
+            auto desired_wei_fmt = simd_w == 16 ? Goihw16g : Goihw8g;
 
             if (this->diff_src_pd_.desc()->format == any)
                 CHECK(this->diff_src_pd_.set_format(desired_act_fmt));
@@ -241,6 +239,10 @@ using jit_avx2_dw_convolution_bwd_data_t
         = _jit_uni_dw_convolution_bwd_data_t<avx2, data_type::f32>;
 using jit_sse42_dw_convolution_bwd_data_t
         = _jit_uni_dw_convolution_bwd_data_t<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+using jit_sve_dw_convolution_bwd_data_t
+        = _jit_uni_dw_convolution_bwd_data_t<sve, data_type::f32>;
+#endif
 
 template <cpu_isa_t isa, data_type_t src_type,
         data_type_t diff_weights_type = src_type>
@@ -296,12 +298,9 @@ struct _jit_uni_dw_convolution_bwd_weights_t : public cpu_primitive_t {
     protected:
         virtual status_t set_default_params() override {
             using namespace memory_format;
-            auto desired_act_fmt
-                    = utils::one_of(isa, avx512_common, avx512_core) ? nChw16c
-                                                                     : nChw8c;
-            auto desired_wei_fmt
-                    = utils::one_of(isa, avx512_common, avx512_core) ? Goihw16g
-                                                                     : Goihw8g;
+            const int simd_w = jit_uni_dw_conv_simd_w<isa>();
+            auto desired_act_fmt = simd_w == 16 ? nChw16c : nChw8c;
+            auto desired_wei_fmt = simd_w == 16 ? Goihw16g : Goihw8g;
 
             if (this->src_pd_.desc()->format == any)
                 CHECK(this->src_pd_.set_format(desired_act_fmt));
@@ -362,6 +361,10 @@ using jit_avx2_dw_convolution_bwd_weights_t
         = _jit_uni_dw_convolution_bwd_weights_t<avx2, data_type::f32>;
 using jit_sse42_dw_convolution_bwd_weights_t
         = _jit_uni_dw_convolution_bwd_weights_t<sse42, data_type::f32>;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+using jit_sve_dw_convolution_bwd_weights_t
+        = _jit_uni_dw_convolution_bwd_weights_t<sve, data_type::f32>;
+#endif
 
 }
 }
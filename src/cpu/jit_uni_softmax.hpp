@@ -62,6 +62,7 @@ struct jit_uni_softmax_fwd_t: public cpu_primitive_t {
             bool ok = true
                 && mayiuse(isa)
                 && is_fwd()
+                && !is_logsoftmax()
                 && !has_zero_dim_memory()
                 && data_pd_.desc()->data_type == data_type::f32
                 && is_dense() // not dense impl can be easily done
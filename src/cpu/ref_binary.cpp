@@ -0,0 +1,85 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+
+#include "ref_binary.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace alg_kind;
+
+ref_binary_scalar_t::ref_binary_scalar_t(alg_kind_t alg): alg_(alg) {
+    assert(utils::one_of(alg_, binary_add, binary_mul, binary_max,
+                binary_min));
+}
+
+float ref_binary_scalar_t::compute_scalar(float s0, float s1) const {
+    switch (alg_) {
+    case binary_add: return s0 + s1;
+    case binary_mul: return s0 * s1;
+    case binary_max: return nstl::max(s0, s1);
+    case binary_min: return nstl::min(s0, s1);
+    default: assert(!"unknown binary alg_kind");
+    }
+    return 0.f;
+}
+
+void ref_binary_t::execute_forward() const {
+    auto src0 = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto src1 = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+
+    const memory_desc_wrapper src0_d(pd()->src_pd(0));
+    const memory_desc_wrapper src1_d(pd()->src_pd(1));
+    const memory_desc_wrapper dst_d(pd()->dst_pd());
+
+    const int ndims = pd()->ndims();
+    const dims_t &dims = dst_d.dims();
+    const dims_t &src1_dims = src1_d.dims();
+    const ref_binary_scalar_t binary(pd()->desc()->alg_kind);
+
+    parallel_nd(dst_d.nelems(), [&](ptrdiff_t e) {
+        dims_t pos;
+        size_t l_offset = e;
+        for (int d = ndims - 1; d >= 0; --d) {
+            pos[d] = l_offset % dims[d];
+            l_offset /= dims[d];
+        }
+        const size_t dst_off = dst_d.off_v(pos);
+        const float s0 = src0[src0_d.off_v(pos)];
+
+        /* src1 is broadcast along its dims of size 1 */
+        for (int d = 0; d < ndims; ++d)
+            if (src1_dims[d] == 1) pos[d] = 0;
+        const float s1 = src1[src1_d.off_v(pos)];
+
+        dst[dst_off] = binary.compute_scalar(s0, s1);
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,108 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_REF_BINARY_HPP
+#define CPU_REF_BINARY_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_binary_pd.hpp"
+#include "cpu_engine.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+struct ref_binary_scalar_t {
+public:
+    ref_binary_scalar_t(alg_kind_t alg);
+
+    float compute_scalar(float s0, float s1) const;
+
+    const alg_kind_t alg_;
+};
+
+/* Applies a binary post-op to the dst values of the primitive it is fused
+ * into, src1 is broadcast as classified by get_binary_po_bcast() */
+struct ref_binary_po_t: public ref_binary_scalar_t {
+public:
+    ref_binary_po_t(const post_ops_t::entry_t::binary_t &binary,
+            const memory_desc_t &dst_md, int oc_dim = 1)
+        : ref_binary_scalar_t(binary.alg)
+        , bcast_(get_binary_po_bcast(binary.src1_desc, dst_md, oc_dim)) {}
+
+    /* off is the offset of the value in dst and oc its channel */
+    float compute_scalar(float d, const float *src1, size_t off,
+            size_t oc) const {
+        const size_t src1_off = bcast_ == binary_po_bcast_per_tensor
+            ? 0 : bcast_ == binary_po_bcast_per_oc ? oc : off;
+        return ref_binary_scalar_t::compute_scalar(d, src1[src1_off]);
+    }
+
+    const binary_po_bcast_t bcast_;
+};
+
+struct ref_binary_t: public cpu_primitive_t {
+    struct pd_t: public cpu_binary_pd_t {
+        pd_t(engine_t *engine, const binary_desc_t *adesc,
+                const primitive_attr_t *attr, const binary_pd_t *hint_pd)
+            : cpu_binary_pd_t(engine, adesc, attr, hint_pd) {}
+
+        DECLARE_COMMON_PD_T("ref:any", ref_binary_t);
+
+        virtual status_t init() override {
+            using namespace data_type;
+            assert(engine()->kind() == engine_kind::cpu);
+            bool ok = true
+                && !has_zero_dim_memory()
+                && set_default_params() == status::success
+                && utils::everyone_is(f32, desc()->src_desc[0].data_type,
+                        desc()->src_desc[1].data_type,
+                        desc()->dst_desc.data_type)
+                && memory_desc_wrapper(src_pd(0)).is_blocking_desc()
+                && memory_desc_wrapper(src_pd(1)).is_blocking_desc()
+                && memory_desc_wrapper(dst_pd()).is_blocking_desc()
+                && attr()->has_default_values();
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    ref_binary_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,169 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+
+#include "ref_layer_normalization.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+void ref_layer_normalization_fwd_t::execute_forward() const {
+    const bool stats_is_src = pd()->stats_is_src();
+    const bool save_stats = !stats_is_src && pd()->is_training();
+
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto mean = reinterpret_cast<float *>(stats_is_src
+            ? const_cast<char *>(this->input_memory(1))
+            : save_stats ? this->memory(1) : nullptr);
+    auto variance = reinterpret_cast<float *>(stats_is_src
+            ? const_cast<char *>(this->input_memory(2))
+            : save_stats ? this->memory(2) : nullptr);
+    auto scaleshift = pd()->use_scaleshift()
+        ? reinterpret_cast<const float *>(
+                this->input_memory(1 + 2 * stats_is_src))
+        : nullptr;
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+
+    const memory_desc_wrapper data_d(pd()->src_pd());
+    const memory_desc_wrapper stat_d(pd()->stat_pd());
+    const memory_desc_wrapper scaleshift_d(pd()->weights_pd());
+
+    const int N = pd()->across_axis();
+    const int C = pd()->norm_axis();
+    const float eps = pd()->desc()->layer_norm_epsilon;
+
+    parallel_nd(N, [&](int n) {
+        const size_t s_off = stat_d.off_l(n);
+        float v_mean = stats_is_src ? mean[s_off] : 0;
+        float v_variance = stats_is_src ? variance[s_off] : 0;
+
+        if (!stats_is_src) {
+            for (int c = 0; c < C; ++c)
+                v_mean += src[data_d.off_l(n * C + c)];
+            v_mean /= C;
+
+            for (int c = 0; c < C; ++c) {
+                float m = src[data_d.off_l(n * C + c)] - v_mean;
+                v_variance += m * m;
+            }
+            v_variance /= C;
+        }
+
+        const float sqrt_variance = sqrtf(v_variance + eps);
+        for (int c = 0; c < C; ++c) {
+            const size_t off = data_d.off_l(n * C + c);
+            float v = (src[off] - v_mean) / sqrt_variance;
+            if (scaleshift)
+                v = scaleshift[scaleshift_d.off(0, c)] * v
+                    + scaleshift[scaleshift_d.off(1, c)];
+            dst[off] = v;
+        }
+
+        if (save_stats) {
+            mean[s_off] = v_mean;
+            variance[s_off] = v_variance;
+        }
+    });
+}
+
+void ref_layer_normalization_bwd_t::execute_backward() const {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto mean = reinterpret_cast<const float *>(this->input_memory(1));
+    auto variance = reinterpret_cast<const float *>(this->input_memory(2));
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(3));
+    auto scaleshift = pd()->use_scaleshift()
+        ? reinterpret_cast<const float *>(this->input_memory(4)) : nullptr;
+    auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+    auto diff_scaleshift = pd()->use_diff_scaleshift()
+        ? reinterpret_cast<float *>(this->memory(1)) : nullptr;
+
+    const memory_desc_wrapper data_d(pd()->src_pd());
+    const memory_desc_wrapper diff_data_d(pd()->diff_src_pd());
+    const memory_desc_wrapper stat_d(pd()->stat_pd());
+    const memory_desc_wrapper scaleshift_d(pd()->weights_pd());
+    const memory_desc_wrapper diff_scaleshift_d(pd()->diff_weights_pd());
+
+    const int N = pd()->across_axis();
+    const int C = pd()->norm_axis();
+    const float eps = pd()->desc()->layer_norm_epsilon;
+    const bool calculate_diff_stats = !pd()->use_global_stats();
+
+    auto inv_sqrt_variance = [&](int n) {
+        return 1.f / sqrtf(variance[stat_d.off_l(n)] + eps);
+    };
+
+    if (diff_scaleshift) {
+        parallel_nd(C, [&](int c) {
+            float diff_gamma = 0, diff_beta = 0;
+            for (int n = 0; n < N; ++n) {
+                const float dd = diff_dst[diff_data_d.off_l(n * C + c)];
+                const float x_hat = (src[data_d.off_l(n * C + c)]
+                        - mean[stat_d.off_l(n)]) * inv_sqrt_variance(n);
+                diff_gamma += dd * x_hat;
+                diff_beta += dd;
+            }
+            diff_scaleshift[diff_scaleshift_d.off(0, c)] = diff_gamma;
+            diff_scaleshift[diff_scaleshift_d.off(1, c)] = diff_beta;
+        });
+    }
+
+    parallel_nd(N, [&](int n) {
+        const float v_mean = mean[stat_d.off_l(n)];
+        const float inv_sqrt = inv_sqrt_variance(n);
+
+        auto gamma = [&](int c) {
+            return scaleshift ? scaleshift[scaleshift_d.off(0, c)] : 1.f;
+        };
+
+        float dd_gamma = 0, dd_gamma_x_hat = 0;
+        if (calculate_diff_stats) {
+            for (int c = 0; c < C; ++c) {
+                const float dd = diff_dst[diff_data_d.off_l(n * C + c)]
+                    * gamma(c);
+                const float x_hat
+                    = (src[data_d.off_l(n * C + c)] - v_mean) * inv_sqrt;
+                dd_gamma += dd;
+                dd_gamma_x_hat += dd * x_hat;
+            }
+            dd_gamma /= C;
+            dd_gamma_x_hat /= C;
+        }
+
+        for (int c = 0; c < C; ++c) {
+            const size_t off = diff_data_d.off_l(n * C + c);
+            float v = diff_dst[off] * gamma(c);
+            if (calculate_diff_stats) {
+                const float x_hat
+                    = (src[data_d.off_l(n * C + c)] - v_mean) * inv_sqrt;
+                v -= dd_gamma + x_hat * dd_gamma_x_hat;
+            }
+            diff_src[off] = v * inv_sqrt;
+        }
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,129 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_REF_LAYER_NORMALIZATION_HPP
+#define CPU_REF_LAYER_NORMALIZATION_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_layer_normalization_pd.hpp"
+#include "cpu_engine.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+struct ref_layer_normalization_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_layer_normalization_fwd_pd_t {
+        pd_t(engine_t *engine, const layer_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const layer_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_layer_normalization_fwd_pd_t(engine, adesc, attr,
+                    hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("ref:any", ref_layer_normalization_fwd_t);
+
+        virtual status_t init() override {
+            using namespace data_type;
+            assert(engine()->kind() == engine_kind::cpu);
+            bool ok = true
+                && is_fwd()
+                && !has_zero_dim_memory()
+                && set_default_params() == status::success
+                && desc()->data_desc.data_type == f32
+                && desc()->stat_desc.data_type == f32
+                && IMPLICATION(use_scaleshift(),
+                        desc()->data_scaleshift_desc.data_type == f32)
+                && memory_desc_wrapper(src_pd()).is_blocking_desc()
+                && memory_desc_wrapper(stat_pd()).is_blocking_desc()
+                && attr()->has_default_values();
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    ref_layer_normalization_fwd_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+};
+
+struct ref_layer_normalization_bwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_layer_normalization_bwd_pd_t {
+        pd_t(engine_t *engine, const layer_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const layer_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_layer_normalization_bwd_pd_t(engine, adesc, attr,
+                    hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("ref:any", ref_layer_normalization_bwd_t);
+
+        virtual status_t init() override {
+            using namespace data_type;
+            assert(engine()->kind() == engine_kind::cpu);
+            bool ok = true
+                && is_bwd()
+                && !has_zero_dim_memory()
+                && set_default_params() == status::success
+                && utils::everyone_is(f32, desc()->data_desc.data_type,
+                        desc()->diff_data_desc.data_type,
+                        desc()->stat_desc.data_type)
+                && IMPLICATION(use_scaleshift(), utils::everyone_is(f32,
+                        desc()->data_scaleshift_desc.data_type,
+                        desc()->diff_data_scaleshift_desc.data_type))
+                && memory_desc_wrapper(src_pd()).is_blocking_desc()
+                && memory_desc_wrapper(diff_src_pd()).is_blocking_desc()
+                && memory_desc_wrapper(stat_pd()).is_blocking_desc()
+                && attr()->has_default_values();
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    ref_layer_normalization_bwd_t(const pd_t *apd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(apd, inputs, outputs) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) const override {
+        execute_backward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward() const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -79,6 +79,41 @@ rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution) {
     gates_reduction(rnn, ws_gates_, diff_bias_);
 }
 
+#ifdef DNNL_NATIVE_JIT_AARCH64
+/* The fused kernel works on blocks of rows of the batch and one vector of
+ * output channels, the blocks of a cell are independent. */
+template <>
+rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_fused) {
+    const int mb_block = jit_sve_rnn_cell_fwd_kernel::mb_block_;
+    const int simd_w = fused_cell_->simd_w();
+    const int ld = rnn.states_ws_ld;
+
+    const int nb_mb = utils::div_up(rnn.mb, mb_block);
+    const int nb_oc = utils::div_up(rnn.dic, simd_w);
+
+    // ocb-major, so that each CMG works on a consecutive slice of weights
+    parallel_nd_cmg(nb_oc * nb_mb, [&](int iwork) {
+        const int ocb = iwork / nb_mb;
+        const int mbb = iwork % nb_mb;
+        const int b0 = mbb * mb_block;
+        const int o0 = ocb * simd_w;
+        jit_sve_rnn_cell_fwd_kernel::call_params_t p;
+        p.w_layer = w_layer_[0] + o0;
+        p.w_iter = w_iter_[0] + o0;
+        p.bias = bias_[0] + o0;
+        p.src_layer = states_t_lm1_ + (size_t)b0 * ld;
+        p.src_iter = states_tm1_l_ + (size_t)b0 * ld;
+        p.h_tm1 = p.src_iter + o0;
+        p.c_tm1 = c_states_tm1_l_ + (size_t)b0 * ld + o0;
+        p.dst = states_t_l_ + (size_t)b0 * ld + o0;
+        p.c_dst = c_states_t_l_ + (size_t)b0 * ld + o0;
+        p.nb = nstl::min(mb_block, rnn.mb - b0);
+        p.oc_work = nstl::min(simd_w, rnn.dic - o0);
+        fused_cell_->ker_(&p);
+    });
+}
+#endif
+
 }
 }
 }
@@ -0,0 +1,262 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "utils.hpp"
+
+#include "jit_sve_rnn_cell_fwd_kernel.hpp"
+
+#define GET_OFF(field) static_cast<int32_t>( \
+        offsetof(jit_sve_rnn_cell_fwd_kernel::call_params_t, field))
+
+using namespace Xbyak::Xbyak_aarch64;
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+bool jit_sve_rnn_cell_fwd_kernel::is_applicable(
+        const rnn_utils::rnn_conf_t &rnn, alg_kind_t cell_kind) {
+    return true
+            && mayiuse(sve)
+            && rnn.dt_conf == rnn_utils::all_f32
+            && rnn.is_fwd && !rnn.is_training
+            && rnn.mb <= 16
+            && utils::one_of(cell_kind, alg_kind::vanilla_lstm,
+                    alg_kind::gru_linear_before_reset);
+}
+
+jit_sve_rnn_cell_fwd_kernel::xreg_t jit_sve_rnn_cell_fwd_kernel::reg_goff(
+        int g) const {
+    assert(g > 0 && g < 4);
+    return g == 1 ? reg_goff1 : (g == 2 ? reg_goff2 : reg_goff3);
+}
+
+/* GRU-LBR keeps the iter part of the candidate gate apart, it is scaled by
+ * the reset gate before being added to the layer part. */
+int jit_sve_rnn_cell_fwd_kernel::acc_of_gate(int g, bool is_iter) const {
+    if (cell_kind_ == alg_kind::gru_linear_before_reset && is_iter && g == 2)
+        return 3;
+    return g;
+}
+
+void jit_sve_rnn_cell_fwd_kernel::gemm_body(
+        int nb, int n_gates, int ld_w, bool is_iter, int k_idx) {
+    for (int g = 0; g < n_gates; g++) {
+        if (g == 0)
+            ld1w(ZRegS(w_idx(g)), reg_p_oc / T_z, ptr(reg_w));
+        else
+            ld1w(ZRegS(w_idx(g)), reg_p_oc / T_z,
+                    ptr(reg_w, reg_goff(g), LSL, 2));
+    }
+    add_imm(reg_w, reg_w, ld_w * 4, reg_tmp);
+
+    for (int b = 0; b < nb; b++) {
+        ld1rw(ZRegS(bcast_idx(b)), reg_p_all,
+                ptr(reg_src(b), static_cast<int32_t>(k_idx * 4)));
+        for (int g = 0; g < n_gates; g++)
+            fmla(ZRegS(acc_idx(acc_of_gate(g, is_iter), b)), reg_p_all,
+                    ZRegS(w_idx(g)), ZRegS(bcast_idx(b)));
+    }
+}
+
+/* Accumulates W * states over K for nb rows of the batch. K is known at
+ * generation time, so the remainder of the unrolled loop is emitted
+ * straight-line. */
+void jit_sve_rnn_cell_fwd_kernel::gemm(
+        int nb, int n_gates, int K, int ld_w, bool is_iter) {
+    const int unroll_k = 4;
+    LabelAArch64 k_loop;
+
+    if (K >= unroll_k) {
+        mov_imm(reg_k, K / unroll_k);
+        L_aarch64(k_loop);
+        {
+            for (int k_idx = 0; k_idx < unroll_k; k_idx++)
+                gemm_body(nb, n_gates, ld_w, is_iter, k_idx);
+            for (int b = 0; b < nb; b++)
+                add(reg_src(b), reg_src(b), unroll_k * 4);
+            subs(reg_k, reg_k, 1);
+            b(NE, k_loop);
+        }
+    }
+    for (int k_idx = 0; k_idx < K % unroll_k; k_idx++)
+        gemm_body(nb, n_gates, ld_w, is_iter, k_idx);
+}
+
+void jit_sve_rnn_cell_fwd_kernel::load_exp_table() {
+    /* Same constants as the exp of the SVE eltwise injector */
+    const unsigned int cvals[] = {
+            0x3f317218, // log2 = std::log(2.0f)
+            0x3fb8aa3b, // log2_e = 1.0f / log2
+            0x3f800000, // exp coefficients
+            0x3effff12,
+            0x3e2aaa56,
+            0x3d2b89cc,
+            0x3c091331,
+    };
+    for (int i = 0; i < 7; i++) {
+        mov_imm(reg_tmp, cvals[i]);
+        dup(ZRegS(z_log2.getIdx() + i), WReg(reg_tmp.getIdx()));
+    }
+}
+
+// z = exp(z), destroys z_t1 and z_t2
+void jit_sve_rnn_cell_fwd_kernel::exp(const zreg_t &z) {
+    auto coeff = [&](int i) { return ZRegS(z_one.getIdx() + i); };
+
+    fmul(z, z, z_log2_e);
+    frintn(z_t2, reg_p_all / T_m, z);
+    fcvtzs(z_t1, reg_p_all / T_m, z_t2);
+    fsub(z_t2, z, z_t2);
+    fmul(z_t2, z_t2, z_log2);
+    mov(ZRegD(z.getIdx()), ZRegD(coeff(4).getIdx()));
+    fmad(z, reg_p_all, z_t2, coeff(3));
+    fmad(z, reg_p_all, z_t2, coeff(2));
+    fmad(z, reg_p_all, z_t2, coeff(1));
+    fmad(z, reg_p_all, z_t2, coeff(0));
+    fmad(z, reg_p_all, z_t2, coeff(0));
+    fscale(z, reg_p_all, z_t1);
+}
+
+// z = 1 / (1 + exp(-z))
+void jit_sve_rnn_cell_fwd_kernel::sigmoid(const zreg_t &z) {
+    fneg(z, reg_p_all / T_m, z);
+    exp(z);
+    fadd(z, z, z_one);
+    fdivr(z, reg_p_all, z_one);
+}
+
+// z = 1 - 2 / (1 + exp(2z))
+void jit_sve_rnn_cell_fwd_kernel::tanh(const zreg_t &z) {
+    fadd(z, z, z);
+    exp(z);
+    fadd(z, z, z_one);
+    fdivr(z, reg_p_all, z_one);
+    fadd(z, z, z);
+    fsub(z, z_one, z);
+}
+
+// reg_ptr = (param pointer at param_off) + b rows of the states
+void jit_sve_rnn_cell_fwd_kernel::row_addr(int param_off, int b) {
+    ldr(reg_ptr, ptr(reg_param, param_off));
+    if (b > 0)
+        add_imm(reg_ptr, reg_ptr, b * rnn_.states_ws_ld * 4, reg_tmp);
+}
+
+void jit_sve_rnn_cell_fwd_kernel::compute(int nb) {
+    const bool is_lstm = cell_kind_ == alg_kind::vanilla_lstm;
+
+    /* The accumulators start from the bias, for GRU-LBR the fourth one is
+     * the iter part of the candidate gate with its own bias. */
+    ldr(reg_bias, ptr(reg_param, GET_OFF(bias)));
+    for (int a = 0; a < 4; a++) {
+        if (a == 0)
+            ld1w(ZRegS(acc_idx(a, 0)), reg_p_oc / T_z, ptr(reg_bias));
+        else
+            ld1w(ZRegS(acc_idx(a, 0)), reg_p_oc / T_z,
+                    ptr(reg_bias, reg_goff(a), LSL, 2));
+        for (int b = 1; b < nb; b++)
+            mov(ZRegD(acc_idx(a, b)), ZRegD(acc_idx(a, 0)));
+    }
+
+    ldr(reg_w, ptr(reg_param, GET_OFF(w_layer)));
+    ldr(reg_src(0), ptr(reg_param, GET_OFF(src_layer)));
+    for (int b = 1; b < nb; b++)
+        add_imm(reg_src(b), reg_src(0), b * rnn_.states_ws_ld * 4, reg_tmp);
+    gemm(nb, rnn_.n_gates, rnn_.slc, rnn_.weights_layer_ld, false);
+
+    ldr(reg_w, ptr(reg_param, GET_OFF(w_iter)));
+    ldr(reg_src(0), ptr(reg_param, GET_OFF(src_iter)));
+    for (int b = 1; b < nb; b++)
+        add_imm(reg_src(b), reg_src(0), b * rnn_.states_ws_ld * 4, reg_tmp);
+    gemm(nb, rnn_.n_gates, rnn_.sic, rnn_.weights_iter_ld, true);
+
+    load_exp_table();
+
+    for (int b = 0; b < nb; b++) {
+        const ZRegS G0(acc_idx(0, b)), G1(acc_idx(1, b)), G2(acc_idx(2, b)),
+                G3(acc_idx(3, b));
+        if (is_lstm) {
+            sigmoid(G0);
+            sigmoid(G1);
+            tanh(G2);
+            sigmoid(G3);
+
+            // c_t = f * c_t-1 + i * c~
+            row_addr(GET_OFF(c_tm1), b);
+            ld1w(z_t3, reg_p_oc / T_z, ptr(reg_ptr));
+            fmul(z_t3, z_t3, G1);
+            fmla(z_t3, reg_p_all, G0, G2);
+            row_addr(GET_OFF(c_dst), b);
+            st1w(z_t3, reg_p_oc, ptr(reg_ptr));
+
+            // h_t = o * tanh(c_t)
+            tanh(z_t3);
+            fmul(z_t3, z_t3, G3);
+            row_addr(GET_OFF(dst), b);
+            st1w(z_t3, reg_p_oc, ptr(reg_ptr));
+        } else {
+            sigmoid(G0);
+            sigmoid(G1);
+
+            // n = tanh(Wx x + bx + r * (Wh h + bh))
+            fmla(G2, reg_p_all, G1, G3);
+            tanh(G2);
+
+            // h_t = u * h_t-1 + (1 - u) * n = n + u * (h_t-1 - n)
+            row_addr(GET_OFF(h_tm1), b);
+            ld1w(z_t3, reg_p_oc / T_z, ptr(reg_ptr));
+            fsub(z_t3, z_t3, G2);
+            fmla(G2, reg_p_all, G0, z_t3);
+            row_addr(GET_OFF(dst), b);
+            st1w(G2, reg_p_oc, ptr(reg_ptr));
+        }
+    }
+}
+
+void jit_sve_rnn_cell_fwd_kernel::generate() {
+    LabelAArch64 nb_label[mb_block_], end_label;
+
+    preamble();
+
+    ptrue(reg_p_all.s);
+    ldr(reg_oc_work, ptr(reg_param, GET_OFF(oc_work)));
+    whilelt(reg_p_oc.s, xzr, reg_oc_work);
+
+    mov_imm(reg_goff1, rnn_.dic);
+    mov_imm(reg_goff2, 2 * rnn_.dic);
+    mov_imm(reg_goff3, 3 * rnn_.dic);
+
+    ldr(reg_nb, ptr(reg_param, GET_OFF(nb)));
+    for (int nb = 1; nb < mb_block_; nb++) {
+        cmp(reg_nb, nb);
+        b(EQ, nb_label[nb - 1]);
+    }
+    b(nb_label[mb_block_ - 1]);
+
+    for (int nb = 1; nb <= mb_block_; nb++) {
+        L_aarch64(nb_label[nb - 1]);
+        compute(nb);
+        b(end_label);
+    }
+
+    L_aarch64(end_label);
+    postamble();
+}
+
+}
+}
+}
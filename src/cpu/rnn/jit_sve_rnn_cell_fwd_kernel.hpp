@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_SVE_RNN_CELL_FWD_KERNEL_HPP
+#define JIT_SVE_RNN_CELL_FWD_KERNEL_HPP
+
+#include "c_types_map.hpp"
+
+#include "../jit_generator.hpp"
+#include "../jit_generator_aarch64.hpp"
+#include "rnn_utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Fused forward cell for small batch f32 inference.
+ *
+ * The layer and iter gemms of a cell are accumulated in registers and the
+ * LSTM or GRU-LBR elementwise part is applied before the states are stored,
+ * so ws_gates is never written nor read back.
+ *
+ * One call computes one vector of output channels for up to mb_block_ rows
+ * of the batch. w_layer, w_iter and bias point at the first output channel
+ * of the ldigo weights and of the bias of the cell; src_layer and src_iter
+ * point at the first row of the block in the states workspace, the other
+ * pointers at the first row and output channel of the block. */
+struct jit_sve_rnn_cell_fwd_kernel : public jit_generator_aarch64 {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_sve_rnn_cell_fwd_kernel)
+
+    struct call_params_t {
+        const float *w_layer, *w_iter, *bias;
+        const float *src_layer, *src_iter;
+        const float *h_tm1, *c_tm1;
+        float *dst, *c_dst;
+        size_t nb; // rows of the batch in the block
+        size_t oc_work; // valid output channels in the vector
+    };
+
+    enum { mb_block_ = 4 };
+
+    static bool is_applicable(const rnn_utils::rnn_conf_t &rnn,
+            alg_kind_t cell_kind);
+
+    jit_sve_rnn_cell_fwd_kernel(const rnn_utils::rnn_conf_t &rnn,
+            alg_kind_t cell_kind)
+        : jit_generator_aarch64(nullptr, 64 * 1024)
+        , rnn_(rnn)
+        , cell_kind_(cell_kind) {
+        const code_key_t key = code_key();
+        if (!load_cached_code(&key, sizeof(key)))
+            generate();
+        ready();
+        ker_ = getCode<void (*)(const call_params_t *)>();
+    }
+
+    int simd_w() const { return get_sve_length() / sizeof(float); }
+
+    void (*ker_)(const call_params_t *);
+
+private:
+    using xreg_t = const Xbyak::Xbyak_aarch64::XReg;
+    using preg_t = const Xbyak::Xbyak_aarch64::PReg;
+    using zreg_t = Xbyak::Xbyak_aarch64::ZRegS;
+
+    rnn_utils::rnn_conf_t rnn_;
+    alg_kind_t cell_kind_;
+
+    /* the inputs of generate(), the key of the persistent code cache */
+    struct code_key_t {
+        int cell_kind, n_gates, slc, sic, dic;
+        int states_ws_ld, weights_layer_ld, weights_iter_ld;
+    };
+
+    code_key_t code_key() const {
+        code_key_t key = code_key_t();
+        key.cell_kind = cell_kind_;
+        key.n_gates = rnn_.n_gates;
+        key.slc = rnn_.slc;
+        key.sic = rnn_.sic;
+        key.dic = rnn_.dic;
+        key.states_ws_ld = rnn_.states_ws_ld;
+        key.weights_layer_ld = rnn_.weights_layer_ld;
+        key.weights_iter_ld = rnn_.weights_iter_ld;
+        return key;
+    }
+
+    xreg_t reg_param = x0;
+    xreg_t reg_w = x1;
+    xreg_t reg_bias = x2;
+    xreg_t reg_nb = x3;
+    xreg_t reg_oc_work = x4;
+    xreg_t reg_goff1 = x5;
+    xreg_t reg_goff2 = x6;
+    xreg_t reg_goff3 = x7;
+    xreg_t reg_k = x8;
+    xreg_t reg_ptr = x9;
+    xreg_t reg_tmp = x10;
+
+    preg_t reg_p_all = p0;
+    preg_t reg_p_oc = p1;
+
+    /* z0 - z15 : gate accumulators,
+     * z16 - z19 : weights, z20 - z21 : broadcasts of the states,
+     * after the gemms z16 - z22 hold the exp constants and z23 - z25 are
+     * temporaries of the elementwise part */
+    int acc_idx(int g, int b) const { return g * mb_block_ + b; }
+    int w_idx(int g) const { return 16 + g; }
+    int bcast_idx(int b) const { return 20 + b % 2; }
+    /* x12 - x15 : the rows of the batch in the states */
+    xreg_t reg_src(int b) const { return Xbyak::Xbyak_aarch64::XReg(12 + b); }
+
+    zreg_t z_log2 = zreg_t(16);
+    zreg_t z_log2_e = zreg_t(17);
+    zreg_t z_one = zreg_t(18); // exp coefficients are z18 - z22
+    zreg_t z_t1 = zreg_t(23);
+    zreg_t z_t2 = zreg_t(24);
+    zreg_t z_t3 = zreg_t(25);
+
+    xreg_t reg_goff(int g) const;
+    int acc_of_gate(int g, bool is_iter) const;
+
+    void gemm_body(int nb, int n_gates, int ld_w, bool is_iter, int k_idx);
+    void gemm(int nb, int n_gates, int K, int ld_w, bool is_iter);
+    void load_exp_table();
+    void exp(const zreg_t &z);
+    void sigmoid(const zreg_t &z);
+    void tanh(const zreg_t &z);
+    void row_addr(int param_off, int b);
+    void compute(int nb);
+    void generate();
+};
+
+}
+}
+}
+
+#endif
@@ -53,7 +53,7 @@ template <typename src_data_t, typename acc_data_t>
 
         // Todo: add parallelization on dic for the batch 1 case
         // Assumption: the kernel runs a loop on dic elements
-        parallel_nd(rnn.mb, [&](int i) {
+        parallel_nd_cmg(rnn.mb, [&](int i) {
             void *param1_ = &ws_gates(i, 0, 0); // RNN, LSTM, GRU
             const void *param2_ = &bias(0, 0); // RNN, LSTM, GRU
             void *param3_ = &states_t_l(i, 0); // RNN, LSTM, GRU
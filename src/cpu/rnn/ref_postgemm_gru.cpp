@@ -39,7 +39,7 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::gru_part1_postgemm) {
     ws_states_aoc_t states_t_l(rnn, states_t_l_);
     ws_states_aoc_t states_tm1_l(rnn, states_tm1_l_);
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             ws_gates(i, 0, j) = logistic_fwd(ws_gates(i, 0, j) + bias(0, j));
@@ -56,7 +56,7 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::gru_part2_postgemm) {
     ws_states_aoc_t states_t_l(rnn, states_t_l_);
     ws_states_aoc_t states_tm1_l(rnn, states_tm1_l_);
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             ws_gates(i, 2, j) = tanh_fwd(ws_gates(i, 2, j) + bias(2, j));
@@ -88,7 +88,7 @@ rnn_postgemm_sig(rnn_postgemm_bwd_f32_t::gru_part1_postgemm) {
     // dG2^ = dh * (1 - G0) * (1 - G2^2)
     // dG0^ = dh * (ht-1 - G2) * u * (1 - G0)
     // dht-1 (part) = dh * G0
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             float h = states_tm1_l(i, j);
@@ -123,7 +123,7 @@ rnn_postgemm_sig(rnn_postgemm_bwd_f32_t::gru_part2_postgemm) {
     // dG1^ = d(hG1) * h * G1 * (1 - G1)
     // dht-1 (part) += d(hG1) * G1
     // h * G1 (required for dWh)
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             float h = states_tm1_l(i, j);
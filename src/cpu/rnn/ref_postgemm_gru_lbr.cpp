@@ -41,7 +41,7 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::gru_lbr_postgemm) {
     ws_gates_aoc_t ws_gemm_state(rnn, ws_cell_);
     AOC<float, 2> ws_Wh_b(ws_grid_, rnn.mb, rnn.dic);
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             float Wh_b = ws_gemm_state(i, 2, j) + bias(3, j);
@@ -78,7 +78,7 @@ rnn_postgemm_sig(rnn_postgemm_bwd_f32_t::gru_lbr_postgemm) {
     // dG0 = (dht - G2) * dht * (1 - G0) * G0
     // dG1 = (W*h + b) * dG2 * (1 - G1) * G1
     // dG2 = (1 - G0) * dht * (1 - G2*G2)
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             float h = states_tm1_l(i, j);
@@ -40,7 +40,7 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::lstm_postgemm) {
     ws_states_aoc_t c_states_t_l(rnn, c_states_t_l_);
     ws_states_aoc_t c_states_tm1_l(rnn, c_states_tm1_l_);
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             ws_gates(i, 0, j) = logistic_fwd(ws_gates(i, 0, j) + bias(0, j));
@@ -81,7 +81,7 @@ rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::lstm_postgemm) {
                                                    * data_scale));
     };
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             float G0 = logistic_fwd<float>(
@@ -109,7 +109,7 @@ rnn_postgemm_sig(rnn_postgemm_bwd_f32_t::lstm_postgemm) {
     ws_diff_states_aoc_t diff_states_tp1_l(rnn, diff_states_tp1_l_);
     ws_diff_states_aoc_t diff_states_t_lp1(rnn, diff_states_t_lp1_);
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
             float Ct = c_states_t_l(i, j);
@@ -74,7 +74,7 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::rnn_postgemm) {
     ws_states_aoc_t states_t_l(rnn, states_t_l_);
     ws_states_aoc_t states_tm1_l(rnn, states_tm1_l_);
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         for (int j = 0; j < rnn.dic; j++) {
             const float h
                     = activation_func(0, ws_gates(i, 0, j) + bias(0, j), 0, 0);
@@ -98,7 +98,7 @@ rnn_postgemm_sig(rnn_postgemm_bwd_f32_t::rnn_postgemm) {
     ws_diff_states_aoc_t diff_states_tp1_l(rnn, diff_states_tp1_l_);
     ws_diff_states_aoc_t diff_states_t_lp1(rnn, diff_states_t_lp1_);
 
-    parallel_nd(rnn.mb, [&](int i) {
+    parallel_nd_cmg(rnn.mb, [&](int i) {
         for (int j = 0; j < rnn.dic; ++j) {
             const float dH = diff_states_t_lp1(rnn.n_states, i, j)
                     + diff_states_tp1_l(0, i, j);
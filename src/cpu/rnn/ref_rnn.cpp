@@ -88,19 +88,14 @@ rnn_gemm_sig((_ref_rnn_common_t<aprop, src_type, weights_type>::packed_gemm)) {
             (transB == 'T') ? CblasTrans : CblasNoTrans, m, n, k, a_, ldA, b_,
             ldB, beta, c_, ldC);
 #else
+    assert(transA == 'N' && alpha == 1.0f);
     UNUSED(transA);
-    UNUSED(transB);
-    UNUSED(m);
-    UNUSED(n);
-    UNUSED(k);
     UNUSED(alpha);
     UNUSED(ldA);
-    UNUSED(b_);
-    UNUSED(ldB);
-    UNUSED(beta);
-    UNUSED(c_);
-    UNUSED(ldC);
-    assert(!"packed gemm is disabled");
+    mkldnn_status_t st = sgemm_compute(&transB, &m, &n, &k, a_, b_, &ldB,
+            &beta, c_, &ldC);
+    assert(st == mkldnn_success);
+    UNUSED(st);
 #endif
 }
 
@@ -113,19 +108,14 @@ rnn_gemm_sig((ref_rnn_fwd_u8s8_t::packed_gemm)) {
             CblasNoTrans, CblasFixOffset, m, n, k, alpha, a_, ldA, offseta, b_,
             ldB, offsetb, beta, c_, ldC, &offsetc);
 #else
+    assert(transA == 'N' && alpha == 1.0f);
     UNUSED(transA);
-    UNUSED(transB);
-    UNUSED(m);
-    UNUSED(n);
-    UNUSED(k);
     UNUSED(alpha);
     UNUSED(ldA);
-    UNUSED(b_);
-    UNUSED(ldB);
-    UNUSED(beta);
-    UNUSED(c_);
-    UNUSED(ldC);
-    assert(!"packed gemm is disabled");
+    mkldnn_status_t st = gemm_s8u8s32_compute(&transB, &m, &n, &k, a_, b_,
+            &ldB, &beta, c_, &ldC);
+    assert(st == mkldnn_success);
+    UNUSED(st);
 #endif
 }
 
@@ -225,6 +215,64 @@ rnn_grid_execution_sig(
     }
 }
 
+//*************** Grid computations strategy: wavefront ***************//
+/* Cell (lay, iter) only depends on (lay - 1, iter) and (lay, iter - 1), so
+ * all the cells of a diagonal lay + iter == const, of both directions, are
+ * independent and are computed concurrently. The gemms and post-gemm of a
+ * cell then run on the thread that owns it. */
+template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
+rnn_grid_execution_sig(
+        (_ref_rnn_common_t<aprop, src_type, weights_type>::wavefront_execution)) {
+    assert(aprop == prop_kind::forward && !rnn.merge_gemm_layer);
+    AOC<src_data_t, 4> ws_states(ws_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<float, 4> ws_c_states(ws_c_states_, rnn.n_layer + 1, rnn.n_dir,
+            rnn.n_iter + 1, rnn.states_nld * rnn.states_ws_ld);
+    AOC<float, 5> ws_diff_states(ws_diff_states_, rnn.n_layer + 1, rnn.n_dir,
+            (rnn.n_states + 1), rnn.n_iter + 1,
+            rnn.states_nld * rnn.states_ws_ld);
+    AOC<acc_data_t, 4> ws_gates(ws_gates_, rnn.n_layer, rnn.n_dir, rnn.n_iter,
+            rnn.gates_nld * rnn.gates_ws_ld);
+    AOC<weights_data_t *, 3> weights_input(
+            weights_layer_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_layer);
+    AOC<weights_data_t *, 3> weights_states(
+            weights_states_, rnn.n_layer, rnn.n_dir, rnn.n_parts_weights_iter);
+    AOC<float*, 3> bias(
+        bias_, rnn.n_layer, rnn.n_dir, rnn.n_parts_bias);
+    AOC<float, 4> ws_grid(
+            ws_grid_, rnn.n_layer, rnn.n_dir, rnn.n_iter, (int)rnn.ws_per_cell);
+
+    const int n_diag = rnn.n_layer + rnn.n_iter - 1;
+    for (int diag = 0; diag < n_diag; diag++) {
+        const int lay_s = nstl::max(0, diag - rnn.n_iter + 1);
+        const int lay_e = nstl::min(rnn.n_layer, diag + 1);
+
+        // the few cells of a diagonal go to different CMGs
+        const int n_lay = lay_e - lay_s;
+        parallel_nd_cmg(rnn.n_dir * n_lay, [&](int icell) {
+            const int dir = icell / n_lay;
+            const int lay = lay_s + icell % n_lay;
+            const int iter = diag - lay;
+            (this->*cell_func)(rnn,
+                    &(ws_states(lay + 1, dir, iter + 1, 0)),
+                    &(ws_c_states(lay + 1, dir, iter + 1, 0)),
+                    &(ws_diff_states(lay, dir, 0, iter, 0)),
+                    &(weights_input(lay, dir, 0)),
+                    &(weights_states(lay, dir, 0)),
+                    &(bias(lay, dir, 0)),
+                    &(ws_states(lay, dir, iter + 1, 0)),
+                    &(ws_states(lay + 1, dir, iter, 0)),
+                    &(ws_c_states(lay + 1, dir, iter, 0)),
+                    &(ws_diff_states(lay + 1, dir, 0, iter, 0)),
+                    &(ws_diff_states(lay, dir, 0, iter + 1, 0)),
+                    nullptr, nullptr, nullptr,
+                    &(ws_gates(lay, dir, iter, 0)),
+                    &(ws_grid(lay, dir, iter, 0)),
+                    ws_cell_);
+        });
+    }
+}
+
 //********* GRID computations strategy: utility functions **********//
 
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
@@ -787,6 +835,9 @@ template<> rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru);
 template<> rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_gru_lbr);
 template<> rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution_gru_lbr);
 template<> rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution_gru_lbr);
+#ifdef DNNL_NATIVE_JIT_AARCH64
+template<> rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution_fused);
+#endif
 
 template struct _ref_rnn_common_t<prop_kind::forward, data_type::f32, data_type::f32>;
 template struct _ref_rnn_common_t<prop_kind::forward, data_type::u8, data_type::s8>;
@@ -30,6 +30,9 @@
 #include "cpu_rnn_pd.hpp"
 #include "rnn_utils.hpp"
 #include "jit_uni_rnn_common_postgemm_dispatcher.hpp"
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "jit_sve_rnn_cell_fwd_kernel.hpp"
+#endif
 
 namespace mkldnn {
 namespace impl {
@@ -64,7 +67,7 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
         pd_t(engine_t *engine, const rnn_desc_t *adesc,
                 const primitive_attr_t *attr,
                 const typename pd_t::hint_class *hint_pd)
-            : base_pd_t(engine, adesc, attr, hint_pd) {}
+            : base_pd_t(engine, adesc, attr, hint_pd), rnn_() {}
 
         DECLARE_COMMON_PD_T("ref:any", class_name);
 
@@ -105,6 +108,11 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
             if (rnn_.dt_conf == all_f32)
                 ok = ok && this->attr()->has_default_values();
 
+            /* int8 is computed by the packed gemm only */
+            if (rnn_.dt_conf != all_f32 && !(rnn_.use_layer_packed_gemm
+                        && rnn_.use_iter_packed_gemm))
+                return status::unimplemented;
+
             // Set weights descriptors to desired format
             memory_desc_t weights_layer_md = *(this->weights_layer_pd_.desc());
             CHECK(set_expected_desc(rnn_, weights_layer_md, false));
@@ -211,7 +219,15 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
         default: break;
         }
 
-        grid_computation = &class_name::linear_execution;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+        fused_cell_ = nullptr;
+        if (pd()->rnn_.use_fused_cell)
+            init_fused_cell();
+#endif
+
+        grid_computation = pd()->rnn_.use_wavefront
+                ? &class_name::wavefront_execution
+                : &class_name::linear_execution;
 
         size_t scratchpad_size, workspace_size;
         rnn_utils::set_offsets(pd()->rnn_, ws_gates_offset_, ws_states_offset_,
@@ -222,6 +238,9 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
 
     ~_ref_rnn_common_t() {
         delete rnn_postgemm_;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+        delete fused_cell_;
+#endif
     }
 
     // typedef typename prec_traits::type data_t;
@@ -234,9 +253,29 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
 private:
     void execute_() const;
     rnn_grid_execution_sig(linear_execution);
+    rnn_grid_execution_sig(wavefront_execution);
     rnn_cell_execution_sig(cell_execution);
     rnn_cell_execution_sig(cell_execution_gru);
     rnn_cell_execution_sig(cell_execution_gru_lbr);
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    /* the fused cell is only implemented for the f32 forward, which is the
+     * only instantiation that references it */
+    rnn_cell_execution_sig(cell_execution_fused);
+
+    template <bool fused = aprop == prop_kind::forward
+            && src_type == data_type::f32>
+    typename utils::enable_if<fused>::type init_fused_cell() {
+        fused_cell_ = new jit_sve_rnn_cell_fwd_kernel(
+                pd()->rnn_, pd()->cell_kind());
+        cell_func = &class_name::cell_execution_fused;
+    }
+
+    template <bool fused = aprop == prop_kind::forward
+            && src_type == data_type::f32>
+    typename utils::enable_if<!fused>::type init_fused_cell() {
+        assert(!"the fused cell is f32 forward only");
+    }
+#endif
     rnn_gemm_sig(gemm);
     rnn_gemm_sig(packed_gemm);
     rnn_bias_prepare_sig(bias_prepare);
@@ -280,6 +319,9 @@ private:
     size_t ws_grid_comp_offset_;
     size_t ws_cell_comp_offset_;
     rnn_postgemm_dispatcher<aprop,src_type> *rnn_postgemm_;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    jit_sve_rnn_cell_fwd_kernel *fused_cell_;
+#endif
 
     grid_execution_f grid_computation;
     cell_execution_f cell_func;
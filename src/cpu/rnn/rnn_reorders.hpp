@@ -25,6 +25,7 @@
 #include "simple_q10n.hpp"
 #include "cpu_reorder_pd.hpp"
 #include "../gemm/os_blas.hpp"
+#include "../gemm/gemm.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -105,7 +106,8 @@ struct rnn_weights_reorder_t : public cpu_primitive_t {
                 const memory_pd_t *input_pd, const memory_pd_t *output_pd,
                 const primitive_attr_t *attr) {
 #if !USE_MKL_PACKED_GEMM
-            return status::unimplemented;
+            if (!pack_gemm_available(data_type::s8))
+                return status::unimplemented;
 #endif
             using namespace memory_format;
             assert(input_pd->engine()->kind() == engine_kind::cpu);
@@ -171,7 +173,6 @@ private:
         : cpu_primitive_t(apd, inputs, outputs) {}
 
     virtual void execute(event_t *e) const {
-#if USE_MKL_PACKED_GEMM
         auto input = reinterpret_cast<const in_data_t *>(input_memory(0));
         auto output = reinterpret_cast<char *>(memory());
         const memory_desc_wrapper &input_d = pd()->input_pd();
@@ -270,16 +271,24 @@ private:
                     int g = (p > 0) ? parts[p - 1] : 0;
                     int m_p = parts[p] * O;
                     int k_p = I;
+#if USE_MKL_PACKED_GEMM
                     cblas_gemm_s8u8s32_pack(CblasColMajor, CblasAMatrix,
                             is_igo ? CblasNoTrans : CblasTrans, m_p, n, k_p,
                             &quantized[is_igo ? off_igo(l, d, 0, g, 0) :
                                                 off_goi(l, d, g, 0, 0)],
                             is_igo ? G * O : I, to_pack);
+#else
+                    const char trans = is_igo ? 'N' : 'T';
+                    const int ld = is_igo ? G * O : I;
+                    gemm_s8u8s32_pack(&trans, &m_p, &n, &k_p,
+                            &quantized[is_igo ? off_igo(l, d, 0, g, 0) :
+                                                off_goi(l, d, g, 0, 0)],
+                            &ld, to_pack);
+#endif
                     to_pack += size_packed_cell[p];
                 }
             }
         }
-#endif
         e->set_state(event_t::ready);
     }
 
@@ -300,7 +309,8 @@ struct rnn_weights_reorder_t<data_type::f32, data_type::f32>
                 const memory_pd_t *input_pd, const memory_pd_t *output_pd,
                 const primitive_attr_t *attr) {
 #if !USE_MKL_PACKED_GEMM
-            return status::unimplemented;
+            if (!pack_gemm_available(data_type::f32))
+                return status::unimplemented;
 #endif
             using namespace memory_format;
             using namespace data_type;
@@ -336,7 +346,6 @@ private:
         : cpu_primitive_t(apd, inputs, outputs) {}
 
     virtual void execute(event_t *e) const {
-#if USE_MKL_PACKED_GEMM
         auto input = reinterpret_cast<const float *>(input_memory(0));
         auto output = reinterpret_cast<float *>(memory());
         const memory_desc_wrapper &input_d = pd()->input_pd();
@@ -354,7 +363,11 @@ private:
                         && rnn_pdata.format == mkldnn_ldgoi_p)
                 || (input_d.format() == memory_format::ldgoi
                         && rnn_pdata.format == mkldnn_ldigo_p);
+#if USE_MKL_PACKED_GEMM
         auto trans = cross_case ? CblasTrans : CblasNoTrans;
+#else
+        const char trans = cross_case ? 'T' : 'N';
+#endif
         int n_parts = rnn_pdata.n_parts;
         const size_t *size_packed_cell = rnn_pdata.part_pack_size;
         const int *parts = rnn_pdata.parts;
@@ -374,16 +387,22 @@ private:
                     int m_p = is_igo ? parts[p] * O : I;
                     int k_p = is_igo ? I : parts[p] * O;
                     int ld = is_igo ? G * O : I;
+#if USE_MKL_PACKED_GEMM
                     cblas_sgemm_pack(CblasColMajor, CblasAMatrix, trans, m_p, n,
                             k_p, 1.0f, &input[is_igo ? off_igo(l, d, 0, g, 0) :
                                                        off_goi(l, d, 0, g, 0)],
                             ld, output);
+#else
+                    sgemm_pack(&trans, &m_p, &n, &k_p,
+                            &input[is_igo ? off_igo(l, d, 0, g, 0) :
+                                            off_goi(l, d, 0, g, 0)],
+                            &ld, output);
+#endif
                     output += size_packed_cell[p] / sizeof(float);
                 }
             }
         }
         e->set_state(event_t::ready);
-#endif
     }
 
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
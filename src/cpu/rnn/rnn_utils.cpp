@@ -22,6 +22,11 @@
 #include "rnn_utils.hpp"
 #include "type_helpers.hpp"
 
+#include "../gemm/gemm.hpp"
+#ifdef DNNL_NATIVE_JIT_AARCH64
+#include "jit_sve_rnn_cell_fwd_kernel.hpp"
+#endif
+
 namespace mkldnn {
 namespace impl {
 namespace cpu {
@@ -32,6 +37,17 @@ using namespace memory_format;
 using namespace rnn_packed_format;
 using namespace data_type;
 
+namespace {
+/* The wavefront schedule is opt-in: MKLDNN_RNN_WAVEFRONT=1. It is read at
+ * every primitive descriptor creation, so it can be switched per primitive */
+bool wavefront_enabled() {
+    const int len = 2;
+    char env[len] = {0};
+    return mkldnn_getenv("MKLDNN_RNN_WAVEFRONT", env, len) == 1
+        && env[0] == '1';
+}
+}
+
 void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
         const memory_desc_wrapper &src_layer_d,
         const memory_desc_wrapper &src_iter_d,
@@ -105,12 +121,35 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     bool is_gru = utils::one_of(rd.cell_desc.cell_kind, alg_kind::vanilla_gru,
             alg_kind::gru_linear_before_reset);
     rnn.merge_gemm_iter = !(rnn.is_fwd || is_gru) || is_int8;
+
+    /* With small batches a single cell cannot keep all the cores busy, so
+     * the cells of a layer x time diagonal are run concurrently instead.
+     * A layer then only starts an iteration once the layer below is done
+     * with it, so its gemm cannot be merged across iterations.
+     * lbr cells share ws_cell and are kept on the linear grid. */
+    rnn.use_wavefront = wavefront_enabled() && rnn.is_fwd && !rnn.is_lbr
+            && rnn.n_layer > 1 && rnn.n_iter > 1 && rnn.mb <= 8
+            && mkldnn_get_max_threads() > 1;
+    if (rnn.use_wavefront)
+        rnn.merge_gemm_layer = false;
     bool is_inference = !rnn.is_training;
 
     rnn.use_jit_gemm = !mayiuse(avx512_mic)
             && ((is_inference && (rnn.n_layer > 1 || rnn.mb < 100))
                 || (rnn.is_training && rnn.dic < 500));
 
+    /* Small batch inference computes a whole cell in one kernel that reads
+     * the plain ldigo weights, so the layer gemm is done per iteration */
+    rnn.use_fused_cell = false;
+#ifdef DNNL_NATIVE_JIT_AARCH64
+    rnn.use_fused_cell = jit_sve_rnn_cell_fwd_kernel::is_applicable(
+                                 rnn, rd.cell_desc.cell_kind)
+            && utils::one_of(weights_layer_d.format(), any, ldigo)
+            && utils::one_of(weights_iter_d.format(), any, ldigo);
+    if (rnn.use_fused_cell)
+        rnn.merge_gemm_layer = false;
+#endif
+
     /* Decide to copy bias */
     rnn.copy_bias = rnn.dt_conf != all_f32;
 
@@ -125,10 +164,25 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
            && is_inference && rnn.mb >= 16)
         || is_int8;
 #else
-    rnn.use_layer_packed_gemm = false;
-    rnn.use_iter_packed_gemm = false;
+    /* The library packed gemm has no cblas fallback, so it is only used when
+     * the jit gemm of the running isa can consume the packed weights */
+    bool pack_ok = pack_gemm_available(
+            is_int8 ? data_type::s8 : data_type::f32);
+    rnn.use_layer_packed_gemm = pack_ok
+        && ((utils::one_of(weights_layer_d.format(), any, rnn_packed)
+            && is_inference && rnn.n_iter == 1)
+            || is_int8);
+    rnn.use_iter_packed_gemm = pack_ok
+        && ((utils::one_of(weights_iter_d.format(), any, rnn_packed)
+            && is_inference && rnn.mb >= 16)
+            || is_int8);
 #endif
 
+    if (rnn.use_fused_cell) {
+        rnn.use_layer_packed_gemm = false;
+        rnn.use_iter_packed_gemm = false;
+    }
+
     /* Set packed gemm sizes */
     if (rnn.use_layer_packed_gemm) {
         rnn.weights_layer_pack_size = 0;
@@ -150,10 +204,12 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                         = cblas_gemm_s8u8s32_pack_get_size(
                                 CblasAMatrix, m_p, n_p, k_p);
 #else
-            UNUSED(m_p);
-            UNUSED(k_p);
-            UNUSED(n_p);
-            rnn.part_weights_layer_pack_size[p] = 0;
+            if (rnn.dt_conf == all_f32)
+                rnn.part_weights_layer_pack_size[p]
+                        = sgemm_pack_get_size(&m_p, &n_p, &k_p);
+            else
+                rnn.part_weights_layer_pack_size[p]
+                        = gemm_s8u8s32_pack_get_size(&m_p, &n_p, &k_p);
 #endif
             rnn.weights_layer_pack_size += rnn.n_layer * rnn.n_dir
                     * rnn.part_weights_layer_pack_size[p];
@@ -181,10 +237,12 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                         = cblas_gemm_s8u8s32_pack_get_size(
                                 CblasAMatrix, m_p, n_p, k_p);
 #else
-            UNUSED(m_p);
-            UNUSED(k_p);
-            UNUSED(n_p);
-            rnn.part_weights_iter_pack_size[p] = 0;
+            if (rnn.dt_conf == all_f32)
+                rnn.part_weights_iter_pack_size[p]
+                        = sgemm_pack_get_size(&m_p, &n_p, &k_p);
+            else
+                rnn.part_weights_iter_pack_size[p]
+                        = gemm_s8u8s32_pack_get_size(&m_p, &n_p, &k_p);
 #endif
             rnn.weights_iter_pack_size += rnn.n_layer * rnn.n_dir
                     * rnn.part_weights_iter_pack_size[p];
@@ -124,7 +124,7 @@ struct rnn_conf_t {
     size_t ws_gates_size, ws_states_size, ws_c_states_size, ws_diff_states_size,
             ws_cell_comp_size, ws_grid_comp_size, ws_per_cell, ws_bias_size;
     bool merge_gemm_iter, merge_gemm_layer, use_jit_gemm, use_layer_packed_gemm,
-        use_iter_packed_gemm;
+        use_iter_packed_gemm, use_wavefront, use_fused_cell;
     memory_format_t weights_layer_fmt, weights_iter_fmt, diff_weights_layer_fmt,
             diff_weights_iter_fmt;
 };
@@ -103,7 +103,11 @@ INST_TEST_CASE(Simple_Dilated_NCHW,
     PARAMS(nchw, oihw, FMT_BIAS, nchw,
         2, 1, 8, 8, 8, 8, 3, 8, 3, 3, 1, 1, 2, 1, 1, 0),
     PARAMS(nchw, oihw, FMT_BIAS, nchw,
-        2, 1, 8, 8, 8, 8, 8, 2, 3, 3, 1, 1, 1, 3, 0, 2)
+        2, 1, 8, 8, 8, 8, 8, 2, 3, 3, 1, 1, 1, 3, 0, 2),
+    PARAMS(nchw, oihw, FMT_BIAS, nchw,
+        2, 1, 64, 35, 35, 24, 17, 17, 3, 3, 0, 0, 2, 2, 0, 0),
+    PARAMS(nchw, oihw, FMT_BIAS, nchw,
+        2, 1, 64, 35, 35, 24, 16, 16, 3, 3, 0, 0, 2, 2, 1, 1)
 );
 
 INST_TEST_CASE(Simple_Blocked,
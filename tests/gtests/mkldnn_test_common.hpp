@@ -239,6 +239,21 @@ void check_zero_tail(int set_zero_flag, mkldnn::memory &src) {
     }
 }
 
+/* Reference of the binary primitive and of the binary post-op */
+template <typename data_t>
+inline data_t compute_binary_scalar(mkldnn::algorithm alg, data_t x,
+        data_t y) {
+    using mkldnn::algorithm;
+    switch (alg) {
+    case algorithm::binary_add: return x + y;
+    case algorithm::binary_mul: return x * y;
+    case algorithm::binary_max: return x > y ? x : y;
+    case algorithm::binary_min: return x < y ? x : y;
+    default: assert(!"unknown alg_kind");
+    }
+    return data_t(0);
+}
+
 inline mkldnn::memory::desc create_md(mkldnn::memory::dims dims,
         mkldnn::memory::data_type data_type, mkldnn::memory::format fmt) {
     using f = mkldnn::memory::format;
@@ -0,0 +1,185 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct binary_test_params {
+    algorithm alg;
+    memory::dims src0_dims;
+    memory::dims src1_dims;
+    memory::format src0_format;
+    memory::format src1_format;
+    bool expect_to_fail;
+    mkldnn_status_t expected_status;
+};
+
+template <typename data_t>
+void check_binary(const binary_test_params &p, memory &src0, memory &src1,
+        memory &dst) {
+    const data_t *src0_data = (data_t *)src0.get_data_handle();
+    const data_t *src1_data = (data_t *)src1.get_data_handle();
+    const data_t *dst_data = (data_t *)dst.get_data_handle();
+
+    const memory::desc src0_d = src0.get_primitive_desc().desc();
+    const memory::desc src1_d = src1.get_primitive_desc().desc();
+    const memory::desc dst_d = dst.get_primitive_desc().desc();
+
+    const int nd = (int)p.src0_dims.size();
+    ptrdiff_t nelems = 1;
+    for (int d = 0; d < nd; ++d) nelems *= p.src0_dims[d];
+
+    mkldnn::impl::parallel_nd(nelems, [&](ptrdiff_t e) {
+        /* logical offset of the broadcast element of src1 */
+        ptrdiff_t off1 = 0, stride0 = 1, stride1 = 1;
+        for (int d = nd - 1; d >= 0; --d) {
+            const ptrdiff_t pos = (e / stride0) % p.src0_dims[d];
+            if (p.src1_dims[d] != 1) off1 += pos * stride1;
+            stride0 *= p.src0_dims[d];
+            stride1 *= p.src1_dims[d];
+        }
+
+        const data_t ref = compute_binary_scalar(p.alg,
+                src0_data[map_index(src0_d, e)],
+                src1_data[map_index(src1_d, off1)]);
+        const data_t out = dst_data[map_index(dst_d, e)];
+        EXPECT_NEAR(out, ref, 1e-6 * (1 + fabs(ref)));
+    });
+}
+
+template <typename data_t>
+class binary_test : public ::testing::TestWithParam<binary_test_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<binary_test_params>::GetParam();
+        catch_expected_failures([=](){Test();}, p.expect_to_fail,
+                    p.expected_status);
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<binary_test_params>::GetParam();
+
+        auto eng = engine(engine::kind::cpu, 0);
+        memory::data_type data_type = data_traits<data_t>::data_type;
+        ASSERT_EQ(data_type, mkldnn::memory::data_type::f32);
+
+        auto src0_desc = create_md(p.src0_dims, data_type, p.src0_format);
+        auto src1_desc = create_md(p.src1_dims, data_type, p.src1_format);
+
+        auto binary_desc = binary::desc(p.alg, src0_desc, src1_desc);
+        auto binary_pd = binary::primitive_desc(binary_desc, eng);
+
+        memory src0(binary_pd.src0_primitive_desc());
+        memory src1(binary_pd.src1_primitive_desc());
+        memory dst(binary_pd.dst_primitive_desc());
+
+        fill_data<data_t>(src0.get_primitive_desc().get_size()
+                / sizeof(data_t), (data_t *)src0.get_data_handle(),
+                data_t(0), data_t(2));
+        fill_data<data_t>(src1.get_primitive_desc().get_size()
+                / sizeof(data_t), (data_t *)src1.get_data_handle(),
+                data_t(0), data_t(1));
+        check_zero_tail<data_t>(1, src0);
+
+        std::vector<primitive> pipeline;
+        pipeline.push_back(binary(binary_pd, src0, src1, dst));
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        check_binary<data_t>(p, src0, src1, dst);
+    }
+};
+
+using binary_test_float = binary_test<float>;
+
+TEST_P(binary_test_float, TestsBinary)
+{
+}
+
+#define FMT(f) memory::format::f
+#define ALG(a) algorithm::binary_##a
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinary, binary_test_float,
+        ::testing::Values(
+                binary_test_params{ ALG(add), { 2, 16, 5, 7 },
+                        { 2, 16, 5, 7 }, FMT(nchw), FMT(any) },
+                binary_test_params{ ALG(mul), { 100 }, { 100 }, FMT(x),
+                        FMT(x) },
+                binary_test_params{ ALG(max), { 2, 37 }, { 1, 37 }, FMT(nc),
+                        FMT(any) },
+                binary_test_params{ ALG(min), { 2, 37 }, { 2, 1 }, FMT(nc),
+                        FMT(any) },
+                binary_test_params{ ALG(add), { 2, 3, 4, 5 },
+                        { 1, 1, 1, 1 }, FMT(nchw), FMT(any) },
+                binary_test_params{ ALG(add), { 2, 3, 4, 5 },
+                        { 2, 3, 4, 5 }, FMT(nchw), FMT(nhwc) }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryPerChannel, binary_test_float,
+        ::testing::Values(
+                binary_test_params{ ALG(mul), { 2, 64, 7, 7 },
+                        { 2, 64, 1, 1 }, FMT(nchw), FMT(any) },
+                binary_test_params{ ALG(mul), { 2, 64, 7, 7 },
+                        { 1, 64, 1, 1 }, FMT(nhwc), FMT(any) },
+                binary_test_params{ ALG(add), { 3, 17, 5, 6 },
+                        { 1, 17, 1, 1 }, FMT(nhwc), FMT(nchw) },
+                binary_test_params{ ALG(mul), { 2, 32, 7, 7 },
+                        { 2, 32, 1, 1 }, FMT(nChw16c), FMT(any) },
+                binary_test_params{ ALG(max), { 2, 17, 3, 3 },
+                        { 1, 17, 1, 1 }, FMT(nChw16c), FMT(any) },
+                binary_test_params{ ALG(add), { 2, 20, 2, 3, 4 },
+                        { 2, 20, 1, 1, 1 }, FMT(nCdhw16c), FMT(any) },
+                binary_test_params{ ALG(min), { 2, 24, 3, 3 },
+                        { 1, 24, 1, 1 }, FMT(nChw8c), FMT(any) },
+                binary_test_params{ ALG(add), { 2, 20, 2, 3, 4 },
+                        { 1, 20, 1, 1, 1 }, FMT(ncdhw), FMT(any) }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryBroadcast, binary_test_float,
+        ::testing::Values(
+                binary_test_params{ ALG(add), { 2, 4, 16, 16 },
+                        { 2, 1, 1, 16 }, FMT(nchw), FMT(any) },
+                binary_test_params{ ALG(add), { 2, 4, 16, 16 },
+                        { 1, 1, 16, 16 }, FMT(nchw), FMT(any) },
+                binary_test_params{ ALG(mul), { 8, 100, 3 }, { 1, 100, 1 },
+                        FMT(ncw), FMT(any) },
+                binary_test_params{ ALG(mul), { 8, 100, 3 }, { 8, 1, 3 },
+                        FMT(nwc), FMT(any) },
+                binary_test_params{ ALG(add), { 2, 32, 4, 4 },
+                        { 1, 1, 1, 1 }, FMT(nChw16c), FMT(any) }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryEF, binary_test_float,
+        ::testing::Values(
+                binary_test_params{ ALG(add), { 2, 16 }, { 2, 8 }, FMT(nc),
+                        FMT(any), true, mkldnn_invalid_arguments },
+                binary_test_params{ ALG(add), { 2, 16 }, { 16 }, FMT(nc),
+                        FMT(x), true, mkldnn_invalid_arguments },
+                binary_test_params{ algorithm::eltwise_relu, { 2, 16 },
+                        { 2, 16 }, FMT(nc), FMT(any), true,
+                        mkldnn_invalid_arguments }));
+
+#undef ALG
+#undef FMT
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,251 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+enum binary_po_bcast { per_tensor, per_oc, full };
+enum binary_po_prim { conv_3x3, conv_1x1, ip, matmul_2d };
+
+struct binary_po_test_params {
+    binary_po_prim prim;
+    algorithm alg;
+    binary_po_bcast bcast;
+    memory::format src1_format;
+    bool expect_to_fail;
+    mkldnn_status_t expected_status;
+};
+
+/* The primitive with the binary post-op is checked against the same
+ * primitive without post-ops followed by the binary operation. */
+template <typename data_t>
+class binary_po_test : public ::testing::TestWithParam<binary_po_test_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<binary_po_test_params>::GetParam();
+        catch_expected_failures([=](){Test();}, p.expect_to_fail,
+                    p.expected_status);
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<binary_po_test_params>::GetParam();
+        const bool conv = p.prim == conv_3x3 || p.prim == conv_1x1;
+        const int KS = p.prim == conv_1x1 ? 1 : 3;
+
+        auto eng = engine(engine::kind::cpu, 0);
+        memory::data_type data_type = data_traits<data_t>::data_type;
+        ASSERT_EQ(data_type, mkldnn::memory::data_type::f32);
+
+        /* the 1x1 case spans several load blocks of the jit kernel; for
+         * matmul MB and OC are the rows and the columns of dst */
+        const int MB = 2, IC = 16, H = 7, W = 7;
+        const int OC = p.prim == conv_1x1 ? 128 : 32;
+        memory::dims src_dims = conv
+            ? memory::dims{ MB, IC, H, W } : memory::dims{ MB, IC };
+        memory::dims wei_dims = conv
+            ? memory::dims{ OC, IC, KS, KS }
+            : p.prim == matmul_2d ? memory::dims{ IC, OC }
+            : memory::dims{ OC, IC };
+        memory::dims dst_dims = conv
+            ? memory::dims{ MB, OC, H, W } : memory::dims{ MB, OC };
+
+        memory::dims src1_dims(dst_dims.size(), 1);
+        if (p.bcast == per_oc) src1_dims[1] = OC;
+        if (p.bcast == full) src1_dims = dst_dims;
+
+        auto src_md = create_md(src_dims, data_type, memory::format::any);
+        auto wei_md = create_md(wei_dims, data_type, memory::format::any);
+        auto bia_md = p.prim == matmul_2d
+            ? create_md({ 1, OC }, data_type, memory::format::nc)
+            : create_md({ OC }, data_type, memory::format::x);
+        auto dst_md = create_md(dst_dims, data_type,
+                p.bcast == full ? p.src1_format : memory::format::any);
+        auto src1_md = create_md(src1_dims, data_type, p.src1_format);
+
+        post_ops ops;
+        ops.append_binary(p.alg, src1_md.data);
+        primitive_attr attr;
+        attr.set_post_ops(ops);
+
+        memory::dims strides = { 1, 1 }, padding = { KS / 2, KS / 2 };
+        auto make_conv_pd = [&](const memory::desc &s, const memory::desc &w,
+                const memory::desc &d, const primitive_attr &a) {
+            auto cd = convolution_forward::desc(prop_kind::forward_inference,
+                    algorithm::convolution_direct, s, w, bia_md, d, strides,
+                    padding, padding, padding_kind::zero);
+            return convolution_forward::primitive_desc(cd, a, eng);
+        };
+        auto make_ip_pd = [&](const memory::desc &s, const memory::desc &w,
+                const memory::desc &d, const primitive_attr &a) {
+            auto ipd = inner_product_forward::desc(
+                    prop_kind::forward_inference, s, w, bia_md, d);
+            return inner_product_forward::primitive_desc(ipd, a, eng);
+        };
+        auto make_mm_pd = [&](const memory::desc &s, const memory::desc &w,
+                const memory::desc &d, const primitive_attr &a) {
+            auto mmd = matmul::desc(s, w, bia_md, d);
+            return matmul::primitive_desc(mmd, a, eng);
+        };
+
+        std::shared_ptr<memory> src, wei, bia, dst, dst_ref;
+        memory src1(memory::primitive_desc(src1_md, eng));
+        std::vector<primitive> pipeline;
+        if (conv) {
+            auto pd = make_conv_pd(src_md, wei_md, dst_md, attr);
+            auto ref_pd = make_conv_pd(pd.src_primitive_desc().desc(),
+                    pd.weights_primitive_desc().desc(),
+                    pd.dst_primitive_desc().desc(), primitive_attr());
+            src.reset(new memory(pd.src_primitive_desc()));
+            wei.reset(new memory(pd.weights_primitive_desc()));
+            bia.reset(new memory(pd.bias_primitive_desc()));
+            dst.reset(new memory(pd.dst_primitive_desc()));
+            dst_ref.reset(new memory(ref_pd.dst_primitive_desc()));
+            pipeline.push_back(convolution_forward(pd,
+                        { *src, *wei, *bia, src1 }, *dst));
+            pipeline.push_back(convolution_forward(ref_pd, *src, *wei, *bia,
+                        *dst_ref));
+        } else if (p.prim == matmul_2d) {
+            auto pd = make_mm_pd(src_md, wei_md, dst_md, attr);
+            auto ref_pd = make_mm_pd(pd.src_primitive_desc().desc(),
+                    pd.weights_primitive_desc().desc(),
+                    pd.dst_primitive_desc().desc(), primitive_attr());
+            src.reset(new memory(pd.src_primitive_desc()));
+            wei.reset(new memory(pd.weights_primitive_desc()));
+            bia.reset(new memory(pd.bias_primitive_desc()));
+            dst.reset(new memory(pd.dst_primitive_desc()));
+            dst_ref.reset(new memory(ref_pd.dst_primitive_desc()));
+            pipeline.push_back(matmul(pd, { *src, *wei, *bia, src1 }, *dst));
+            pipeline.push_back(matmul(ref_pd, *src, *wei, *bia, *dst_ref));
+        } else {
+            auto pd = make_ip_pd(src_md, wei_md, dst_md, attr);
+            auto ref_pd = make_ip_pd(pd.src_primitive_desc().desc(),
+                    pd.weights_primitive_desc().desc(),
+                    pd.dst_primitive_desc().desc(), primitive_attr());
+            src.reset(new memory(pd.src_primitive_desc()));
+            wei.reset(new memory(pd.weights_primitive_desc()));
+            bia.reset(new memory(pd.bias_primitive_desc()));
+            dst.reset(new memory(pd.dst_primitive_desc()));
+            dst_ref.reset(new memory(ref_pd.dst_primitive_desc()));
+            pipeline.push_back(inner_product_forward(pd,
+                        { *src, *wei, *bia, src1 }, *dst));
+            pipeline.push_back(inner_product_forward(ref_pd, *src, *wei,
+                        *bia, *dst_ref));
+        }
+
+        auto fill = [](memory &m, data_t mean, data_t var) {
+            fill_data<data_t>(m.get_primitive_desc().get_size()
+                    / sizeof(data_t), (data_t *)m.get_data_handle(),
+                    mean, var);
+        };
+        fill(*src, data_t(0), data_t(1));
+        fill(*wei, data_t(0), data_t(1));
+        fill(*bia, data_t(0), data_t(1));
+        fill(src1, data_t(1), data_t(1));
+
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        const data_t *dst_data = (data_t *)dst->get_data_handle();
+        const data_t *ref_data = (data_t *)dst_ref->get_data_handle();
+        const data_t *src1_data = (data_t *)src1.get_data_handle();
+        const memory::desc dst_d = dst->get_primitive_desc().desc();
+        const memory::desc ref_d = dst_ref->get_primitive_desc().desc();
+
+        const ptrdiff_t spatial = conv ? H * W : 1;
+        const ptrdiff_t nelems = MB * OC * spatial;
+        mkldnn::impl::parallel_nd(nelems, [&](ptrdiff_t e) {
+            const ptrdiff_t oc = (e / spatial) % OC;
+            const ptrdiff_t off1 = p.bcast == per_tensor ? 0
+                : p.bcast == per_oc ? oc : e;
+            const data_t ref = compute_binary_scalar(p.alg,
+                    ref_data[map_index(ref_d, e)],
+                    src1_data[map_index(src1_md, off1)]);
+            const data_t out = dst_data[map_index(dst_d, e)];
+            EXPECT_NEAR(out, ref, 1e-5 * (1 + fabs(ref)));
+        });
+    }
+};
+
+using binary_po_test_float = binary_po_test<float>;
+
+TEST_P(binary_po_test_float, TestsBinaryPostOp)
+{
+}
+
+#define CONV conv_3x3
+#define CONV1X1 conv_1x1
+#define IP ip
+#define MATMUL matmul_2d
+#define FMT(f) memory::format::f
+#define ALG(a) algorithm::binary_##a
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryPostOpConvolution, binary_po_test_float,
+        ::testing::Values(
+                binary_po_test_params{ CONV, ALG(mul), per_oc, FMT(nchw) },
+                binary_po_test_params{ CONV, ALG(add), per_tensor,
+                        FMT(nchw) },
+                binary_po_test_params{ CONV, ALG(max), per_oc, FMT(nchw) },
+                binary_po_test_params{ CONV, ALG(add), full, FMT(nchw) }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryPostOpConvolution1x1, binary_po_test_float,
+        ::testing::Values(
+                binary_po_test_params{ CONV1X1, ALG(mul), per_oc, FMT(nchw) },
+                binary_po_test_params{ CONV1X1, ALG(add), per_oc, FMT(nchw) },
+                binary_po_test_params{ CONV1X1, ALG(add), per_tensor,
+                        FMT(nchw) },
+                binary_po_test_params{ CONV1X1, ALG(min), per_tensor,
+                        FMT(nchw) }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryPostOpInnerProduct, binary_po_test_float,
+        ::testing::Values(
+                binary_po_test_params{ IP, ALG(mul), per_oc, FMT(nc) },
+                binary_po_test_params{ IP, ALG(add), per_tensor, FMT(nc) },
+                binary_po_test_params{ IP, ALG(min), per_oc, FMT(nc) },
+                binary_po_test_params{ IP, ALG(add), full, FMT(nc) }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryPostOpMatMul, binary_po_test_float,
+        ::testing::Values(
+                binary_po_test_params{ MATMUL, ALG(add), per_oc, FMT(nc) },
+                binary_po_test_params{ MATMUL, ALG(mul), per_tensor,
+                        FMT(nc) },
+                binary_po_test_params{ MATMUL, ALG(max), full, FMT(nc) }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestBinaryPostOpEF, binary_po_test_float,
+        ::testing::Values(
+                binary_po_test_params{ IP, ALG(add), per_oc, FMT(any), true,
+                        mkldnn_invalid_arguments },
+                binary_po_test_params{ IP, algorithm::eltwise_relu, per_oc,
+                        FMT(nc), true, mkldnn_invalid_arguments }));
+
+#undef ALG
+#undef FMT
+#undef MATMUL
+#undef IP
+#undef CONV1X1
+#undef CONV
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
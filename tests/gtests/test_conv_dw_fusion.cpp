@@ -0,0 +1,229 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct conv_dw_fusion_test_params {
+    int mb, ic, oc, h, w;
+    int dw_stride;
+    mkldnn_data_type_t dw_dt; // data type of the dw weights and dst
+    bool dw_with_bias;
+    bool eltwise_1x1; // leaky relu after the 1x1 convolution
+    mkldnn_alg_kind_t eltwise_dw; // eltwise after the dw one, undef if none
+    bool expect_to_fail;
+    mkldnn_status_t expected_status;
+};
+
+/* The 1x1 convolution with the depthwise post-op is checked against the same
+ * 1x1 convolution followed by a standalone depthwise convolution. */
+template <typename data_t>
+class conv_dw_fusion_test
+    : public ::testing::TestWithParam<conv_dw_fusion_test_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<
+                conv_dw_fusion_test_params>::GetParam();
+        catch_expected_failures([=](){Test();}, p.expect_to_fail,
+                    p.expected_status);
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<
+                conv_dw_fusion_test_params>::GetParam();
+
+        auto eng = engine(engine::kind::cpu, 0);
+        memory::data_type data_type = data_traits<data_t>::data_type;
+        ASSERT_EQ(data_type, mkldnn::memory::data_type::f32);
+
+        const mkldnn_data_type_t dw_bias_dt
+            = p.dw_with_bias ? mkldnn_f32 : mkldnn_data_type_undef;
+
+        /* the reference convolutions apply the eltwise post-ops that
+         * surround the dw one */
+        post_ops ops, ops_1x1, ops_dw;
+        if (p.eltwise_1x1) {
+            ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.1f, 0.f);
+            ops_1x1.append_eltwise(1.f, algorithm::eltwise_relu, 0.1f, 0.f);
+        }
+        if (p.dw_stride == 1)
+            ops.append_dw_k3s1p1(p.dw_dt, dw_bias_dt, p.dw_dt);
+        else
+            ops.append_dw_k3s2p1(p.dw_dt, dw_bias_dt, p.dw_dt);
+        if (p.eltwise_dw != mkldnn_alg_kind_undef) {
+            /* linear gives the padded channels a non-zero f(0) */
+            const algorithm alg = (algorithm)p.eltwise_dw;
+            const float alpha = alg == algorithm::eltwise_linear ? 0.5f : 6.f;
+            const float beta = alg == algorithm::eltwise_linear ? 1.f : 0.f;
+            ops.append_eltwise(1.f, alg, alpha, beta);
+            ops_dw.append_eltwise(1.f, alg, alpha, beta);
+        }
+        primitive_attr attr, attr_1x1, attr_dw;
+        attr.set_post_ops(ops);
+        attr_1x1.set_post_ops(ops_1x1);
+        attr_dw.set_post_ops(ops_dw);
+
+        const int OH = (p.h + 2 - 3) / p.dw_stride + 1;
+        const int OW = (p.w + 2 - 3) / p.dw_stride + 1;
+
+        auto src_md = create_md({ p.mb, p.ic, p.h, p.w }, data_type,
+                memory::format::any);
+        auto wei_md = create_md({ p.oc, p.ic, 1, 1 }, data_type,
+                memory::format::any);
+        auto bia_md = create_md({ p.oc }, data_type, memory::format::x);
+        auto mid_md = create_md({ p.mb, p.oc, p.h, p.w }, data_type,
+                memory::format::any);
+
+        auto cd = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, bia_md, mid_md,
+                { 1, 1 }, { 0, 0 }, { 0, 0 }, padding_kind::zero);
+        auto pd = convolution_forward::primitive_desc(cd, attr, eng);
+
+        /* the dw weights and bias follow the 1x1 bias */
+        auto dw_wei_pd = pd.query_mpd(query::input_pd, 3);
+        auto dst_pd = pd.dst_primitive_desc();
+
+        auto ref_cd = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, pd.src_primitive_desc().desc(),
+                pd.weights_primitive_desc().desc(), bia_md, mid_md,
+                { 1, 1 }, { 0, 0 }, { 0, 0 }, padding_kind::zero);
+        auto ref_pd = convolution_forward::primitive_desc(ref_cd, attr_1x1,
+                eng);
+
+        /* a zero bias stands for the missing one in the reference */
+        auto dw_bia_md = create_md({ p.oc }, data_type, memory::format::x);
+        auto dw_cd = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct,
+                ref_pd.dst_primitive_desc().desc(), dw_wei_pd.desc(),
+                dw_bia_md, dst_pd.desc(), { p.dw_stride, p.dw_stride },
+                { 1, 1 }, { 1, 1 }, padding_kind::zero);
+        auto dw_pd = convolution_forward::primitive_desc(dw_cd, attr_dw, eng);
+
+        memory src(pd.src_primitive_desc()), wei(pd.weights_primitive_desc()),
+               bia(pd.bias_primitive_desc()), dw_wei(dw_wei_pd),
+               dw_bia(memory::primitive_desc(dw_bia_md, eng)),
+               dst(dst_pd), mid(ref_pd.dst_primitive_desc()),
+               dst_ref(dw_pd.dst_primitive_desc());
+
+        auto fill = [](memory &m, data_t mean, data_t var) {
+            fill_data<data_t>(m.get_primitive_desc().get_size()
+                    / sizeof(data_t), (data_t *)m.get_data_handle(),
+                    mean, var);
+        };
+        fill(src, data_t(0), data_t(1));
+        fill(wei, data_t(0), data_t(1));
+        fill(bia, data_t(0), data_t(1));
+        fill(dw_wei, data_t(0), data_t(1));
+        fill(dst, data_t(1), data_t(1));
+        check_zero_tail<data_t>(1, wei);
+        check_zero_tail<data_t>(1, dw_wei);
+        if (p.dw_with_bias)
+            fill(dw_bia, data_t(0), data_t(1));
+        else
+            memset(dw_bia.get_data_handle(), 0,
+                    dw_bia.get_primitive_desc().get_size());
+
+        std::vector<primitive::at> inputs = { src, wei, bia, dw_wei };
+        if (p.dw_with_bias) inputs.push_back(dw_bia);
+
+        std::vector<primitive> pipeline;
+        pipeline.push_back(convolution_forward(pd, inputs, dst));
+        pipeline.push_back(convolution_forward(ref_pd, src, wei, bia, mid));
+        pipeline.push_back(convolution_forward(dw_pd, mid, dw_wei, dw_bia,
+                    dst_ref));
+
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        /* the padded channels of the blocked dst stay zero */
+        check_zero_tail<data_t>(0, dst);
+
+        const data_t *dst_data = (data_t *)dst.get_data_handle();
+        const data_t *ref_data = (data_t *)dst_ref.get_data_handle();
+        const memory::desc dst_d = dst.get_primitive_desc().desc();
+        const memory::desc ref_d = dst_ref.get_primitive_desc().desc();
+
+        const ptrdiff_t nelems = (ptrdiff_t)p.mb * p.oc * OH * OW;
+        mkldnn::impl::parallel_nd(nelems, [&](ptrdiff_t e) {
+            const data_t ref = ref_data[map_index(ref_d, e)];
+            const data_t out = dst_data[map_index(dst_d, e)];
+            EXPECT_NEAR(out, ref, 1e-4 * (1 + fabs(ref)));
+        });
+    }
+};
+
+using conv_dw_fusion_test_float = conv_dw_fusion_test<float>;
+
+TEST_P(conv_dw_fusion_test_float, TestsConvDwFusion)
+{
+}
+
+#define F32 mkldnn_f32
+#define ELT_UNDEF mkldnn_alg_kind_undef
+#define ELT_BRELU mkldnn_eltwise_bounded_relu
+#define ELT_LINEAR mkldnn_eltwise_linear
+
+INSTANTIATE_TEST_SUITE_P(
+        TestConvDwFusion, conv_dw_fusion_test_float,
+        ::testing::Values(
+                conv_dw_fusion_test_params{ 2, 16, 32, 14, 14, 1, F32, true },
+                conv_dw_fusion_test_params{ 2, 32, 64, 14, 14, 2, F32, true },
+                conv_dw_fusion_test_params{ 1, 16, 48, 17, 13, 1, F32, false },
+                conv_dw_fusion_test_params{ 1, 32, 32, 15, 19, 2, F32, false },
+                conv_dw_fusion_test_params{ 3, 64, 96, 56, 56, 1, F32, true }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestConvDwFusionPaddedOC, conv_dw_fusion_test_float,
+        ::testing::Values(
+                conv_dw_fusion_test_params{ 2, 16, 24, 14, 14, 1, F32, true },
+                conv_dw_fusion_test_params{ 1, 16, 40, 15, 11, 2, F32, true },
+                conv_dw_fusion_test_params{ 1, 32, 8, 9, 9, 1, F32, false }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestConvDwFusionEltwise, conv_dw_fusion_test_float,
+        ::testing::Values(
+                conv_dw_fusion_test_params{ 2, 16, 32, 14, 14, 1, F32, true,
+                        true, ELT_UNDEF },
+                conv_dw_fusion_test_params{ 2, 16, 32, 14, 14, 2, F32, true,
+                        false, ELT_BRELU },
+                conv_dw_fusion_test_params{ 1, 32, 64, 28, 28, 1, F32, true,
+                        true, ELT_BRELU },
+                conv_dw_fusion_test_params{ 1, 16, 24, 13, 17, 2, F32, true,
+                        true, ELT_BRELU },
+                conv_dw_fusion_test_params{ 2, 16, 24, 14, 14, 1, F32, true,
+                        false, ELT_LINEAR },
+                conv_dw_fusion_test_params{ 1, 32, 40, 11, 9, 2, F32, false,
+                        true, ELT_LINEAR }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestConvDwFusionEF, conv_dw_fusion_test_float,
+        ::testing::Values(
+                conv_dw_fusion_test_params{ 1, 16, 32, 7, 7, 1,
+                        mkldnn_data_type_undef, true, false, ELT_UNDEF, true,
+                        mkldnn_invalid_arguments }));
+
+#undef ELT_LINEAR
+#undef ELT_BRELU
+#undef ELT_UNDEF
+#undef F32
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -64,6 +64,49 @@ TEST_F(pd_iter_test, TestReLUImpls) {
     mkldnn_primitive_desc_iterator_destroy(it);
 }
 
+TEST_F(pd_iter_test, TestPrimitiveCache) {
+    int capacity;
+    EXPECT_EQ(mkldnn_get_primitive_cache_capacity(&capacity), ok);
+    EXPECT_EQ(mkldnn_set_primitive_cache_capacity(-1),
+            mkldnn_invalid_arguments);
+
+    mkldnn_memory_desc_t dense_md;
+    mkldnn_dims_t dims = {4, 16, 16, 16};
+    EXPECT_EQ(mkldnn_memory_desc_init(&dense_md, 4, dims, mkldnn_f32,
+                mkldnn_nchw), ok);
+
+    mkldnn_eltwise_desc_t ed;
+    EXPECT_EQ(mkldnn_eltwise_forward_desc_init(&ed, mkldnn_forward_inference,
+                mkldnn_eltwise_relu, &dense_md, 0., 0.), ok);
+
+    /* a cached descriptor must iterate over the same implementations */
+    auto impl_names = [&]() {
+        std::vector<std::string> names;
+        mkldnn_primitive_desc_iterator_t it;
+        EXPECT_EQ(mkldnn_primitive_desc_iterator_create(&it, &ed, engine,
+                    nullptr), ok);
+        do {
+            mkldnn_primitive_desc_t pd
+                = mkldnn_primitive_desc_iterator_fetch(it);
+            const char *name;
+            EXPECT_EQ(mkldnn_primitive_desc_query(pd,
+                        mkldnn_query_impl_info_str, 0, &name), ok);
+            names.push_back(name);
+            mkldnn_primitive_desc_destroy(pd);
+        } while (mkldnn_primitive_desc_iterator_next(it) == ok);
+        mkldnn_primitive_desc_iterator_destroy(it);
+        return names;
+    };
+
+    EXPECT_EQ(mkldnn_set_primitive_cache_capacity(0), ok);
+    auto uncached = impl_names();
+    EXPECT_EQ(mkldnn_set_primitive_cache_capacity(16), ok);
+    impl_names();
+    EXPECT_EQ(impl_names(), uncached);
+
+    EXPECT_EQ(mkldnn_set_primitive_cache_capacity(capacity), ok);
+}
+
 TEST(pd_next_impl, TestEltwiseImpl) {
     auto eng = engine(engine::kind::cpu, 0);
     memory::desc md({8, 32, 4, 4}, memory::data_type::f32, memory::format::nChw8c);
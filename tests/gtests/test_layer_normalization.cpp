@@ -0,0 +1,301 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct lnorm_test_params {
+    memory::dims dims;
+    memory::format data_format;
+    unsigned flags;
+    float epsilon;
+    bool expect_to_fail;
+    mkldnn_status_t expected_status;
+};
+
+template <typename data_t>
+class lnorm_test : public ::testing::TestWithParam<lnorm_test_params> {
+protected:
+    virtual void SetUp() {
+        p = ::testing::TestWithParam<lnorm_test_params>::GetParam();
+        catch_expected_failures([=](){Test();}, p.expect_to_fail,
+                    p.expected_status);
+    }
+
+    void Test() {
+        use_scaleshift = p.flags & use_scale_shift;
+        use_global_stats = p.flags & mkldnn::use_global_stats;
+
+        const int nd = (int)p.dims.size();
+        C = p.dims[nd - 1];
+        N = 1;
+        for (int d = 0; d < nd - 1; ++d) N *= p.dims[d];
+
+        auto eng = engine(engine::kind::cpu, 0);
+        memory::data_type data_type = data_traits<data_t>::data_type;
+        ASSERT_EQ(data_type, mkldnn::memory::data_type::f32);
+
+        data_desc.reset(new memory::desc(
+                    create_md(p.dims, data_type, p.data_format)));
+
+        auto fwd_desc = layer_normalization_forward::desc(
+                prop_kind::forward_training, *data_desc, p.epsilon, p.flags);
+        auto fwd_pd = layer_normalization_forward::primitive_desc(fwd_desc,
+                eng);
+
+        memory src(fwd_pd.src_primitive_desc());
+        memory dst(fwd_pd.dst_primitive_desc());
+        memory mean(fwd_pd.mean_primitive_desc());
+        memory variance(fwd_pd.variance_primitive_desc());
+        std::shared_ptr<memory> weights;
+        if (use_scaleshift)
+            weights.reset(new memory(fwd_pd.weights_primitive_desc()));
+
+        fill(src, data_t(1), data_t(2));
+        if (use_scaleshift) fill(*weights, data_t(1), data_t(1));
+        if (use_global_stats) {
+            fill(mean, data_t(1), data_t(1));
+            fill(variance, data_t(1), data_t(2e-1));
+        }
+
+        std::shared_ptr<primitive> lnorm;
+        if (use_global_stats) {
+            if (use_scaleshift)
+                lnorm.reset(new layer_normalization_forward(fwd_pd, src,
+                            mean, variance, *weights, dst));
+            else
+                lnorm.reset(new layer_normalization_forward(fwd_pd, src,
+                            mean, variance, dst));
+        } else {
+            if (use_scaleshift)
+                lnorm.reset(new layer_normalization_forward(fwd_pd, src,
+                            *weights, dst, mean, variance));
+            else
+                lnorm.reset(new layer_normalization_forward(fwd_pd, src,
+                            dst, mean, variance));
+        }
+
+        std::vector<primitive> pipeline;
+        pipeline.push_back(*lnorm);
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        check_fwd(src, dst, mean, variance, weights.get());
+
+        auto bwd_desc = layer_normalization_backward::desc(
+                use_scaleshift ? prop_kind::backward : prop_kind::backward_data,
+                *data_desc, *data_desc, p.epsilon, p.flags);
+        auto bwd_pd = layer_normalization_backward::primitive_desc(bwd_desc,
+                eng, fwd_pd);
+
+        memory diff_dst(bwd_pd.diff_dst_primitive_desc());
+        memory diff_src(bwd_pd.diff_src_primitive_desc());
+        std::shared_ptr<memory> diff_weights;
+        if (use_scaleshift)
+            diff_weights.reset(
+                    new memory(bwd_pd.diff_weights_primitive_desc()));
+
+        fill(diff_dst, data_t(0), data_t(1));
+
+        if (use_scaleshift)
+            lnorm.reset(new layer_normalization_backward(bwd_pd, src, mean,
+                        variance, diff_dst, *weights, diff_src,
+                        *diff_weights));
+        else
+            lnorm.reset(new layer_normalization_backward(bwd_pd, src, mean,
+                        variance, diff_dst, diff_src));
+
+        pipeline.clear();
+        pipeline.push_back(*lnorm);
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        check_bwd(src, diff_dst, mean, variance, weights.get(), diff_src,
+                diff_weights.get());
+    }
+
+    void fill(memory &m, data_t mean, data_t deviation) {
+        fill_data<data_t>(m.get_primitive_desc().get_size() / sizeof(data_t),
+                (data_t *)m.get_data_handle(), mean, deviation);
+    }
+
+    data_t gamma(const data_t *ss, int c) const
+    { return ss ? ss[c] : data_t(1); }
+
+    void check_fwd(memory &src, memory &dst, memory &mean, memory &variance,
+            memory *weights) {
+        const data_t *src_data = (const data_t *)src.get_data_handle();
+        const data_t *dst_data = (const data_t *)dst.get_data_handle();
+        const data_t *mean_data = (const data_t *)mean.get_data_handle();
+        const data_t *var_data = (const data_t *)variance.get_data_handle();
+        const data_t *ss = weights
+            ? (const data_t *)weights->get_data_handle() : nullptr;
+        const memory::desc stat_d = mean.get_primitive_desc().desc();
+
+        const data_t eps = static_cast<data_t>(1.e-4 * C);
+
+        mkldnn::impl::parallel_nd(N, [&](int n) {
+            data_t ref_mean = 0, ref_var = 0;
+            if (use_global_stats) {
+                ref_mean = mean_data[map_index(stat_d, n)];
+                ref_var = var_data[map_index(stat_d, n)];
+            } else {
+                for (int c = 0; c < C; ++c)
+                    ref_mean += src_data[map_index(*data_desc, n * C + c)];
+                ref_mean /= C;
+                for (int c = 0; c < C; ++c) {
+                    data_t m = src_data[map_index(*data_desc, n * C + c)]
+                        - ref_mean;
+                    ref_var += m * m;
+                }
+                ref_var /= C;
+
+                data_t out_mean = mean_data[map_index(stat_d, n)];
+                data_t out_var = var_data[map_index(stat_d, n)];
+                EXPECT_NEAR((out_mean - ref_mean) / (fabs(ref_mean) + 1), 0,
+                        eps);
+                EXPECT_NEAR((out_var - ref_var) / (fabs(ref_var) + 1), 0,
+                        eps);
+            }
+
+            const data_t sqrt_var = sqrt(ref_var + p.epsilon);
+            for (int c = 0; c < C; ++c) {
+                const size_t off = map_index(*data_desc, n * C + c);
+                data_t ref_dst = (src_data[off] - ref_mean) / sqrt_var;
+                if (ss) ref_dst = ss[c] * ref_dst + ss[C + c];
+                EXPECT_NEAR((dst_data[off] - ref_dst) / (fabs(ref_dst) + 1),
+                        0, eps);
+            }
+        });
+    }
+
+    void check_bwd(memory &src, memory &diff_dst, memory &mean,
+            memory &variance, memory *weights, memory &diff_src,
+            memory *diff_weights) {
+        const data_t *src_data = (const data_t *)src.get_data_handle();
+        const data_t *dd_data = (const data_t *)diff_dst.get_data_handle();
+        const data_t *mean_data = (const data_t *)mean.get_data_handle();
+        const data_t *var_data = (const data_t *)variance.get_data_handle();
+        const data_t *ss = weights
+            ? (const data_t *)weights->get_data_handle() : nullptr;
+        const data_t *ds_data = (const data_t *)diff_src.get_data_handle();
+        const data_t *dss = diff_weights
+            ? (const data_t *)diff_weights->get_data_handle() : nullptr;
+        const memory::desc stat_d = mean.get_primitive_desc().desc();
+        const memory::desc diff_d = diff_src.get_primitive_desc().desc();
+
+        const data_t eps = static_cast<data_t>(1.e-4 * C);
+
+        auto inv_sqrt_var = [&](int n) {
+            return data_t(1)
+                / sqrt(var_data[map_index(stat_d, n)] + p.epsilon);
+        };
+        auto x_hat = [&](int n, int c) {
+            return (src_data[map_index(*data_desc, n * C + c)]
+                    - mean_data[map_index(stat_d, n)]) * inv_sqrt_var(n);
+        };
+
+        if (dss) {
+            const data_t eps_ss = static_cast<data_t>(1.e-4 * N);
+            mkldnn::impl::parallel_nd(C, [&](int c) {
+                data_t ref_dg = 0, ref_db = 0;
+                for (int n = 0; n < N; ++n) {
+                    const data_t dd = dd_data[map_index(diff_d, n * C + c)];
+                    ref_dg += dd * x_hat(n, c);
+                    ref_db += dd;
+                }
+                EXPECT_NEAR((dss[c] - ref_dg) / (fabs(ref_dg) + 1), 0,
+                        eps_ss);
+                EXPECT_NEAR((dss[C + c] - ref_db) / (fabs(ref_db) + 1), 0,
+                        eps_ss);
+            });
+        }
+
+        mkldnn::impl::parallel_nd(N, [&](int n) {
+            data_t m1 = 0, m2 = 0;
+            if (!use_global_stats) {
+                for (int c = 0; c < C; ++c) {
+                    const data_t dd = dd_data[map_index(diff_d, n * C + c)]
+                        * gamma(ss, c);
+                    m1 += dd;
+                    m2 += dd * x_hat(n, c);
+                }
+                m1 /= C;
+                m2 /= C;
+            }
+
+            for (int c = 0; c < C; ++c) {
+                const size_t off = map_index(diff_d, n * C + c);
+                data_t ref_ds = dd_data[off] * gamma(ss, c);
+                if (!use_global_stats) ref_ds -= m1 + x_hat(n, c) * m2;
+                ref_ds *= inv_sqrt_var(n);
+                EXPECT_NEAR((ds_data[off] - ref_ds) / (fabs(ref_ds) + 1), 0,
+                        eps);
+            }
+        });
+    }
+
+    lnorm_test_params p;
+    std::shared_ptr<memory::desc> data_desc;
+    bool use_scaleshift, use_global_stats;
+    int N, C;
+};
+
+using lnorm_test_float = lnorm_test<float>;
+
+TEST_P(lnorm_test_float, TestsLayerNormalization)
+{
+}
+
+#define FMT(f) memory::format::f
+#define NONE 0u
+#define GS use_global_stats
+#define SS use_scale_shift
+#define EPS 1.e-5f
+
+INSTANTIATE_TEST_SUITE_P(
+        TestLayerNormalization, lnorm_test_float,
+        ::testing::Values(
+                lnorm_test_params{ { 16, 64 }, FMT(nc), NONE, EPS },
+                lnorm_test_params{ { 10, 33 }, FMT(nc), SS, EPS },
+                lnorm_test_params{ { 10, 1000 }, FMT(nc), SS, EPS },
+                lnorm_test_params{ { 7, 3 }, FMT(nc), GS, EPS },
+                lnorm_test_params{ { 5, 20, 768 }, FMT(ncw), SS, EPS },
+                lnorm_test_params{ { 5, 20, 17 }, FMT(ncw), GS | SS, EPS },
+                lnorm_test_params{ { 2, 3, 4, 130 }, FMT(nchw), SS, EPS },
+                lnorm_test_params{ { 4, 9, 24 }, FMT(nwc), SS, EPS },
+                lnorm_test_params{ { 1, 1, 1, 1 }, FMT(nchw), SS, EPS }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestLayerNormalizationEF, lnorm_test_float,
+        ::testing::Values(
+                lnorm_test_params{ { 16 }, FMT(x), NONE, EPS,
+                        true, mkldnn_invalid_arguments },
+                lnorm_test_params{ { 2, 16 }, FMT(nc), 4u, EPS,
+                        true, mkldnn_invalid_arguments }));
+
+#undef EPS
+#undef SS
+#undef GS
+#undef NONE
+#undef FMT
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
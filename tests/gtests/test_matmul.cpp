@@ -0,0 +1,221 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct matmul_test_params {
+    memory::dims src_dims;
+    memory::dims weights_dims;
+    memory::dims bias_dims; // empty for no bias
+    memory::dims dst_dims;
+    memory::format src_format;
+    memory::format weights_format;
+    float scale;
+    bool with_sum;
+    bool with_relu;
+    bool expect_to_fail;
+    mkldnn_status_t expected_status;
+};
+
+/* offset of the logical element (idx[0], ..., idx[nd - 1]) of dst in the
+ * broadcast tensor md */
+static size_t bcast_off(const memory::desc &md, const int *idx) {
+    const int nd = md.data.ndims;
+    size_t off = 0;
+    for (int d = 0; d < nd; ++d)
+        off = off * md.data.dims[d] + (md.data.dims[d] == 1 ? 0 : idx[d]);
+    return map_index(md, off);
+}
+
+template <typename data_t>
+void compute_ref_matmul(const matmul_test_params &p, memory &src,
+        memory &weights, memory *bias, memory &dst) {
+    const data_t *src_data = (data_t *)src.get_data_handle();
+    const data_t *wei_data = (data_t *)weights.get_data_handle();
+    const data_t *bias_data = bias ? (data_t *)bias->get_data_handle()
+        : nullptr;
+    data_t *dst_data = (data_t *)dst.get_data_handle();
+
+    const memory::desc src_d = src.get_primitive_desc().desc();
+    const memory::desc wei_d = weights.get_primitive_desc().desc();
+    const memory::desc dst_d = dst.get_primitive_desc().desc();
+
+    const int nd = (int)p.dst_dims.size();
+    const int M = p.dst_dims[nd - 2], N = p.dst_dims[nd - 1];
+    const int K = p.src_dims[nd - 1];
+    int batch = 1;
+    for (int d = 0; d < nd - 2; ++d) batch *= p.dst_dims[d];
+
+    mkldnn::impl::parallel_nd(batch, M, N, [&](int b, int m, int n) {
+        int idx[TENSOR_MAX_DIMS];
+        for (int d = nd - 3, bb = b; d >= 0; --d) {
+            idx[d] = bb % p.dst_dims[d];
+            bb /= p.dst_dims[d];
+        }
+        idx[nd - 2] = m;
+        idx[nd - 1] = n;
+        const size_t dst_off = bcast_off(dst_d, idx);
+
+        float acc = 0;
+        int s_idx[TENSOR_MAX_DIMS], w_idx[TENSOR_MAX_DIMS];
+        for (int d = 0; d < nd; ++d) s_idx[d] = w_idx[d] = idx[d];
+        for (int k = 0; k < K; ++k) {
+            s_idx[nd - 1] = k;
+            w_idx[nd - 2] = k;
+            acc += src_data[bcast_off(src_d, s_idx)]
+                * wei_data[bcast_off(wei_d, w_idx)];
+        }
+        if (bias_data)
+            acc += bias_data[bcast_off(bias->get_primitive_desc().desc(),
+                    idx)];
+        acc *= p.scale;
+        if (p.with_sum) acc += dst_data[dst_off];
+        if (p.with_relu) acc = acc > 0 ? acc : 0;
+        dst_data[dst_off] = acc;
+    });
+}
+
+template <typename data_t>
+class matmul_test : public ::testing::TestWithParam<matmul_test_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<matmul_test_params>::GetParam();
+        catch_expected_failures([=](){Test();}, p.expect_to_fail,
+                    p.expected_status);
+    }
+
+    void Test() {
+        auto p = ::testing::TestWithParam<matmul_test_params>::GetParam();
+        const bool with_bias = !p.bias_dims.empty();
+
+        auto eng = engine(engine::kind::cpu, 0);
+        memory::data_type data_type = data_traits<data_t>::data_type;
+        ASSERT_EQ(data_type, mkldnn::memory::data_type::f32);
+
+        auto src_desc = create_md(p.src_dims, data_type, p.src_format);
+        auto wei_desc = create_md(p.weights_dims, data_type,
+                p.weights_format);
+        auto bias_desc = create_md(p.bias_dims, data_type,
+                with_bias ? memory::format::any
+                : memory::format::format_undef);
+        auto dst_desc = create_md(p.dst_dims, data_type, memory::format::any);
+
+        auto mm_desc = with_bias
+            ? matmul::desc(src_desc, wei_desc, bias_desc, dst_desc)
+            : matmul::desc(src_desc, wei_desc, dst_desc);
+
+        primitive_attr attr;
+        attr.set_output_scales(0, { p.scale });
+        post_ops ops;
+        if (p.with_sum) ops.append_sum(1.f);
+        if (p.with_relu)
+            ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+        attr.set_post_ops(ops);
+
+        auto mm_pd = matmul::primitive_desc(mm_desc, attr, eng);
+
+        memory src(mm_pd.src_primitive_desc());
+        memory weights(mm_pd.weights_primitive_desc());
+        memory dst(mm_pd.dst_primitive_desc());
+        memory dst_ref(mm_pd.dst_primitive_desc());
+        std::shared_ptr<memory> bias;
+        if (with_bias) bias.reset(new memory(mm_pd.bias_primitive_desc()));
+
+        auto fill = [](memory &m) {
+            fill_data<data_t>(m.get_primitive_desc().get_size()
+                    / sizeof(data_t), (data_t *)m.get_data_handle());
+        };
+        fill(src);
+        fill(weights);
+        fill(dst);
+        if (with_bias) fill(*bias);
+
+        const size_t dst_size = dst.get_primitive_desc().get_size();
+        memcpy(dst_ref.get_data_handle(), dst.get_data_handle(), dst_size);
+
+        auto mm = with_bias
+            ? matmul(mm_pd, src, weights, *bias, dst)
+            : matmul(mm_pd, src, weights, dst);
+
+        std::vector<primitive> pipeline;
+        pipeline.push_back(mm);
+        stream(stream::kind::eager).submit(pipeline).wait();
+
+        compute_ref_matmul<data_t>(p, src, weights, bias.get(), dst_ref);
+        compare_data<data_t>(dst_ref, dst);
+    }
+};
+
+using matmul_test_float = matmul_test<float>;
+
+TEST_P(matmul_test_float, TestsMatmul)
+{
+}
+
+#define FMT(f) memory::format::f
+
+INSTANTIATE_TEST_SUITE_P(
+        TestMatmul2D, matmul_test_float,
+        ::testing::Values(
+                matmul_test_params{ { 16, 32 }, { 32, 24 }, {}, { 16, 24 },
+                        FMT(any), FMT(any), 1.f, false, false },
+                matmul_test_params{ { 7, 65 }, { 65, 33 }, { 1, 33 },
+                        { 7, 33 }, FMT(any), FMT(any), 1.f, false, false },
+                matmul_test_params{ { 17, 9 }, { 9, 40 }, { 17, 40 },
+                        { 17, 40 }, FMT(io), FMT(io), 0.5f, false, true },
+                matmul_test_params{ { 64, 64 }, { 64, 64 }, {}, { 64, 64 },
+                        FMT(nc), FMT(io), 2.f, true, false }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestMatmulBatched, matmul_test_float,
+        ::testing::Values(
+                matmul_test_params{ { 4, 16, 32 }, { 4, 32, 24 }, {},
+                        { 4, 16, 24 }, FMT(any), FMT(any), 1.f, false,
+                        false },
+                matmul_test_params{ { 3, 128, 20 }, { 1, 20, 30 },
+                        { 1, 1, 30 }, { 3, 128, 30 }, FMT(any), FMT(any),
+                        1.f, false, true },
+                matmul_test_params{ { 1, 70, 20 }, { 5, 20, 30 },
+                        { 5, 70, 1 }, { 5, 70, 30 }, FMT(nwc), FMT(nwc),
+                        1.f, true, true },
+                matmul_test_params{ { 2, 3, 40, 8 }, { 2, 1, 8, 16 },
+                        { 1, 3, 1, 16 }, { 2, 3, 40, 16 }, FMT(any),
+                        FMT(any), 0.25f, true, false }));
+
+INSTANTIATE_TEST_SUITE_P(
+        TestMatmulEF, matmul_test_float,
+        ::testing::Values(
+                matmul_test_params{ { 16, 32 }, { 31, 24 }, {}, { 16, 24 },
+                        FMT(any), FMT(any), 1.f, false, false,
+                        true, mkldnn_invalid_arguments },
+                matmul_test_params{ { 2, 16, 32 }, { 3, 32, 24 }, {},
+                        { 2, 16, 24 }, FMT(any), FMT(any), 1.f, false, false,
+                        true, mkldnn_invalid_arguments },
+                matmul_test_params{ { 16, 32 }, { 32, 24 }, { 16, 2 },
+                        { 16, 24 }, FMT(any), FMT(any), 1.f, false, false,
+                        true, mkldnn_invalid_arguments }));
+
+#undef FMT
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -14,6 +14,10 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -240,4 +244,143 @@ INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd, ::testing::Values(
     np_t{{4, 3, 0, 3, 0, 1}}, np_t{{2, 1, 3, 1, 2, 1}}, np_t{{4, 1, 4, 3, 2, 2}}
 ));
 
+
+struct cmg_params_t {
+    int nthr, num_cmgs;
+};
+
+class test_cmg: public ::testing::TestWithParam<cmg_params_t> {};
+
+TEST_P(test_cmg, Team) {
+    const auto p = GetParam();
+    const int ncmg_expected = std::max(1, std::min(p.num_cmgs, p.nthr));
+
+    /* the CMGs take consecutive, balanced ranges of the team */
+    int prev_icmg = 0, prev_ithr_cmg = -1;
+    for (int ithr = 0; ithr < p.nthr; ithr++) {
+        int ncmg, icmg, nthr_cmg, ithr_cmg;
+        impl::cmg_team(p.nthr, ithr, p.num_cmgs, ncmg, icmg, nthr_cmg,
+                ithr_cmg);
+        ASSERT_EQ(ncmg, ncmg_expected);
+        ASSERT_TRUE(0 <= icmg && icmg < ncmg);
+        ASSERT_TRUE(0 <= ithr_cmg && ithr_cmg < nthr_cmg);
+        ASSERT_LE(nthr_cmg, impl::utils::div_up(p.nthr, ncmg));
+        ASSERT_GE(nthr_cmg, p.nthr / ncmg);
+        if (icmg == prev_icmg) {
+            ASSERT_EQ(ithr_cmg, prev_ithr_cmg + 1);
+        } else {
+            ASSERT_EQ(icmg, prev_icmg + 1);
+            ASSERT_EQ(ithr_cmg, 0);
+        }
+        prev_icmg = icmg;
+        prev_ithr_cmg = ithr_cmg;
+    }
+    ASSERT_EQ(prev_icmg, ncmg_expected - 1);
+}
+
+TEST_P(test_cmg, Balance) {
+    const auto p = GetParam();
+    const int ncmg = std::max(1, std::min(p.num_cmgs, p.nthr));
+
+    for (int n : { 0, 1, 3, 4, 7, 100 }) {
+        std::vector<int> owner(n, -1);
+        std::vector<int> cmg_work(ncmg, 0);
+        for (int ithr = 0; ithr < p.nthr; ithr++) {
+            int start = 0, end = 0;
+            impl::balance_cmg(n, p.nthr, ithr, p.num_cmgs, start, end);
+            ASSERT_TRUE(0 <= start && start <= end && end <= n);
+
+            int nc, icmg, nthr_cmg, ithr_cmg;
+            impl::cmg_team(p.nthr, ithr, p.num_cmgs, nc, icmg, nthr_cmg,
+                    ithr_cmg);
+            for (int i = start; i < end; i++) {
+                ASSERT_EQ(owner[i], -1);
+                owner[i] = ithr;
+            }
+            cmg_work[icmg] += end - start;
+        }
+        for (int i = 0; i < n; i++)
+            ASSERT_NE(owner[i], -1);
+        /* the work is spread over the CMGs first */
+        for (int icmg = 0; icmg < ncmg; icmg++) {
+            ASSERT_GE(cmg_work[icmg], n / ncmg);
+            ASSERT_LE(cmg_work[icmg], impl::utils::div_up(n, ncmg));
+        }
+    }
+}
+
+TEST_P(test_cmg, SpreadIthr) {
+    const auto p = GetParam();
+    const int ncmg = std::max(1, std::min(p.num_cmgs, p.nthr));
+
+    for (int nwork : { 0, 1, 3, p.nthr / 2, p.nthr - 1, p.nthr }) {
+        std::vector<int> owner(p.nthr, -1);
+        std::vector<int> cmg_work(ncmg, 0);
+        for (int ithr = 0; ithr < p.nthr; ithr++) {
+            const int id = impl::cmg_spread_ithr(p.nthr, ithr, nwork,
+                    p.num_cmgs);
+            ASSERT_TRUE(0 <= id && id < p.nthr);
+            ASSERT_EQ(owner[id], -1);
+            owner[id] = ithr;
+
+            int nc, icmg, nthr_cmg, ithr_cmg;
+            impl::cmg_team(p.nthr, ithr, p.num_cmgs, nc, icmg, nthr_cmg,
+                    ithr_cmg);
+            cmg_work[icmg] += id < nwork;
+        }
+        /* the working ids are spread over the CMGs first */
+        for (int icmg = 0; icmg < ncmg; icmg++) {
+            ASSERT_GE(cmg_work[icmg], nwork / ncmg);
+            ASSERT_LE(cmg_work[icmg], impl::utils::div_up(nwork, ncmg));
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Case, test_cmg, ::testing::Values(
+    cmg_params_t{1, 1}, cmg_params_t{12, 1}, cmg_params_t{48, 4},
+    cmg_params_t{10, 4}, cmg_params_t{2, 4}, cmg_params_t{13, 2},
+    cmg_params_t{5, 0}
+));
+
+TEST(test_stream_max_threads, Status) {
+    stream s(stream::kind::eager);
+    EXPECT_EQ(mkldnn_stream_set_max_threads(s.get(), -1),
+            mkldnn_invalid_arguments);
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+    EXPECT_EQ(mkldnn_stream_set_max_threads(s.get(), 2), mkldnn_success);
+    EXPECT_EQ(mkldnn_stream_set_max_threads(s.get(), 0), mkldnn_success);
+#else
+    /* only the native thread pool can cap the threads of a stream */
+    EXPECT_EQ(mkldnn_stream_set_max_threads(s.get(), 2),
+            mkldnn_unimplemented);
+#endif
+}
+
+#if MKLDNN_THR == MKLDNN_THR_THREADPOOL
+/* a section asking for more threads than the cap, as the primitives that
+ * fixed their nthr at creation do, keeps its nthr tasks but runs them on at
+ * most the cap threads */
+TEST(test_parallel, MaxThreads) {
+    const int max_threads = 2, nthr = 8;
+    impl::threadpool_utils::max_threads_scope_t scope(max_threads);
+    EXPECT_LE(mkldnn_get_max_threads(), max_threads);
+
+    std::atomic<int> running(0), max_running(0);
+    std::vector<int> ran(nthr, 0);
+    impl::parallel(nthr, [&](int ithr, int team) {
+        EXPECT_EQ(team, nthr);
+        ran[ithr]++;
+        const int r = ++running;
+        int m = max_running.load();
+        while (r > m && !max_running.compare_exchange_weak(m, r)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        --running;
+    });
+
+    EXPECT_LE(max_running.load(), max_threads);
+    for (int ithr = 0; ithr < nthr; ithr++)
+        EXPECT_EQ(ran[ithr], 1);
+}
+#endif
+
 }
@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <stdlib.h>
 #include <utility>
 #include <numeric>
 
@@ -55,6 +56,28 @@ struct test_rnn_params_t {
     test_rnn_sizes_t sizes;
     bool expect_to_fail;
     mkldnn_status_t expected_status;
+    bool wavefront; // the tested primitive runs the wavefront schedule
+};
+
+/* Sets MKLDNN_RNN_WAVEFRONT while in scope, the library reads it when a
+ * primitive descriptor is created */
+struct rnn_wavefront_scope_t {
+    rnn_wavefront_scope_t(bool on): on_(on) {
+        if (on_) set("1");
+    }
+    ~rnn_wavefront_scope_t() {
+        if (on_) set(nullptr);
+    }
+private:
+    static void set(const char *value) {
+#ifdef _WIN32
+        _putenv_s("MKLDNN_RNN_WAVEFRONT", value ? value : "");
+#else
+        if (value) setenv("MKLDNN_RNN_WAVEFRONT", value, 1);
+        else unsetenv("MKLDNN_RNN_WAVEFRONT");
+#endif
+    }
+    bool on_;
 };
 
 // We assume uniform data type accross tensors for now
@@ -201,6 +224,7 @@ protected:
                 direction, src_layer_md_tgt, src_iter_md_tgt,
                 weights_layer_md_tgt, weights_iter_md_tgt, bias_md_tgt,
                 dst_layer_md_tgt, dst_iter_md_tgt);
+        rnn_wavefront_scope_t wavefront_scope(p.wavefront);
         auto tgt_prim_desc = rnn_forward::primitive_desc(tgt_desc, eng);
         auto prim_tgt = rnn_forward(tgt_prim_desc, src_layer_tgt, src_iter_tgt,
                 weights_layer_tgt, weights_iter_tgt, bias_tgt,
@@ -243,4 +267,20 @@ INSTANTIATE_TEST_SUITE_P(TestRnn, rnn_forward_test_f32,
             )
     );
 
+/* Several layers and iterations with a small batch run as a wavefront, the
+ * reference keeps the linear schedule */
+INSTANTIATE_TEST_SUITE_P(TestRnnWavefront, rnn_forward_test_f32,
+        ::testing::Values(
+            cfg_f32{eng::cpu, alg::vanilla_rnn, alg::eltwise_tanh, dir::unidirectional_left2right,
+                {fmt::tnc, fmt::ldsnc, fmt::ldigo, fmt::ldigo, fmt::ldgo, fmt::tnc, fmt::ldsnc},
+                    test_rnn_sizes_t(3, 1, 5, 4, 32, 32, 32, 32), false, mkldnn_success, true},
+            cfg_f32{eng::cpu, alg::vanilla_lstm, alg::eltwise_tanh, dir::unidirectional_left2right,
+                {fmt::tnc, fmt::ldsnc, fmt::ldigo, fmt::ldigo, fmt::ldgo, fmt::tnc, fmt::ldsnc},
+                    test_rnn_sizes_t(4, 1, 7, 2, 48, 48, 48, 48), false, mkldnn_success, true},
+            cfg_f32{eng::cpu, alg::vanilla_gru, alg::eltwise_tanh, dir::bidirectional_sum,
+                {fmt::tnc, fmt::ldsnc, fmt::ldigo, fmt::ldigo, fmt::ldgo, fmt::tnc, fmt::ldsnc},
+                    test_rnn_sizes_t(2, 2, 6, 8, 40, 40, 40, 40), false, mkldnn_success, true}
+            )
+    );
+
 }
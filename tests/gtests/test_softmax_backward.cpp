@@ -23,7 +23,8 @@
 namespace mkldnn {
 
 template <typename data_t>
-void check_softmax_bwd(memory& dst, memory& diff_dst, memory &diff_src, int axis)
+void check_softmax_bwd(algorithm aalgorithm, memory& dst, memory& diff_dst,
+        memory &diff_src, int axis)
 {
     data_t *dst_ptr = (data_t *)dst.get_data_handle();
     data_t *diff_dst_ptr = (data_t *)diff_dst.get_data_handle();
@@ -37,7 +38,8 @@ void check_softmax_bwd(memory& dst, memory& diff_dst, memory &diff_src, int axis
 
     auto ndims = diff_dst_pd.data.ndims;
 
-    const float eps = 1e-7; //TODO: What should be the threshold?
+    const bool is_log = aalgorithm == algorithm::softmax_log;
+    const float eps = is_log ? 1e-6 : 1e-7; //TODO: What should be the threshold?
 
     int OU = 1;
     for (int d = 0; d < axis; ++d) OU *= diff_dst_pd.data.dims[d];
@@ -52,14 +54,16 @@ void check_softmax_bwd(memory& dst, memory& diff_dst, memory &diff_src, int axis
         for (int c = 0; c < C; ++c) {
             auto off_d = map_index(dst_pd, idx_start + c * IN, false);
             auto off_dd = map_index(diff_dst_pd, idx_start + c * IN, false);
-            sbr += dst_ptr[off_d] * diff_dst_ptr[off_dd];
+            sbr += is_log
+                ? diff_dst_ptr[off_dd] : dst_ptr[off_d] * diff_dst_ptr[off_dd];
         }
 
         for (int c = 0; c < C; ++c) {
             auto off_d = map_index(dst_pd, idx_start + c * IN, false);
             auto off_dd = map_index(diff_dst_pd, idx_start + c * IN, false);
-            const float diff_src_ref =
-                dst_ptr[off_d] * (diff_dst_ptr[off_dd] - sbr);
+            const float diff_src_ref = is_log
+                ? diff_dst_ptr[off_dd] - expf(dst_ptr[off_d]) * sbr
+                : dst_ptr[off_d] * (diff_dst_ptr[off_dd] - sbr);
             EXPECT_NEAR(diff_src_ptr[off_dd], diff_src_ref, eps);
         }
     });
@@ -74,6 +78,7 @@ struct softmax_test_params {
     int axis;
     bool expect_to_fail;
     mkldnn_status_t expected_status;
+    algorithm aalgorithm; // softmax_accurate if not set
 };
 
 template <typename data_t>
@@ -111,12 +116,14 @@ protected:
 
         // Create softmax backward descriptor
         // before forward so its exceptions can be tested
-        auto softmax_desc
-            = softmax_backward::desc(diff_mem_desc, data_mem_desc, p.axis);
+        const algorithm alg = p.aalgorithm == algorithm::softmax_log
+            ? algorithm::softmax_log : algorithm::softmax_accurate;
+        auto softmax_desc = softmax_backward::desc(alg, diff_mem_desc,
+                data_mem_desc, p.axis);
 
         // Create softmax forward (hint for backward)
         auto softmax_fwd_desc = softmax_forward::desc(prop_kind::forward_scoring,
-                data_mem_desc, p.axis);
+                alg, data_mem_desc, p.axis);
         auto softmax_fwd_pdesc = softmax_forward::primitive_desc(softmax_fwd_desc,
                 eng);
 
@@ -139,7 +146,7 @@ protected:
             check_zero_tail<data_t>(1, diff_dst);
 
             stream(stream::kind::lazy).submit({softmax, softmax_bwd}).wait();
-            check_softmax_bwd<data_t>(dst, diff_dst, diff_src, p.axis);
+            check_softmax_bwd<data_t>(alg, dst, diff_dst, diff_src, p.axis);
             check_zero_tail<data_t>(0, diff_src);
         };
 
@@ -166,6 +173,11 @@ INSTANTIATE_TEST_SUITE_P(TestSoftmaxBackward, softmax_backward_test_float,
             softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nc, memory::format::nc, {16, 30000}, 1},
             softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nc, memory::format::nc, {2, 1000}, 1},
             softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw8c, memory::format::nChw8c, {64, 1011, 1, 1}, 1},
-            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw8c, memory::format::nChw8c, {2, 1011, 32, 1}, 2}
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw8c, memory::format::nChw8c, {2, 1011, 32, 1}, 2},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw16c, memory::format::nChw16c, {2, 21, 17, 13}, 1},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nhwc, memory::format::nhwc, {2, 21, 17, 13}, 1},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nc, memory::format::nc, {16, 1000}, 1, false, mkldnn_success, algorithm::softmax_log},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nchw, memory::format::nchw, {2, 19, 16, 13}, 1, false, mkldnn_success, algorithm::softmax_log},
+            softmax_bwd_test_params_float{ engine::kind::cpu, memory::format::nChw16c, memory::format::nChw16c, {2, 21, 17, 13}, 1, false, mkldnn_success, algorithm::softmax_log}
 ));
 }
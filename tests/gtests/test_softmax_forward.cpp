@@ -22,7 +22,8 @@
 namespace mkldnn {
 
 template <typename data_t>
-void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
+void check_softmax_fwd(prop_kind aprop_kind, algorithm aalgorithm,
+        memory &src, memory &dst, int axis)
 {
     data_t *dst_ptr = (data_t *)dst.get_data_handle();
 
@@ -38,7 +39,12 @@ void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
     //     SIAM Publications, Philadelphia, 2nd edition, 2002.
     // So below tests will use error bound dependent
     // on the number of elements in reduction.
-    const float eps = std::numeric_limits<float>::epsilon();
+    // logsoftmax is checked through exp(dst), the exp adds its own error
+    const bool is_log = aalgorithm == algorithm::softmax_log;
+    const float eps = std::numeric_limits<float>::epsilon() * (is_log ? 4 : 1);
+    auto val = [&](size_t off) {
+        return is_log ? expf(dst_ptr[off]) : dst_ptr[off];
+    };
 
     int MB = dst_pd.data.dims[0];
     int C = dst_pd.data.dims[1];
@@ -50,7 +56,7 @@ void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
                 result = 0.0f;
 
                 for (int c = 0; c < C; ++c) {
-                    result += dst_ptr[map_index(dst_pd, n * C + c, false)];
+                    result += val(map_index(dst_pd, n * C + c, false));
                 }
                 EXPECT_NEAR(result, 1.0, eps*C);
             }
@@ -60,7 +66,7 @@ void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
                 result = 0.0f;
 
                 for (int n = 0; n < MB; ++n) {
-                    result += dst_ptr[map_index(dst_pd, n * C + c, false)];
+                    result += val(map_index(dst_pd, n * C + c, false));
                 }
                 EXPECT_NEAR(result, 1.0, eps*MB);
             }
@@ -84,7 +90,7 @@ void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
                         result = 0.0f;
 
                         for (int n = 0; n < MB; ++n) {
-                            result += dst_ptr[off(n, c, h, w)];
+                            result += val(off(n, c, h, w));
                         }
                         EXPECT_NEAR(result, 1.0, eps*MB);
                     }
@@ -97,7 +103,7 @@ void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
                         result = 0.0f;
 
                         for (int c = 0; c < C; ++c) {
-                            result += dst_ptr[off(n, c, h, w)];
+                            result += val(off(n, c, h, w));
                         }
                         EXPECT_NEAR(result, 1.0, eps*C);
                     }
@@ -110,7 +116,7 @@ void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
                         result = 0.0f;
 
                         for (int h = 0; h < H; ++h) {
-                            result += dst_ptr[off(n, c, h, w)];
+                            result += val(off(n, c, h, w));
                         }
                         EXPECT_NEAR(result, 1.0, eps*H);
                     }
@@ -123,7 +129,7 @@ void check_softmax_fwd(prop_kind aprop_kind, memory &src, memory &dst, int axis)
                         result = 0.0f;
 
                         for (int w = 0; w < W; ++w) {
-                            result += dst_ptr[off(n, c, h, w)];
+                            result += val(off(n, c, h, w));
                         }
                         EXPECT_NEAR(result, 1.0, eps*W);
                     }
@@ -142,6 +148,7 @@ struct softmax_test_params {
     int axis;
     bool expect_to_fail;
     mkldnn_status_t expected_status;
+    algorithm aalgorithm; // softmax_accurate if not set
 };
 
 template <typename data_t>
@@ -169,8 +176,10 @@ protected:
         auto src = memory(mem_prim_desc);
         auto dst = memory(mem_prim_desc);
 
-        auto softmax_desc = softmax_forward::desc(p.aprop_kind, mem_desc,
-                    p.axis);
+        const algorithm alg = p.aalgorithm == algorithm::softmax_log
+            ? algorithm::softmax_log : algorithm::softmax_accurate;
+        auto softmax_desc = softmax_forward::desc(p.aprop_kind, alg,
+                mem_desc, p.axis);
         auto softmax_prim_desc
             = softmax_forward::primitive_desc(softmax_desc, eng);
         auto softmax = softmax_forward(softmax_prim_desc, src, dst);
@@ -181,7 +190,7 @@ protected:
             check_zero_tail<data_t>(1, src);
 
             stream(stream::kind::lazy).submit({softmax}).wait();
-            check_softmax_fwd<data_t>(p.aprop_kind, src, dst, p.axis);
+            check_softmax_fwd<data_t>(p.aprop_kind, alg, src, dst, p.axis);
             check_zero_tail<data_t>(0, dst);
         };
 
@@ -233,5 +242,25 @@ INSTANTIATE_TEST_SUITE_P(TestSoftmaxForward, softmax_forward_test_float,
             softmax_fwd_test_params_float{prop_kind::forward_scoring,
             engine::kind::cpu, memory::format::nChw8c, {64, 1011, 1, 1}, 1},
             softmax_fwd_test_params_float{prop_kind::forward_scoring,
-            engine::kind::cpu, memory::format::nChw8c, {2, 1000, 32, 1}, 2}));
+            engine::kind::cpu, memory::format::nChw8c, {2, 1000, 32, 1}, 2},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nChw16c, {2, 21, 17, 13}, 1},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nhwc, {2, 21, 17, 13}, 1},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nc, {16, 1000}, 1,
+            false, mkldnn_success, algorithm::softmax_log},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nchw, {2, 19, 16, 13}, 1,
+            false, mkldnn_success, algorithm::softmax_log},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nChw16c, {2, 21, 17, 13}, 1,
+            false, mkldnn_success, algorithm::softmax_log},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nc, {2, 300000}, 1},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nchw, {2, 20000, 16, 1}, 1},
+            softmax_fwd_test_params_float{prop_kind::forward_scoring,
+            engine::kind::cpu, memory::format::nc, {2, 300000}, 1,
+            false, mkldnn_success, algorithm::softmax_log}));
 }
@@ -0,0 +1,156 @@
+/*******************************************************************************
+* Copyright 2020 FUJITSU LIMITED
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string.h>
+#include <string>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+/* The gemm convolution backward by data always keeps its col2im buffer in a
+ * scratchpad borrowed from the stream, so it shows whether the primitive
+ * really works in the memory given to the stream. */
+class stream_scratchpad_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        eng_.reset(new engine(engine::kind::cpu, 0));
+        memory::desc src_md({2, 8, 10, 10}, memory::data_type::f32,
+                memory::format::nchw);
+        memory::desc wei_md({16, 8, 3, 3}, memory::data_type::f32,
+                memory::format::oihw);
+        memory::desc dst_md({2, 16, 8, 8}, memory::data_type::f32,
+                memory::format::nchw);
+
+        convolution_forward::desc fd(prop_kind::forward_training,
+                algorithm::convolution_direct, src_md, wei_md, dst_md,
+                {1, 1}, {0, 0}, {0, 0}, padding_kind::zero);
+        convolution_forward::primitive_desc fpd(fd, *eng_);
+
+        convolution_backward_data::desc bd(algorithm::convolution_direct,
+                src_md, wei_md, dst_md, {1, 1}, {0, 0}, {0, 0},
+                padding_kind::zero);
+        pd_.reset(new convolution_backward_data::primitive_desc(bd, *eng_,
+                    fpd));
+        while (std::string(pd_->impl_info_str()).find("gemm") != 0)
+            ASSERT_TRUE(pd_->next_impl()) << "no gemm implementation";
+
+        diff_dst_.reset(new memory({dst_md, *eng_}));
+        wei_.reset(new memory({wei_md, *eng_}));
+        fill(*diff_dst_);
+        fill(*wei_);
+    }
+
+    static void fill(memory &m) {
+        fill_data<float>(m.get_primitive_desc().get_size() / sizeof(float),
+                (float *)m.get_data_handle());
+    }
+
+    void execute(stream &s, memory &diff_src) {
+        s.submit({convolution_backward_data(*pd_, *diff_dst_, *wei_,
+                    diff_src)}).wait();
+    }
+
+    size_t scratchpad_size() const {
+        ptrdiff_t size = 0;
+        EXPECT_EQ(mkldnn_primitive_desc_query(pd_->get(),
+                    mkldnn_query_memory_consumption_s64, 0, &size),
+                mkldnn_success);
+        return (size_t)size;
+    }
+
+    std::shared_ptr<engine> eng_;
+    std::shared_ptr<convolution_backward_data::primitive_desc> pd_;
+    std::shared_ptr<memory> diff_dst_, wei_;
+};
+
+TEST_F(stream_scratchpad_test, TestUserMemory) {
+    const size_t size = scratchpad_size();
+    ASSERT_GT(size, 0u);
+
+    memory diff_src_own(pd_->diff_src_primitive_desc());
+    memory diff_src_user(pd_->diff_src_primitive_desc());
+
+    stream s_own(stream::kind::eager);
+    execute(s_own, diff_src_own);
+
+    const unsigned char sentinel = 0xa5;
+    std::vector<unsigned char> buf(size + 64, sentinel);
+    unsigned char *ptr = buf.data() + (64 - (size_t)buf.data() % 64) % 64;
+
+    stream s(stream::kind::eager);
+    EXPECT_EQ(mkldnn_stream_set_scratchpad(s.get(), ptr + 1, size),
+            mkldnn_invalid_arguments);
+    s.set_scratchpad(ptr, size);
+    execute(s, diff_src_user);
+
+    /* the primitive worked in the user memory ... */
+    size_t overwritten = 0;
+    for (size_t i = 0; i < size; ++i)
+        overwritten += ptr[i] != sentinel;
+    EXPECT_GT(overwritten, 0u);
+
+    /* ... and nothing around it */
+    for (unsigned char *p = buf.data(); p < ptr; ++p)
+        EXPECT_EQ(*p, sentinel);
+    for (unsigned char *p = ptr + size; p < buf.data() + buf.size(); ++p)
+        EXPECT_EQ(*p, sentinel);
+
+    const float *d0 = (const float *)diff_src_own.get_data_handle();
+    const float *d1 = (const float *)diff_src_user.get_data_handle();
+    const size_t nelems
+        = diff_src_own.get_primitive_desc().get_size() / sizeof(float);
+    for (size_t i = 0; i < nelems; ++i)
+        ASSERT_EQ(d0[i], d1[i]) << "i = " << i;
+}
+
+TEST_F(stream_scratchpad_test, TestTooSmallUserMemory) {
+    const size_t size = scratchpad_size();
+    ASSERT_GT(size, 64u);
+
+    memory diff_src_own(pd_->diff_src_primitive_desc());
+    memory diff_src_user(pd_->diff_src_primitive_desc());
+
+    stream s_own(stream::kind::eager);
+    execute(s_own, diff_src_own);
+
+    /* a primitive that needs more than the user memory falls back to memory
+     * of the stream and leaves the user memory alone */
+    const unsigned char sentinel = 0x5a;
+    std::vector<unsigned char> buf(128, sentinel);
+    unsigned char *ptr = buf.data() + (64 - (size_t)buf.data() % 64) % 64;
+
+    stream s(stream::kind::eager);
+    s.set_scratchpad(ptr, 64);
+    execute(s, diff_src_user);
+
+    for (size_t i = 0; i < buf.size(); ++i)
+        EXPECT_EQ(buf[i], sentinel);
+
+    const float *d0 = (const float *)diff_src_own.get_data_handle();
+    const float *d1 = (const float *)diff_src_user.get_data_handle();
+    const size_t nelems
+        = diff_src_own.get_primitive_desc().get_size() / sizeof(float);
+    for (size_t i = 0; i < nelems; ++i)
+        ASSERT_EQ(d0[i], d1[i]) << "i = " << i;
+}
+
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s